@@ -0,0 +1,18 @@
+/*
+ ============================================================================
+ Name        : sort_bench.h
+ Description : sort benchmark header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_SORT_BENCH_H
+#define CODESHARK_SORT_BENCH_H
+
+#include <stddef.h>
+
+void bench_sort(size_t n);
+
+#endif //CODESHARK_SORT_BENCH_H
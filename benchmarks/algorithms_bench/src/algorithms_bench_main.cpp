@@ -0,0 +1,32 @@
+/*
+ ============================================================================
+ Name        : algorithms_bench_main.cpp
+ Description : algorithms benchmark main program
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#include <stdio.h>
+
+#include "bench_common/include/bench_common.h"
+#include "algorithms_bench/include/sort_bench.h"
+
+/**
+ * Usage: algorithms_bench [n]
+ *      n: number of elements per array, 1000000 by default
+ */
+int main(int argc, char *argv[])
+{
+    size_t n;
+
+    n = bench_parse_size(argc, argv, 1, 1000000);
+
+    bench_header("algorithms benchmark");
+
+    // benchmark functions implemented in other cpp files within same directory
+    bench_sort(n);
+
+    return 0;
+}
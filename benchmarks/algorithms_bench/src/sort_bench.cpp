@@ -0,0 +1,132 @@
+/*
+ ============================================================================
+ Name        : sort_bench.cpp
+ Description : sort benchmark implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/include/perf.h"
+#include "algorithms/include/sort.h"
+#include "bench_common/include/bench_common.h"
+#include "algorithms_bench/include/sort_bench.h"
+
+typedef int (*sort_func_t)(int *arr, size_t n);
+
+typedef struct _sort_bench_case_t
+{
+    const char *name;
+    sort_func_t func;
+}sort_bench_case_t;
+
+static int std_sort(int *arr, size_t n)
+{
+    sort(arr, arr + n);
+    return 0;
+}
+
+static int parallel_merge(int *arr, size_t n)
+{
+    return cshark_sort_parallel_merge(arr, n, 0);
+}
+
+static const sort_bench_case_t sort_cases[] = {
+    {"std::sort", std_sort},
+    {"introsort", cshark_sort_introsort},
+    {"pdqsort", cshark_sort_pdqsort},
+    {"radix_lsd", cshark_sort_radix_lsd},
+    {"radix_msd", cshark_sort_radix_msd},
+    {"parallel_merge", parallel_merge}
+};
+
+static const char *dist_names[] = {
+    "random", "sorted", "reversed", "few_unique", "organ_pipe", "nearly_sorted", "all_equal"
+};
+
+/**
+ * Generate input of a distribution, see dist_names
+ */
+static void gen_input(int dist, vector<int> &v, mt19937 &rng)
+{
+    size_t n = v.size();
+    size_t i;
+
+    for (i = 0; i < n; i++)
+    {
+        switch (dist)
+        {
+            case 0: v[i] = (int)rng(); break;
+            case 1: v[i] = (int)i; break;
+            case 2: v[i] = (int)(n - i); break;
+            case 3: v[i] = (int)(rng() % 16); break;
+            case 4: v[i] = (int)(i < n / 2 ? i : n - i); break;
+            case 5: v[i] = (int)i; break;
+            default: v[i] = 0; break;
+        }
+    }
+
+    if (dist == 5)
+    {
+        for (i = 0; i < n / 100; i++)    // 1% of elements out of place
+        {
+            swap(v[rng() % n], v[rng() % n]);
+        }
+    }
+}
+
+/**
+ * Benchmark int sorts against std::sort on several input distributions
+ * @param n [in] number of elements
+ */
+void bench_sort(size_t n)
+{
+    vector<int> input(n);
+    vector<int> v;
+    mt19937 rng(1);
+    string name;
+    uint64_t t0;
+    size_t c;
+    int d;
+
+    for (d = 0; d < (int)(sizeof(dist_names) / sizeof(dist_names[0])); d++)
+    {
+        gen_input(d, input, rng);
+
+        for (c = 0; c < sizeof(sort_cases) / sizeof(sort_cases[0]); c++)
+        {
+            v = input;
+            name = string(sort_cases[c].name) + "/" + dist_names[d];
+
+            t0 = perf_cycles_begin();
+            sort_cases[c].func(v.data(), v.size());
+            bench_report(name.c_str(), n, perf_cycles_to_ns(perf_cycles_end() - t0));
+        }
+    }
+
+    // small arrays: network kernel against std::sort, 16 elements per call
+    input.resize(SORT_NETWORK_MAX * 4096);
+    gen_input(0, input, rng);
+
+    v = input;
+    t0 = perf_cycles_begin();
+    for (c = 0; c < v.size(); c += SORT_NETWORK_MAX)
+    {
+        sort(v.begin() + c, v.begin() + c + SORT_NETWORK_MAX);
+    }
+    bench_report("std::sort/16", v.size(), perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    v = input;
+    t0 = perf_cycles_begin();
+    for (c = 0; c < v.size(); c += SORT_NETWORK_MAX)
+    {
+        cshark_sort_network(v.data() + c, SORT_NETWORK_MAX);
+    }
+    bench_report("network/16", v.size(), perf_cycles_to_ns(perf_cycles_end() - t0));
+}
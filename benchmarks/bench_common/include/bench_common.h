@@ -0,0 +1,31 @@
+/*
+ ============================================================================
+ Name        : bench_common.h
+ Description : common benchmark header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_BENCH_COMMON_H
+#define CODESHARK_BENCH_COMMON_H
+
+#include <stdint.h>
+#include <functional>
+#include <string>
+
+using namespace std;
+
+/**
+ * Every benchmark prints one line per case:
+ *      <case name>  <operations>  <total ms>  <ns/op>
+ * so runs of different builds can be compared with diff or a spreadsheet.
+ */
+
+void bench_header(const char *title);
+void bench_report(const char *name, uint64_t ops, uint64_t elapsed_ns);
+size_t bench_parse_size(int argc, char *argv[], int pos, size_t def);
+void bench_threads(const string &name, size_t threads, size_t ops, function<void(size_t, size_t)> fn);
+
+#endif //CODESHARK_BENCH_COMMON_H
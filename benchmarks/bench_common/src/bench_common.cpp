@@ -0,0 +1,85 @@
+/*
+ ============================================================================
+ Name        : bench_common.cpp
+ Description : common benchmark implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+
+#include "common/include/perf.h"
+#include "bench_common/include/bench_common.h"
+
+/**
+ * Print the title and column names of a benchmark
+ * @param title [in] benchmark title
+ */
+void bench_header(const char *title)
+{
+    printf("=== %s (timer: %s) ===\n", title, perf_tsc_enabled() ? "cycle counter" : "steady_clock");
+    printf("%-36s %12s %12s %10s\n", "case", "ops", "total(ms)", "ns/op");
+}
+
+/**
+ * Print the result of one benchmark case
+ * @param name [in] case name
+ * @param ops [in] number of operations
+ * @param elapsed_ns [in] elapsed time of all operations
+ */
+void bench_report(const char *name, uint64_t ops, uint64_t elapsed_ns)
+{
+    printf("%-36s %12llu %12.3f %10.1f\n", name, (unsigned long long)ops,
+           elapsed_ns / 1e6, ops == 0 ? 0.0 : (double)elapsed_ns / ops);
+}
+
+/**
+ * Parse a size argument
+ * @param argc [in] argc of main()
+ * @param argv [in] argv of main()
+ * @param pos [in] position of the argument
+ * @param def [in] default value if the argument is missing or invalid
+ * @return size
+ */
+size_t bench_parse_size(int argc, char *argv[], int pos, size_t def)
+{
+    long long v;
+
+    if (pos >= argc)
+    {
+        return def;
+    }
+
+    v = atoll(argv[pos]);
+    return v > 0 ? (size_t)v : def;
+}
+
+/**
+ * Run fn(id, ops) on threads at once, id from 0, and report the time of all of them
+ * @param name [in] case name
+ * @param threads [in] number of threads
+ * @param ops [in] operations per thread
+ * @param fn [in] work of one thread
+ */
+void bench_threads(const string &name, size_t threads, size_t ops, function<void(size_t, size_t)> fn)
+{
+    vector<thread> workers;
+    uint64_t t0;
+    size_t i;
+
+    t0 = perf_cycles_begin();
+    for (i = 0; i < threads; i++)
+    {
+        workers.push_back(thread(fn, i, ops));
+    }
+    for (i = 0; i < threads; i++)
+    {
+        workers[i].join();
+    }
+    bench_report(name.c_str(), threads * ops, perf_cycles_to_ns(perf_cycles_end() - t0));
+}
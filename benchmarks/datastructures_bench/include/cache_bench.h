@@ -0,0 +1,18 @@
+/*
+ ============================================================================
+ Name        : cache_bench.h
+ Description : cache benchmark header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_CACHE_BENCH_H
+#define CODESHARK_CACHE_BENCH_H
+
+#include <stddef.h>
+
+void bench_cache(size_t n, const char *trace_path);
+
+#endif //CODESHARK_CACHE_BENCH_H
@@ -0,0 +1,29 @@
+/*
+ ============================================================================
+ Name        : container_bench.h
+ Description : container benchmark header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_CONTAINER_BENCH_H
+#define CODESHARK_CONTAINER_BENCH_H
+
+#include <stddef.h>
+
+void bench_linklist(size_t n);
+void bench_stack(size_t n);
+void bench_queue(size_t n);
+void bench_heap(size_t n);
+void bench_hashtable(size_t n);
+void bench_str_hashtable(size_t n);
+void bench_perfect_hashtable(size_t n);
+void bench_flat_map(size_t n);
+void bench_tree(size_t n);
+void bench_persistent(size_t n);
+void bench_skiplist(size_t n);
+void bench_intrusive(size_t n);
+
+#endif //CODESHARK_CONTAINER_BENCH_H
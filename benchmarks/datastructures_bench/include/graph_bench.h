@@ -0,0 +1,18 @@
+/*
+ ============================================================================
+ Name        : graph_bench.h
+ Description : graph benchmark header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_GRAPH_BENCH_H
+#define CODESHARK_GRAPH_BENCH_H
+
+#include <stddef.h>
+
+void bench_graph(size_t n);
+
+#endif //CODESHARK_GRAPH_BENCH_H
@@ -0,0 +1,226 @@
+/*
+ ============================================================================
+ Name        : cache_bench.cpp
+ Description : cache benchmark implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <algorithm>
+#include <mutex>
+#include <random>
+#include <vector>
+
+#include "common/include/err.h"
+#include "common/include/perf.h"
+#include "datastructures/include/cache.h"
+#include "datastructures/include/concurrent_cache.h"
+#include "bench_common/include/bench_common.h"
+#include "datastructures_bench/include/cache_bench.h"
+
+#define CACHE_BENCH_ACCESSES    8       // accesses per key of a generated trace
+#define CACHE_BENCH_RATIO       10      // keys per cache entry
+#define CACHE_BENCH_ZIPF        0.99    // skew of the Zipf trace
+#define CACHE_BENCH_MAX_THREADS 8       // most threads sharing a cache
+
+/**
+ * Generate keys of a Zipf distribution, key 0 the most popular
+ */
+static vector<int> cache_trace_zipf(size_t keys, size_t len, mt19937 *rng)
+{
+    vector<double> cdf(keys);
+    vector<int> trace(len);
+    uniform_real_distribution<double> uniform(0.0, 1.0);
+    double sum;
+    size_t i;
+
+    sum = 0;
+    for (i = 0; i < keys; i++)
+    {
+        sum += 1.0 / pow((double)(i + 1), CACHE_BENCH_ZIPF);
+        cdf[i] = sum;
+    }
+
+    for (i = 0; i < len; i++)
+    {
+        trace[i] = (int)(lower_bound(cdf.begin(), cdf.end(), uniform(*rng) * sum) - cdf.begin());
+    }
+
+    return trace;
+}
+
+/**
+ * Read a recorded trace, one key per line
+ * @return keys, empty if the file cannot be read
+ */
+static vector<int> cache_trace_load(const char *path)
+{
+    vector<int> trace;
+    FILE *fp;
+    int key;
+
+    fp = fopen(path, "r");
+    if (fp == NULL)
+    {
+        printf("cannot read trace %s\n", path);
+        return trace;
+    }
+
+    while (fscanf(fp, "%d", &key) == 1)
+    {
+        trace.push_back(key);
+    }
+    fclose(fp);
+
+    return trace;
+}
+
+/**
+ * Replay a trace with read-through caching, a miss puts the key, and report time and hit ratio
+ */
+static void cache_replay(const char *trace_name, const vector<int> &trace, size_t capacity)
+{
+    const CACHE_POLICY policies[3] = {CACHE_LRU, CACHE_SLRU, CACHE_CLOCK};
+    const char *policy_names[3] = {"LRU", "SLRU", "CLOCK"};
+    cshark_cache_stats_t stats;
+    Cache *cache;
+    string value = "value";
+    char name[128];
+    uint64_t t0, ns;
+    size_t i;
+    int p;
+
+    for (p = 0; p < 3; p++)
+    {
+        cache = new Cache(policies[p], capacity);
+
+        t0 = perf_cycles_begin();
+        for (i = 0; i < trace.size(); i++)
+        {
+            if (cache->get(trace[i]) == NULL)
+            {
+                cache->put(trace[i], value);
+            }
+        }
+        ns = perf_cycles_to_ns(perf_cycles_end() - t0);
+
+        stats = cache->get_stats();
+        snprintf(name, sizeof(name), "Cache %s %s, hit %.1f%%", policy_names[p], trace_name,
+                 100.0 * stats.hits / (stats.hits + stats.misses));
+        bench_report(name, trace.size(), ns);
+        delete(cache);
+    }
+
+    ConcurrentCache tinylfu(capacity);
+    string v;
+
+    t0 = perf_cycles_begin();
+    for (i = 0; i < trace.size(); i++)
+    {
+        if (tinylfu.get(trace[i], &v) != SUCCESS)
+        {
+            tinylfu.put(trace[i], value);
+        }
+    }
+    ns = perf_cycles_to_ns(perf_cycles_end() - t0);
+
+    stats = tinylfu.get_stats();
+    snprintf(name, sizeof(name), "Cache TinyLFU %s, hit %.1f%%", trace_name,
+             100.0 * stats.hits / (stats.hits + stats.misses));
+    bench_report(name, trace.size(), ns);
+}
+
+/**
+ * Replay a trace on 1 to CACHE_BENCH_MAX_THREADS threads sharing a cache, each from its own
+ * offset: Cache with LRU under a mutex against ConcurrentCache; ns per access
+ */
+static void cache_replay_threads(const vector<int> &trace, size_t capacity)
+{
+    Cache lru(CACHE_LRU, capacity);
+    ConcurrentCache tinylfu(capacity);
+    mutex lock;
+    string value = "value";
+    size_t threads;
+
+    for (threads = 1; threads <= CACHE_BENCH_MAX_THREADS; threads *= 2)
+    {
+        bench_threads("Cache LRU+mutex, " + to_string(threads) + " threads", threads, trace.size() / threads,
+                      [&](size_t id, size_t ops) {
+            size_t i, k;
+
+            for (k = 0; k < ops; k++)
+            {
+                i = (id * ops + k) % trace.size();
+                lock_guard<mutex> guard(lock);
+                if (lru.get(trace[i]) == NULL)
+                {
+                    lru.put(trace[i], value);
+                }
+            }
+        });
+
+        bench_threads("ConcurrentCache, " + to_string(threads) + " threads", threads, trace.size() / threads,
+                      [&](size_t id, size_t ops) {
+            string v;
+            size_t i, k;
+
+            for (k = 0; k < ops; k++)
+            {
+                i = (id * ops + k) % trace.size();
+                if (tinylfu.get(trace[i], &v) != SUCCESS)
+                {
+                    tinylfu.put(trace[i], value);
+                }
+            }
+        });
+    }
+}
+
+/**
+ * Benchmark caches by replaying key traces; ops are accesses
+ * @param n [in] number of distinct keys of generated traces; caches hold n / CACHE_BENCH_RATIO entries
+ * @param trace_path [in] recorded trace replayed in addition, or \NULL
+ */
+void bench_cache(size_t n, const char *trace_path)
+{
+    vector<int> trace;
+    vector<int> loop;
+    mt19937 rng(1);
+    size_t capacity = n / CACHE_BENCH_RATIO > 0 ? n / CACHE_BENCH_RATIO : 1;
+    size_t len = n * CACHE_BENCH_ACCESSES;
+    size_t i;
+
+    trace = cache_trace_zipf(n, len, &rng);
+    cache_replay("zipf", trace, capacity);
+    cache_replay_threads(trace, capacity);
+
+    // Zipf interleaved with a scan of one-time keys, one scan key per access
+    loop.reserve(len * 2);
+    for (i = 0; i < len; i++)
+    {
+        loop.push_back(trace[i]);
+        loop.push_back((int)(n + i));
+    }
+    cache_replay("zipf+scan", loop, capacity);
+
+    // a loop slightly larger than the cache, where LRU misses every access
+    loop.clear();
+    for (i = 0; i < len; i++)
+    {
+        loop.push_back((int)(i % (capacity + capacity / 10 + 1)));
+    }
+    cache_replay("loop", loop, capacity);
+
+    if (trace_path != NULL)
+    {
+        trace = cache_trace_load(trace_path);
+        if (!trace.empty())
+        {
+            cache_replay("trace", trace, capacity);
+        }
+    }
+}
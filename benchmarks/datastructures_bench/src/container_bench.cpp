@@ -0,0 +1,1123 @@
+/*
+ ============================================================================
+ Name        : container_bench.cpp
+ Description : container benchmark implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "common/include/perf.h"
+#include "datastructures/include/linklist.h"
+#include "datastructures/include/stack.h"
+#include "datastructures/include/queue.h"
+#include "datastructures/include/lockfree_queue.h"
+#include "datastructures/include/lockfree_stack.h"
+#include "datastructures/include/hahstable.h"
+#include "datastructures/include/lockfree_hashtable.h"
+#include "datastructures/include/str_hashtable.h"
+#include "datastructures/include/perfect_hashtable.h"
+#include "datastructures/include/flat_map.h"
+#include "datastructures/include/tree.h"
+#include "datastructures/include/heap.h"
+#include "datastructures/include/persistent.h"
+#include "datastructures/include/skiplist.h"
+#include "datastructures/include/lockfree_skiplist.h"
+#include "datastructures/include/intrusive.h"
+#include "datastructures/include/static_containers.h"
+#include "bench_common/include/bench_common.h"
+#include "datastructures_bench/include/container_bench.h"
+
+#define BENCH_MERGE_LISTS   8                   // lists merged by the concat benchmark
+#define BENCH_BATCH         4096                // values per batch of the batch benchmarks
+#define BENCH_SNAPSHOTS     100                 // snapshots taken by the persistent benchmark
+#define BENCH_QUEUE_THREADS 4                   // producer and consumer pairs of the shared queue benchmark
+#define BENCH_MAX_THREADS   64                  // most threads of the stack contention benchmark
+#define BENCH_STATIC_SLOTS  (1 << 18)           // slots of the StaticHashTable benchmark, up to 3/4 full
+#define BENCH_HASH_THREADS  32                  // most threads of the growing hash table benchmark
+#define BENCH_LONG_VALUES   10000               // entries of the hash table benchmark with long values
+#define BENCH_RANGE_KEYS    64                  // keys per range of the skip list range benchmark
+#define BENCH_SKIP_THREADS  8                   // most threads of the skip list contention benchmark
+
+// keeps results alive so the compiler cannot drop benchmarked calls
+static volatile int bench_sink;
+
+/**
+ * Benchmark linklist insertion, lookup and deletion
+ * @param n [in] number of nodes
+ */
+void bench_linklist(size_t n)
+{
+    cshark_linklist_t *llt;
+    cshark_node_t *nt;
+    LinkList *list;
+    LinkList *parts[BENCH_MERGE_LISTS];
+    uint64_t t0;
+    size_t i, k;
+    int v;
+
+    list = new LinkList(0);
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        list->insert_val(i);
+    }
+    bench_report("LinkList::insert_val", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i += 16)
+    {
+        bench_sink = list->find_by_val(i)->val;
+    }
+    bench_report("LinkList::find_by_val", n / 16, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    // scatter values so sort() relinks every node
+    for (nt = list->get_first(), i = 0; nt != NULL; nt = nt->next, i++)
+    {
+        nt->val = (int)((i * 7919) % n);
+    }
+    t0 = perf_cycles_begin();
+    list->sort();
+    bench_report("LinkList::sort", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        list->delete_first();
+    }
+    bench_report("LinkList::delete_first", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+    delete(list);
+
+    llt = cshark_linklist_init(0);
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        cshark_linklist_add(llt, i);
+    }
+    bench_report("cshark_linklist_add", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        cshark_linklist_delete_first(llt, &v);
+    }
+    bench_report("cshark_linklist_delete_first", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+    cshark_linklist_destroy(llt);
+
+    // merge per-thread result lists into one list, moving nodes one by one, then by concat()
+    list = new LinkList(0);
+    for (k = 0; k < BENCH_MERGE_LISTS; k++)
+    {
+        parts[k] = new LinkList(n / BENCH_MERGE_LISTS);
+    }
+    t0 = perf_cycles_begin();
+    for (k = 0; k < BENCH_MERGE_LISTS; k++)
+    {
+        while ((nt = parts[k]->pop_first()) != NULL)
+        {
+            list->insert_node(nt);
+        }
+    }
+    bench_report("LinkList::pop_first+insert_node", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    for (k = 0; k < BENCH_MERGE_LISTS; k++)
+    {
+        delete(parts[k]);
+        parts[k] = new LinkList(n / BENCH_MERGE_LISTS);
+    }
+    t0 = perf_cycles_begin();
+    for (k = 0; k < BENCH_MERGE_LISTS; k++)
+    {
+        list->concat(parts[k]);
+    }
+    bench_report("LinkList::concat (per list)", BENCH_MERGE_LISTS, perf_cycles_to_ns(perf_cycles_end() - t0));
+    bench_sink = (int)list->get_size();
+
+    for (k = 0; k < BENCH_MERGE_LISTS; k++)
+    {
+        delete(parts[k]);
+    }
+    delete(list);
+}
+
+/**
+ * Benchmark a stack shared by 1 to BENCH_MAX_THREADS threads, as a free list is: each thread
+ * pushes a value and pops one. A Stack under a mutex against LockFreeStack; ns per push and pop
+ * @param n [in] number of push and pop pairs, divided among threads
+ */
+static void bench_stack_contention(size_t n)
+{
+    Stack stack;
+    LockFreeStack lfstack;
+    mutex lock;
+    size_t threads;
+
+    for (threads = 1; threads <= BENCH_MAX_THREADS; threads *= 2)
+    {
+        bench_threads("Stack+mutex, " + to_string(threads) + " threads", threads, n / threads, [&](size_t, size_t ops) {
+            cshark_node_t *nt;
+            size_t k;
+
+            for (k = 0; k < ops; k++)
+            {
+                lock.lock();
+                stack.push(k);
+                lock.unlock();
+
+                lock.lock();
+                nt = stack.pop();
+                lock.unlock();
+                if (nt != NULL)
+                {
+                    bench_sink = nt->val;
+                    delete(nt);
+                }
+            }
+        });
+
+        bench_threads("LockFreeStack, " + to_string(threads) + " threads", threads, n / threads, [&](size_t, size_t ops) {
+            size_t k;
+            int v;
+
+            for (k = 0; k < ops; k++)
+            {
+                lfstack.push((int)k);
+                if (lfstack.pop(&v) == SUCCESS)
+                {
+                    bench_sink = v;
+                }
+            }
+        });
+    }
+}
+
+/**
+ * Benchmark stack push and pop
+ * @param n [in] number of nodes
+ */
+void bench_stack(size_t n)
+{
+    Stack *stack;
+    StaticStack<int, BENCH_BATCH> static_stack;
+    cshark_node_t *nt;
+    uint64_t t0, elapsed;
+    size_t i;
+    int k = 0;
+
+    stack = new Stack();
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        stack->push(i);
+    }
+    bench_report("Stack::push", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        nt = stack->pop();
+        bench_sink = nt->val;
+        delete(nt);
+    }
+    bench_report("Stack::pop", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+    delete(stack);
+
+    // the static stack holds BENCH_BATCH values, and is cleared or refilled at the limits
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        if (static_stack.push(i) == ERROR_MAX_NODES)
+        {
+            static_stack.clear();
+        }
+    }
+    bench_report("StaticStack::push", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    // pop full stacks; refills are not timed
+    elapsed = 0;
+    for (i = 0; i < n; )
+    {
+        while (!static_stack.is_full())
+        {
+            static_stack.push((int)static_stack.get_size());
+        }
+
+        t0 = perf_cycles_begin();
+        for (; i < n and static_stack.pop(&k) == SUCCESS; i++)
+        {
+            bench_sink = k;
+        }
+        elapsed += perf_cycles_end() - t0;
+    }
+    bench_report("StaticStack::pop", n, perf_cycles_to_ns(elapsed));
+
+    bench_stack_contention(n);
+}
+
+/**
+ * Benchmark a queue shared by producer and consumer threads: a Queue under a mutex
+ * against LockFreeQueue; ns per value enqueued and dequeued
+ * @param n [in] number of values
+ */
+static void bench_queue_shared(size_t n)
+{
+    Queue *queue;
+    LockFreeQueue *lfqueue;
+    mutex lock;
+    vector<thread> threads;
+    size_t per_thread = n / BENCH_QUEUE_THREADS;
+    uint64_t t0;
+    size_t i;
+
+    queue = new Queue();
+    t0 = perf_cycles_begin();
+    for (i = 0; i < BENCH_QUEUE_THREADS; i++)
+    {
+        threads.push_back(thread([queue, &lock, per_thread]() {
+            size_t k;
+
+            for (k = 0; k < per_thread; k++)
+            {
+                lock_guard<mutex> guard(lock);
+                queue->enqueue(k);
+            }
+        }));
+        threads.push_back(thread([queue, &lock, per_thread]() {
+            cshark_node_t *nt;
+            size_t k = 0;
+
+            while (k < per_thread)
+            {
+                {
+                    lock_guard<mutex> guard(lock);
+                    nt = queue->is_empty() ? NULL : queue->dequeue();
+                }
+                if (nt != NULL)
+                {
+                    delete(nt);
+                    k++;
+                }
+            }
+        }));
+    }
+    for (i = 0; i < threads.size(); i++)
+    {
+        threads[i].join();
+    }
+    bench_report("Queue+mutex, shared", per_thread * BENCH_QUEUE_THREADS, perf_cycles_to_ns(perf_cycles_end() - t0));
+    delete(queue);
+
+    threads.clear();
+    lfqueue = new LockFreeQueue();
+    t0 = perf_cycles_begin();
+    for (i = 0; i < BENCH_QUEUE_THREADS; i++)
+    {
+        threads.push_back(thread([lfqueue, per_thread]() {
+            size_t k;
+
+            for (k = 0; k < per_thread; k++)
+            {
+                lfqueue->enqueue((int)k);
+            }
+        }));
+        threads.push_back(thread([lfqueue, per_thread]() {
+            size_t k = 0;
+            int v;
+
+            while (k < per_thread)
+            {
+                if (lfqueue->dequeue(&v) == SUCCESS)
+                {
+                    k++;
+                }
+            }
+        }));
+    }
+    for (i = 0; i < threads.size(); i++)
+    {
+        threads[i].join();
+    }
+    bench_report("LockFreeQueue, shared", per_thread * BENCH_QUEUE_THREADS, perf_cycles_to_ns(perf_cycles_end() - t0));
+    delete(lfqueue);
+}
+
+/**
+ * Benchmark queue enqueue and dequeue
+ * @param n [in] number of nodes
+ */
+void bench_queue(size_t n)
+{
+    Queue *queue;
+    cshark_node_t *nt;
+    vector<int> vals;
+    uint64_t t0;
+    size_t i, k;
+
+    queue = new Queue();
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        queue->enqueue(i);
+    }
+    bench_report("Queue::enqueue", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        nt = queue->dequeue();
+        bench_sink = nt->val;
+        delete(nt);
+    }
+    bench_report("Queue::dequeue", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+    delete(queue);
+
+    // the same values moved in batches, as an ingest path does
+    vals.resize(BENCH_BATCH);
+    for (i = 0; i < BENCH_BATCH; i++)
+    {
+        vals[i] = (int)i;
+    }
+
+    queue = new Queue();
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i += k)
+    {
+        k = (n - i < BENCH_BATCH) ? n - i : BENCH_BATCH;
+        queue->enqueue_batch(vals.data(), k);
+    }
+    bench_report("Queue::enqueue_batch", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    t0 = perf_cycles_begin();
+    while ((k = queue->dequeue_batch(vals.data(), BENCH_BATCH)) > 0)
+    {
+        bench_sink = vals[k - 1];
+    }
+    bench_report("Queue::dequeue_batch", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+    delete(queue);
+
+    bench_queue_shared(n);
+}
+
+/**
+ * Benchmark priority queue enqueue and dequeue of random priorities,
+ * and the heap arity against a binary heap
+ * @param n [in] number of nodes
+ */
+void bench_heap(size_t n)
+{
+    PriorityQueue *pq;
+    DaryHeap<int, 2> heap2;
+    DaryHeap<int, 4> heap4;
+    cshark_node_t *nt;
+    uint64_t t0;
+    size_t i;
+
+    pq = new PriorityQueue();
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        pq->enqueue((int)((i * 7919) % n));
+    }
+    bench_report("PriorityQueue::enqueue", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        nt = pq->dequeue();
+        bench_sink = nt->val;
+        delete(nt);
+    }
+    bench_report("PriorityQueue::dequeue", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+    delete(pq);
+
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        heap2.push((int)((i * 7919) % n));
+    }
+    while (!heap2.is_empty())
+    {
+        bench_sink = heap2.top();
+        heap2.pop();
+    }
+    bench_report("DaryHeap<2>::push+pop", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        heap4.push((int)((i * 7919) % n));
+    }
+    while (!heap4.is_empty())
+    {
+        bench_sink = heap4.top();
+        heap4.pop();
+    }
+    bench_report("DaryHeap<4>::push+pop", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+}
+
+/**
+ * Benchmark hash table add and find, and concurrent adds to a growing table
+ * @param n [in] number of entries
+ */
+void bench_hashtable(size_t n)
+{
+    hashtable_t *ht;
+    lockfree_hashtable_t *lft;
+    StaticHashTable<int, int, BENCH_STATIC_SLOTS> *table;
+    vector<int> keys;
+    vector<string> values;
+    mutex lock;
+    uint64_t t0;
+    size_t i, m, threads;
+
+    ht = hashtable_init();
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        hashtable_add(ht, i, "value");
+    }
+    bench_report("hashtable_add", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        bench_sink = hashtable_find(ht, i).size();
+    }
+    bench_report("hashtable_find", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    keys.resize(n);
+    values.resize(BENCH_BATCH);
+    for (i = 0; i < n; i++)
+    {
+        keys[i] = (int)i;
+    }
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i += BENCH_BATCH)
+    {
+        m = (n - i < BENCH_BATCH) ? n - i : BENCH_BATCH;
+        bench_sink = (int)hashtable_find_batch(ht, keys.data() + i, m, values.data());
+    }
+    bench_report("hashtable_find_batch", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        bench_sink = hashtable_find_ref(ht, i)->size();
+    }
+    bench_report("hashtable_find_ref", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        bench_sink = hashtable_contains(ht, i);
+    }
+    bench_report("hashtable_contains", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+    hashtable_destroy(ht);
+
+    // values beyond the short string buffer are copied to the heap by hashtable_find()
+    m = (n < BENCH_LONG_VALUES) ? n : BENCH_LONG_VALUES;
+    ht = hashtable_init();
+    for (i = 0; i < m; i++)
+    {
+        hashtable_add(ht, i, string(64, 'v'));
+    }
+
+    t0 = perf_cycles_begin();
+    for (i = 0; i < m; i++)
+    {
+        bench_sink = hashtable_find(ht, i).size();
+    }
+    bench_report("hashtable_find, 64-byte values", m, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    t0 = perf_cycles_begin();
+    for (i = 0; i < m; i++)
+    {
+        bench_sink = hashtable_find_ref(ht, i)->size();
+    }
+    bench_report("hashtable_find_ref, 64-byte values", m, perf_cycles_to_ns(perf_cycles_end() - t0));
+    hashtable_destroy(ht);
+
+    // allocated once here, as it is too large for the stack; it never allocates afterwards
+    table = new StaticHashTable<int, int, BENCH_STATIC_SLOTS>();
+    m = (n < BENCH_STATIC_SLOTS / 4 * 3) ? n : BENCH_STATIC_SLOTS / 4 * 3;
+
+    t0 = perf_cycles_begin();
+    for (i = 0; i < m; i++)
+    {
+        table->insert(i, i);
+    }
+    bench_report("StaticHashTable::insert", m, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    t0 = perf_cycles_begin();
+    for (i = 0; i < m; i++)
+    {
+        bench_sink = *table->find(i);
+    }
+    bench_report("StaticHashTable::find", m, perf_cycles_to_ns(perf_cycles_end() - t0));
+    delete(table);
+
+    lft = lockfree_hashtable_init(NULL);
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        lockfree_hashtable_add(lft, i, "value");
+    }
+    bench_report("lockfree_hashtable_add", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        bench_sink = lockfree_hashtable_find(lft, i).size();
+    }
+    bench_report("lockfree_hashtable_find", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+    lockfree_hashtable_destroy(lft);
+
+    // threads add disjoint keys to a table growing from empty
+    for (threads = 1; threads <= BENCH_HASH_THREADS; threads *= 2)
+    {
+        ht = hashtable_init();
+        bench_threads("hashtable_add+mutex, " + to_string(threads) + " threads", threads, n / threads,
+                      [&](size_t id, size_t ops) {
+            size_t k;
+
+            for (k = 0; k < ops; k++)
+            {
+                lock_guard<mutex> guard(lock);
+                hashtable_add(ht, (int)(id * ops + k), "value");
+            }
+        });
+        hashtable_destroy(ht);
+
+        lft = lockfree_hashtable_init(NULL);
+        bench_threads("lockfree_hashtable_add, " + to_string(threads) + " threads", threads, n / threads,
+                      [&](size_t id, size_t ops) {
+            size_t k;
+
+            for (k = 0; k < ops; k++)
+            {
+                lockfree_hashtable_add(lft, (int)(id * ops + k), "value");
+            }
+        });
+        lockfree_hashtable_destroy(lft);
+    }
+}
+
+/**
+ * Benchmark the string-keyed hash table against unordered_map<string, string>, with keys like
+ * "user:12345" looked up from a buffer by pointer and length
+ * @param n [in] number of keys
+ */
+void bench_str_hashtable(size_t n)
+{
+    str_hashtable_t *ht;
+    unordered_map<string, string> map;
+    vector<string> keys(n);
+    char name[64];
+    const char *v;
+    size_t i, len;
+    uint64_t t0;
+
+    for (i = 0; i < n; i++)
+    {
+        keys[i] = "user:" + to_string(i * 2654435761u % 1000000007u);
+    }
+
+    ht = str_hashtable_init(0);
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        str_hashtable_add(ht, keys[i].data(), keys[i].size(), "value", 5);
+    }
+    t0 = perf_cycles_end() - t0;
+    snprintf(name, sizeof(name), "str_hashtable_add, %zu B/key", str_hashtable_get_memory(ht) / n);
+    bench_report(name, n, perf_cycles_to_ns(t0));
+
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        v = str_hashtable_find(ht, keys[i].data(), keys[i].size(), &len);
+        bench_sink = v[len - 1];
+    }
+    bench_report("str_hashtable_find", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        bench_sink = str_hashtable_contains(ht, keys[i].data(), keys[i].size() - 1);
+    }
+    bench_report("str_hashtable_find, missing keys", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+    str_hashtable_destroy(ht);
+
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        map[keys[i]] = "value";
+    }
+    bench_report("unordered_map<string, string> insert", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    // a lookup by pointer and length has to build a temporary string first
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        bench_sink = (int)map.find(string(keys[i].data(), keys[i].size()))->second.size();
+    }
+    bench_report("unordered_map<string, string> find", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+}
+
+/**
+ * Benchmark building a static hash table from a fixed key set, and lookups by its minimal
+ * perfect hash function, against hashtable_find_ref()
+ * @param n [in] number of keys
+ */
+void bench_perfect_hashtable(size_t n)
+{
+    perfect_hashtable_t *t;
+    hashtable_t *ht;
+    vector<int> keys(n);
+    vector<string> values(n, "value");
+    char name[64];
+    size_t i, len;
+    uint64_t t0;
+
+    for (i = 0; i < n; i++)
+    {
+        keys[i] = (int)(i * 2654435761u);
+    }
+
+    t0 = perf_cycles_begin();
+    t = perfect_hashtable_build(keys.data(), values.data(), n);
+    t0 = perf_cycles_end() - t0;
+    snprintf(name, sizeof(name), "perfect_hashtable_build, %.1f bits/key", (double)mphf_get_bits(t->mphf) / n);
+    bench_report(name, n, perf_cycles_to_ns(t0));
+
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        bench_sink = perfect_hashtable_find(t, keys[i], &len)[0];
+    }
+    bench_report("perfect_hashtable_find", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        bench_sink = perfect_hashtable_contains(t, keys[i] + 1);
+    }
+    bench_report("perfect_hashtable_find, missing keys", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+    perfect_hashtable_destroy(t);
+
+    ht = hashtable_init();
+    for (i = 0; i < n; i++)
+    {
+        hashtable_add(ht, keys[i], values[i]);
+    }
+
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        bench_sink = hashtable_find_ref(ht, keys[i])->size();
+    }
+    bench_report("hashtable_find_ref, same keys", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+    hashtable_destroy(ht);
+}
+
+/**
+ * Benchmark lookups and scans of a sorted flat map against std::lower_bound and std::map, with
+ * keys looked up in random order
+ * @param n [in] number of keys
+ */
+void bench_flat_map(size_t n)
+{
+    FlatMap<int> flat;
+    map<int, int> tree;
+    vector<int> keys(n);
+    vector<int> sorted;
+    vector<int> batch(BENCH_BATCH);
+    char name[64];
+    size_t i;
+    uint64_t t0;
+    int sum = 0;
+
+    for (i = 0; i < n; i++)
+    {
+        keys[i] = (int)(i * 2654435761u);
+    }
+
+    t0 = perf_cycles_begin();
+    flat.build(keys.data(), keys.data(), n);
+    t0 = perf_cycles_end() - t0;
+    snprintf(name, sizeof(name), "FlatMap::build, %zu B/key", flat.get_memory() / n);
+    bench_report(name, n, perf_cycles_to_ns(t0));
+
+    sorted = keys;
+    sort(sorted.begin(), sorted.end());
+
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        sum += (int)(lower_bound(sorted.begin(), sorted.end(), keys[i]) - sorted.begin());
+    }
+    bench_report("std::lower_bound", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        sum += (int)cshark_lower_bound_branchless(sorted.data(), n, keys[i]);
+    }
+    bench_report("cshark_lower_bound_branchless", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        sum += (int)cshark_lower_bound_simd(sorted.data(), n, keys[i]);
+    }
+    bench_report("cshark_lower_bound_simd", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        sum += *flat.find(keys[i]);
+    }
+    bench_report("FlatMap::find", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    flat.set_eytzinger(true);
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        sum += *flat.find(keys[i]);
+    }
+    bench_report("FlatMap::find, Eytzinger", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    t0 = perf_cycles_begin();
+    flat.for_each([&](int k, int v) { sum += k ^ v; });
+    bench_report("FlatMap::for_each, Eytzinger", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+    flat.set_eytzinger(false);
+
+    t0 = perf_cycles_begin();
+    flat.for_each([&](int k, int v) { sum += k ^ v; });
+    bench_report("FlatMap::for_each", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    // a batch of new keys merged into the whole map, per key of the batch
+    for (i = 0; i < BENCH_BATCH; i++)
+    {
+        batch[i] = (int)((n + i) * 2654435761u);
+    }
+    t0 = perf_cycles_begin();
+    flat.insert_batch(batch.data(), batch.data(), BENCH_BATCH);
+    bench_report("FlatMap::insert_batch", BENCH_BATCH, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    for (i = 0; i < n; i++)
+    {
+        tree[keys[i]] = keys[i];
+    }
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        sum += tree.find(keys[i])->second;
+    }
+    bench_report("std::map::find", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    bench_sink = sum;
+}
+
+/**
+ * Benchmark binary tree creation and traversal
+ * @param n [in] number of nodes
+ */
+void bench_tree(size_t n)
+{
+    BTree *btree;
+    LinkList *list;
+    uint64_t t0;
+    int sum;
+
+    btree = new BTree();
+    t0 = perf_cycles_begin();
+    btree->create_by_level(n);
+    bench_report("BTree::create_by_level", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    t0 = perf_cycles_begin();
+    btree->traverse_inorder(&list);
+    bench_report("BTree::traverse_inorder", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    list->detach_head();
+    delete(list);
+
+    sum = 0;
+    t0 = perf_cycles_begin();
+    for (cshark_node_t &nt : btree->traversal(INORDER))
+    {
+        sum += nt.val;
+    }
+    bench_report("BTree::traversal(INORDER)", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+    bench_sink = sum;
+
+    delete(btree);
+}
+
+/**
+ * Benchmark snapshots of persistent containers against deep copies, and the cost of the
+ * first change after a snapshot
+ * @param n [in] number of nodes
+ */
+void bench_persistent(size_t n)
+{
+    cshark_linklist_t *llt;
+    cshark_linklist_t *copy;
+    PersistentList plist;
+    PersistentTree ptree;
+    uint64_t t0;
+    size_t i;
+
+    llt = cshark_linklist_init(0);
+    for (i = 0; i < n; i++)
+    {
+        cshark_linklist_add(llt, i);
+        plist.push_front(i);
+    }
+
+    t0 = perf_cycles_begin();
+    for (i = 0; i < BENCH_SNAPSHOTS; i++)
+    {
+        copy = cshark_linklist_copy(llt);
+        cshark_linklist_destroy(copy);
+    }
+    bench_report("cshark_linklist_copy", BENCH_SNAPSHOTS, perf_cycles_to_ns(perf_cycles_end() - t0));
+    cshark_linklist_destroy(llt);
+
+    t0 = perf_cycles_begin();
+    for (i = 0; i < BENCH_SNAPSHOTS; i++)
+    {
+        PersistentList snap = plist.snapshot();
+        plist.set(0, i);                // copies one node
+        bench_sink = snap.get_first()->val;
+    }
+    bench_report("PersistentList::snapshot+set", BENCH_SNAPSHOTS, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        ptree.insert((int)((i * 7919) % n), "");
+    }
+    bench_report("PersistentTree::insert", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    t0 = perf_cycles_begin();
+    for (i = 0; i < BENCH_SNAPSHOTS; i++)
+    {
+        PersistentTree snap = ptree.snapshot();
+        ptree.insert((int)(i % n), "x"); // copies the path to the key
+        bench_sink = (int)snap.get_size();
+    }
+    bench_report("PersistentTree::snapshot+insert", BENCH_SNAPSHOTS, perf_cycles_to_ns(perf_cycles_end() - t0));
+}
+
+/**
+ * Benchmark the skip list as an ordered set against LinkList lookups, and the lock-free skip list
+ * against a skip list behind a mutex; a thread does 80% contains(), 10% insert() and 10% erase()
+ * @param n [in] number of keys
+ */
+void bench_skiplist(size_t n)
+{
+    SkipList slist;
+    LinkList *list;
+    LockFreeSkipList *lflist;
+    mutex lock;
+    uint64_t t0;
+    size_t i, threads, visited;
+    int lo;
+
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        slist.insert((int)((i * 7919) % n));
+    }
+    bench_report("SkipList::insert", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        bench_sink = slist.find((int)((i * 7919) % n))->val;
+    }
+    bench_report("SkipList::find", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    list = new LinkList(0);
+    for (i = 0; i < n; i++)
+    {
+        list->insert_val(i);
+    }
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i += 16)
+    {
+        bench_sink = list->find_by_val((int)((i * 7919) % n))->val;
+    }
+    bench_report("LinkList::find_by_val, random", n / 16, perf_cycles_to_ns(perf_cycles_end() - t0));
+    delete(list);
+
+    // ops are keys visited, ranges start at random keys
+    visited = 0;
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i += BENCH_RANGE_KEYS)
+    {
+        lo = (int)((i * 7919) % n);
+        for (cshark_node_t &nt : slist.range(lo, lo + BENCH_RANGE_KEYS))
+        {
+            bench_sink = nt.val;
+            visited++;
+        }
+    }
+    bench_report("SkipList::range", visited, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        slist.erase((int)((i * 7919) % n));
+    }
+    bench_report("SkipList::erase", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    lflist = new LockFreeSkipList();
+    for (i = 0; i < n; i += 2)
+    {
+        slist.insert((int)i);
+        lflist->insert((int)i);
+    }
+
+    for (threads = 1; threads <= BENCH_SKIP_THREADS; threads *= 2)
+    {
+        bench_threads("SkipList+mutex, " + to_string(threads) + " threads", threads, n / threads,
+                      [&](size_t id, size_t ops) {
+            size_t k;
+            int key;
+
+            for (k = 0; k < ops; k++)
+            {
+                key = (int)(((id * ops + k) * 7919) % n);
+                lock_guard<mutex> guard(lock);
+                if (k % 10 == 0)
+                {
+                    slist.insert(key);
+                }
+                else if (k % 10 == 5)
+                {
+                    slist.erase(key);
+                }
+                else
+                {
+                    bench_sink = slist.contains(key);
+                }
+            }
+        });
+
+        bench_threads("LockFreeSkipList, " + to_string(threads) + " threads", threads, n / threads,
+                      [&](size_t id, size_t ops) {
+            size_t k;
+            int key;
+
+            for (k = 0; k < ops; k++)
+            {
+                key = (int)(((id * ops + k) * 7919) % n);
+                if (k % 10 == 0)
+                {
+                    lflist->insert(key);
+                }
+                else if (k % 10 == 5)
+                {
+                    lflist->erase(key);
+                }
+                else
+                {
+                    bench_sink = lflist->contains(key);
+                }
+            }
+        });
+    }
+
+    delete(lflist);
+}
+
+// an object of the intrusive benchmark, with a payload so objects span a cache line
+typedef struct _bench_object_t
+{
+    int val;
+    char payload[44];
+    cshark_list_hook_t hook;
+}bench_object_t;
+
+/**
+ * Benchmark an intrusive list of objects against a LinkList of nodes pointing to them by data.
+ * Objects are linked in a scattered order, so both walks jump around memory.
+ * @param n [in] number of objects
+ */
+void bench_intrusive(size_t n)
+{
+    vector<bench_object_t> objects(n);
+    IntrusiveList<bench_object_t, &bench_object_t::hook> ilist;
+    LinkList *list;
+    cshark_node_t *nt;
+    uint64_t t0;
+    size_t i;
+    int sum;
+
+    for (i = 0; i < n; i++)
+    {
+        objects[i].val = (int)i;
+    }
+
+    list = new LinkList(0);
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        nt = cshark_node_init();
+        nt->data = &objects[(i * 7919) % n];
+        list->insert_node(nt);
+    }
+    bench_report("LinkList::insert_node, data", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        ilist.push_back(objects[(i * 7919) % n]);
+    }
+    bench_report("IntrusiveList::push_back", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    sum = 0;
+    t0 = perf_cycles_begin();
+    for (cshark_node_t &node : *list)
+    {
+        sum += ((bench_object_t *)node.data)->val;
+    }
+    bench_report("LinkList traversal, data", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+    bench_sink = sum;
+
+    sum = 0;
+    t0 = perf_cycles_begin();
+    for (bench_object_t &obj : ilist)
+    {
+        sum += obj.val;
+    }
+    bench_report("IntrusiveList traversal", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+    bench_sink = sum;
+
+    // LinkList deletes by position, an intrusive list deletes any object it is given
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        list->delete_first();
+    }
+    bench_report("LinkList::delete_first", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+    delete(list);
+
+    t0 = perf_cycles_begin();
+    for (i = 0; i < n; i++)
+    {
+        ilist.erase(objects[(i * 104729) % n]);
+    }
+    bench_report("IntrusiveList::erase, random", n, perf_cycles_to_ns(perf_cycles_end() - t0));
+}
@@ -0,0 +1,48 @@
+/*
+ ============================================================================
+ Name        : datastructures_bench_main.cpp
+ Description : data structures benchmark main program
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#include <stdio.h>
+
+#include "bench_common/include/bench_common.h"
+#include "datastructures_bench/include/container_bench.h"
+#include "datastructures_bench/include/graph_bench.h"
+#include "datastructures_bench/include/cache_bench.h"
+
+/**
+ * Usage: datastructures_bench [n] [trace]
+ *      n: number of elements per container, 10000 by default
+ *      trace: file of cache keys, one per line, replayed by the cache benchmark
+ */
+int main(int argc, char *argv[])
+{
+    size_t n;
+
+    n = bench_parse_size(argc, argv, 1, 10000);
+
+    bench_header("data structures benchmark");
+
+    // benchmark functions implemented in other cpp files within same directory
+    bench_linklist(n);
+    bench_stack(n);
+    bench_queue(n);
+    bench_heap(n);
+    bench_hashtable(n);
+    bench_str_hashtable(n);
+    bench_perfect_hashtable(n);
+    bench_flat_map(n);
+    bench_tree(n);
+    bench_persistent(n);
+    bench_skiplist(n);
+    bench_intrusive(n);
+    bench_cache(n, argc > 2 ? argv[2] : NULL);
+    bench_graph(n);
+
+    return 0;
+}
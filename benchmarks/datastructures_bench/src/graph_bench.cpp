@@ -0,0 +1,71 @@
+/*
+ ============================================================================
+ Name        : graph_bench.cpp
+ Description : graph benchmark implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#include <random>
+#include <vector>
+
+#include "common/include/perf.h"
+#include "datastructures/include/graph.h"
+#include "bench_common/include/bench_common.h"
+#include "datastructures_bench/include/graph_bench.h"
+
+#define GRAPH_BENCH_SCALE    10      // vertices per benchmark element
+#define GRAPH_BENCH_DEGREE   16      // edges per vertex
+
+/**
+ * Benchmark graph building and traversals on a random graph; ops are edges
+ * @param n [in] benchmark size, the graph has n * GRAPH_BENCH_SCALE vertices
+ */
+void bench_graph(size_t n)
+{
+    size_t n_vertices = n * GRAPH_BENCH_SCALE;
+    size_t n_edges = n_vertices * GRAPH_BENCH_DEGREE;
+    vector<cshark_edge_t> edges(n_edges);
+    vector<int> levels(n_vertices);
+    vector<uint32_t> order(n_vertices);
+    vector<int64_t> dist(n_vertices);
+    cshark_graph_t *g;
+    mt19937 rng(1);
+    uint64_t t0;
+    size_t i, count;
+
+    for (i = 0; i < n_edges; i++)
+    {
+        edges[i].src = rng() % n_vertices;
+        edges[i].dst = rng() % n_vertices;
+        edges[i].weight = rng() % 100;
+    }
+
+    t0 = perf_cycles_begin();
+    g = cshark_graph_build(n_vertices, edges.data(), n_edges, true);
+    bench_report("cshark_graph_build", n_edges, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    t0 = perf_cycles_begin();
+    cshark_graph_bfs(g, 0, levels.data());
+    bench_report("cshark_graph_bfs", n_edges, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    t0 = perf_cycles_begin();
+    cshark_graph_bfs_parallel(g, 0, levels.data(), 0);
+    bench_report("cshark_graph_bfs_parallel", n_edges, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    t0 = perf_cycles_begin();
+    cshark_graph_dfs(g, 0, order.data(), &count);
+    bench_report("cshark_graph_dfs", n_edges, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    t0 = perf_cycles_begin();
+    cshark_graph_components(g, order.data(), &count);
+    bench_report("cshark_graph_components", n_edges, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    t0 = perf_cycles_begin();
+    cshark_graph_dijkstra(g, 0, dist.data());
+    bench_report("cshark_graph_dijkstra", n_edges, perf_cycles_to_ns(perf_cycles_end() - t0));
+
+    cshark_graph_destroy(g);
+}
@@ -0,0 +1,46 @@
+#!/bin/sh
+#============================================================================
+#Name        : pgo_build.sh
+#Description : Profile-guided optimization build of Codeshark
+#Author      : Zhi Liu<zliucd66@gmail.com>
+#Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+#              see LICENSE.txt.
+#============================================================================
+#
+# Usage: scripts/pgo_build.sh [benchmark size]
+#
+# 1. configure and build with -fprofile-generate (preset pgo-generate)
+# 2. run the benchmarks in bin/ to write profiles into build/pgo/pgo
+# 3. reconfigure the same build directory with -fprofile-use (preset pgo-use) and rebuild
+#
+# Both builds must use the same build directory, as GCC names profiles by object paths.
+
+set -e
+
+ROOT_DIR=$(cd "$(dirname "$0")/.." && pwd)
+BUILD_DIR=${ROOT_DIR}/build/pgo
+PGO_DIR=${BUILD_DIR}/pgo
+BENCH_SIZE=${1:-10000}
+
+cd "${ROOT_DIR}"
+
+echo "=== PGO: instrumented build"
+rm -rf "${PGO_DIR}"
+cmake --preset pgo-generate
+cmake --build --preset pgo-generate -j
+
+echo "=== PGO: training run"
+for bench in "${ROOT_DIR}"/bin/*_bench; do
+    "${bench}" "${BENCH_SIZE}" > /dev/null
+done
+
+# clang writes raw profiles which must be merged
+if ls "${PGO_DIR}"/*.profraw > /dev/null 2>&1; then
+    llvm-profdata merge -output="${PGO_DIR}/default.profdata" "${PGO_DIR}"/*.profraw
+fi
+
+echo "=== PGO: optimized build"
+cmake --preset pgo-use
+cmake --build --preset pgo-use -j --clean-first
+
+echo "=== PGO: done, see ${ROOT_DIR}/lib and ${ROOT_DIR}/bin"
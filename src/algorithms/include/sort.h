@@ -0,0 +1,48 @@
+/*
+ ============================================================================
+ Name        : sort.h
+ Description : sort header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_SORT_H
+#define CODESHARK_SORT_H
+
+#include <stddef.h>
+
+#include "datastructures/include/linklist.h"
+
+#define SORT_NETWORK_MAX 16     // maximum elements of sorting network kernel
+
+/**
+ * Sorting algorithms of int arrays, all in ascending order:
+ *
+ *  - introsort: quicksort with median-of-3 pivot, heapsort when recursion is too deep
+ *  - pdqsort: pattern-defeating quicksort, linear time for sorted, reversed and few-unique inputs
+ *  - radix LSD: stable, 4 passes of 8 bits with O(n) extra memory; passes with a single digit are skipped
+ *  - radix MSD: in-place (American flag sort), recursing on 8-bit digits from the highest
+ *  - parallel merge sort: fork-join merge sort with parallel merges on a work-stealing pool
+ *  - sorting network: branchless kernel for arrays of at most SORT_NETWORK_MAX elements,
+ *    which also sorts small partitions of introsort and pdqsort
+ *
+ * Template versions of introsort and pdqsort for any random access iterators and comparators
+ * are in sort_impl.h, e.g., cshark_pdqsort(v.begin(), v.end(), less<int>()).
+ */
+
+// Sort functions
+
+int cshark_sort_introsort(int *arr, size_t n);
+int cshark_sort_pdqsort(int *arr, size_t n);
+int cshark_sort_radix_lsd(int *arr, size_t n);
+int cshark_sort_radix_msd(int *arr, size_t n);
+int cshark_sort_parallel_merge(int *arr, size_t n, size_t threads);
+int cshark_sort_network(int *arr, size_t n);
+
+int cshark_sort_linklist(cshark_linklist_t *llt);
+
+#include "algorithms/include/sort_impl.h"
+
+#endif //CODESHARK_SORT_H
@@ -0,0 +1,398 @@
+/*
+ ============================================================================
+ Name        : sort_impl.h
+ Description : template implementation of introsort and pdqsort
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_SORT_IMPL_H
+#define CODESHARK_SORT_IMPL_H
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+using namespace std;
+
+#define SORT_INSERTION_THRESHOLD        16      // introsort leaves partitions up to this size
+#define PDQSORT_INSERTION_THRESHOLD     24      // pdqsort sorts partitions below this size directly
+#define PDQSORT_NINTHER_THRESHOLD       128     // pdqsort uses Tukey's ninther above this size
+#define PDQSORT_PARTIAL_INSERTION_LIMIT 8       // moves allowed to finish an almost sorted partition
+
+/**
+ * @struct cshark_insertion_small_sort
+ * Default sorter of small partitions; an int specialization uses the sorting network.
+ */
+struct cshark_insertion_small_sort
+{
+    template <typename Iter, typename Compare>
+    void operator()(Iter first, Iter last, Compare comp) const
+    {
+        typedef typename iterator_traits<Iter>::value_type value_t;
+        Iter i, j;
+
+        if (first == last)
+        {
+            return;
+        }
+
+        for (i = first + 1; i != last; ++i)
+        {
+            value_t tmp = std::move(*i);
+            for (j = i; j != first and comp(tmp, *(j - 1)); --j)
+            {
+                *j = std::move(*(j - 1));
+            }
+            *j = std::move(tmp);
+        }
+    }
+};
+
+/**
+ * Get floor(log2(n)), the depth limit unit of introsort and pdqsort
+ */
+static inline int _cshark_sort_log2(size_t n)
+{
+    int log = 0;
+
+    while (n > 1)
+    {
+        n >>= 1;
+        log++;
+    }
+
+    return log;
+}
+
+template <typename Iter, typename Compare>
+void _cshark_sort_heap(Iter first, Iter last, Compare comp)
+{
+    make_heap(first, last, comp);
+    sort_heap(first, last, comp);
+}
+
+template <typename Iter, typename Compare>
+inline void _cshark_sort2(Iter a, Iter b, Compare comp)
+{
+    if (comp(*b, *a))
+    {
+        iter_swap(a, b);
+    }
+}
+
+template <typename Iter, typename Compare>
+inline void _cshark_sort3(Iter a, Iter b, Iter c, Compare comp)
+{
+    _cshark_sort2(a, b, comp);
+    _cshark_sort2(b, c, comp);
+    _cshark_sort2(a, b, comp);
+}
+
+/**
+ * Introsort loop: partitions until ranges are small, or switches to heapsort when depth runs out
+ */
+template <typename Iter, typename Compare, typename SmallSort>
+void _cshark_introsort_loop(Iter first, Iter last, int depth, Compare comp, SmallSort small_sort)
+{
+    Iter left, right, mid;
+
+    while (last - first > SORT_INSERTION_THRESHOLD)
+    {
+        if (depth == 0)
+        {
+            _cshark_sort_heap(first, last, comp);
+            return;
+        }
+        depth--;
+
+        // median of 3 as pivot at *first; *(last - 1) >= pivot guards the left scan,
+        // and the pivot itself guards the right scan
+        mid = first + (last - first) / 2;
+        _cshark_sort3(first + 1, mid, last - 1, comp);
+        iter_swap(first, mid);
+
+        left = first + 1;
+        right = last - 1;
+        while (true)
+        {
+            while (comp(*++left, *first));
+            while (comp(*first, *--right));
+            if (!(left < right))
+            {
+                break;
+            }
+            iter_swap(left, right);
+        }
+
+        iter_swap(first, right);
+        _cshark_introsort_loop(right + 1, last, depth, comp, small_sort);
+        last = right;
+    }
+
+    small_sort(first, last, comp);
+}
+
+/**
+ * Introsort of [first, last)
+ * Time complexity: O(NlogN) in the worst case
+ */
+template <typename Iter, typename Compare, typename SmallSort>
+void cshark_introsort(Iter first, Iter last, Compare comp, SmallSort small_sort)
+{
+    if (last - first < 2)
+    {
+        return;
+    }
+
+    _cshark_introsort_loop(first, last, 2 * _cshark_sort_log2(last - first), comp, small_sort);
+}
+
+template <typename Iter, typename Compare>
+void cshark_introsort(Iter first, Iter last, Compare comp)
+{
+    cshark_introsort(first, last, comp, cshark_insertion_small_sort());
+}
+
+/**
+ * Insertion sort which gives up after PDQSORT_PARTIAL_INSERTION_LIMIT moves
+ * @return \true if [first, last) is sorted
+ */
+template <typename Iter, typename Compare>
+bool _cshark_pdq_partial_insertion_sort(Iter first, Iter last, Compare comp)
+{
+    typedef typename iterator_traits<Iter>::value_type value_t;
+    Iter cur, sift, sift_1;
+    size_t moves = 0;
+
+    if (first == last)
+    {
+        return true;
+    }
+
+    for (cur = first + 1; cur != last; ++cur)
+    {
+        if (moves > PDQSORT_PARTIAL_INSERTION_LIMIT)
+        {
+            return false;
+        }
+
+        sift = cur;
+        sift_1 = cur - 1;
+        if (comp(*sift, *sift_1))
+        {
+            value_t tmp = std::move(*sift);
+            do
+            {
+                *sift-- = std::move(*sift_1);
+            } while (sift != first and comp(tmp, *--sift_1));
+
+            *sift = std::move(tmp);
+            moves += cur - sift;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Partition around pivot *first; elements equal to the pivot go to the right.
+ * Requires an element >= pivot after first, which median-of-3 guarantees.
+ * @return pivot position, and whether the range was already partitioned
+ */
+template <typename Iter, typename Compare>
+pair<Iter, bool> _cshark_pdq_partition_right(Iter first, Iter last, Compare comp)
+{
+    typedef typename iterator_traits<Iter>::value_type value_t;
+    value_t pivot(std::move(*first));
+    Iter left = first;
+    Iter right = last;
+    Iter pivot_pos;
+    bool already_partitioned;
+
+    while (comp(*++left, pivot));
+
+    // if no element was skipped, nothing on the left guards the right scan
+    if (left - 1 == first)
+    {
+        while (left < right and !comp(*--right, pivot));
+    }
+    else
+    {
+        while (!comp(*--right, pivot));
+    }
+
+    already_partitioned = left >= right;
+    while (left < right)
+    {
+        iter_swap(left, right);
+        while (comp(*++left, pivot));
+        while (!comp(*--right, pivot));
+    }
+
+    pivot_pos = left - 1;
+    *first = std::move(*pivot_pos);
+    *pivot_pos = std::move(pivot);
+
+    return make_pair(pivot_pos, already_partitioned);
+}
+
+/**
+ * Partition around pivot *first; elements equal to the pivot go to the left.
+ * Used when the pivot equals the element before first, so all equal elements are done in one pass.
+ * @return pivot position
+ */
+template <typename Iter, typename Compare>
+Iter _cshark_pdq_partition_left(Iter first, Iter last, Compare comp)
+{
+    typedef typename iterator_traits<Iter>::value_type value_t;
+    value_t pivot(std::move(*first));
+    Iter left = first;
+    Iter right = last;
+    Iter pivot_pos;
+
+    while (comp(pivot, *--right));
+
+    if (right + 1 == last)
+    {
+        while (left < right and !comp(pivot, *++left));
+    }
+    else
+    {
+        while (!comp(pivot, *++left));
+    }
+
+    while (left < right)
+    {
+        iter_swap(left, right);
+        while (comp(pivot, *--right));
+        while (!comp(pivot, *++left));
+    }
+
+    pivot_pos = right;
+    *first = std::move(*pivot_pos);
+    *pivot_pos = std::move(pivot);
+
+    return pivot_pos;
+}
+
+/**
+ * Break patterns of an unbalanced partition by swapping a few elements
+ */
+template <typename Iter>
+void _cshark_pdq_shuffle(Iter first, Iter last)
+{
+    typename iterator_traits<Iter>::difference_type size = last - first;
+
+    if (size < PDQSORT_INSERTION_THRESHOLD)
+    {
+        return;
+    }
+
+    iter_swap(first, first + size / 4);
+    iter_swap(last - 1, last - size / 4);
+    if (size > PDQSORT_NINTHER_THRESHOLD)
+    {
+        iter_swap(first + 1, first + (size / 4 + 1));
+        iter_swap(first + 2, first + (size / 4 + 2));
+        iter_swap(last - 2, last - (size / 4 + 1));
+        iter_swap(last - 3, last - (size / 4 + 2));
+    }
+}
+
+/**
+ * pdqsort loop
+ * @param bad_allowed [in] number of unbalanced partitions before switching to heapsort
+ * @param leftmost [in] \false if an element before first is <= all elements of the range
+ */
+template <typename Iter, typename Compare, typename SmallSort>
+void _cshark_pdqsort_loop(Iter first, Iter last, Compare comp, SmallSort small_sort, int bad_allowed, bool leftmost)
+{
+    typedef typename iterator_traits<Iter>::difference_type diff_t;
+    pair<Iter, bool> part;
+    diff_t size, half, l_size, r_size;
+    Iter pivot_pos;
+
+    while (true)
+    {
+        size = last - first;
+        if (size < PDQSORT_INSERTION_THRESHOLD)
+        {
+            small_sort(first, last, comp);
+            return;
+        }
+
+        // choose pivot as median of 3, or pseudo median of 9, and move it to first
+        half = size / 2;
+        if (size > PDQSORT_NINTHER_THRESHOLD)
+        {
+            _cshark_sort3(first, first + half, last - 1, comp);
+            _cshark_sort3(first + 1, first + (half - 1), last - 2, comp);
+            _cshark_sort3(first + 2, first + (half + 1), last - 3, comp);
+            _cshark_sort3(first + (half - 1), first + half, first + (half + 1), comp);
+            iter_swap(first, first + half);
+        }
+        else
+        {
+            _cshark_sort3(first + half, first, last - 1, comp);
+        }
+
+        // pivot equals the element before the range: everything equal to it goes left and is done
+        if (!leftmost and !comp(*(first - 1), *first))
+        {
+            first = _cshark_pdq_partition_left(first, last, comp) + 1;
+            continue;
+        }
+
+        part = _cshark_pdq_partition_right(first, last, comp);
+        pivot_pos = part.first;
+
+        l_size = pivot_pos - first;
+        r_size = last - (pivot_pos + 1);
+        if (l_size < size / 8 or r_size < size / 8)
+        {
+            if (--bad_allowed == 0)
+            {
+                _cshark_sort_heap(first, last, comp);
+                return;
+            }
+
+            _cshark_pdq_shuffle(first, pivot_pos);
+            _cshark_pdq_shuffle(pivot_pos + 1, last);
+        }
+        else if (part.second and _cshark_pdq_partial_insertion_sort(first, pivot_pos, comp)
+                 and _cshark_pdq_partial_insertion_sort(pivot_pos + 1, last, comp))
+        {
+            return;    // the input was (almost) sorted
+        }
+
+        _cshark_pdqsort_loop(first, pivot_pos, comp, small_sort, bad_allowed, leftmost);
+        first = pivot_pos + 1;
+        leftmost = false;
+    }
+}
+
+/**
+ * Pattern-defeating quicksort of [first, last)
+ * Time complexity: O(NlogN) in the worst case, O(N) for sorted or few-unique inputs
+ */
+template <typename Iter, typename Compare, typename SmallSort>
+void cshark_pdqsort(Iter first, Iter last, Compare comp, SmallSort small_sort)
+{
+    if (last - first < 2)
+    {
+        return;
+    }
+
+    _cshark_pdqsort_loop(first, last, comp, small_sort, _cshark_sort_log2(last - first), true);
+}
+
+template <typename Iter, typename Compare>
+void cshark_pdqsort(Iter first, Iter last, Compare comp)
+{
+    cshark_pdqsort(first, last, comp, cshark_insertion_small_sort());
+}
+
+#endif //CODESHARK_SORT_IMPL_H
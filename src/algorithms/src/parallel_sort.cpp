@@ -0,0 +1,120 @@
+/*
+ ============================================================================
+ Name        : parallel_sort.cpp
+ Description : parallel merge sort implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#include <string.h>
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include "common/include/err.h"
+#include "common/include/task_pool.h"
+#include "algorithms/include/sort.h"
+
+#define PSORT_SEQ_CUTOFF    8192    // ranges below this size are sorted sequentially
+#define PMERGE_SEQ_CUTOFF   8192    // merges below this output size are sequential
+
+/**
+ * Merge sorted a[0, na) and b[0, nb) into out in parallel: the middle of the larger input
+ * splits both inputs by binary search, and the two halves are merged independently.
+ */
+static void parallel_merge(TaskPool *pool, const int *a, size_t na, const int *b, size_t nb, int *out)
+{
+    TaskGroup group;
+    size_t ma, mb;
+
+    if (na < nb)
+    {
+        swap(a, b);
+        swap(na, nb);
+    }
+
+    if (na + nb <= PMERGE_SEQ_CUTOFF or nb == 0)
+    {
+        merge(a, a + na, b, b + nb, out);
+        return;
+    }
+
+    ma = na / 2;
+    mb = lower_bound(b, b + nb, a[ma]) - b;
+    out[ma + mb] = a[ma];
+
+    pool->spawn(&group, [=]() {
+        parallel_merge(pool, a, ma, b, mb, out);
+    });
+    parallel_merge(pool, a + ma + 1, na - ma - 1, b + mb, nb - mb, out + ma + mb + 1);
+    pool->wait(&group);
+}
+
+/**
+ * Sort arr[0, n) with buffer tmp[0, n); the result is written to tmp if to_tmp is true,
+ * otherwise to arr. Children write into the other array, so every level merges between the
+ * two arrays without copying back (ping-pong).
+ */
+static void parallel_merge_sort(TaskPool *pool, int *arr, int *tmp, size_t n, bool to_tmp)
+{
+    TaskGroup group;
+    size_t half;
+    int *src, *dst;
+
+    if (n <= PSORT_SEQ_CUTOFF)
+    {
+        cshark_sort_pdqsort(arr, n);
+        if (to_tmp)
+        {
+            memcpy(tmp, arr, n * sizeof(int));
+        }
+        return;
+    }
+
+    half = n / 2;
+    pool->spawn(&group, [=]() {
+        parallel_merge_sort(pool, arr, tmp, half, !to_tmp);
+    });
+    parallel_merge_sort(pool, arr + half, tmp + half, n - half, !to_tmp);
+    pool->wait(&group);
+
+    src = to_tmp ? arr : tmp;
+    dst = to_tmp ? tmp : arr;
+    parallel_merge(pool, src, half, src + half, n - half, dst);
+}
+
+/**
+ * Sort an int array by parallel merge sort
+ * Time complexity: O(NlogN / P) with P threads, with N extra ints
+ * @param arr [in,out] array
+ * @param n [in] number of elements
+ * @param threads [in] number of threads, 0 for all hardware threads
+ * @return \0 on success, or other error code
+ */
+int cshark_sort_parallel_merge(int *arr, size_t n, size_t threads)
+{
+    if (arr == NULL and n > 0)
+    {
+        return ERROR_PARAM;
+    }
+
+    if (threads == 0)
+    {
+        threads = thread::hardware_concurrency();
+    }
+
+    // one thread, or too small to split: no pool and no buffer
+    if (threads <= 1 or n <= PSORT_SEQ_CUTOFF)
+    {
+        return cshark_sort_pdqsort(arr, n);
+    }
+
+    TaskPool pool(threads);
+    vector<int> tmp(n);
+
+    parallel_merge_sort(&pool, arr, tmp.data(), n, false);
+
+    return SUCCESS;
+}
@@ -0,0 +1,342 @@
+/*
+ ============================================================================
+ Name        : sort.cpp
+ Description : sort implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <limits.h>
+#include <functional>
+#include <vector>
+
+#include "common/include/err.h"
+#include "algorithms/include/sort.h"
+
+#define RADIX_BITS          8
+#define RADIX_BUCKETS       (1 << RADIX_BITS)
+#define RADIX_MSD_CUTOFF    64      // MSD radix sorts buckets below this size by comparison
+
+/**
+ * Batcher's odd-even merge network for 16 inputs, 63 comparators in 10 layers.
+ * Comparators in a layer are independent, so the compiler can schedule them in parallel;
+ * verified by the 0-1 principle on all 2^16 binary inputs.
+ */
+static const unsigned char network16[][2] = {
+    {0, 1}, {2, 3}, {4, 5}, {6, 7}, {8, 9}, {10, 11}, {12, 13}, {14, 15},
+    {0, 2}, {1, 3}, {4, 6}, {5, 7}, {8, 10}, {9, 11}, {12, 14}, {13, 15},
+    {1, 2}, {5, 6}, {9, 10}, {13, 14},
+    {0, 4}, {1, 5}, {2, 6}, {3, 7}, {8, 12}, {9, 13}, {10, 14}, {11, 15},
+    {2, 4}, {3, 5}, {10, 12}, {11, 13},
+    {1, 2}, {3, 4}, {5, 6}, {9, 10}, {11, 12}, {13, 14},
+    {0, 8}, {1, 9}, {2, 10}, {3, 11}, {4, 12}, {5, 13}, {6, 14}, {7, 15},
+    {4, 8}, {5, 9}, {6, 10}, {7, 11},
+    {2, 4}, {3, 5}, {6, 8}, {7, 9}, {10, 12}, {11, 13},
+    {1, 2}, {3, 4}, {5, 6}, {7, 8}, {9, 10}, {11, 12}, {13, 14}
+};
+
+/**
+ * Sort up to 16 ints with the network. Each comparator is a min and a max without branches
+ * (cmov on x86, csel on ARM), so the cost does not depend on the input order.
+ */
+static inline void sort_network16(int *arr, size_t n)
+{
+    int v[SORT_NETWORK_MAX];
+    int a, b;
+    size_t i;
+
+    memcpy(v, arr, n * sizeof(int));
+    for (i = n; i < SORT_NETWORK_MAX; i++)
+    {
+        v[i] = INT_MAX;    // padding sinks to the end
+    }
+
+    for (i = 0; i < sizeof(network16) / sizeof(network16[0]); i++)
+    {
+        a = v[network16[i][0]];
+        b = v[network16[i][1]];
+        v[network16[i][0]] = a < b ? a : b;
+        v[network16[i][1]] = a < b ? b : a;
+    }
+
+    memcpy(arr, v, n * sizeof(int));
+}
+
+/**
+ * @struct network_small_sort
+ * Small partition sorter of int arrays: the first 16 elements by the network,
+ * then the rest (pdqsort leaves up to 23) by insertion.
+ */
+struct network_small_sort
+{
+    void operator()(int *first, int *last, less<int> comp) const
+    {
+        size_t n = last - first;
+        int *i, *j;
+        int tmp;
+
+        if (n < 2)
+        {
+            return;
+        }
+
+        sort_network16(first, n < SORT_NETWORK_MAX ? n : SORT_NETWORK_MAX);
+
+        for (i = first + SORT_NETWORK_MAX; i < last; i++)
+        {
+            tmp = *i;
+            for (j = i; j != first and comp(tmp, *(j - 1)); j--)
+            {
+                *j = *(j - 1);
+            }
+            *j = tmp;
+        }
+    }
+};
+
+/**
+ * Sort an int array by introsort
+ * @param arr [in,out] array
+ * @param n [in] number of elements
+ * @return \0 on success, or other error code
+ */
+int cshark_sort_introsort(int *arr, size_t n)
+{
+    if (arr == NULL and n > 0)
+    {
+        return ERROR_PARAM;
+    }
+
+    cshark_introsort(arr, arr + n, less<int>(), network_small_sort());
+
+    return SUCCESS;
+}
+
+/**
+ * Sort an int array by pattern-defeating quicksort
+ * @param arr [in,out] array
+ * @param n [in] number of elements
+ * @return \0 on success, or other error code
+ */
+int cshark_sort_pdqsort(int *arr, size_t n)
+{
+    if (arr == NULL and n > 0)
+    {
+        return ERROR_PARAM;
+    }
+
+    cshark_pdqsort(arr, arr + n, less<int>(), network_small_sort());
+
+    return SUCCESS;
+}
+
+/**
+ * Sort at most SORT_NETWORK_MAX ints by the sorting network
+ * @param arr [in,out] array
+ * @param n [in] number of elements
+ * @return \0 on success, or other error code
+ */
+int cshark_sort_network(int *arr, size_t n)
+{
+    if ((arr == NULL and n > 0) or n > SORT_NETWORK_MAX)
+    {
+        return ERROR_PARAM;
+    }
+
+    if (n > 1)
+    {
+        sort_network16(arr, n);
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Map int to unsigned key of the same order, by flipping the sign bit
+ */
+static inline uint32_t radix_key(int v)
+{
+    return (uint32_t)v ^ 0x80000000u;
+}
+
+/**
+ * Sort an int array by LSD radix sort, 8 bits per pass
+ * Time complexity: O(N), with N extra ints
+ * @param arr [in,out] array
+ * @param n [in] number of elements
+ * @return \0 on success, or other error code
+ */
+int cshark_sort_radix_lsd(int *arr, size_t n)
+{
+    size_t counts[sizeof(int)][RADIX_BUCKETS];
+    size_t i, sum, tmp;
+    int *src, *dst, *swap;
+    uint32_t key;
+    int pass, b;
+
+    if (arr == NULL and n > 0)
+    {
+        return ERROR_PARAM;
+    }
+
+    if (n < 2)
+    {
+        return SUCCESS;
+    }
+
+    // histograms of all passes in one read of the input
+    memset(counts, 0, sizeof(counts));
+    for (i = 0; i < n; i++)
+    {
+        key = radix_key(arr[i]);
+        for (pass = 0; pass < (int)sizeof(int); pass++)
+        {
+            counts[pass][(key >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1)]++;
+        }
+    }
+
+    vector<int> buffer(n);
+    src = arr;
+    dst = buffer.data();
+
+    for (pass = 0; pass < (int)sizeof(int); pass++)
+    {
+        // all keys have the same digit: the pass would not move anything
+        if (counts[pass][(radix_key(src[0]) >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1)] == n)
+        {
+            continue;
+        }
+
+        sum = 0;
+        for (b = 0; b < RADIX_BUCKETS; b++)
+        {
+            tmp = counts[pass][b];
+            counts[pass][b] = sum;
+            sum += tmp;
+        }
+
+        for (i = 0; i < n; i++)
+        {
+            key = (radix_key(src[i]) >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1);
+            dst[counts[pass][key]++] = src[i];
+        }
+
+        swap = src;
+        src = dst;
+        dst = swap;
+    }
+
+    if (src != arr)
+    {
+        memcpy(arr, src, n * sizeof(int));
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * In-place MSD radix sort (American flag sort) of one digit, and recursion into buckets
+ * @param shift [in] bit offset of the digit
+ */
+static void radix_msd(int *arr, size_t n, int shift)
+{
+    size_t counts[RADIX_BUCKETS] = {0};
+    size_t next[RADIX_BUCKETS];
+    size_t ends[RADIX_BUCKETS];
+    size_t i, sum;
+    uint32_t d;
+    int b, v, tmp;
+
+    if (n < RADIX_MSD_CUTOFF)
+    {
+        cshark_pdqsort(arr, arr + n, less<int>(), network_small_sort());
+        return;
+    }
+
+    for (i = 0; i < n; i++)
+    {
+        counts[(radix_key(arr[i]) >> shift) & (RADIX_BUCKETS - 1)]++;
+    }
+
+    // a single bucket: go to the next digit without permuting
+    if (counts[(radix_key(arr[0]) >> shift) & (RADIX_BUCKETS - 1)] == n)
+    {
+        if (shift > 0)
+        {
+            radix_msd(arr, n, shift - RADIX_BITS);
+        }
+        return;
+    }
+
+    sum = 0;
+    for (b = 0; b < RADIX_BUCKETS; b++)
+    {
+        next[b] = sum;
+        sum += counts[b];
+        ends[b] = sum;
+    }
+
+    // move each element directly into its bucket, following permutation cycles
+    for (b = 0; b < RADIX_BUCKETS; b++)
+    {
+        while (next[b] < ends[b])
+        {
+            v = arr[next[b]];
+            d = (radix_key(v) >> shift) & (RADIX_BUCKETS - 1);
+            while ((int)d != b)
+            {
+                tmp = arr[next[d]];
+                arr[next[d]++] = v;
+                v = tmp;
+                d = (radix_key(v) >> shift) & (RADIX_BUCKETS - 1);
+            }
+            arr[next[b]++] = v;
+        }
+    }
+
+    if (shift == 0)
+    {
+        return;
+    }
+
+    for (b = 0; b < RADIX_BUCKETS; b++)
+    {
+        if (counts[b] > 1)
+        {
+            radix_msd(arr + (ends[b] - counts[b]), counts[b], shift - RADIX_BITS);
+        }
+    }
+}
+
+/**
+ * Sort an int array by in-place MSD radix sort
+ * Time complexity: O(N) per digit, without extra memory
+ * @param arr [in,out] array
+ * @param n [in] number of elements
+ * @return \0 on success, or other error code
+ */
+int cshark_sort_radix_msd(int *arr, size_t n)
+{
+    if (arr == NULL and n > 0)
+    {
+        return ERROR_PARAM;
+    }
+
+    radix_msd(arr, n, (sizeof(int) - 1) * RADIX_BITS);
+
+    return SUCCESS;
+}
+
+/**
+ * Sort a link list by node values with stable merge sort, see cshark_linklist_sort()
+ * @param llt [in,out] link list
+ * @return \0 on success, or other error code
+ */
+int cshark_sort_linklist(cshark_linklist_t *llt)
+{
+    return cshark_linklist_sort(llt);
+}
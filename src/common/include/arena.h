@@ -0,0 +1,90 @@
+/*
+ ============================================================================
+ Name        : arena.h
+ Description : bump allocator header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_ARENA_H
+#define CODESHARK_ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+using namespace std;
+
+#define ARENA_BLOCK_SIZE    (1 << 20)       // bytes of a block; larger requests get a block of their own
+
+/**
+ * @class Arena hands out memory from large blocks by bumping a pointer, and frees it all at once.
+ *        There is no per-object header or free, so many small objects (keys, values, nodes)
+ *        cost their own bytes only, and objects allocated together lie together.
+ *
+ *      | block 0: a | b | c | ...       | block 1: d | e | (free)      |
+ *                                                            ^ ptr
+ *
+ * Memory stays valid until clear() or the arena is destroyed. Objects are not constructed or
+ * destroyed; store trivially destructible data only.
+ */
+class Arena
+{
+private:
+    vector<char *> blocks;
+    char *ptr;                          // next free byte of the current block
+    char *end;
+    size_t block_size;
+    size_t used;                        // bytes handed out
+    size_t reserved;                    // bytes of all blocks
+
+    void *allocate_slow(size_t size, size_t align);
+
+public:
+    Arena(size_t block_size = ARENA_BLOCK_SIZE);
+    ~Arena();
+
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    /**
+     * Allocate memory
+     * @param size [in] bytes
+     * @param align [in] alignment, a power of two
+     * @return memory, never \NULL
+     */
+    void *allocate(size_t size, size_t align = 8)
+    {
+        uintptr_t p = ((uintptr_t)this->ptr + align - 1) & ~(uintptr_t)(align - 1);
+
+        if (this->ptr == NULL or p + size > (uintptr_t)this->end)
+        {
+            return this->allocate_slow(size, align);
+        }
+
+        this->ptr = (char *)(p + size);
+        this->used += size;
+        return (void *)p;
+    }
+
+    /**
+     * Copy bytes into the arena
+     * @return copy, unaligned
+     */
+    char *copy(const void *p, size_t size)
+    {
+        char *q = (char *)this->allocate(size, 1);
+
+        memcpy(q, p, size);
+        return q;
+    }
+
+    void clear();
+    size_t get_used();
+    size_t get_reserved();
+};
+
+#endif //CODESHARK_ARENA_H
@@ -0,0 +1,83 @@
+/*
+ ============================================================================
+ Name        : bitmap.h
+ Description : bitmap header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_BITMAP_H
+#define CODESHARK_BITMAP_H
+
+#include <stdint.h>
+#include <string.h>
+#include <stddef.h>
+
+/**
+ * @struct cshark_bitmap_t
+ * A fixed-size bit array, e.g., visited flags of graph vertices: one bit per item
+ * instead of a bool per node, so 512 items fit in a cache line.
+ */
+typedef struct _cshark_bitmap_t
+{
+    uint64_t *words;
+    size_t n_bits;
+}cshark_bitmap_t;
+
+#define BITMAP_WORD_BITS 64
+#define BITMAP_WORDS(n) (((n) + BITMAP_WORD_BITS - 1) / BITMAP_WORD_BITS)
+
+/**
+ * Allocate a bitmap with all bits cleared
+ * @param bm [out] bitmap
+ * @param n_bits [in] number of bits
+ */
+static inline void cshark_bitmap_init(cshark_bitmap_t *bm, size_t n_bits)
+{
+    bm->n_bits = n_bits;
+    bm->words = new uint64_t[BITMAP_WORDS(n_bits) + 1]();
+}
+
+static inline void cshark_bitmap_free(cshark_bitmap_t *bm)
+{
+    delete[](bm->words);
+    bm->words = NULL;
+    bm->n_bits = 0;
+}
+
+static inline void cshark_bitmap_clear_all(cshark_bitmap_t *bm)
+{
+    memset(bm->words, 0, BITMAP_WORDS(bm->n_bits) * sizeof(uint64_t));
+}
+
+static inline bool cshark_bitmap_test(const cshark_bitmap_t *bm, size_t i)
+{
+    return (bm->words[i / BITMAP_WORD_BITS] >> (i % BITMAP_WORD_BITS)) & 1;
+}
+
+static inline void cshark_bitmap_set(cshark_bitmap_t *bm, size_t i)
+{
+    bm->words[i / BITMAP_WORD_BITS] |= (uint64_t)1 << (i % BITMAP_WORD_BITS);
+}
+
+/**
+ * Set a bit atomically, for bitmaps shared by threads
+ * @return \true if the bit was already set, so exactly one thread gets \false
+ */
+static inline bool cshark_bitmap_test_and_set_atomic(cshark_bitmap_t *bm, size_t i)
+{
+    uint64_t mask = (uint64_t)1 << (i % BITMAP_WORD_BITS);
+    uint64_t *word = &bm->words[i / BITMAP_WORD_BITS];
+
+    // a plain read first avoids taking the cache line exclusive for visited bits
+    if (__atomic_load_n(word, __ATOMIC_RELAXED) & mask)
+    {
+        return true;
+    }
+
+    return (__atomic_fetch_or(word, mask, __ATOMIC_RELAXED) & mask) != 0;
+}
+
+#endif //CODESHARK_BITMAP_H
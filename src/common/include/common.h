@@ -13,6 +13,21 @@
 
 #define MAX_STR_LEN 512
 
+/**
+ * Header-only build: define CODESHARK_HEADER_ONLY before including any header of data structures,
+ * and function bodies (<name>_inl.h) are compiled into the including translation unit as inline
+ * functions, so the compiler can inline and vectorize them at call sites instead of calling
+ * libcodeshark.so through PLT. libcodeshark.so itself is always built without the macro.
+ */
+#ifdef CODESHARK_HEADER_ONLY
+#define CODESHARK_INLINE inline
+#else
+#define CODESHARK_INLINE
+#endif
+
+// hint the cache to load the line of an address ahead of its use; a NULL address is harmless
+#define CSHARK_PREFETCH(p) __builtin_prefetch((const void *)(p))
+
 void codeshark_prologue();
 void codeshark_epilogue();
 
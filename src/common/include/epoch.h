@@ -0,0 +1,115 @@
+/*
+ ============================================================================
+ Name        : epoch.h
+ Description : epoch-based memory reclamation header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_EPOCH_H
+#define CODESHARK_EPOCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "common/include/node.h"
+
+using namespace std;
+
+#define EPOCH_MAX_THREADS     128       // threads using one domain at the same time
+#define EPOCH_RECLAIM_BATCH   64        // objects a thread retires before it tries to reclaim
+#define EPOCH_CACHE_LINE      64
+
+typedef void (*cshark_epoch_free_fn)(void *p);
+
+/**
+ * @class EpochDomain frees memory of lock-free containers once no thread can still read it.
+ *
+ * A thread enters the domain (is pinned) while it reads shared nodes, and leaves it afterwards.
+ * A node unlinked from a container is retired instead of freed: it is kept with the global epoch
+ * at that time, and freed in batches once the epoch has advanced twice. The epoch only advances
+ * when every pinned thread has seen the current one, so after two advances no thread can be
+ * pinned from before the node was unlinked.
+ *
+ *      EpochGuard guard(domain);       // pin
+ *      ... read nodes, unlink one ...
+ *      domain->retire_node(nt);        // freed after readers have left
+ *
+ * Entering and leaving are a store to a slot of the calling thread, so readers never write
+ * shared cache lines. A thread that stays pinned delays reclamation, but never blocks others.
+ */
+class EpochDomain
+{
+private:
+    typedef struct _epoch_retired_t
+    {
+        void *p;
+        cshark_epoch_free_fn free_fn;
+        uint64_t epoch;
+    }epoch_retired_t;
+
+    /**
+     * A slot is owned by one thread; state is read by threads advancing the epoch, and the
+     * other fields are used by the owner only. Slots are padded against false sharing.
+     */
+    typedef struct _epoch_slot_t
+    {
+        atomic<uint64_t> state;             // (epoch << 1) | 1 while pinned, 0 otherwise
+        atomic<bool> owned;
+        size_t nesting;
+        vector<epoch_retired_t> retired;    // in epoch order
+        char pad[EPOCH_CACHE_LINE];
+    }epoch_slot_t;
+
+    uint64_t id;
+    atomic<uint64_t> epoch;
+    char pad[EPOCH_CACHE_LINE];
+    unique_ptr<epoch_slot_t[]> slots;
+    atomic<size_t> slots_used;              // slots ever owned, the range scanned by try_advance()
+    mutex orphan_lock;
+    vector<epoch_retired_t> orphans;        // retired by threads which have exited
+
+    epoch_slot_t *get_slot();
+    void release_slot(epoch_slot_t *slot);
+    bool try_advance();
+    size_t free_retired(vector<epoch_retired_t> *retired, uint64_t epoch, bool ordered);
+
+    friend class EpochThreadSlots;
+
+public:
+    EpochDomain();
+    ~EpochDomain();
+
+    void enter();
+    void leave();
+    void retire(void *p, cshark_epoch_free_fn free_fn);
+    void retire_node(cshark_node_t *nt);
+    size_t reclaim();
+    uint64_t get_epoch();
+
+    static EpochDomain *get_default();
+};
+
+/**
+ * @class EpochGuard pins the calling thread in a domain for its scope; guards may be nested.
+ */
+class EpochGuard
+{
+private:
+    EpochDomain *domain;
+
+public:
+    EpochGuard(EpochDomain *d) : domain(d) { this->domain->enter(); }
+    ~EpochGuard() { this->domain->leave(); }
+
+    EpochGuard(const EpochGuard &) = delete;
+    EpochGuard &operator=(const EpochGuard &) = delete;
+};
+
+#endif //CODESHARK_EPOCH_H
@@ -17,6 +17,8 @@
 #define ERROR_NOT_FOUND         0x00000003
 #define ERROR_TARGET_EMPTY      0x00000004
 #define ERROR_MAX_NODES         0x00000008
+#define ERROR_CYCLE             0x00000010
+#define ERROR_EXISTS            0x00000020
 
 
 #endif //CODESHARK_ERR_H
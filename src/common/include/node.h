@@ -12,6 +12,7 @@
 #define CODESHARK_NODE_H
 
 #include <iostream>
+#include <atomic>
 
 using namespace std;
 
@@ -22,6 +23,22 @@ const size_t MAX_NODES = 100000;        // maximum nodes for performance reasons
 #define MAX_QUEUE_NODES      MAX_NODES
 #define MAX_TREE_NODES       MAX_NODES
 
+#define NODE_HEADER_SIZE     16                 // header before each node, keeping nodes 16-byte aligned
+
+/**
+ * @struct cshark_node_block_t
+ * Nodes created by cshark_node_init_batch() share one allocation; the block is
+ * released when its last node is freed.
+ *
+ *      | block | header | node 0 | header | node 1 | ... | header | node n-1 |
+ *
+ * The header before a node points to its block, or is NULL for a node allocated alone.
+ */
+typedef struct _cshark_node_block_t
+{
+    atomic<size_t> refs;           // nodes of the block not freed yet
+}cshark_node_block_t;
+
 /**
  * @struct cshark_node_t
  * note_t is a common data structure used in link list and queue, tree, graph etc.
@@ -39,12 +56,33 @@ typedef struct _cshark_node_t
     struct _cshark_node_t *left;   // for tree
     struct _cshark_node_t *right;  // for tree
 
+    // nodes carry a header, so delete frees nodes allocated alone or in a block alike
+    static void *operator new(size_t size);
+    static void *operator new(size_t, void *where) { return where; }
+    static void operator delete(void *p);
 }cshark_node_t;
 
+/**
+ * @struct cshark_node_less_val_op
+ * Orders nodes by val; a function object, so sorting and heap code inline the comparison
+ */
+struct cshark_node_less_val_op
+{
+    bool operator()(const cshark_node_t *a, const cshark_node_t *b) const
+    {
+        return a->val < b->val;
+    }
+};
+
 // Node functions
 
 cshark_node_t *cshark_node_init();
+cshark_node_t *cshark_node_init_batch(size_t n);
 int cshark_node_copy(cshark_node_t *src, cshark_node_t *dest);
 void cshark_node_free(cshark_node_t *nt);
 
+#ifdef CODESHARK_HEADER_ONLY
+#include "common/include/node_inl.h"
+#endif
+
 #endif //CODESHARK_NODE_H
@@ -0,0 +1,165 @@
+/*
+ ============================================================================
+ Name        : node_inl.h
+ Description : node inline implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_NODE_INL_H
+#define CODESHARK_NODE_INL_H
+
+#include "common/include/common.h"
+#include "common/include/node.h"
+#include "common/include/err.h"
+#include "common/include/stats.h"
+
+/**
+ * Create and init a new node, which must be manually freed.
+ * @return a new node
+ */
+CODESHARK_INLINE cshark_node_t *cshark_node_init()
+{
+    // assume node can always be successfully allocated
+    cshark_node_t *nt = new cshark_node_t();
+    CSHARK_STAT_INC(STAT_NODE_ALLOC);
+
+    nt->val = 0xdeadbeef;
+    nt->name = "unused";
+    nt->visited = false;
+
+    nt->prev = NULL;
+    nt->next = NULL;
+    nt->left = NULL;
+    nt->right = NULL;
+
+    return nt;
+}
+
+/**
+ * Create and init n nodes in one contiguous block, linked by next and prev in order.
+ * Each node is freed as usual, e.g., by cshark_node_free(); the block is released with its last node.
+ * @param n [in] number of nodes
+ * @return first node, or \NULL if n is 0
+ */
+CODESHARK_INLINE cshark_node_t *cshark_node_init_batch(size_t n)
+{
+    cshark_node_block_t *block;
+    cshark_node_t *nt;
+    cshark_node_t *prev;
+    cshark_node_t *first;
+    size_t slot;
+    char *p;
+    size_t i;
+
+    if (n == 0)
+    {
+        return NULL;
+    }
+
+    // a slot is a header and a node rounded up to NODE_HEADER_SIZE
+    slot = NODE_HEADER_SIZE + (sizeof(cshark_node_t) + NODE_HEADER_SIZE - 1) / NODE_HEADER_SIZE * NODE_HEADER_SIZE;
+    p = (char *)::operator new(NODE_HEADER_SIZE + n * slot);
+
+    block = new(p) cshark_node_block_t();
+    block->refs.store(n, memory_order_relaxed);
+    CSHARK_STAT_ADD(STAT_NODE_ALLOC, n);
+
+    first = NULL;
+    prev = NULL;
+    p += NODE_HEADER_SIZE;
+    for (i = 0; i < n; i++, p += slot)
+    {
+        *(cshark_node_block_t **)p = block;
+        nt = new(p + NODE_HEADER_SIZE) cshark_node_t();
+
+        nt->val = 0xdeadbeef;
+        nt->name = "unused";
+        nt->visited = false;
+        nt->prev = prev;
+        nt->next = NULL;
+        nt->left = NULL;
+        nt->right = NULL;
+
+        if (prev == NULL)
+        {
+            first = nt;
+        }
+        else
+        {
+            prev->next = nt;
+        }
+        prev = nt;
+    }
+
+    return first;
+}
+
+/**
+ * Allocate a node alone, with a NULL block in its header
+ */
+CODESHARK_INLINE void *cshark_node_t::operator new(size_t size)
+{
+    char *p = (char *)::operator new(NODE_HEADER_SIZE + size);
+
+    *(cshark_node_block_t **)p = NULL;
+    return p + NODE_HEADER_SIZE;
+}
+
+/**
+ * Release the memory of a node; a node in a block releases the block if it is the last one alive
+ */
+CODESHARK_INLINE void cshark_node_t::operator delete(void *p)
+{
+    cshark_node_block_t *block;
+    char *hdr;
+
+    if (p == NULL)
+    {
+        return;
+    }
+
+    hdr = (char *)p - NODE_HEADER_SIZE;
+    block = *(cshark_node_block_t **)hdr;
+    if (block == NULL)
+    {
+        ::operator delete(hdr);
+    }
+    else if (block->refs.fetch_sub(1, memory_order_acq_rel) == 1)
+    {
+        block->~cshark_node_block_t();
+        ::operator delete(block);
+    }
+}
+
+/**
+ * Copy a node, and the dest node must also has been created.
+ * @param src  [in] source node
+ * @param dest [in,out] dest node
+ * @return SUCCESS on success, or other error code
+ */
+CODESHARK_INLINE int cshark_node_copy(cshark_node_t *src, cshark_node_t *dest)
+{
+    if (src == NULL or dest == NULL)
+    {
+        return ERROR_PARAM;
+    }
+
+    dest->name = src->name;
+    dest->val = src->val;
+
+    return SUCCESS;
+}
+
+/**
+ * Free a node
+ * @param nt [in] node pointer
+ */
+CODESHARK_INLINE void cshark_node_free(cshark_node_t *nt)
+{
+    delete(nt);
+}
+
+#endif //CODESHARK_NODE_INL_H
@@ -0,0 +1,99 @@
+/*
+ ============================================================================
+ Name        : node_iterator.h
+ Description : STL iterators over nodes linked by next and prev
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_NODE_ITERATOR_H
+#define CODESHARK_NODE_ITERATOR_H
+
+#include <stddef.h>
+#include <iterator>
+
+#include "common/include/node.h"
+
+/**
+ * @class cshark_list_iterator is a bidirectional iterator over nodes linked by next and prev,
+ *        dereferencing to the node; T is cshark_node_t, or const cshark_node_t for const iterators.
+ *
+ * end() is the NULL node following the last one. The iterator keeps the address of the tail
+ * pointer of its list, so --end() reaches the last node even after the list has grown.
+ */
+template <typename T>
+class cshark_list_iterator
+{
+private:
+    T *nt;
+    cshark_node_t *const *tail;
+
+public:
+    typedef bidirectional_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef ptrdiff_t difference_type;
+    typedef T *pointer;
+    typedef T &reference;
+
+    cshark_list_iterator() : nt(NULL), tail(NULL) {}
+    cshark_list_iterator(T *node, cshark_node_t *const *last) : nt(node), tail(last) {}
+
+    // an iterator converts to a const iterator, but not the other way
+    template <typename U>
+    cshark_list_iterator(const cshark_list_iterator<U> &other) : nt(other.node()), tail(other.tail_ref()) {}
+
+    T *node() const { return this->nt; }
+    cshark_node_t *const *tail_ref() const { return this->tail; }
+
+    reference operator*() const { return *this->nt; }
+    pointer operator->() const { return this->nt; }
+
+    cshark_list_iterator &operator++()
+    {
+        this->nt = this->nt->next;
+        return *this;
+    }
+
+    cshark_list_iterator operator++(int)
+    {
+        cshark_list_iterator it = *this;
+        this->nt = this->nt->next;
+        return it;
+    }
+
+    cshark_list_iterator &operator--()
+    {
+        this->nt = (this->nt == NULL) ? *this->tail : this->nt->prev;
+        return *this;
+    }
+
+    cshark_list_iterator operator--(int)
+    {
+        cshark_list_iterator it = *this;
+        --(*this);
+        return it;
+    }
+
+    bool operator==(const cshark_list_iterator &other) const { return this->nt == other.nt; }
+    bool operator!=(const cshark_list_iterator &other) const { return this->nt != other.nt; }
+};
+
+/**
+ * @struct cshark_range is a pair of iterators usable by range-for, e.g.,
+ *      for (cshark_node_t &nt : tree->traversal(INORDER)) { ... }
+ */
+template <typename Iter>
+struct cshark_range
+{
+    Iter first;
+    Iter last;
+
+    cshark_range(Iter f, Iter l) : first(f), last(l) {}
+
+    Iter begin() const { return this->first; }
+    Iter end() const { return this->last; }
+};
+
+#endif //CODESHARK_NODE_ITERATOR_H
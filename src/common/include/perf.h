@@ -11,9 +11,19 @@
 #ifndef CODESHARK_PERF_H
 #define CODESHARK_PERF_H
 
+#include <stdint.h>
+#include <atomic>
 #include <iostream>
 #include <chrono>
 
+// define CODESHARK_PERF_NO_TSC to always use steady_clock
+#if !defined(CODESHARK_PERF_NO_TSC) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define PERF_HAVE_TSC 1
+#elif !defined(CODESHARK_PERF_NO_TSC) && defined(__aarch64__)
+#define PERF_HAVE_TSC 1
+#endif
+
 using namespace std;
 using namespace chrono;
 
@@ -22,11 +32,209 @@ typedef struct _perf_t
     // high-precision clock
     high_resolution_clock::time_point curr_clock;
     float time_float;
+    uint64_t time_ns;          // elapsed time in nanoseconds, set by perf_get_elapsed_time()
     string time_str;
 }perf_t;
 
 void perf_get_time(perf_t *time_perf);
 void perf_get_elapsed_time(perf_t *start, perf_t *end, perf_t *elapsed);
 
+/**
+ * Low-overhead timer
+ *
+ * perf_get_time() formats a wall-clock string on every call, which costs microseconds.
+ * To time short operations, read the cycle counter instead, and convert the difference into
+ * integer nanoseconds:
+ *
+ *      uint64_t t0 = perf_cycles_begin();
+ *      ... operation ...
+ *      uint64_t ns = perf_cycles_to_ns(perf_cycles_end() - t0);
+ *
+ * The counter is rdtsc on x86 and cntvct_el0 on ARM64. If the CPU has no invariant TSC,
+ * or on other platforms, steady_clock nanoseconds are used and one "cycle" is 1ns.
+ */
+
+#define PERF_TSC_UNKNOWN   0
+#define PERF_TSC_ON        1
+#define PERF_TSC_OFF       2
+
+// detection result; constant-initialized, so it is PERF_TSC_UNKNOWN (not a stale false) when the
+// counter is read from static initializers of other translation units before perf.cpp's run
+extern atomic<int> perf_tsc_state;
+
+int perf_tsc_detect();
+
+/**
+ * Check if the cycle counter is constant-rate; detected on the first call
+ */
+static inline bool perf_tsc_usable()
+{
+    int state = perf_tsc_state.load(memory_order_relaxed);
+
+    if (__builtin_expect(state == PERF_TSC_UNKNOWN, 0))
+    {
+        state = perf_tsc_detect();
+    }
+
+    return state == PERF_TSC_ON;
+}
+
+/**
+ * Read steady_clock in nanoseconds, the fallback of the cycle counter
+ */
+static inline uint64_t perf_steady_ns()
+{
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * Read the cycle counter. Not ordered with surrounding instructions.
+ */
+static inline uint64_t perf_cycles()
+{
+#if defined(PERF_HAVE_TSC) && (defined(__x86_64__) || defined(__i386__))
+    if (perf_tsc_usable())
+    {
+        return __rdtsc();
+    }
+#elif defined(PERF_HAVE_TSC)
+    uint64_t v;
+
+    if (perf_tsc_usable())
+    {
+        asm volatile("mrs %0, cntvct_el0" : "=r" (v));
+        return v;
+    }
+#endif
+    return perf_steady_ns();
+}
+
+/**
+ * Read the cycle counter at the start of a measured region;
+ * earlier instructions complete before the counter is read.
+ */
+static inline uint64_t perf_cycles_begin()
+{
+#if defined(PERF_HAVE_TSC) && (defined(__x86_64__) || defined(__i386__))
+    if (perf_tsc_usable())
+    {
+        _mm_lfence();
+        return __rdtsc();
+    }
+#elif defined(PERF_HAVE_TSC)
+    asm volatile("isb" ::: "memory");
+#endif
+    return perf_cycles();
+}
+
+/**
+ * Read the cycle counter at the end of a measured region;
+ * instructions of the region complete before the counter is read.
+ */
+static inline uint64_t perf_cycles_end()
+{
+#if defined(PERF_HAVE_TSC) && (defined(__x86_64__) || defined(__i386__))
+    unsigned int aux;
+    uint64_t v;
+
+    if (perf_tsc_usable())
+    {
+        v = __rdtscp(&aux);
+        _mm_lfence();
+        return v;
+    }
+#elif defined(PERF_HAVE_TSC)
+    asm volatile("isb" ::: "memory");
+#endif
+    return perf_cycles();
+}
+
+// Timer functions
+
+bool perf_tsc_enabled();
+double perf_cycles_per_ns();
+uint64_t perf_cycles_to_ns(uint64_t cycles);
+uint64_t perf_now_ns();
+
+/**
+ * Latency histogram in HDR style: values below 2^(PERF_HIST_SUB_BITS + 1) are exact,
+ * larger values fall into log2 ranges split into 2^PERF_HIST_SUB_BITS linear sub-buckets,
+ * so the relative error is below 1 / 2^PERF_HIST_SUB_BITS (~3%) for any value.
+ *
+ * A histogram is written by a single thread without locks or atomics; use perf_hist_local()
+ * for the calling thread's histogram. When a thread exits, its local histogram is merged into
+ * a global one, and perf_hist_collect() returns that plus the calling thread's, e.g., in the
+ * main thread once workers are joined.
+ */
+#define PERF_HIST_SUB_BITS 5
+#define PERF_HIST_SUB_COUNT (1 << PERF_HIST_SUB_BITS)
+#define PERF_HIST_BUCKETS ((64 - PERF_HIST_SUB_BITS + 1) * PERF_HIST_SUB_COUNT)   // up to UINT64_MAX
+
+typedef struct _perf_hist_t
+{
+    uint64_t counts[PERF_HIST_BUCKETS];
+    uint64_t total;
+    uint64_t min;
+    uint64_t max;
+    uint64_t sum;
+}perf_hist_t;
+
+// Histogram functions
+
+void perf_hist_init(perf_hist_t *hist);
+void perf_hist_record(perf_hist_t *hist, uint64_t ns);
+int perf_hist_merge(perf_hist_t *dest, perf_hist_t *src);
+uint64_t perf_hist_percentile(perf_hist_t *hist, double p);
+string perf_hist_summary(perf_hist_t *hist);
+perf_hist_t *perf_hist_local();
+int perf_hist_collect(perf_hist_t *dest);
+void perf_hist_reset_all();
+
+/**
+ * @class ScopedTimer measures the lifetime of the object in nanoseconds, and
+ *        stores it in a variable or records it in a histogram on destruction, e.g.,
+ *
+ *      {
+ *          ScopedTimer timer(perf_hist_local());
+ *          stack->push(1);
+ *      }
+ */
+class ScopedTimer
+{
+private:
+    uint64_t start;
+    uint64_t *elapsed_ns;
+    perf_hist_t *hist;
+
+public:
+    explicit ScopedTimer(uint64_t *elapsed_ns)
+    {
+        this->elapsed_ns = elapsed_ns;
+        this->hist = NULL;
+        this->start = perf_cycles_begin();
+    }
+
+    explicit ScopedTimer(perf_hist_t *hist)
+    {
+        this->elapsed_ns = NULL;
+        this->hist = hist;
+        this->start = perf_cycles_begin();
+    }
+
+    ~ScopedTimer()
+    {
+        uint64_t ns = perf_cycles_to_ns(perf_cycles_end() - this->start);
+
+        if (this->elapsed_ns != NULL)
+        {
+            *this->elapsed_ns = ns;
+        }
+        if (this->hist != NULL)
+        {
+            perf_hist_record(this->hist, ns);
+        }
+    }
+};
+
 
 #endif //CODESHARK_PERF_H
@@ -0,0 +1,86 @@
+/*
+ ============================================================================
+ Name        : stats.h
+ Description : hot-path instrumentation header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_STATS_H
+#define CODESHARK_STATS_H
+
+#include <stdint.h>
+#include <string>
+
+using namespace std;
+
+/**
+ * Instrumentation is opt-in: containers call the CSHARK_STAT_* macros below, which
+ * compile to nothing unless CODESHARK_ENABLE_STATS is defined (cmake -DCODESHARK_ENABLE_STATS=1).
+ *
+ * Each thread owns its counters, so recording is a plain load and store without locks;
+ * cshark_stats_snapshot() sums all threads, including threads which have already exited.
+ */
+
+enum CSHARK_STAT_COUNTER {
+    STAT_NODE_ALLOC = 0,
+    STAT_HASHTABLE_FIND,
+    STAT_HASHTABLE_FIND_MISS,
+    STAT_HASHTABLE_ADD,
+    STAT_LINKLIST_INSERT,
+    STAT_LINKLIST_DELETE,
+    STAT_STACK_PUSH,
+    STAT_STACK_POP,
+    STAT_QUEUE_ENQUEUE,
+    STAT_QUEUE_DEQUEUE,
+    STAT_TREE_TRAVERSE,
+    STAT_COUNTER_MAX
+};
+
+enum CSHARK_STAT_HISTOGRAM {
+    STAT_HIST_HASHTABLE_PROBE = 0,   // nodes compared by one hashtable_find()
+    STAT_HIST_HASHTABLE_CHAIN,       // slot chain length seen by hashtable_add()
+    STAT_HIST_LINKLIST_WALK,         // nodes walked by one linklist insert or delete
+    STAT_HIST_TREE_TRAVERSE,         // nodes visited by one tree traversal
+    STAT_HISTOGRAM_MAX
+};
+
+// bucket i counts values in [2^(i-1), 2^i), bucket 0 counts zeros
+#define STAT_HIST_BUCKETS 64
+
+/**
+ * @struct cshark_stats_t
+ * A point-in-time copy of all counters and histograms.
+ */
+typedef struct _cshark_stats_t
+{
+    uint64_t counters[STAT_COUNTER_MAX];
+    uint64_t histograms[STAT_HISTOGRAM_MAX][STAT_HIST_BUCKETS];
+}cshark_stats_t;
+
+#ifdef CODESHARK_ENABLE_STATS
+#define CSHARK_STAT_INC(c)          cshark_stats_add((c), 1)
+#define CSHARK_STAT_ADD(c, n)       cshark_stats_add((c), (n))
+#define CSHARK_STAT_RECORD(h, v)    cshark_stats_record((h), (v))
+#else
+#define CSHARK_STAT_INC(c)          ((void)0)
+#define CSHARK_STAT_ADD(c, n)       ((void)0)
+#define CSHARK_STAT_RECORD(h, v)    ((void)0)
+#endif
+
+// Stats functions
+
+bool cshark_stats_enabled();
+void cshark_stats_add(CSHARK_STAT_COUNTER c, uint64_t n);
+void cshark_stats_record(CSHARK_STAT_HISTOGRAM h, uint64_t v);
+
+int cshark_stats_snapshot(cshark_stats_t *stats);
+void cshark_stats_reset();
+string cshark_stats_export(cshark_stats_t *stats);
+
+const char *cshark_stats_counter_name(CSHARK_STAT_COUNTER c);
+const char *cshark_stats_histogram_name(CSHARK_STAT_HISTOGRAM h);
+
+#endif //CODESHARK_STATS_H
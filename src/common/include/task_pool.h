@@ -0,0 +1,87 @@
+/*
+ ============================================================================
+ Name        : task_pool.h
+ Description : work-stealing task pool header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_TASK_POOL_H
+#define CODESHARK_TASK_POOL_H
+
+#include <stddef.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @class TaskGroup counts unfinished tasks spawned into a pool, for fork-join:
+ *
+ *      TaskGroup group;
+ *      pool.spawn(&group, [=]() { sort(left); });
+ *      sort(right);
+ *      pool.wait(&group);
+ */
+class TaskGroup
+{
+public:
+    atomic<size_t> pending;
+
+    TaskGroup() : pending(0) {}
+};
+
+/**
+ * @class TaskPool runs tasks on a fixed set of threads.
+ *        Each thread owns a queue; it pushes and pops its own tasks at the back (LIFO, cache-hot),
+ *        and idle threads steal the oldest tasks from the front of other queues, which are
+ *        the largest pieces of divide-and-conquer work.
+ *        A thread waiting on a group runs queued tasks instead of blocking, so tasks may
+ *        spawn and wait recursively without deadlock.
+ */
+class TaskPool
+{
+private:
+    typedef struct _task_t
+    {
+        function<void()> fn;
+        TaskGroup *group;
+    }task_t;
+
+    typedef struct _task_queue_t
+    {
+        mutex lock;
+        deque<task_t> tasks;
+    }task_queue_t;
+
+    vector<unique_ptr<task_queue_t>> queues;   // queues[0] is shared by threads outside the pool
+    vector<thread> workers;
+    atomic<size_t> queued;
+    atomic<bool> stop;
+    mutex sleep_lock;
+    condition_variable sleep_cv;
+
+    size_t get_local_queue();
+    bool pop_task(size_t self, task_t *task);
+    void run_task(task_t *task);
+    void worker_loop(size_t id);
+
+public:
+    TaskPool(size_t threads);
+    ~TaskPool();
+
+    size_t get_threads();
+    void spawn(TaskGroup *group, function<void()> fn);
+    void wait(TaskGroup *group);
+    void parallel_for(size_t begin, size_t end, size_t grain, function<void(size_t, size_t)> fn);
+};
+
+#endif //CODESHARK_TASK_POOL_H
@@ -0,0 +1,95 @@
+/*
+ ============================================================================
+ Name        : arena.cpp
+ Description : bump allocator implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#include "common/include/arena.h"
+
+/**
+ * Initialize an empty arena; blocks are allocated on first use
+ * @param block_size [in] bytes of a block
+ */
+Arena::Arena(size_t block_size)
+{
+    this->ptr = NULL;
+    this->end = NULL;
+    this->block_size = (block_size == 0) ? ARENA_BLOCK_SIZE : block_size;
+    this->used = 0;
+    this->reserved = 0;
+}
+
+Arena::~Arena()
+{
+    this->clear();
+}
+
+/**
+ * Allocate from a new block, when the current one is full. A request over a quarter of a block
+ * gets a block of its own, and the current block stays in use, so little space is wasted.
+ */
+void *Arena::allocate_slow(size_t size, size_t align)
+{
+    char *block;
+    char *p;
+    size_t bytes;
+
+    if (size + align > this->block_size / 4)
+    {
+        bytes = size + align;
+        block = new char[bytes];
+        this->blocks.push_back(block);
+        this->reserved += bytes;
+
+        p = (char *)(((uintptr_t)block + align - 1) & ~(uintptr_t)(align - 1));
+        this->used += size;
+        return p;
+    }
+
+    block = new char[this->block_size];
+    this->blocks.push_back(block);
+    this->reserved += this->block_size;
+    this->ptr = block;
+    this->end = block + this->block_size;
+
+    return this->allocate(size, align);
+}
+
+/**
+ * Free all memory of the arena; everything allocated before becomes invalid
+ */
+void Arena::clear()
+{
+    size_t i;
+
+    for (i = 0; i < this->blocks.size(); i++)
+    {
+        delete[] this->blocks[i];
+    }
+
+    this->blocks.clear();
+    this->ptr = NULL;
+    this->end = NULL;
+    this->used = 0;
+    this->reserved = 0;
+}
+
+/**
+ * Get the bytes handed out, without alignment padding
+ */
+size_t Arena::get_used()
+{
+    return this->used;
+}
+
+/**
+ * Get the bytes of all blocks
+ */
+size_t Arena::get_reserved()
+{
+    return this->reserved;
+}
@@ -0,0 +1,395 @@
+/*
+ ============================================================================
+ Name        : epoch.cpp
+ Description : epoch-based memory reclamation implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#include <thread>
+
+#include "common/include/epoch.h"
+
+/**
+ * Global registry of live domains, so that exiting threads only release slots of domains
+ * which still exist
+ */
+typedef struct _epoch_registry_t
+{
+    mutex lock;
+    vector<EpochDomain *> domains;
+    uint64_t next_id;
+}epoch_registry_t;
+
+/**
+ * Get the registry; constructed on first use so it is safe during static initialization.
+ * The registry is never destroyed, as threads may exit after main() returns.
+ */
+static epoch_registry_t *epoch_get_registry()
+{
+    static epoch_registry_t *registry = new epoch_registry_t();
+    return registry;
+}
+
+static void epoch_free_node(void *p)
+{
+    cshark_node_free((cshark_node_t *)p);
+}
+
+/**
+ * @class EpochThreadSlots keeps the slots a thread owns in each domain, and releases them
+ *        when the thread exits; retired objects of the thread are handed over to the domain.
+ */
+class EpochThreadSlots
+{
+public:
+    typedef struct _entry_t
+    {
+        EpochDomain *domain;
+        uint64_t id;                        // a new domain may reuse the address of a destroyed one
+        EpochDomain::epoch_slot_t *slot;
+    }entry_t;
+
+    vector<entry_t> entries;
+    entry_t last;                           // entry of the last lookup
+
+    EpochThreadSlots()
+    {
+        this->last.domain = NULL;
+        this->last.id = 0;
+        this->last.slot = NULL;
+    }
+
+    ~EpochThreadSlots()
+    {
+        epoch_registry_t *registry = epoch_get_registry();
+        size_t i, k;
+
+        lock_guard<mutex> guard(registry->lock);
+        for (i = 0; i < this->entries.size(); i++)
+        {
+            for (k = 0; k < registry->domains.size(); k++)
+            {
+                if (registry->domains[k] == this->entries[i].domain and
+                    registry->domains[k]->id == this->entries[i].id)
+                {
+                    this->entries[i].domain->release_slot(this->entries[i].slot);
+                    break;
+                }
+            }
+        }
+    }
+};
+
+static thread_local EpochThreadSlots epoch_local;
+
+EpochDomain::EpochDomain() : epoch(1), slots(new epoch_slot_t[EPOCH_MAX_THREADS]), slots_used(0)
+{
+    epoch_registry_t *registry = epoch_get_registry();
+    size_t i;
+
+    for (i = 0; i < EPOCH_MAX_THREADS; i++)
+    {
+        this->slots[i].state.store(0, memory_order_relaxed);
+        this->slots[i].owned.store(false, memory_order_relaxed);
+        this->slots[i].nesting = 0;
+    }
+
+    lock_guard<mutex> guard(registry->lock);
+    this->id = ++registry->next_id;
+    registry->domains.push_back(this);
+}
+
+/**
+ * Free all retired objects
+ * \warning no thread may use the domain any more
+ */
+EpochDomain::~EpochDomain()
+{
+    epoch_registry_t *registry = epoch_get_registry();
+    size_t i;
+
+    {
+        lock_guard<mutex> guard(registry->lock);
+        for (i = 0; i < registry->domains.size(); i++)
+        {
+            if (registry->domains[i] == this)
+            {
+                registry->domains.erase(registry->domains.begin() + i);
+                break;
+            }
+        }
+    }
+
+    for (i = 0; i < EPOCH_MAX_THREADS; i++)
+    {
+        this->free_retired(&this->slots[i].retired, UINT64_MAX, true);
+    }
+    this->free_retired(&this->orphans, UINT64_MAX, false);
+}
+
+/**
+ * Get the domain shared by containers created without one. It is never destroyed.
+ */
+EpochDomain *EpochDomain::get_default()
+{
+    static EpochDomain *domain = new EpochDomain();
+    return domain;
+}
+
+/**
+ * Get the slot of the calling thread, and take a free one on its first call.
+ * When all EPOCH_MAX_THREADS slots are owned, the thread waits until another one exits.
+ */
+EpochDomain::epoch_slot_t *EpochDomain::get_slot()
+{
+    EpochThreadSlots::entry_t *entry;
+    epoch_slot_t *slot;
+    bool expected;
+    size_t used;
+    size_t i;
+
+    if (epoch_local.last.domain == this and epoch_local.last.id == this->id)
+    {
+        return epoch_local.last.slot;
+    }
+
+    entry = NULL;
+    for (i = 0; i < epoch_local.entries.size(); i++)
+    {
+        if (epoch_local.entries[i].domain == this)
+        {
+            entry = &epoch_local.entries[i];
+            break;
+        }
+    }
+
+    if (entry != NULL and entry->id == this->id)
+    {
+        epoch_local.last = *entry;
+        return entry->slot;
+    }
+
+    slot = NULL;
+    while (slot == NULL)
+    {
+        for (i = 0; i < EPOCH_MAX_THREADS; i++)
+        {
+            expected = false;
+            if (!this->slots[i].owned.load(memory_order_relaxed) and
+                this->slots[i].owned.compare_exchange_strong(expected, true, memory_order_acquire))
+            {
+                slot = &this->slots[i];
+                break;
+            }
+        }
+
+        if (slot == NULL)
+        {
+            this_thread::yield();
+        }
+    }
+
+    used = this->slots_used.load();
+    while (used < i + 1 and !this->slots_used.compare_exchange_weak(used, i + 1))
+    {
+    }
+
+    // an entry of a destroyed domain at the same address is replaced
+    if (entry == NULL)
+    {
+        epoch_local.entries.push_back(EpochThreadSlots::entry_t());
+        entry = &epoch_local.entries.back();
+    }
+    entry->domain = this;
+    entry->id = this->id;
+    entry->slot = slot;
+    epoch_local.last = *entry;
+
+    return slot;
+}
+
+/**
+ * Release the slot of an exiting thread; its retired objects are reclaimed by other threads
+ */
+void EpochDomain::release_slot(epoch_slot_t *slot)
+{
+    {
+        lock_guard<mutex> guard(this->orphan_lock);
+        this->orphans.insert(this->orphans.end(), slot->retired.begin(), slot->retired.end());
+    }
+
+    slot->retired.clear();
+    slot->retired.shrink_to_fit();
+    slot->nesting = 0;
+    slot->state.store(0, memory_order_relaxed);
+    slot->owned.store(false, memory_order_release);
+}
+
+/**
+ * Advance the global epoch if every pinned thread has seen the current one
+ * @return \true if advanced, by this thread or another one
+ */
+bool EpochDomain::try_advance()
+{
+    uint64_t e = this->epoch.load();
+    size_t used = this->slots_used.load();
+    uint64_t state;
+    size_t i;
+
+    for (i = 0; i < used; i++)
+    {
+        state = this->slots[i].state.load();
+        if ((state & 1) and (state >> 1) != e)
+        {
+            return false;
+        }
+    }
+
+    // a failed exchange means another thread has advanced it
+    this->epoch.compare_exchange_strong(e, e + 1);
+    return true;
+}
+
+/**
+ * Free retired objects which are at least two epochs old
+ * @param retired [in,out] retired objects
+ * @param epoch [in] current global epoch, UINT64_MAX to free all
+ * @param ordered [in] \true if objects are in epoch order, so the scan stops at the first one too new
+ * @return number of objects freed
+ */
+size_t EpochDomain::free_retired(vector<epoch_retired_t> *retired, uint64_t epoch, bool ordered)
+{
+    size_t i, k;
+
+    k = 0;
+    for (i = 0; i < retired->size(); i++)
+    {
+        epoch_retired_t &r = (*retired)[i];
+        if (r.epoch + 2 <= epoch)
+        {
+            r.free_fn(r.p);
+        }
+        else if (ordered)
+        {
+            break;
+        }
+        else
+        {
+            (*retired)[k++] = r;
+        }
+    }
+
+    if (ordered)
+    {
+        retired->erase(retired->begin(), retired->begin() + i);
+        return i;
+    }
+
+    retired->resize(k);
+    return i - k;
+}
+
+/**
+ * Pin the calling thread: nodes it reads are not freed until it leaves.
+ * Calls may be nested, and only the outermost leave() unpins.
+ */
+void EpochDomain::enter()
+{
+    epoch_slot_t *slot = this->get_slot();
+    uint64_t e, current;
+
+    if (slot->nesting++ > 0)
+    {
+        return;
+    }
+
+    // publish the epoch, then check it is still current, so an advance cannot pass unnoticed
+    e = this->epoch.load();
+    while (true)
+    {
+        slot->state.store((e << 1) | 1);
+        current = this->epoch.load();
+        if (current == e)
+        {
+            break;
+        }
+        e = current;
+    }
+}
+
+void EpochDomain::leave()
+{
+    epoch_slot_t *slot = this->get_slot();
+
+    if (--slot->nesting == 0)
+    {
+        slot->state.store(0, memory_order_release);
+    }
+}
+
+/**
+ * Retire an object unlinked from a shared structure; it is freed by free_fn once no thread
+ * pinned before the call is still pinned. Reclamation runs every EPOCH_RECLAIM_BATCH retires.
+ * @param p [in] object, which no new reader can reach any more
+ * @param free_fn [in] function freeing the object
+ */
+void EpochDomain::retire(void *p, cshark_epoch_free_fn free_fn)
+{
+    epoch_slot_t *slot;
+    epoch_retired_t r;
+
+    if (p == NULL or free_fn == NULL)
+    {
+        return;
+    }
+
+    slot = this->get_slot();
+    r.p = p;
+    r.free_fn = free_fn;
+    r.epoch = this->epoch.load();
+    slot->retired.push_back(r);
+
+    if (slot->retired.size() % EPOCH_RECLAIM_BATCH == 0)
+    {
+        this->reclaim();
+    }
+}
+
+/**
+ * Retire a node, freed by cshark_node_free()
+ * @param nt [in] node
+ */
+void EpochDomain::retire_node(cshark_node_t *nt)
+{
+    this->retire(nt, epoch_free_node);
+}
+
+/**
+ * Try to advance the epoch, and free the objects retired by the calling thread and by exited
+ * threads which no thread can read any more
+ * @return number of objects freed
+ */
+size_t EpochDomain::reclaim()
+{
+    epoch_slot_t *slot = this->get_slot();
+    size_t n;
+
+    this->try_advance();
+    n = this->free_retired(&slot->retired, this->epoch.load(), true);
+
+    if (this->orphan_lock.try_lock())
+    {
+        n += this->free_retired(&this->orphans, this->epoch.load(), false);
+        this->orphan_lock.unlock();
+    }
+
+    return n;
+}
+
+uint64_t EpochDomain::get_epoch()
+{
+    return this->epoch.load();
+}
@@ -11,11 +11,17 @@
 #include <iostream>
 #include <string>
 #include <chrono>
+#include <mutex>
 #include <string.h>
 
 #include "common/include/common.h"
+#include "common/include/err.h"
 #include "common/include/perf.h"
 
+#if defined(PERF_HAVE_TSC) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#endif
+
 using namespace std;
 using namespace chrono;
 
@@ -89,9 +95,386 @@ void perf_get_elapsed_time(perf_t *start, perf_t *end, perf_t *elapsed)
     elapsed_f = end->curr_clock - start->curr_clock;
 
     elapsed->time_float = elapsed_f.count() / 1000;
+    elapsed->time_ns = duration_cast<nanoseconds>(end->curr_clock - start->curr_clock).count();
     elapsed->time_str = std::to_string(elapsed->time_float);
 }
 
 
 
 
+
+/**
+ * Check if the cycle counter runs at a constant rate, i.e., invariant TSC on x86;
+ * the generic timer of ARM64 always does.
+ * @return \true if the counter can be used for timing
+ */
+static bool perf_detect_tsc()
+{
+#if defined(PERF_HAVE_TSC) && (defined(__x86_64__) || defined(__i386__))
+    unsigned int eax, ebx, ecx, edx;
+
+    if (__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) == 0)
+    {
+        return false;
+    }
+
+    return (edx & (1 << 8)) != 0;   // CPUID.80000007H:EDX[8], invariant TSC
+#elif defined(PERF_HAVE_TSC)
+    return true;
+#else
+    return false;
+#endif
+}
+
+atomic<int> perf_tsc_state(PERF_TSC_UNKNOWN);
+
+/**
+ * Detect the cycle counter once, on the first read from any thread or static initializer
+ * @return PERF_TSC_ON or PERF_TSC_OFF
+ */
+int perf_tsc_detect()
+{
+    static int state = perf_detect_tsc() ? PERF_TSC_ON : PERF_TSC_OFF;
+
+    perf_tsc_state.store(state, memory_order_relaxed);
+    return state;
+}
+
+/**
+ * Measure the rate of the cycle counter against steady_clock
+ * @return cycles per nanosecond, 1.0 if steady_clock is the fallback
+ */
+static double perf_calibrate()
+{
+    uint64_t c0, c1, t0, t1;
+
+    if (!perf_tsc_usable())
+    {
+        return 1.0;
+    }
+
+#if defined(PERF_HAVE_TSC) && defined(__aarch64__)
+    uint64_t freq;
+
+    asm volatile("mrs %0, cntfrq_el0" : "=r" (freq));
+    if (freq != 0)
+    {
+        return freq / 1e9;
+    }
+#endif
+
+    // spin for 20ms; the error of steady_clock reads is well below 0.01%
+    t0 = perf_steady_ns();
+    c0 = perf_cycles_begin();
+    do
+    {
+        t1 = perf_steady_ns();
+    } while (t1 - t0 < 20000000);
+    c1 = perf_cycles_end();
+
+    return (double)(c1 - c0) / (t1 - t0);
+}
+
+/**
+ * Check if timing uses the cycle counter rather than steady_clock
+ * @return \true if cycle counter is used
+ */
+bool perf_tsc_enabled()
+{
+    return perf_tsc_usable();
+}
+
+/**
+ * Get the calibrated counter rate; the first call calibrates, which takes about 20ms.
+ * @return cycles per nanosecond
+ */
+double perf_cycles_per_ns()
+{
+    static double cycles_per_ns = perf_calibrate();
+    return cycles_per_ns;
+}
+
+/**
+ * Convert a number of cycles into nanoseconds
+ * @param cycles [in] difference of two perf_cycles() reads
+ * @return nanoseconds
+ */
+uint64_t perf_cycles_to_ns(uint64_t cycles)
+{
+    static double ns_per_cycle = 1.0 / perf_cycles_per_ns();
+    return (uint64_t)(cycles * ns_per_cycle);
+}
+
+/**
+ * Get monotonic time in nanoseconds from an arbitrary origin
+ * @return nanoseconds
+ */
+uint64_t perf_now_ns()
+{
+    return perf_cycles_to_ns(perf_cycles());
+}
+
+/**
+ * Map a value to its histogram bucket
+ */
+static inline size_t perf_hist_bucket(uint64_t v)
+{
+    int shift;
+
+    if (v < 2 * PERF_HIST_SUB_COUNT)
+    {
+        return (size_t)v;
+    }
+
+    // v = mantissa << shift, where mantissa is in [SUB_COUNT, 2 * SUB_COUNT)
+    shift = 63 - __builtin_clzll(v) - PERF_HIST_SUB_BITS;
+    return (size_t)(shift + 1) * PERF_HIST_SUB_COUNT + (size_t)((v >> shift) - PERF_HIST_SUB_COUNT);
+}
+
+/**
+ * Get the largest value which maps to a bucket
+ */
+static inline uint64_t perf_hist_bucket_high(size_t b)
+{
+    int shift;
+    uint64_t mantissa;
+
+    if (b < 2 * PERF_HIST_SUB_COUNT)
+    {
+        return b;
+    }
+
+    shift = (int)(b / PERF_HIST_SUB_COUNT) - 1;
+    mantissa = b % PERF_HIST_SUB_COUNT + PERF_HIST_SUB_COUNT;
+
+    // the top bucket ends at UINT64_MAX, where (mantissa + 1) << shift would overflow
+    if (mantissa + 1 > (UINT64_MAX >> shift))
+    {
+        return UINT64_MAX;
+    }
+    return ((mantissa + 1) << shift) - 1;
+}
+
+/**
+ * Initialize an empty histogram
+ * @param hist [in,out] histogram
+ */
+void perf_hist_init(perf_hist_t *hist)
+{
+    if (hist == NULL)
+    {
+        return;
+    }
+
+    memset(hist, 0, sizeof(perf_hist_t));
+    hist->min = UINT64_MAX;
+}
+
+/**
+ * Record one value in histogram
+ * @param hist [in,out] histogram
+ * @param ns [in] value, usually nanoseconds
+ */
+void perf_hist_record(perf_hist_t *hist, uint64_t ns)
+{
+    hist->counts[perf_hist_bucket(ns)]++;
+    hist->total++;
+    hist->sum += ns;
+
+    if (ns < hist->min)
+    {
+        hist->min = ns;
+    }
+    if (ns > hist->max)
+    {
+        hist->max = ns;
+    }
+}
+
+/**
+ * Add all values of src to dest
+ * @param dest [in,out] histogram
+ * @param src [in] histogram, which must not be written concurrently
+ * @return \0 on success, or other error code
+ */
+int perf_hist_merge(perf_hist_t *dest, perf_hist_t *src)
+{
+    size_t i;
+
+    if (dest == NULL or src == NULL)
+    {
+        return ERROR_PARAM;
+    }
+
+    for (i = 0; i < PERF_HIST_BUCKETS; i++)
+    {
+        dest->counts[i] += src->counts[i];
+    }
+
+    dest->total += src->total;
+    dest->sum += src->sum;
+    dest->min = src->min < dest->min ? src->min : dest->min;
+    dest->max = src->max > dest->max ? src->max : dest->max;
+
+    return SUCCESS;
+}
+
+/**
+ * Get a percentile of recorded values
+ * @param hist [in] histogram
+ * @param p [in] percentile in [0, 100], e.g., 99.9
+ * @return upper bound of the bucket holding the percentile (never above max), 0 if empty
+ */
+uint64_t perf_hist_percentile(perf_hist_t *hist, double p)
+{
+    uint64_t rank, seen, high;
+    size_t i;
+
+    if (hist == NULL or hist->total == 0)
+    {
+        return 0;
+    }
+
+    rank = (uint64_t)(p / 100.0 * hist->total + 0.5);
+    rank = rank == 0 ? 1 : rank;
+    rank = rank > hist->total ? hist->total : rank;
+
+    seen = 0;
+    for (i = 0; i < PERF_HIST_BUCKETS; i++)
+    {
+        seen += hist->counts[i];
+        if (seen >= rank)
+        {
+            break;
+        }
+    }
+
+    high = perf_hist_bucket_high(i);
+    return high < hist->max ? high : hist->max;
+}
+
+/**
+ * Summarize a histogram as "count=... min=... p50=... p99=... p999=... max=... mean=..." in ns
+ * @param hist [in] histogram
+ * @return printable string
+ */
+string perf_hist_summary(perf_hist_t *hist)
+{
+    char buff[MAX_STR_LEN];
+
+    if (hist == NULL or hist->total == 0)
+    {
+        return string("count=0");
+    }
+
+    snprintf(buff, MAX_STR_LEN, "count=%llu min=%llu p50=%llu p99=%llu p999=%llu max=%llu mean=%.1f",
+             (unsigned long long)hist->total, (unsigned long long)hist->min,
+             (unsigned long long)perf_hist_percentile(hist, 50), (unsigned long long)perf_hist_percentile(hist, 99),
+             (unsigned long long)perf_hist_percentile(hist, 99.9), (unsigned long long)hist->max,
+             (double)hist->sum / hist->total);
+
+    return string(buff);
+}
+
+/**
+ * Histograms of exited threads, merged when each thread exits
+ */
+typedef struct _perf_hist_registry_t
+{
+    mutex lock;
+    perf_hist_t retired;
+}perf_hist_registry_t;
+
+static perf_hist_registry_t *perf_hist_new_registry()
+{
+    perf_hist_registry_t *registry = new perf_hist_registry_t();
+
+    perf_hist_init(&registry->retired);
+    return registry;
+}
+
+/**
+ * Get the registry; constructed on first use and never destroyed, as threads may exit
+ * after main() returns
+ */
+static perf_hist_registry_t *perf_hist_get_registry()
+{
+    static perf_hist_registry_t *registry = perf_hist_new_registry();
+    return registry;
+}
+
+/**
+ * @class PerfThreadHist owns the histogram of a thread, allocated on first use, and merges it
+ *        into the registry when the thread exits.
+ */
+class PerfThreadHist
+{
+public:
+    perf_hist_t *hist;
+
+    PerfThreadHist()
+    {
+        this->hist = new perf_hist_t();
+        perf_hist_init(this->hist);
+    }
+
+    ~PerfThreadHist()
+    {
+        perf_hist_registry_t *registry = perf_hist_get_registry();
+
+        {
+            lock_guard<mutex> guard(registry->lock);
+            perf_hist_merge(&registry->retired, this->hist);
+        }
+        delete(this->hist);
+    }
+};
+
+/**
+ * Get the histogram of the calling thread; it is valid until the thread exits, when its
+ * values move to the histogram of perf_hist_collect()
+ * @return histogram
+ */
+perf_hist_t *perf_hist_local()
+{
+    static thread_local PerfThreadHist local;
+    return local.hist;
+}
+
+/**
+ * Merge the histograms of all exited threads and of the calling thread into dest.
+ * Histograms of other running threads are not read, as they are written without locks.
+ * @param dest [in,out] histogram
+ * @return \0 on success, or other error code
+ */
+int perf_hist_collect(perf_hist_t *dest)
+{
+    perf_hist_registry_t *registry = perf_hist_get_registry();
+
+    if (dest == NULL)
+    {
+        return ERROR_PARAM;
+    }
+
+    {
+        lock_guard<mutex> guard(registry->lock);
+        perf_hist_merge(dest, &registry->retired);
+    }
+
+    return perf_hist_merge(dest, perf_hist_local());
+}
+
+/**
+ * Clear the histograms of exited threads and of the calling thread
+ */
+void perf_hist_reset_all()
+{
+    perf_hist_registry_t *registry = perf_hist_get_registry();
+
+    {
+        lock_guard<mutex> guard(registry->lock);
+        perf_hist_init(&registry->retired);
+    }
+
+    perf_hist_init(perf_hist_local());
+}
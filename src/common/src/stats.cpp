@@ -0,0 +1,314 @@
+/*
+ ============================================================================
+ Name        : stats.cpp
+ Description : hot-path instrumentation implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#include <string.h>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "common/include/err.h"
+#include "common/include/stats.h"
+
+using namespace std;
+
+/**
+ * Counters of a single thread. Only the owner thread writes them, so an update is a
+ * relaxed load plus a relaxed store (no lock prefix); snapshot threads read them concurrently.
+ */
+typedef struct _stats_block_t
+{
+    atomic<uint64_t> counters[STAT_COUNTER_MAX];
+    atomic<uint64_t> histograms[STAT_HISTOGRAM_MAX][STAT_HIST_BUCKETS];
+}stats_block_t;
+
+/**
+ * Global registry of live thread blocks, and totals of threads that have exited
+ */
+typedef struct _stats_registry_t
+{
+    mutex lock;
+    vector<stats_block_t *> blocks;
+    cshark_stats_t retired;     // totals merged from exited threads
+    cshark_stats_t baseline;    // totals at the last cshark_stats_reset()
+}stats_registry_t;
+
+static const char *counter_names[STAT_COUNTER_MAX] = {
+    "node_alloc",
+    "hashtable_find",
+    "hashtable_find_miss",
+    "hashtable_add",
+    "linklist_insert",
+    "linklist_delete",
+    "stack_push",
+    "stack_pop",
+    "queue_enqueue",
+    "queue_dequeue",
+    "tree_traverse"
+};
+
+static const char *histogram_names[STAT_HISTOGRAM_MAX] = {
+    "hashtable_probe",
+    "hashtable_chain",
+    "linklist_walk",
+    "tree_traverse"
+};
+
+/**
+ * Get the registry; constructed on first use so it is safe during static initialization.
+ * The registry is never destroyed, as threads may exit after main() returns.
+ */
+static stats_registry_t *stats_get_registry()
+{
+    static stats_registry_t *registry = new stats_registry_t();
+    return registry;
+}
+
+/**
+ * Add all counters of a thread block into stats
+ */
+static void stats_block_merge(stats_block_t *block, cshark_stats_t *stats)
+{
+    int i, j;
+
+    for (i = 0; i < STAT_COUNTER_MAX; i++)
+    {
+        stats->counters[i] += block->counters[i].load(memory_order_relaxed);
+    }
+
+    for (i = 0; i < STAT_HISTOGRAM_MAX; i++)
+    {
+        for (j = 0; j < STAT_HIST_BUCKETS; j++)
+        {
+            stats->histograms[i][j] += block->histograms[i][j].load(memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * @class StatsThreadBlock registers a block on a thread's first record,
+ *        and merges it into the retired totals when the thread exits.
+ */
+class StatsThreadBlock
+{
+public:
+    stats_block_t *block;
+
+    StatsThreadBlock()
+    {
+        stats_registry_t *registry = stats_get_registry();
+
+        this->block = new stats_block_t();   // value-initialized, all counters are 0
+
+        lock_guard<mutex> guard(registry->lock);
+        registry->blocks.push_back(this->block);
+    }
+
+    ~StatsThreadBlock()
+    {
+        stats_registry_t *registry = stats_get_registry();
+        size_t i;
+
+        lock_guard<mutex> guard(registry->lock);
+        stats_block_merge(this->block, &registry->retired);
+        for (i = 0; i < registry->blocks.size(); i++)
+        {
+            if (registry->blocks[i] == this->block)
+            {
+                registry->blocks.erase(registry->blocks.begin() + i);
+                break;
+            }
+        }
+
+        delete(this->block);
+    }
+};
+
+/**
+ * Get the block of the calling thread
+ */
+static stats_block_t *stats_get_local()
+{
+    static thread_local StatsThreadBlock local;
+    return local.block;
+}
+
+/**
+ * Map a value to a log2 bucket
+ */
+static inline int stats_bucket(uint64_t v)
+{
+    int b;
+
+    if (v == 0)
+    {
+        return 0;
+    }
+
+    b = 64 - __builtin_clzll(v);
+    return b < STAT_HIST_BUCKETS ? b : STAT_HIST_BUCKETS - 1;
+}
+
+/**
+ * Check if the library is built with instrumentation
+ * @return \true if CSHARK_STAT_* macros record values
+ */
+bool cshark_stats_enabled()
+{
+#ifdef CODESHARK_ENABLE_STATS
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Add n to a counter of the calling thread
+ * @param c [in] counter
+ * @param n [in] increment
+ */
+void cshark_stats_add(CSHARK_STAT_COUNTER c, uint64_t n)
+{
+    atomic<uint64_t> *p;
+
+    p = &stats_get_local()->counters[c];
+    p->store(p->load(memory_order_relaxed) + n, memory_order_relaxed);
+}
+
+/**
+ * Record a value in a histogram of the calling thread
+ * @param h [in] histogram
+ * @param v [in] value, e.g., probe length
+ */
+void cshark_stats_record(CSHARK_STAT_HISTOGRAM h, uint64_t v)
+{
+    atomic<uint64_t> *p;
+
+    p = &stats_get_local()->histograms[h][stats_bucket(v)];
+    p->store(p->load(memory_order_relaxed) + 1, memory_order_relaxed);
+}
+
+/**
+ * Take a snapshot of all threads since the last reset
+ * \note counters of other threads are read without stopping them, so a snapshot
+ *       is consistent per counter rather than across counters.
+ * @param stats [out] snapshot
+ * @return \0 on success, or other error code
+ */
+int cshark_stats_snapshot(cshark_stats_t *stats)
+{
+    stats_registry_t *registry = stats_get_registry();
+    size_t k;
+    int i, j;
+
+    if (stats == NULL)
+    {
+        return ERROR_PARAM;
+    }
+
+    lock_guard<mutex> guard(registry->lock);
+
+    memcpy(stats, &registry->retired, sizeof(cshark_stats_t));
+    for (k = 0; k < registry->blocks.size(); k++)
+    {
+        stats_block_merge(registry->blocks[k], stats);
+    }
+
+    for (i = 0; i < STAT_COUNTER_MAX; i++)
+    {
+        stats->counters[i] -= registry->baseline.counters[i];
+    }
+
+    for (i = 0; i < STAT_HISTOGRAM_MAX; i++)
+    {
+        for (j = 0; j < STAT_HIST_BUCKETS; j++)
+        {
+            stats->histograms[i][j] -= registry->baseline.histograms[i][j];
+        }
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Reset all counters to zero.
+ * Thread blocks are never written by other threads, so the current totals are
+ * saved as a baseline which later snapshots subtract.
+ */
+void cshark_stats_reset()
+{
+    stats_registry_t *registry = stats_get_registry();
+    cshark_stats_t totals;
+    size_t k;
+
+    lock_guard<mutex> guard(registry->lock);
+
+    memcpy(&totals, &registry->retired, sizeof(cshark_stats_t));
+    for (k = 0; k < registry->blocks.size(); k++)
+    {
+        stats_block_merge(registry->blocks[k], &totals);
+    }
+
+    memcpy(&registry->baseline, &totals, sizeof(cshark_stats_t));
+}
+
+/**
+ * Export a snapshot as text, one "name value" per line; histograms are exported as
+ * "name{le=upper_bound} count" for non-empty buckets.
+ * @param stats [in] snapshot
+ * @return exported text, or empty string on invalid input
+ */
+string cshark_stats_export(cshark_stats_t *stats)
+{
+    string s;
+    int i, j;
+
+    if (stats == NULL)
+    {
+        return s;
+    }
+
+    for (i = 0; i < STAT_COUNTER_MAX; i++)
+    {
+        s += string("codeshark_") + counter_names[i] + " " + to_string(stats->counters[i]) + "\n";
+    }
+
+    for (i = 0; i < STAT_HISTOGRAM_MAX; i++)
+    {
+        for (j = 0; j < STAT_HIST_BUCKETS; j++)
+        {
+            if (stats->histograms[i][j] == 0)
+            {
+                continue;
+            }
+
+            // bucket j holds values below 2^j
+            s += string("codeshark_") + histogram_names[i] + "{le=" + (j == 0 ? string("0") : to_string((1ULL << j) - 1))
+                 + "} " + to_string(stats->histograms[i][j]) + "\n";
+        }
+    }
+
+    return s;
+}
+
+/**
+ * Get the printable name of a counter
+ */
+const char *cshark_stats_counter_name(CSHARK_STAT_COUNTER c)
+{
+    return counter_names[c];
+}
+
+/**
+ * Get the printable name of a histogram
+ */
+const char *cshark_stats_histogram_name(CSHARK_STAT_HISTOGRAM h)
+{
+    return histogram_names[h];
+}
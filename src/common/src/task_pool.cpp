@@ -0,0 +1,221 @@
+/*
+ ============================================================================
+ Name        : task_pool.cpp
+ Description : work-stealing task pool implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#include "common/include/task_pool.h"
+
+// pool and queue index of the calling thread; threads outside any pool use queue 0
+static thread_local TaskPool *local_pool = NULL;
+static thread_local size_t local_queue = 0;
+
+/**
+ * Create a pool
+ * @param threads [in] total threads including the caller of wait(), 0 for all hardware threads
+ */
+TaskPool::TaskPool(size_t threads) : queued(0), stop(false)
+{
+    size_t i;
+
+    if (threads == 0)
+    {
+        threads = thread::hardware_concurrency();
+    }
+
+    if (threads == 0)
+    {
+        threads = 1;
+    }
+
+    // the thread calling wait() works too, so threads - 1 workers are started
+    for (i = 0; i < threads; i++)
+    {
+        this->queues.push_back(unique_ptr<task_queue_t>(new task_queue_t()));
+    }
+
+    for (i = 1; i < threads; i++)
+    {
+        this->workers.push_back(thread(&TaskPool::worker_loop, this, i));
+    }
+}
+
+TaskPool::~TaskPool()
+{
+    size_t i;
+
+    {
+        lock_guard<mutex> guard(this->sleep_lock);
+        this->stop.store(true);
+    }
+    this->sleep_cv.notify_all();
+
+    for (i = 0; i < this->workers.size(); i++)
+    {
+        this->workers[i].join();
+    }
+}
+
+/**
+ * Get the number of threads, including the waiting caller
+ */
+size_t TaskPool::get_threads()
+{
+    return this->queues.size();
+}
+
+size_t TaskPool::get_local_queue()
+{
+    return local_pool == this ? local_queue : 0;
+}
+
+/**
+ * Pop a task from the own queue (back), or steal from other queues (front)
+ * @return \true if a task is got
+ */
+bool TaskPool::pop_task(size_t self, task_t *task)
+{
+    size_t i, k;
+    size_t n = this->queues.size();
+
+    if (this->queued.load(memory_order_acquire) == 0)
+    {
+        return false;
+    }
+
+    for (i = 0; i < n; i++)
+    {
+        k = (self + i) % n;
+        task_queue_t *q = this->queues[k].get();
+
+        lock_guard<mutex> guard(q->lock);
+        if (q->tasks.empty())
+        {
+            continue;
+        }
+
+        if (i == 0)
+        {
+            *task = std::move(q->tasks.back());
+            q->tasks.pop_back();
+        }
+        else
+        {
+            *task = std::move(q->tasks.front());
+            q->tasks.pop_front();
+        }
+
+        this->queued.fetch_sub(1, memory_order_relaxed);
+        return true;
+    }
+
+    return false;
+}
+
+void TaskPool::run_task(task_t *task)
+{
+    task->fn();
+    task->group->pending.fetch_sub(1, memory_order_acq_rel);
+}
+
+void TaskPool::worker_loop(size_t id)
+{
+    task_t task;
+
+    local_pool = this;
+    local_queue = id;
+
+    while (!this->stop.load(memory_order_acquire))
+    {
+        if (this->pop_task(id, &task))
+        {
+            this->run_task(&task);
+            continue;
+        }
+
+        unique_lock<mutex> lock(this->sleep_lock);
+        this->sleep_cv.wait(lock, [this]() {
+            return this->stop.load() or this->queued.load() > 0;
+        });
+    }
+}
+
+/**
+ * Queue a task of a group
+ * @param group [in,out] group which counts the task until it finishes
+ * @param fn [in] task
+ */
+void TaskPool::spawn(TaskGroup *group, function<void()> fn)
+{
+    task_t task;
+    task_queue_t *q = this->queues[this->get_local_queue()].get();
+
+    task.fn = std::move(fn);
+    task.group = group;
+    group->pending.fetch_add(1, memory_order_relaxed);
+
+    {
+        lock_guard<mutex> guard(q->lock);
+        q->tasks.push_back(std::move(task));
+        this->queued.fetch_add(1, memory_order_release);
+    }
+
+    // sleepers check queued while holding sleep_lock, so taking it here ensures
+    // the notification cannot fall between their check and their sleep
+    {
+        lock_guard<mutex> guard(this->sleep_lock);
+    }
+    this->sleep_cv.notify_one();
+}
+
+/**
+ * Wait until all tasks of a group finish; the caller runs queued tasks meanwhile
+ * @param group [in] group
+ */
+void TaskPool::wait(TaskGroup *group)
+{
+    task_t task;
+    size_t self = this->get_local_queue();
+
+    while (group->pending.load(memory_order_acquire) > 0)
+    {
+        if (this->pop_task(self, &task))
+        {
+            this->run_task(&task);
+        }
+        else
+        {
+            this_thread::yield();
+        }
+    }
+}
+
+/**
+ * Run fn on chunks [b, e) of [begin, end) in parallel, and wait for all of them
+ * @param grain [in] chunk size; chunks start at begin + k * grain
+ * @param fn [in] function of a chunk
+ */
+void TaskPool::parallel_for(size_t begin, size_t end, size_t grain, function<void(size_t, size_t)> fn)
+{
+    TaskGroup group;
+    size_t b, e;
+
+    if (grain == 0)
+    {
+        grain = 1;
+    }
+
+    for (b = begin; b < end; b += grain)
+    {
+        e = (end - b > grain) ? b + grain : end;
+        this->spawn(&group, [=]() {
+            fn(b, e);
+        });
+    }
+
+    this->wait(&group);
+}
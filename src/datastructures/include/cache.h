@@ -0,0 +1,112 @@
+/*
+ ============================================================================
+ Name        : cache.h
+ Description : LRU, SLRU and CLOCK cache header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_CACHE_H
+#define CODESHARK_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+
+#include "common/include/node.h"
+
+using namespace std;
+
+#define CACHE_SLRU_PROTECTED_PCT    80      // share of entries in the protected segment of SLRU
+
+enum CACHE_POLICY {
+    CACHE_LRU = 1,      // evict the least recently used entry
+    CACHE_SLRU = 2,     // segmented LRU: entries hit twice are protected from one-time scans
+    CACHE_CLOCK = 4     // second chance: a hit sets a bit instead of moving the entry
+};
+
+/**
+ * @struct cshark_cache_stats_t
+ * Counters of a cache since creation or the last reset_stats()
+ */
+typedef struct _cshark_cache_stats_t
+{
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t inserts;
+    uint64_t evictions;
+}cshark_cache_stats_t;
+
+/**
+ * @class Cache maps int keys to string values, and evicts entries by a policy when it holds more
+ *        than max_entries entries or max_bytes bytes. get(), put(), erase() and each eviction are O(1).
+ *
+ * An entry is a node with the key in val and the value in name, as in the hash table. Nodes are
+ * linked in circular recency lists with a sentinel (head->next is the most recent entry), and the
+ * hash index maps a key to its node, so a hit moves the node without searching the list:
+ *
+ *      index: key -> node          list: head <-> MRU <-> ... <-> LRU <-> head
+ *
+ * SLRU keeps two lists: new entries enter the probation list, a hit promotes an entry to the
+ * protected list, and the LRU entry of a full protected list goes back to probation. Victims come
+ * from probation first, so a scan of one-time keys does not flush the entries used repeatedly.
+ *
+ * CLOCK keeps one ring and a hand; a hit only sets visited. Eviction moves the hand, clearing the
+ * visited bits, to the first entry not visited since the hand last passed it.
+ */
+class Cache
+{
+private:
+    typedef struct _cache_entry_t
+    {
+        cshark_node_t *nt;
+        size_t bytes;
+        int segment;                    // list of the node, 1 for the protected list of SLRU
+    }cache_entry_t;
+
+    CACHE_POLICY policy;
+    size_t max_entries;                 // 0 for no limit
+    size_t max_bytes;                   // 0 for no limit
+    size_t bytes;
+    size_t protected_entries;           // SLRU limits of the protected list
+    size_t protected_bytes;
+    cshark_node_t *lists[2];            // sentinels: probation (or the only list), protected
+    size_t list_sizes[2];
+    size_t list_bytes[2];
+    cshark_node_t *hand;                // CLOCK: next node to examine, may be the sentinel
+    unordered_map<int, cache_entry_t> index;
+    cshark_cache_stats_t stats;
+
+    void link(cache_entry_t *entry, int segment, cshark_node_t *pos);
+    void unlink(cache_entry_t *entry);
+    void touch(cache_entry_t *entry);
+    void evict(cache_entry_t *keep = NULL);
+    void remove(unordered_map<int, cache_entry_t>::iterator it);
+
+public:
+    Cache(CACHE_POLICY policy, size_t max_entries, size_t max_bytes = 0);
+    ~Cache();
+
+    Cache(const Cache &) = delete;
+    Cache &operator=(const Cache &) = delete;
+
+    size_t get_size();
+    size_t get_bytes();
+    bool contains(int key);
+    const string *get(int key);
+    int put(int key, const string &value, size_t bytes = 0);
+    int erase(int key);
+    void clear();
+
+    cshark_cache_stats_t get_stats();
+    void reset_stats();
+};
+
+#ifdef CODESHARK_HEADER_ONLY
+#include "datastructures/include/cache_inl.h"
+#endif
+
+#endif //CODESHARK_CACHE_H
@@ -0,0 +1,341 @@
+/*
+ ============================================================================
+ Name        : cache_inl.h
+ Description : LRU, SLRU and CLOCK cache inline implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_CACHE_INL_H
+#define CODESHARK_CACHE_INL_H
+
+#include "common/include/common.h"
+#include "common/include/err.h"
+#include "datastructures/include/cache.h"
+
+/**
+ * Initialize an empty cache
+ * @param policy [in] eviction policy
+ * @param max_entries [in] most entries, 0 for no limit
+ * @param max_bytes [in] most bytes of all entries, 0 for no limit
+ */
+CODESHARK_INLINE Cache::Cache(CACHE_POLICY policy, size_t max_entries, size_t max_bytes)
+{
+    int i;
+
+    this->policy = policy;
+    this->max_entries = max_entries;
+    this->max_bytes = max_bytes;
+    this->bytes = 0;
+    this->protected_entries = max_entries * CACHE_SLRU_PROTECTED_PCT / 100;
+    this->protected_bytes = max_bytes * CACHE_SLRU_PROTECTED_PCT / 100;
+
+    for (i = 0; i < 2; i++)
+    {
+        this->lists[i] = cshark_node_init();
+        this->lists[i]->prev = this->lists[i];
+        this->lists[i]->next = this->lists[i];
+        this->list_sizes[i] = 0;
+        this->list_bytes[i] = 0;
+    }
+
+    this->hand = this->lists[0];
+    if (max_entries > 0)
+    {
+        this->index.reserve(max_entries);
+    }
+    this->reset_stats();
+}
+
+/**
+ * Delete the cache and all entries
+ */
+CODESHARK_INLINE Cache::~Cache()
+{
+    this->clear();
+    cshark_node_free(this->lists[0]);
+    cshark_node_free(this->lists[1]);
+}
+
+/**
+ * Link the node of an entry after pos in a list
+ */
+CODESHARK_INLINE void Cache::link(cache_entry_t *entry, int segment, cshark_node_t *pos)
+{
+    cshark_node_t *nt = entry->nt;
+
+    nt->prev = pos;
+    nt->next = pos->next;
+    pos->next->prev = nt;
+    pos->next = nt;
+
+    entry->segment = segment;
+    this->list_sizes[segment]++;
+    this->list_bytes[segment] += entry->bytes;
+}
+
+CODESHARK_INLINE void Cache::unlink(cache_entry_t *entry)
+{
+    cshark_node_t *nt = entry->nt;
+
+    if (this->hand == nt)
+    {
+        this->hand = nt->next;
+    }
+
+    nt->prev->next = nt->next;
+    nt->next->prev = nt->prev;
+
+    this->list_sizes[entry->segment]--;
+    this->list_bytes[entry->segment] -= entry->bytes;
+}
+
+/**
+ * Record an access of an entry
+ */
+CODESHARK_INLINE void Cache::touch(cache_entry_t *entry)
+{
+    cache_entry_t *demoted;
+
+    if (this->policy == CACHE_CLOCK)
+    {
+        entry->nt->visited = true;
+        return;
+    }
+
+    if (this->policy == CACHE_LRU)
+    {
+        this->unlink(entry);
+        this->link(entry, 0, this->lists[0]);
+        return;
+    }
+
+    // SLRU: promote to the protected list, and move its overflow back to probation
+    this->unlink(entry);
+    this->link(entry, 1, this->lists[1]);
+
+    while (this->list_sizes[1] > 1 and
+           ((this->max_entries > 0 and this->list_sizes[1] > this->protected_entries) or
+            (this->max_bytes > 0 and this->list_bytes[1] > this->protected_bytes)))
+    {
+        demoted = &this->index.find(this->lists[1]->prev->val)->second;
+        this->unlink(demoted);
+        this->link(demoted, 0, this->lists[0]);
+    }
+}
+
+/**
+ * Evict one entry by the policy
+ * @param keep [in] entry not to evict, or \NULL
+ * \warning the cache must hold an entry other than keep
+ */
+CODESHARK_INLINE void Cache::evict(cache_entry_t *keep)
+{
+    cshark_node_t *victim;
+
+    if (this->policy == CACHE_CLOCK)
+    {
+        // the hand passes keep like the sentinel, without clearing its visited bit
+        while (true)
+        {
+            if (this->hand == this->lists[0] or (keep != NULL and this->hand == keep->nt))
+            {
+                this->hand = this->hand->next;
+            }
+            else if (this->hand->visited)
+            {
+                this->hand->visited = false;
+                this->hand = this->hand->next;
+            }
+            else
+            {
+                break;
+            }
+        }
+        victim = this->hand;
+    }
+    else if (this->list_sizes[0] > 0)
+    {
+        victim = this->lists[0]->prev;
+    }
+    else
+    {
+        victim = this->lists[1]->prev;
+    }
+
+    this->remove(this->index.find(victim->val));
+    this->stats.evictions++;
+}
+
+CODESHARK_INLINE void Cache::remove(unordered_map<int, cache_entry_t>::iterator it)
+{
+    this->unlink(&it->second);
+    this->bytes -= it->second.bytes;
+    cshark_node_free(it->second.nt);
+    this->index.erase(it);
+}
+
+CODESHARK_INLINE size_t Cache::get_size()
+{
+    return this->index.size();
+}
+
+CODESHARK_INLINE size_t Cache::get_bytes()
+{
+    return this->bytes;
+}
+
+/**
+ * Check if a key is cached, without counting an access
+ */
+CODESHARK_INLINE bool Cache::contains(int key)
+{
+    return this->index.count(key) > 0;
+}
+
+/**
+ * Get the value of a key, and record the access
+ * @param key [in] key
+ * @return value, valid until the entry is changed or removed, or \NULL on a miss
+ */
+CODESHARK_INLINE const string *Cache::get(int key)
+{
+    unordered_map<int, cache_entry_t>::iterator it = this->index.find(key);
+
+    if (it == this->index.end())
+    {
+        this->stats.misses++;
+        return NULL;
+    }
+
+    this->stats.hits++;
+    this->touch(&it->second);
+    return &it->second.nt->name;
+}
+
+/**
+ * Add an entry, or update the value of a cached key; entries are evicted to make room
+ * @param key [in] key
+ * @param value [in] value
+ * @param bytes [in] size charged to the entry, 0 for the length of value
+ * @return \0 on success, ERROR_MAX_NODES if the entry alone exceeds max_bytes
+ */
+CODESHARK_INLINE int Cache::put(int key, const string &value, size_t bytes)
+{
+    unordered_map<int, cache_entry_t>::iterator it;
+    cache_entry_t entry;
+    cache_entry_t *e;
+
+    if (bytes == 0)
+    {
+        bytes = value.size();
+    }
+
+    if (this->max_bytes > 0 and bytes > this->max_bytes)
+    {
+        return ERROR_MAX_NODES;
+    }
+
+    it = this->index.find(key);
+    if (it != this->index.end())
+    {
+        e = &it->second;
+        e->nt->name = value;
+        this->bytes += bytes - e->bytes;
+        this->list_bytes[e->segment] += bytes - e->bytes;
+        e->bytes = bytes;
+        this->touch(e);
+
+        // evict other entries until the larger value fits: LRU and SLRU victims come from list
+        // tails, while the updated entry is at a head, and the CLOCK hand passes over it
+        while (this->max_bytes > 0 and this->bytes > this->max_bytes and this->index.size() > 1)
+        {
+            this->evict(e);
+        }
+        return SUCCESS;
+    }
+
+    while (!this->index.empty() and
+           ((this->max_entries > 0 and this->index.size() >= this->max_entries) or
+            (this->max_bytes > 0 and this->bytes + bytes > this->max_bytes)))
+    {
+        this->evict();
+    }
+
+    entry.nt = cshark_node_init();
+    entry.nt->val = key;
+    entry.nt->name = value;
+    entry.nt->visited = false;
+    entry.bytes = bytes;
+    entry.segment = 0;
+
+    e = &this->index.insert(make_pair(key, entry)).first->second;
+
+    // CLOCK inserts behind the hand, so a new entry is examined last
+    this->link(e, 0, this->policy == CACHE_CLOCK ? this->hand->prev : this->lists[0]);
+    this->bytes += bytes;
+    this->stats.inserts++;
+
+    return SUCCESS;
+}
+
+/**
+ * Remove an entry
+ * @return \0 on success, or ERROR_NOT_FOUND if the key is not cached
+ */
+CODESHARK_INLINE int Cache::erase(int key)
+{
+    unordered_map<int, cache_entry_t>::iterator it = this->index.find(key);
+
+    if (it == this->index.end())
+    {
+        return ERROR_NOT_FOUND;
+    }
+
+    this->remove(it);
+    return SUCCESS;
+}
+
+/**
+ * Remove all entries; counters are kept
+ */
+CODESHARK_INLINE void Cache::clear()
+{
+    cshark_node_t *nt;
+    cshark_node_t *next;
+    int i;
+
+    for (i = 0; i < 2; i++)
+    {
+        for (nt = this->lists[i]->next; nt != this->lists[i]; nt = next)
+        {
+            next = nt->next;
+            cshark_node_free(nt);
+        }
+        this->lists[i]->prev = this->lists[i];
+        this->lists[i]->next = this->lists[i];
+        this->list_sizes[i] = 0;
+        this->list_bytes[i] = 0;
+    }
+
+    this->hand = this->lists[0];
+    this->bytes = 0;
+    this->index.clear();
+}
+
+CODESHARK_INLINE cshark_cache_stats_t Cache::get_stats()
+{
+    return this->stats;
+}
+
+CODESHARK_INLINE void Cache::reset_stats()
+{
+    this->stats.hits = 0;
+    this->stats.misses = 0;
+    this->stats.inserts = 0;
+    this->stats.evictions = 0;
+}
+
+#endif //CODESHARK_CACHE_INL_H
@@ -0,0 +1,183 @@
+/*
+ ============================================================================
+ Name        : concurrent_cache.h
+ Description : sharded concurrent cache with TinyLFU admission header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_CONCURRENT_CACHE_H
+#define CODESHARK_CONCURRENT_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "common/include/node.h"
+#include "datastructures/include/cache.h"
+
+using namespace std;
+
+#define CCACHE_MAX_SHARDS           256
+#define CCACHE_MIN_SHARD_ENTRIES    64      // default sharding keeps at least this many entries per shard
+#define CCACHE_READ_BUFFERS         4       // read buffers per shard, a thread uses one by its id
+#define CCACHE_READ_BUFFER_SIZE     64      // reads recorded before a buffer is drained
+#define CCACHE_WINDOW_PCT           1       // share of entries in the admission window
+#define CCACHE_PROTECTED_PCT        80      // share of the main space in the protected segment
+#define CCACHE_CACHE_LINE           64
+#define CCACHE_EMPTY_KEY            INT64_MIN   // read buffer slot without a key
+
+#define SKETCH_DEPTH                4       // counters of a key, one per row
+#define SKETCH_SAMPLE_FACTOR        10      // increments per counter of a row before aging
+
+/**
+ * @class FrequencySketch estimates how often keys were seen recently, in 4-bit counters
+ *        (a count-min sketch). A key has one counter in each of SKETCH_DEPTH rows, and its
+ *        estimate is the smallest of them, so collisions can only overestimate. An increment
+ *        only raises the smallest counters (conservative update), which keeps the error low.
+ *
+ * Counts saturate at 15. After SKETCH_SAMPLE_FACTOR increments per counter of a row, all
+ * counters are halved, so the sketch follows changes in popularity.
+ */
+class FrequencySketch
+{
+private:
+    vector<uint64_t> table;             // 16 counters per word, rows one after another
+    size_t width;                       // counters per row, a power of two
+    size_t samples;
+
+    size_t counter(uint64_t hash, int row);
+    void age();
+
+public:
+    FrequencySketch(size_t capacity);
+
+    void increment(uint64_t hash);
+    int estimate(uint64_t hash);
+    void clear();
+};
+
+/**
+ * @class ConcurrentCache maps int keys to string values for many threads, and keeps at most
+ *        max_entries entries. Keys are spread over shards by hash, each with its own lock, so
+ *        threads working on different shards do not wait for each other.
+ *
+ * Eviction follows W-TinyLFU. A shard keeps three recency lists like SLRU in Cache:
+ *
+ *      new key -> window (LRU) -> probation -> protected
+ *                                    ^   a hit promotes   |
+ *                                    +--- overflow -------+
+ *
+ * A new entry enters a small window. Entries leaving the window become candidates at the head
+ * of probation; when the shard is full, a candidate is kept only if a FrequencySketch of recent
+ * accesses, misses included, rates it above the victim at the tail of probation. One-time keys
+ * of a scan lose against keys used repeatedly, so they cannot flush the cache.
+ *
+ * get() holds the shard lock only to find the key and copy the value. The access is recorded in
+ * a read buffer instead of moving the entry, and buffers are drained in batches under the lock:
+ * by put(), or by the reader that fills a buffer, if the lock is free. A full buffer drops
+ * records; recency and frequency are approximate, the contents never are.
+ *
+ * With async_evict, put() leaves eviction to a background thread, so a shard may briefly hold
+ * more entries than its share; put() evicts itself beyond twice the share. cleanup() drains and
+ * evicts at once.
+ */
+class ConcurrentCache
+{
+private:
+    // an entry is a node with the key in val, the value in name and the entry in data
+    typedef struct _ccache_entry_t
+    {
+        cshark_node_t *nt;
+        int segment;                    // CCACHE_WINDOW, CCACHE_PROBATION or CCACHE_PROTECTED
+    }ccache_entry_t;
+
+    enum CCACHE_SEGMENT {
+        CCACHE_WINDOW = 0,
+        CCACHE_PROBATION = 1,
+        CCACHE_PROTECTED = 2
+    };
+
+    /**
+     * Readers claim a slot by count and store a key; a slot holds CCACHE_EMPTY_KEY otherwise,
+     * which no int key can equal.
+     */
+    typedef struct _ccache_read_buffer_t
+    {
+        atomic<uint32_t> count;
+        atomic<int64_t> keys[CCACHE_READ_BUFFER_SIZE];
+        char pad[CCACHE_CACHE_LINE];
+    }ccache_read_buffer_t;
+
+    typedef struct _ccache_shard_t
+    {
+        mutex lock;
+        unordered_map<int, ccache_entry_t> index;
+        cshark_node_t *lists[3];        // sentinels, by segment
+        size_t list_sizes[3];
+        size_t max_entries;
+        size_t max_window;
+        size_t max_protected;
+        FrequencySketch *sketch;
+        cshark_cache_stats_t stats;
+        atomic<bool> pending;           // eviction requested from the background thread
+        ccache_read_buffer_t buffers[CCACHE_READ_BUFFERS];
+        char pad[CCACHE_CACHE_LINE];
+    }ccache_shard_t;
+
+    vector<unique_ptr<ccache_shard_t>> shards;
+    size_t shard_mask;                  // shards are chosen by the high half of the hash
+    size_t max_entries;
+
+    bool async_evict;
+    thread evictor;
+    mutex evict_lock;
+    condition_variable evict_cv;
+    size_t evict_requests;
+    bool stop;
+
+    ccache_shard_t *get_shard(uint64_t hash);
+    bool record(ccache_shard_t *shard, int key);
+    void drain(ccache_shard_t *shard);
+    void link(ccache_shard_t *shard, ccache_entry_t *entry, int segment);
+    void unlink(ccache_shard_t *shard, ccache_entry_t *entry);
+    void touch(ccache_shard_t *shard, ccache_entry_t *entry);
+    void maintain(ccache_shard_t *shard);
+    void remove(ccache_shard_t *shard, unordered_map<int, ccache_entry_t>::iterator it);
+    void request_evict(ccache_shard_t *shard);
+    void evictor_loop();
+
+public:
+    ConcurrentCache(size_t max_entries, size_t shards = 0, bool async_evict = false);
+    ~ConcurrentCache();
+
+    ConcurrentCache(const ConcurrentCache &) = delete;
+    ConcurrentCache &operator=(const ConcurrentCache &) = delete;
+
+    size_t get_size();
+    size_t get_shards();
+    bool contains(int key);
+    int get(int key, string *value);
+    int put(int key, const string &value);
+    int erase(int key);
+    void cleanup();
+    void clear();
+
+    cshark_cache_stats_t get_stats();
+    void reset_stats();
+};
+
+#ifdef CODESHARK_HEADER_ONLY
+#include "datastructures/include/concurrent_cache_inl.h"
+#endif
+
+#endif //CODESHARK_CONCURRENT_CACHE_H
@@ -0,0 +1,715 @@
+/*
+ ============================================================================
+ Name        : concurrent_cache_inl.h
+ Description : sharded concurrent cache with TinyLFU admission inline implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_CONCURRENT_CACHE_INL_H
+#define CODESHARK_CONCURRENT_CACHE_INL_H
+
+#include "common/include/common.h"
+#include "common/include/err.h"
+#include "datastructures/include/static_containers.h"
+#include "datastructures/include/concurrent_cache.h"
+
+// odd multipliers giving each row of a sketch its own counter for a key
+static const uint64_t _cshark_sketch_seeds[SKETCH_DEPTH] = {
+    0x97cb3127c4a1f5b3ULL, 0xb492b66fbe98f273ULL, 0x9ae16a3b2f90404fULL, 0xcbf29ce484222325ULL
+};
+
+inline uint64_t _cshark_ccache_hash(int key)
+{
+    return (uint64_t)cshark_static_hash<int>()(key);
+}
+
+/**
+ * Get the read buffer of the calling thread, the same in every shard. The stripe is set on
+ * first use rather than by a dynamic initializer, which would add a guard to every access.
+ */
+inline size_t _cshark_ccache_stripe()
+{
+    static thread_local size_t stripe = 0;
+
+    if (stripe == 0)
+    {
+        stripe = cshark_static_hash<size_t>()(hash<thread::id>()(this_thread::get_id())) | 1;
+    }
+    return (stripe >> 1) & (CCACHE_READ_BUFFERS - 1);
+}
+
+/**
+ * Initialize a sketch with all counts 0
+ * @param capacity [in] number of keys to tell apart, usually the number of cache entries
+ */
+CODESHARK_INLINE FrequencySketch::FrequencySketch(size_t capacity)
+{
+    this->width = 16;
+    while (this->width < capacity)
+    {
+        this->width <<= 1;
+    }
+
+    this->table.assign(SKETCH_DEPTH * this->width / 16, 0);
+    this->samples = 0;
+}
+
+/**
+ * Get the position of the counter of a key in a row, in counters from the start of the table
+ */
+CODESHARK_INLINE size_t FrequencySketch::counter(uint64_t hash, int row)
+{
+    return row * this->width + ((size_t)((hash * _cshark_sketch_seeds[row]) >> 32) & (this->width - 1));
+}
+
+/**
+ * Halve all counters; the shift moves the low bit of each counter into its neighbour,
+ * and the mask clears it
+ */
+CODESHARK_INLINE void FrequencySketch::age()
+{
+    size_t i;
+
+    for (i = 0; i < this->table.size(); i++)
+    {
+        this->table[i] = (this->table[i] >> 1) & 0x7777777777777777ULL;
+    }
+    this->samples /= 2;
+}
+
+/**
+ * Count one occurrence of a key
+ * @param hash [in] hash of the key
+ */
+CODESHARK_INLINE void FrequencySketch::increment(uint64_t hash)
+{
+    size_t pos[SKETCH_DEPTH];
+    int count;
+    int min;
+    int row;
+
+    min = 15;
+    for (row = 0; row < SKETCH_DEPTH; row++)
+    {
+        pos[row] = this->counter(hash, row);
+        count = (int)(this->table[pos[row] >> 4] >> ((pos[row] & 15) << 2)) & 15;
+        min = count < min ? count : min;
+    }
+
+    if (min == 15)
+    {
+        return;
+    }
+
+    for (row = 0; row < SKETCH_DEPTH; row++)
+    {
+        // without a branch, as which rows hold the minimum is random
+        count = (int)(this->table[pos[row] >> 4] >> ((pos[row] & 15) << 2)) & 15;
+        this->table[pos[row] >> 4] += (uint64_t)(count == min) << ((pos[row] & 15) << 2);
+    }
+
+    if (++this->samples >= SKETCH_SAMPLE_FACTOR * this->width)
+    {
+        this->age();
+    }
+}
+
+/**
+ * Estimate how often a key was seen recently
+ * @param hash [in] hash of the key
+ * @return count from 0 to 15
+ */
+CODESHARK_INLINE int FrequencySketch::estimate(uint64_t hash)
+{
+    size_t pos;
+    int count;
+    int min;
+    int row;
+
+    min = 15;
+    for (row = 0; row < SKETCH_DEPTH; row++)
+    {
+        pos = this->counter(hash, row);
+        count = (int)(this->table[pos >> 4] >> ((pos & 15) << 2)) & 15;
+        min = count < min ? count : min;
+    }
+
+    return min;
+}
+
+CODESHARK_INLINE void FrequencySketch::clear()
+{
+    this->table.assign(this->table.size(), 0);
+    this->samples = 0;
+}
+
+/**
+ * Initialize an empty cache
+ * @param max_entries [in] most entries, at least one per shard
+ * @param shards [in] number of shards, rounded up to a power of two; 0 picks one by the number of
+ *        hardware threads, keeping at least CCACHE_MIN_SHARD_ENTRIES entries per shard
+ * @param async_evict [in] \true to evict on a background thread instead of in put()
+ */
+CODESHARK_INLINE ConcurrentCache::ConcurrentCache(size_t max_entries, size_t shards, bool async_evict)
+{
+    ccache_shard_t *shard;
+    size_t limit;
+    size_t n;
+    size_t i, j;
+    int k;
+
+    this->max_entries = max_entries > 0 ? max_entries : 1;
+
+    if (shards == 0)
+    {
+        shards = 4 * thread::hardware_concurrency();
+        limit = this->max_entries / CCACHE_MIN_SHARD_ENTRIES;
+        shards = shards < limit ? shards : limit;
+    }
+    limit = this->max_entries < CCACHE_MAX_SHARDS ? this->max_entries : CCACHE_MAX_SHARDS;
+
+    n = 1;
+    while (n < shards and n * 2 <= limit)
+    {
+        n <<= 1;
+    }
+    this->shard_mask = n - 1;
+
+    for (i = 0; i < n; i++)
+    {
+        shard = new ccache_shard_t();
+        shard->max_entries = this->max_entries / n + (i < this->max_entries % n ? 1 : 0);
+        shard->max_window = shard->max_entries * CCACHE_WINDOW_PCT / 100;
+        shard->max_window = shard->max_window > 0 ? shard->max_window : 1;
+        shard->max_protected = (shard->max_entries - shard->max_window) * CCACHE_PROTECTED_PCT / 100;
+        shard->sketch = new FrequencySketch(shard->max_entries);
+        shard->index.reserve(shard->max_entries);
+        shard->pending.store(false);
+
+        for (k = 0; k < 3; k++)
+        {
+            shard->lists[k] = cshark_node_init();
+            shard->lists[k]->prev = shard->lists[k];
+            shard->lists[k]->next = shard->lists[k];
+            shard->list_sizes[k] = 0;
+        }
+
+        for (k = 0; k < CCACHE_READ_BUFFERS; k++)
+        {
+            shard->buffers[k].count.store(0);
+            for (j = 0; j < CCACHE_READ_BUFFER_SIZE; j++)
+            {
+                shard->buffers[k].keys[j].store(CCACHE_EMPTY_KEY);
+            }
+        }
+
+        this->shards.push_back(unique_ptr<ccache_shard_t>(shard));
+    }
+
+    this->reset_stats();
+
+    this->async_evict = async_evict;
+    this->evict_requests = 0;
+    this->stop = false;
+    if (async_evict)
+    {
+        this->evictor = thread(&ConcurrentCache::evictor_loop, this);
+    }
+}
+
+/**
+ * Stop the background thread, and delete all entries
+ * \warning no other thread may use the cache any more
+ */
+CODESHARK_INLINE ConcurrentCache::~ConcurrentCache()
+{
+    size_t i;
+    int k;
+
+    if (this->async_evict)
+    {
+        {
+            lock_guard<mutex> guard(this->evict_lock);
+            this->stop = true;
+        }
+        this->evict_cv.notify_one();
+        this->evictor.join();
+    }
+
+    this->clear();
+    for (i = 0; i < this->shards.size(); i++)
+    {
+        for (k = 0; k < 3; k++)
+        {
+            cshark_node_free(this->shards[i]->lists[k]);
+        }
+        delete(this->shards[i]->sketch);
+    }
+}
+
+CODESHARK_INLINE ConcurrentCache::ccache_shard_t *ConcurrentCache::get_shard(uint64_t hash)
+{
+    return this->shards[(size_t)(hash >> 32) & this->shard_mask].get();
+}
+
+/**
+ * Record a read of a key in the read buffer of the calling thread. The record is dropped if
+ * another reader claims the same slot at the same time.
+ * @return \false if the buffer is full, and the read is not recorded
+ */
+CODESHARK_INLINE bool ConcurrentCache::record(ccache_shard_t *shard, int key)
+{
+    ccache_read_buffer_t *buffer = &shard->buffers[_cshark_ccache_stripe()];
+    uint32_t n = buffer->count.load(memory_order_relaxed);
+
+    if (n >= CCACHE_READ_BUFFER_SIZE)
+    {
+        return false;
+    }
+
+    if (buffer->count.compare_exchange_strong(n, n + 1, memory_order_relaxed))
+    {
+        buffer->keys[n].store(key, memory_order_release);
+    }
+    return true;
+}
+
+/**
+ * Apply the reads recorded in the buffers of a shard: count them in the sketch, and move the
+ * entries still cached. A slot claimed but not stored yet is left to the next drain.
+ * \warning the shard lock must be held
+ */
+CODESHARK_INLINE void ConcurrentCache::drain(ccache_shard_t *shard)
+{
+    unordered_map<int, ccache_entry_t>::iterator it;
+    ccache_read_buffer_t *buffer;
+    uint32_t n, i;
+    int64_t key;
+    int k;
+
+    for (k = 0; k < CCACHE_READ_BUFFERS; k++)
+    {
+        buffer = &shard->buffers[k];
+        if (buffer->count.load(memory_order_relaxed) == 0)
+        {
+            continue;
+        }
+
+        n = buffer->count.exchange(0, memory_order_relaxed);
+        for (i = 0; i < n; i++)
+        {
+            key = buffer->keys[i].exchange(CCACHE_EMPTY_KEY, memory_order_acquire);
+            if (key == CCACHE_EMPTY_KEY)
+            {
+                continue;
+            }
+
+            shard->sketch->increment(_cshark_ccache_hash((int)key));
+            it = shard->index.find((int)key);
+            if (it != shard->index.end())
+            {
+                this->touch(shard, &it->second);
+            }
+        }
+    }
+}
+
+/**
+ * Link the node of an entry at the head of a list
+ */
+CODESHARK_INLINE void ConcurrentCache::link(ccache_shard_t *shard, ccache_entry_t *entry, int segment)
+{
+    cshark_node_t *head = shard->lists[segment];
+    cshark_node_t *nt = entry->nt;
+
+    nt->prev = head;
+    nt->next = head->next;
+    head->next->prev = nt;
+    head->next = nt;
+
+    entry->segment = segment;
+    shard->list_sizes[segment]++;
+}
+
+CODESHARK_INLINE void ConcurrentCache::unlink(ccache_shard_t *shard, ccache_entry_t *entry)
+{
+    cshark_node_t *nt = entry->nt;
+
+    nt->prev->next = nt->next;
+    nt->next->prev = nt->prev;
+    shard->list_sizes[entry->segment]--;
+}
+
+/**
+ * Record an access of an entry: a hit in probation promotes it, and the overflow of the
+ * protected list goes back to the head of probation
+ */
+CODESHARK_INLINE void ConcurrentCache::touch(ccache_shard_t *shard, ccache_entry_t *entry)
+{
+    ccache_entry_t *demoted;
+
+    this->unlink(shard, entry);
+    if (entry->segment == CCACHE_WINDOW)
+    {
+        this->link(shard, entry, CCACHE_WINDOW);
+        return;
+    }
+
+    this->link(shard, entry, CCACHE_PROTECTED);
+    while (shard->list_sizes[CCACHE_PROTECTED] > shard->max_protected)
+    {
+        demoted = (ccache_entry_t *)shard->lists[CCACHE_PROTECTED]->prev->data;
+        this->unlink(shard, demoted);
+        this->link(shard, demoted, CCACHE_PROBATION);
+    }
+}
+
+/**
+ * Move the overflow of the window to probation, and evict entries while the shard is over its
+ * share: the candidate at the head of probation against the victim at its tail, the one seen
+ * less often by the sketch leaves. Ties keep the victim, which has been in the cache longer.
+ * \warning the shard lock must be held
+ */
+CODESHARK_INLINE void ConcurrentCache::maintain(ccache_shard_t *shard)
+{
+    cshark_node_t *candidate;
+    cshark_node_t *victim;
+    ccache_entry_t *entry;
+    int segment;
+
+    while (shard->list_sizes[CCACHE_WINDOW] > shard->max_window)
+    {
+        entry = (ccache_entry_t *)shard->lists[CCACHE_WINDOW]->prev->data;
+        this->unlink(shard, entry);
+        this->link(shard, entry, CCACHE_PROBATION);
+    }
+
+    while (shard->index.size() > shard->max_entries)
+    {
+        if (shard->list_sizes[CCACHE_PROBATION] == 0)
+        {
+            segment = shard->list_sizes[CCACHE_PROTECTED] > 0 ? CCACHE_PROTECTED : CCACHE_WINDOW;
+            victim = shard->lists[segment]->prev;
+        }
+        else
+        {
+            candidate = shard->lists[CCACHE_PROBATION]->next;
+            victim = shard->lists[CCACHE_PROBATION]->prev;
+            if (candidate != victim and
+                shard->sketch->estimate(_cshark_ccache_hash(candidate->val)) <=
+                shard->sketch->estimate(_cshark_ccache_hash(victim->val)))
+            {
+                victim = candidate;
+            }
+        }
+
+        this->remove(shard, shard->index.find(victim->val));
+        shard->stats.evictions++;
+    }
+}
+
+CODESHARK_INLINE void ConcurrentCache::remove(ccache_shard_t *shard, unordered_map<int, ccache_entry_t>::iterator it)
+{
+    this->unlink(shard, &it->second);
+    cshark_node_free(it->second.nt);
+    shard->index.erase(it);
+}
+
+/**
+ * Ask the background thread to maintain a shard; a shard is queued once until it is served
+ */
+CODESHARK_INLINE void ConcurrentCache::request_evict(ccache_shard_t *shard)
+{
+    if (shard->pending.exchange(true))
+    {
+        return;
+    }
+
+    {
+        lock_guard<mutex> guard(this->evict_lock);
+        this->evict_requests++;
+    }
+    this->evict_cv.notify_one();
+}
+
+CODESHARK_INLINE void ConcurrentCache::evictor_loop()
+{
+    ccache_shard_t *shard;
+    size_t i;
+
+    while (true)
+    {
+        {
+            unique_lock<mutex> guard(this->evict_lock);
+            this->evict_cv.wait(guard, [this]() { return this->stop or this->evict_requests > 0; });
+            if (this->stop)
+            {
+                return;
+            }
+            this->evict_requests = 0;
+        }
+
+        for (i = 0; i < this->shards.size(); i++)
+        {
+            shard = this->shards[i].get();
+            if (shard->pending.exchange(false))
+            {
+                lock_guard<mutex> guard(shard->lock);
+                this->drain(shard);
+                this->maintain(shard);
+            }
+        }
+    }
+}
+
+/**
+ * Get the number of entries; with async_evict it may exceed max_entries until eviction runs
+ */
+CODESHARK_INLINE size_t ConcurrentCache::get_size()
+{
+    size_t n = 0;
+    size_t i;
+
+    for (i = 0; i < this->shards.size(); i++)
+    {
+        lock_guard<mutex> guard(this->shards[i]->lock);
+        n += this->shards[i]->index.size();
+    }
+
+    return n;
+}
+
+CODESHARK_INLINE size_t ConcurrentCache::get_shards()
+{
+    return this->shards.size();
+}
+
+/**
+ * Check if a key is cached, without counting an access
+ */
+CODESHARK_INLINE bool ConcurrentCache::contains(int key)
+{
+    ccache_shard_t *shard = this->get_shard(_cshark_ccache_hash(key));
+    lock_guard<mutex> guard(shard->lock);
+
+    return shard->index.count(key) > 0;
+}
+
+/**
+ * Get the value of a key, and record the access; a miss is recorded too, so a key requested
+ * often gets admitted when it is put
+ * @param key [in] key
+ * @param value [out] copy of the value, may be \NULL to only check for a hit
+ * @return \0 on a hit, or ERROR_NOT_FOUND
+ */
+CODESHARK_INLINE int ConcurrentCache::get(int key, string *value)
+{
+    ccache_shard_t *shard = this->get_shard(_cshark_ccache_hash(key));
+    unordered_map<int, ccache_entry_t>::iterator it;
+    int ret;
+
+    {
+        lock_guard<mutex> guard(shard->lock);
+        it = shard->index.find(key);
+        if (it == shard->index.end())
+        {
+            shard->stats.misses++;
+            ret = ERROR_NOT_FOUND;
+        }
+        else
+        {
+            if (value != NULL)
+            {
+                *value = it->second.nt->name;
+            }
+            shard->stats.hits++;
+            ret = SUCCESS;
+        }
+    }
+
+    // drain a full buffer unless another thread holds the lock; then the read is dropped
+    if (!this->record(shard, key) and shard->lock.try_lock())
+    {
+        this->drain(shard);
+        shard->lock.unlock();
+        this->record(shard, key);
+    }
+
+    return ret;
+}
+
+/**
+ * Add an entry, or update the value of a cached key. A new entry may be evicted again right
+ * away, if keys of the shard are used more often.
+ * @param key [in] key
+ * @param value [in] value
+ * @return \0 on success
+ */
+CODESHARK_INLINE int ConcurrentCache::put(int key, const string &value)
+{
+    uint64_t h = _cshark_ccache_hash(key);
+    ccache_shard_t *shard = this->get_shard(h);
+    unordered_map<int, ccache_entry_t>::iterator it;
+    ccache_entry_t entry;
+    ccache_entry_t *e;
+    bool request;
+
+    {
+        lock_guard<mutex> guard(shard->lock);
+        this->drain(shard);
+
+        it = shard->index.find(key);
+        if (it != shard->index.end())
+        {
+            it->second.nt->name = value;
+            shard->sketch->increment(h);
+            this->touch(shard, &it->second);
+            return SUCCESS;
+        }
+
+        entry.nt = cshark_node_init();
+        entry.nt->val = key;
+        entry.nt->name = value;
+        entry.segment = CCACHE_WINDOW;
+
+        // elements of unordered_map never move, so the node can point back to its entry
+        e = &shard->index.insert(make_pair(key, entry)).first->second;
+        e->nt->data = e;
+        this->link(shard, e, CCACHE_WINDOW);
+        shard->stats.inserts++;
+
+        request = false;
+        if (!this->async_evict or shard->index.size() > 2 * shard->max_entries)
+        {
+            this->maintain(shard);
+        }
+        else if (shard->index.size() > shard->max_entries)
+        {
+            request = true;
+        }
+    }
+
+    if (request)
+    {
+        this->request_evict(shard);
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Remove an entry
+ * @return \0 on success, or ERROR_NOT_FOUND if the key is not cached
+ */
+CODESHARK_INLINE int ConcurrentCache::erase(int key)
+{
+    ccache_shard_t *shard = this->get_shard(_cshark_ccache_hash(key));
+    unordered_map<int, ccache_entry_t>::iterator it;
+    lock_guard<mutex> guard(shard->lock);
+
+    it = shard->index.find(key);
+    if (it == shard->index.end())
+    {
+        return ERROR_NOT_FOUND;
+    }
+
+    this->remove(shard, it);
+    return SUCCESS;
+}
+
+/**
+ * Apply all recorded reads and evict down to max_entries now, on the calling thread
+ */
+CODESHARK_INLINE void ConcurrentCache::cleanup()
+{
+    size_t i;
+
+    for (i = 0; i < this->shards.size(); i++)
+    {
+        lock_guard<mutex> guard(this->shards[i]->lock);
+        this->drain(this->shards[i].get());
+        this->maintain(this->shards[i].get());
+    }
+}
+
+/**
+ * Remove all entries and forget recorded frequencies; counters are kept
+ */
+CODESHARK_INLINE void ConcurrentCache::clear()
+{
+    ccache_shard_t *shard;
+    cshark_node_t *nt;
+    cshark_node_t *next;
+    size_t i;
+    int k;
+
+    for (i = 0; i < this->shards.size(); i++)
+    {
+        shard = this->shards[i].get();
+        lock_guard<mutex> guard(shard->lock);
+
+        for (k = 0; k < CCACHE_READ_BUFFERS; k++)
+        {
+            shard->buffers[k].count.store(0, memory_order_relaxed);
+        }
+
+        for (k = 0; k < 3; k++)
+        {
+            for (nt = shard->lists[k]->next; nt != shard->lists[k]; nt = next)
+            {
+                next = nt->next;
+                cshark_node_free(nt);
+            }
+            shard->lists[k]->prev = shard->lists[k];
+            shard->lists[k]->next = shard->lists[k];
+            shard->list_sizes[k] = 0;
+        }
+
+        shard->index.clear();
+        shard->sketch->clear();
+    }
+}
+
+/**
+ * Get the counters of all shards; evictions include new entries rejected by admission
+ */
+CODESHARK_INLINE cshark_cache_stats_t ConcurrentCache::get_stats()
+{
+    cshark_cache_stats_t stats;
+    size_t i;
+
+    stats.hits = 0;
+    stats.misses = 0;
+    stats.inserts = 0;
+    stats.evictions = 0;
+
+    for (i = 0; i < this->shards.size(); i++)
+    {
+        lock_guard<mutex> guard(this->shards[i]->lock);
+        stats.hits += this->shards[i]->stats.hits;
+        stats.misses += this->shards[i]->stats.misses;
+        stats.inserts += this->shards[i]->stats.inserts;
+        stats.evictions += this->shards[i]->stats.evictions;
+    }
+
+    return stats;
+}
+
+CODESHARK_INLINE void ConcurrentCache::reset_stats()
+{
+    size_t i;
+
+    for (i = 0; i < this->shards.size(); i++)
+    {
+        lock_guard<mutex> guard(this->shards[i]->lock);
+        this->shards[i]->stats.hits = 0;
+        this->shards[i]->stats.misses = 0;
+        this->shards[i]->stats.inserts = 0;
+        this->shards[i]->stats.evictions = 0;
+    }
+}
+
+#endif //CODESHARK_CONCURRENT_CACHE_INL_H
@@ -0,0 +1,486 @@
+/*
+ ============================================================================
+ Name        : flat_map.h
+ Description : sorted flat map and set of int keys
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_FLAT_MAP_H
+#define CODESHARK_FLAT_MAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "common/include/common.h"
+#include "common/include/err.h"
+#include "algorithms/include/sort_impl.h"
+
+using namespace std;
+
+#define FLAT_MAP_SIMD_WINDOW    16      // keys compared at once with SIMD when a search narrows to them
+
+/**
+ * Lower bound of a key in a sorted array, without branches on the keys: each step moves the base
+ * by a conditional move, so there are no mispredictions, and the loop runs log2(n) steps always.
+ * @return index of the first element not less than key, or n
+ */
+inline size_t cshark_lower_bound_branchless(const int *a, size_t n, int key)
+{
+    const int *base = a;
+    size_t half;
+
+    if (n == 0)
+    {
+        return 0;
+    }
+
+    while (n > 1)
+    {
+        half = n / 2;
+        base = (base[half] < key) ? base + half : base;
+        n -= half;
+    }
+
+    return (size_t)(base - a) + (*base < key);
+}
+
+/**
+ * Lower bound of a key in a sorted array: branchless steps until FLAT_MAP_SIMD_WINDOW keys are
+ * left, which lie in one or two cache lines, then SSE2 compares count the keys below the key.
+ * Without SSE2 it is cshark_lower_bound_branchless().
+ * @return index of the first element not less than key, or n
+ */
+inline size_t cshark_lower_bound_simd(const int *a, size_t n, int key)
+{
+#if defined(__SSE2__)
+    const int *base = a;
+    __m128i k = _mm_set1_epi32(key);
+    __m128i below = _mm_setzero_si128();
+    size_t half, i;
+    int lanes[4];
+    size_t count = 0;
+
+    while (n > FLAT_MAP_SIMD_WINDOW)
+    {
+        half = n / 2;
+        base = (base[half] < key) ? base + half : base;
+        n -= half;
+    }
+
+    // a compare gives -1 per lane below the key, so subtracting counts them
+    for (i = 0; i + 4 <= n; i += 4)
+    {
+        below = _mm_sub_epi32(below, _mm_cmplt_epi32(_mm_loadu_si128((const __m128i *)(base + i)), k));
+    }
+    for (; i < n; i++)
+    {
+        count += (base[i] < key);
+    }
+
+    _mm_storeu_si128((__m128i *)lanes, below);
+    return (size_t)(base - a) + count + lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#else
+    return cshark_lower_bound_branchless(a, n, key);
+#endif
+}
+
+/**
+ * Lower bound of a key in an array of n keys in Eytzinger (BFS) order from index 1: the children
+ * of node k are 2k and 2k+1. The top levels share cache lines and stay cached, and the 16
+ * descendants 4 levels down share a line, which is prefetched while the levels between are read.
+ * @return node of the first key not less than key, or 0 if there is none
+ */
+inline size_t cshark_eytzinger_lower_bound(const int *e, size_t n, int key)
+{
+    size_t k = 1;
+
+    while (k <= n)
+    {
+        CSHARK_PREFETCH(e + 16 * k);
+        k = 2 * k + (e[k] < key);
+    }
+
+    // the path turned right at each key below the key; undo the right turns and the last left one
+    return k >> __builtin_ffsll(~(long long)k);
+}
+
+/**
+ * Get the node of the smallest key of an Eytzinger array, or 0 if it is empty
+ */
+inline size_t cshark_eytzinger_first(size_t n)
+{
+    size_t k = 1;
+
+    if (n == 0)
+    {
+        return 0;
+    }
+
+    while (2 * k <= n)
+    {
+        k = 2 * k;
+    }
+    return k;
+}
+
+/**
+ * Get the node of the next key in order: the leftmost node of the right subtree, or the lowest
+ * ancestor whose left subtree holds k
+ * @return next node, or 0 after the largest key
+ */
+inline size_t cshark_eytzinger_next(size_t k, size_t n)
+{
+    if (2 * k + 1 <= n)
+    {
+        k = 2 * k + 1;
+        while (2 * k <= n)
+        {
+            k = 2 * k;
+        }
+        return k;
+    }
+
+    return k >> __builtin_ffsll(~(long long)k);
+}
+
+/**
+ * @struct cshark_flat_no_value is the value type of FlatSet; it takes no memory per key
+ */
+struct cshark_flat_no_value
+{
+};
+
+/**
+ * @class _cshark_flat_values holds the values of a FlatMap, parallel to its keys
+ */
+template <typename V>
+class _cshark_flat_values
+{
+private:
+    vector<V> items;
+
+public:
+    void resize(size_t n) { this->items.resize(n); }
+    void shrink() { this->items.shrink_to_fit(); }
+    void set(size_t i, const V &v) { this->items[i] = v; }
+    V &at(size_t i) { return this->items[i]; }
+    const V &at(size_t i) const { return this->items[i]; }
+    void swap(_cshark_flat_values &other) { this->items.swap(other.items); }
+    size_t get_memory() const { return this->items.capacity() * sizeof(V); }
+};
+
+template <>
+class _cshark_flat_values<cshark_flat_no_value>
+{
+private:
+    cshark_flat_no_value none;
+
+public:
+    void resize(size_t) {}
+    void shrink() {}
+    void set(size_t, const cshark_flat_no_value &) {}
+    cshark_flat_no_value &at(size_t) { return this->none; }
+    const cshark_flat_no_value &at(size_t) const { return this->none; }
+    void swap(_cshark_flat_values &) {}
+    size_t get_memory() const { return 0; }
+};
+
+/**
+ * @class FlatMap maps int keys to values in two sorted arrays, for read-mostly data: a lookup
+ *        is a binary search of contiguous keys, and a range is a linear scan, with no node,
+ *        pointer or empty slot per entry.
+ *
+ *      keys    |  3  |  8  | 17  | 42  | 95  |
+ *      values  | v3  | v8  | v17 | v42 | v95 |
+ *
+ * Entries are added in batches: a batch is sorted with cshark_pdqsort() and merged with the
+ * arrays in one pass, O(n + m) instead of O(n) per key. For a single key that is no better than
+ * a sorted vector; build once, or batch updates.
+ *
+ * set_eytzinger(true) reorders both arrays into Eytzinger order, a binary tree in level order
+ * (see cshark_eytzinger_lower_bound()). Lookups of large maps then miss the cache less, as the
+ * top of the tree stays cached and lower levels are prefetched. Ranges and for_each() still run
+ * in key order, walking the tree by index instead of scanning.
+ *
+ * Pointers to values stay valid until the next insert_batch(), set_eytzinger() or clear().
+ * V must be default-constructible and copy-assignable.
+ */
+template <typename V>
+class FlatMap
+{
+private:
+    vector<int> keys;                   // sorted, or in Eytzinger order from index 1
+    _cshark_flat_values<V> values;      // values of keys at the same index
+    size_t count;
+    bool eytzinger;
+
+    /**
+     * Move keys and values between sorted and Eytzinger order
+     */
+    void relayout(bool to_eytzinger)
+    {
+        vector<int> keys(this->count + (to_eytzinger ? 1 : 0));
+        _cshark_flat_values<V> values;
+        size_t i, k;
+
+        values.resize(keys.size());
+        k = cshark_eytzinger_first(this->count);
+        for (i = 0; i < this->count; i++)
+        {
+            if (to_eytzinger)
+            {
+                keys[k] = this->keys[i];
+                values.set(k, this->values.at(i));
+            }
+            else
+            {
+                keys[i] = this->keys[k];
+                values.set(i, this->values.at(k));
+            }
+            k = cshark_eytzinger_next(k, this->count);
+        }
+
+        this->keys.swap(keys);
+        this->values.swap(values);
+        this->eytzinger = to_eytzinger;
+    }
+
+    /**
+     * Find the index of the first key not less than key
+     * @return index, or get_end() if there is none
+     */
+    size_t lower_bound(int key) const
+    {
+        if (this->eytzinger)
+        {
+            return cshark_eytzinger_lower_bound(this->keys.data(), this->count, key);
+        }
+        return cshark_lower_bound_simd(this->keys.data(), this->count, key);
+    }
+
+    size_t get_begin() const
+    {
+        return this->eytzinger ? cshark_eytzinger_first(this->count) : 0;
+    }
+
+    size_t get_end() const
+    {
+        return this->eytzinger ? 0 : this->count;
+    }
+
+    size_t get_next(size_t i) const
+    {
+        return this->eytzinger ? cshark_eytzinger_next(i, this->count) : i + 1;
+    }
+
+public:
+    FlatMap() : count(0), eytzinger(false) {}
+
+    size_t get_size() const { return this->count; }
+    bool is_empty() const { return this->count == 0; }
+    bool is_eytzinger() const { return this->eytzinger; }
+
+    void clear()
+    {
+        vector<int>().swap(this->keys);
+        _cshark_flat_values<V>().swap(this->values);
+        this->count = 0;
+    }
+
+    /**
+     * Build the map from unsorted entries, replacing its contents
+     * @param keys [in] keys, in any order
+     * @param values [in] value of each key; \NULL gives default values, e.g., for FlatSet
+     * @param n [in] number of entries
+     * @return \0 on success, or ERROR_PARAM
+     */
+    int build(const int *keys, const V *values, size_t n)
+    {
+        this->clear();
+        return this->insert_batch(keys, values, n);
+    }
+
+    /**
+     * Add or update a batch of entries by sorting it and merging it with the map.
+     * A key already in the map gets the new value; of equal keys in a batch, the last one wins.
+     * @param keys [in] keys, in any order
+     * @param values [in] value of each key; \NULL gives default values, e.g., for FlatSet
+     * @param n [in] number of entries
+     * @return \0 on success, or ERROR_PARAM
+     */
+    int insert_batch(const int *keys, const V *values, size_t n)
+    {
+        vector<pair<int, size_t>> batch(n);
+        vector<int> merged_keys;
+        _cshark_flat_values<V> merged_values;
+        bool eytzinger = this->eytzinger;
+        size_t i, j, m;
+
+        if (keys == NULL and n > 0)
+        {
+            return ERROR_PARAM;
+        }
+        if (n == 0)
+        {
+            return SUCCESS;
+        }
+
+        // sorting (key, position) pairs puts equal keys of the batch in input order
+        for (i = 0; i < n; i++)
+        {
+            batch[i] = make_pair(keys[i], i);
+        }
+        cshark_pdqsort(batch.begin(), batch.end(), less<pair<int, size_t>>());
+
+        if (eytzinger)
+        {
+            this->relayout(false);
+        }
+
+        merged_keys.resize(this->count + n);
+        merged_values.resize(this->count + n);
+        i = 0;
+        j = 0;
+        m = 0;
+        while (i < this->count or j < n)
+        {
+            if (j + 1 < n and batch[j + 1].first == batch[j].first)
+            {
+                j++;
+                continue;
+            }
+
+            if (j == n or (i < this->count and this->keys[i] < batch[j].first))
+            {
+                merged_keys[m] = this->keys[i];
+                merged_values.set(m, this->values.at(i));
+                i++;
+            }
+            else
+            {
+                if (i < this->count and this->keys[i] == batch[j].first)
+                {
+                    i++;
+                }
+                merged_keys[m] = batch[j].first;
+                merged_values.set(m, (values == NULL) ? V() : values[batch[j].second]);
+                j++;
+            }
+            m++;
+        }
+
+        // replaced keys leave spare room at the end, which is given back
+        merged_keys.resize(m);
+        merged_values.resize(m);
+        if (m < this->count + n)
+        {
+            merged_keys.shrink_to_fit();
+            merged_values.shrink();
+        }
+
+        this->keys.swap(merged_keys);
+        this->values.swap(merged_values);
+        this->count = m;
+
+        if (eytzinger)
+        {
+            this->relayout(true);
+        }
+        return SUCCESS;
+    }
+
+    /**
+     * Reorder the map for lookups (Eytzinger order) or back to sorted order, in O(n)
+     */
+    void set_eytzinger(bool on)
+    {
+        if (on != this->eytzinger)
+        {
+            this->relayout(on);
+        }
+    }
+
+    /**
+     * Find the value of a key
+     * @return value, or \NULL if the key is not in the map
+     */
+    const V *find(int key) const
+    {
+        size_t i = this->lower_bound(key);
+
+        if (i == this->get_end() or this->keys[i] != key)
+        {
+            return NULL;
+        }
+        return &this->values.at(i);
+    }
+
+    V *find(int key)
+    {
+        return const_cast<V *>(static_cast<const FlatMap *>(this)->find(key));
+    }
+
+    bool contains(int key) const
+    {
+        return this->find(key) != NULL;
+    }
+
+    /**
+     * Visit the entries of keys in [lo, hi) in key order
+     * @param fn [in] function called as fn(key, value)
+     * @return number of entries visited
+     */
+    template <typename Fn>
+    size_t for_each_range(int lo, int hi, Fn fn) const
+    {
+        size_t i, n = 0;
+
+        for (i = this->lower_bound(lo); i != this->get_end() and this->keys[i] < hi; i = this->get_next(i))
+        {
+            fn(this->keys[i], this->values.at(i));
+            n++;
+        }
+        return n;
+    }
+
+    /**
+     * Visit all entries in key order
+     * @param fn [in] function called as fn(key, value)
+     */
+    template <typename Fn>
+    void for_each(Fn fn) const
+    {
+        size_t i;
+
+        for (i = this->get_begin(); i != this->get_end(); i = this->get_next(i))
+        {
+            fn(this->keys[i], this->values.at(i));
+        }
+    }
+
+    /**
+     * Get the bytes of the keys and values
+     */
+    size_t get_memory() const
+    {
+        return this->keys.capacity() * sizeof(int) + this->values.get_memory();
+    }
+};
+
+/**
+ * @class FlatSet is a FlatMap of keys only; pass \NULL values to build() and insert_batch(),
+ *        and for_each() calls fn(key, cshark_flat_no_value)
+ */
+typedef FlatMap<cshark_flat_no_value> FlatSet;
+
+#endif //CODESHARK_FLAT_MAP_H
@@ -0,0 +1,76 @@
+/*
+ ============================================================================
+ Name        : graph.h
+ Description : graph header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_GRAPH_H
+#define CODESHARK_GRAPH_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define GRAPH_INF            INT64_MAX   // distance of unreachable vertices in Dijkstra
+#define GRAPH_UNREACHED      (-1)        // BFS level of unreachable vertices
+
+/**
+ * @struct cshark_edge_t
+ * An edge of the input edge list
+ */
+typedef struct _cshark_edge_t
+{
+    uint32_t src;
+    uint32_t dst;
+    int weight;
+}cshark_edge_t;
+
+/**
+ * @struct cshark_graph_t
+ * Graph in compressed sparse row (CSR) form: the out-edges of vertex v are
+ * targets[offsets[v]] ... targets[offsets[v + 1] - 1], with weights at the same indexes.
+ * Edges of a vertex are contiguous in memory, so traversals stream through arrays
+ * instead of chasing a pointer per edge.
+ *
+ * In-edges are stored in the same form (in_offsets, in_sources) for bottom-up BFS;
+ * for undirected graphs they are the out-edges, and share the arrays.
+ *
+ *      vertices: 0 -> 1, 0 -> 2, 2 -> 1
+ *      offsets:  [0, 2, 2, 3]
+ *      targets:  [1, 2, 1]
+ */
+typedef struct _cshark_graph_t
+{
+    size_t n_vertices;
+    size_t n_edges;             // stored edges; an undirected edge is stored in both directions
+    bool directed;
+
+    size_t *offsets;            // n_vertices + 1
+    uint32_t *targets;          // n_edges
+    int *weights;               // n_edges
+
+    size_t *in_offsets;         // n_vertices + 1
+    uint32_t *in_sources;       // n_edges
+}cshark_graph_t;
+
+// Graph functions
+
+cshark_graph_t *cshark_graph_build(size_t n_vertices, const cshark_edge_t *edges, size_t n_edges, bool directed);
+int cshark_graph_destroy(cshark_graph_t *g);
+size_t cshark_graph_degree(cshark_graph_t *g, uint32_t v);
+
+int cshark_graph_bfs(cshark_graph_t *g, uint32_t src, int *levels);
+int cshark_graph_bfs_parallel(cshark_graph_t *g, uint32_t src, int *levels, size_t threads);
+int cshark_graph_dfs(cshark_graph_t *g, uint32_t src, uint32_t *order, size_t *n);
+int cshark_graph_components(cshark_graph_t *g, uint32_t *labels, size_t *n_components);
+int cshark_graph_dijkstra(cshark_graph_t *g, uint32_t src, int64_t *dist);
+int cshark_graph_toposort(cshark_graph_t *g, uint32_t *order);
+
+#ifdef CODESHARK_HEADER_ONLY
+#include "datastructures/include/graph_inl.h"
+#endif
+
+#endif //CODESHARK_GRAPH_H
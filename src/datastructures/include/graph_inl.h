@@ -0,0 +1,636 @@
+/*
+ ============================================================================
+ Name        : graph_inl.h
+ Description : graph inline implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_GRAPH_INL_H
+#define CODESHARK_GRAPH_INL_H
+
+#include <string.h>
+#include <atomic>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "common/include/common.h"
+#include "common/include/err.h"
+#include "common/include/bitmap.h"
+#include "common/include/task_pool.h"
+#include "datastructures/include/graph.h"
+
+#define GRAPH_BFS_ALPHA          15      // switch to bottom-up when frontier edges > unexplored edges / ALPHA
+#define GRAPH_BFS_BETA           18      // switch back to top-down when frontier < vertices / BETA
+#define GRAPH_BFS_QUEUE_GRAIN    1024    // frontier vertices per top-down task
+#define GRAPH_BFS_VERTEX_GRAIN   4096    // vertices per bottom-up task, a multiple of BITMAP_WORD_BITS
+
+/**
+ * Fill one CSR direction from an edge list by counting sort on the source vertex;
+ * edges of a vertex keep their input order.
+ * @param reverse [in] index edges by dst instead of src
+ * @param both [in] store every edge in both directions (undirected)
+ * @param weights [out] edge weights, or \NULL to skip them
+ */
+CODESHARK_INLINE void _cshark_graph_fill_csr(size_t n, const cshark_edge_t *edges, size_t n_edges,
+                                             bool reverse, bool both,
+                                             size_t *offsets, uint32_t *adj, int *weights)
+{
+    size_t i, v, sum, deg, pos;
+    uint32_t from, to;
+
+    memset(offsets, 0, (n + 1) * sizeof(size_t));
+    for (i = 0; i < n_edges; i++)
+    {
+        offsets[reverse ? edges[i].dst : edges[i].src]++;
+        if (both)
+        {
+            offsets[edges[i].dst]++;
+        }
+    }
+
+    // exclusive prefix sum; offsets[v] is then used as the insert cursor of v
+    sum = 0;
+    for (v = 0; v < n; v++)
+    {
+        deg = offsets[v];
+        offsets[v] = sum;
+        sum += deg;
+    }
+    offsets[n] = sum;
+
+    for (i = 0; i < n_edges; i++)
+    {
+        from = reverse ? edges[i].dst : edges[i].src;
+        to = reverse ? edges[i].src : edges[i].dst;
+
+        pos = offsets[from]++;
+        adj[pos] = to;
+        if (weights != NULL)
+        {
+            weights[pos] = edges[i].weight;
+        }
+
+        if (both)
+        {
+            pos = offsets[to]++;
+            adj[pos] = from;
+            if (weights != NULL)
+            {
+                weights[pos] = edges[i].weight;
+            }
+        }
+    }
+
+    // cursors ended at the start of the next vertex: shift them back
+    for (v = n; v > 0; v--)
+    {
+        offsets[v] = offsets[v - 1];
+    }
+    offsets[0] = 0;
+}
+
+/**
+ * Build a graph from an edge list
+ * Time complexity: O(V + E), two passes over the edges
+ * @param n_vertices [in] number of vertices, ids are [0, n_vertices)
+ * @param edges [in] edge list
+ * @param n_edges [in] number of edges
+ * @param directed [in] \false to add every edge in both directions
+ * @return graph, or \NULL on invalid edges
+ */
+CODESHARK_INLINE cshark_graph_t *cshark_graph_build(size_t n_vertices, const cshark_edge_t *edges, size_t n_edges, bool directed)
+{
+    cshark_graph_t *g;
+    size_t i;
+
+    if ((edges == NULL and n_edges > 0) or n_vertices > UINT32_MAX)
+    {
+        return NULL;
+    }
+
+    for (i = 0; i < n_edges; i++)
+    {
+        if (edges[i].src >= n_vertices or edges[i].dst >= n_vertices)
+        {
+            return NULL;
+        }
+    }
+
+    g = new cshark_graph_t();
+    g->n_vertices = n_vertices;
+    g->n_edges = directed ? n_edges : 2 * n_edges;
+    g->directed = directed;
+
+    g->offsets = new size_t[n_vertices + 1];
+    g->targets = new uint32_t[g->n_edges];
+    g->weights = new int[g->n_edges];
+    _cshark_graph_fill_csr(n_vertices, edges, n_edges, false, !directed, g->offsets, g->targets, g->weights);
+
+    if (directed)
+    {
+        g->in_offsets = new size_t[n_vertices + 1];
+        g->in_sources = new uint32_t[g->n_edges];
+        _cshark_graph_fill_csr(n_vertices, edges, n_edges, true, false, g->in_offsets, g->in_sources, NULL);
+    }
+    else
+    {
+        g->in_offsets = g->offsets;
+        g->in_sources = g->targets;
+    }
+
+    return g;
+}
+
+/**
+ * Destroy a graph
+ * @param g [in] graph
+ * @return \0 on success, or other error code
+ */
+CODESHARK_INLINE int cshark_graph_destroy(cshark_graph_t *g)
+{
+    if (g == NULL)
+    {
+        return ERROR_PARAM;
+    }
+
+    if (g->in_offsets != g->offsets)
+    {
+        delete[](g->in_offsets);
+        delete[](g->in_sources);
+    }
+
+    delete[](g->offsets);
+    delete[](g->targets);
+    delete[](g->weights);
+    delete(g);
+
+    return SUCCESS;
+}
+
+/**
+ * Get the out-degree of a vertex
+ * @return out-degree, or 0 on invalid vertex
+ */
+CODESHARK_INLINE size_t cshark_graph_degree(cshark_graph_t *g, uint32_t v)
+{
+    if (g == NULL or v >= g->n_vertices)
+    {
+        return 0;
+    }
+
+    return g->offsets[v + 1] - g->offsets[v];
+}
+
+/**
+ * Breadth-first search
+ * @param g [in] graph
+ * @param src [in] source vertex
+ * @param levels [out] hops from src of every vertex, GRAPH_UNREACHED if unreachable
+ * @return \0 on success, or other error code
+ */
+CODESHARK_INLINE int cshark_graph_bfs(cshark_graph_t *g, uint32_t src, int *levels)
+{
+    cshark_bitmap_t visited;
+    uint32_t *queue;
+    size_t head, tail, e;
+    uint32_t u, v;
+
+    if (g == NULL or levels == NULL or src >= g->n_vertices)
+    {
+        return ERROR_PARAM;
+    }
+
+    cshark_bitmap_init(&visited, g->n_vertices);
+    queue = new uint32_t[g->n_vertices];
+
+    for (e = 0; e < g->n_vertices; e++)
+    {
+        levels[e] = GRAPH_UNREACHED;
+    }
+
+    head = 0;
+    tail = 0;
+    queue[tail++] = src;
+    cshark_bitmap_set(&visited, src);
+    levels[src] = 0;
+
+    while (head < tail)
+    {
+        u = queue[head++];
+        for (e = g->offsets[u]; e < g->offsets[u + 1]; e++)
+        {
+            v = g->targets[e];
+            if (!cshark_bitmap_test(&visited, v))
+            {
+                cshark_bitmap_set(&visited, v);
+                levels[v] = levels[u] + 1;
+                queue[tail++] = v;
+            }
+        }
+    }
+
+    delete[](queue);
+    cshark_bitmap_free(&visited);
+
+    return SUCCESS;
+}
+
+/**
+ * One top-down BFS step: every frontier vertex claims its unvisited out-neighbours
+ * @return sum of out-degrees of the new frontier
+ */
+CODESHARK_INLINE size_t _cshark_graph_bfs_top_down(cshark_graph_t *g, TaskPool *pool, cshark_bitmap_t *visited,
+                                                   int *levels, int depth,
+                                                   vector<uint32_t> &frontier, vector<uint32_t> &next)
+{
+    size_t n_chunks = (frontier.size() + GRAPH_BFS_QUEUE_GRAIN - 1) / GRAPH_BFS_QUEUE_GRAIN;
+    vector<vector<uint32_t>> locals(n_chunks);
+    atomic<size_t> scout(0);
+    size_t i;
+
+    pool->parallel_for(0, frontier.size(), GRAPH_BFS_QUEUE_GRAIN, [&](size_t b, size_t e) {
+        vector<uint32_t> &local = locals[b / GRAPH_BFS_QUEUE_GRAIN];
+        size_t local_scout = 0;
+        size_t i, k;
+        uint32_t u, v;
+
+        for (i = b; i < e; i++)
+        {
+            u = frontier[i];
+            for (k = g->offsets[u]; k < g->offsets[u + 1]; k++)
+            {
+                v = g->targets[k];
+                if (!cshark_bitmap_test_and_set_atomic(visited, v))
+                {
+                    levels[v] = depth + 1;
+                    local.push_back(v);
+                    local_scout += g->offsets[v + 1] - g->offsets[v];
+                }
+            }
+        }
+
+        scout.fetch_add(local_scout, memory_order_relaxed);
+    });
+
+    next.clear();
+    for (i = 0; i < n_chunks; i++)
+    {
+        next.insert(next.end(), locals[i].begin(), locals[i].end());
+    }
+
+    return scout.load();
+}
+
+/**
+ * One bottom-up BFS step: every unvisited vertex looks for a parent in the frontier,
+ * and stops at the first one found. Tasks own whole bitmap words, so bits are set without atomics.
+ * @return size of the new frontier
+ */
+CODESHARK_INLINE size_t _cshark_graph_bfs_bottom_up(cshark_graph_t *g, TaskPool *pool, cshark_bitmap_t *visited,
+                                                    int *levels, int depth,
+                                                    cshark_bitmap_t *front, cshark_bitmap_t *next)
+{
+    atomic<size_t> awake(0);
+
+    cshark_bitmap_clear_all(next);
+    pool->parallel_for(0, g->n_vertices, GRAPH_BFS_VERTEX_GRAIN, [&](size_t b, size_t e) {
+        size_t local_awake = 0;
+        size_t v, k;
+
+        for (v = b; v < e; v++)
+        {
+            if (cshark_bitmap_test(visited, v))
+            {
+                continue;
+            }
+
+            for (k = g->in_offsets[v]; k < g->in_offsets[v + 1]; k++)
+            {
+                if (cshark_bitmap_test(front, g->in_sources[k]))
+                {
+                    levels[v] = depth + 1;
+                    cshark_bitmap_set(visited, v);
+                    cshark_bitmap_set(next, v);
+                    local_awake++;
+                    break;
+                }
+            }
+        }
+
+        awake.fetch_add(local_awake, memory_order_relaxed);
+    });
+
+    return awake.load();
+}
+
+/**
+ * Direction-optimizing parallel breadth-first search (Beamer et al.).
+ * Top-down steps scan out-edges of the frontier; when the frontier has many edges, bottom-up
+ * steps scan in-edges of unvisited vertices instead and stop at the first parent found,
+ * which skips most edges of the large middle levels of low-diameter graphs.
+ * Both steps read CSR arrays sequentially and run on a work-stealing pool.
+ * @param g [in] graph
+ * @param src [in] source vertex
+ * @param levels [out] hops from src of every vertex, GRAPH_UNREACHED if unreachable
+ * @param threads [in] number of threads, 0 for all hardware threads
+ * @return \0 on success, or other error code
+ */
+CODESHARK_INLINE int cshark_graph_bfs_parallel(cshark_graph_t *g, uint32_t src, int *levels, size_t threads)
+{
+    cshark_bitmap_t visited, front, next;
+    vector<uint32_t> frontier, next_frontier;
+    size_t edges_to_check, scout, awake, prev_awake, v;
+    int depth = 0;
+
+    if (g == NULL or levels == NULL or src >= g->n_vertices)
+    {
+        return ERROR_PARAM;
+    }
+
+    TaskPool pool(threads);
+    cshark_bitmap_init(&visited, g->n_vertices);
+    cshark_bitmap_init(&front, g->n_vertices);
+    cshark_bitmap_init(&next, g->n_vertices);
+
+    for (v = 0; v < g->n_vertices; v++)
+    {
+        levels[v] = GRAPH_UNREACHED;
+    }
+
+    levels[src] = 0;
+    cshark_bitmap_set(&visited, src);
+    frontier.push_back(src);
+
+    edges_to_check = g->n_edges;
+    scout = cshark_graph_degree(g, src);
+
+    while (!frontier.empty())
+    {
+        if (scout > edges_to_check / GRAPH_BFS_ALPHA)
+        {
+            cshark_bitmap_clear_all(&front);
+            for (v = 0; v < frontier.size(); v++)
+            {
+                cshark_bitmap_set(&front, frontier[v]);
+            }
+
+            // stay bottom-up while the frontier grows or is still large
+            awake = frontier.size();
+            do
+            {
+                prev_awake = awake;
+                awake = _cshark_graph_bfs_bottom_up(g, &pool, &visited, levels, depth, &front, &next);
+                swap(front, next);
+                depth++;
+            } while (awake >= prev_awake or awake > g->n_vertices / GRAPH_BFS_BETA);
+
+            frontier.clear();
+            for (v = 0; v < g->n_vertices; v++)
+            {
+                if (cshark_bitmap_test(&front, v))
+                {
+                    frontier.push_back(v);
+                }
+            }
+            scout = 1;
+        }
+        else
+        {
+            edges_to_check -= scout < edges_to_check ? scout : edges_to_check;
+            scout = _cshark_graph_bfs_top_down(g, &pool, &visited, levels, depth, frontier, next_frontier);
+            frontier.swap(next_frontier);
+            depth++;
+        }
+    }
+
+    cshark_bitmap_free(&visited);
+    cshark_bitmap_free(&front);
+    cshark_bitmap_free(&next);
+
+    return SUCCESS;
+}
+
+/**
+ * Depth-first search in preorder, with an explicit stack instead of recursion,
+ * so deep graphs cannot overflow the call stack
+ * @param g [in] graph
+ * @param src [in] source vertex
+ * @param order [out] visited vertices in preorder, capacity of n_vertices
+ * @param n [out] number of visited vertices
+ * @return \0 on success, or other error code
+ */
+CODESHARK_INLINE int cshark_graph_dfs(cshark_graph_t *g, uint32_t src, uint32_t *order, size_t *n)
+{
+    vector<pair<uint32_t, size_t>> stack;     // vertex, next edge to explore
+    cshark_bitmap_t visited;
+    size_t count = 0;
+    uint32_t u, v;
+
+    if (g == NULL or order == NULL or n == NULL or src >= g->n_vertices)
+    {
+        return ERROR_PARAM;
+    }
+
+    cshark_bitmap_init(&visited, g->n_vertices);
+
+    cshark_bitmap_set(&visited, src);
+    order[count++] = src;
+    stack.push_back(make_pair(src, g->offsets[src]));
+
+    while (!stack.empty())
+    {
+        u = stack.back().first;
+        if (stack.back().second == g->offsets[u + 1])
+        {
+            stack.pop_back();
+            continue;
+        }
+
+        v = g->targets[stack.back().second++];
+        if (!cshark_bitmap_test(&visited, v))
+        {
+            cshark_bitmap_set(&visited, v);
+            order[count++] = v;
+            stack.push_back(make_pair(v, g->offsets[v]));
+        }
+    }
+
+    *n = count;
+    cshark_bitmap_free(&visited);
+
+    return SUCCESS;
+}
+
+CODESHARK_INLINE uint32_t _cshark_graph_find_root(vector<uint32_t> &parent, uint32_t v)
+{
+    while (parent[v] != v)
+    {
+        parent[v] = parent[parent[v]];    // path halving
+        v = parent[v];
+    }
+
+    return v;
+}
+
+/**
+ * Connected components by union-find over the edge arrays; for directed graphs
+ * these are weakly connected components
+ * @param g [in] graph
+ * @param labels [out] component of every vertex, numbered from 0 in order of the lowest vertex
+ * @param n_components [out] number of components
+ * @return \0 on success, or other error code
+ */
+CODESHARK_INLINE int cshark_graph_components(cshark_graph_t *g, uint32_t *labels, size_t *n_components)
+{
+    size_t u, e, count;
+    uint32_t ru, rv;
+
+    if (g == NULL or labels == NULL or n_components == NULL)
+    {
+        return ERROR_PARAM;
+    }
+
+    vector<uint32_t> parent(g->n_vertices);
+    for (u = 0; u < g->n_vertices; u++)
+    {
+        parent[u] = (uint32_t)u;
+    }
+
+    for (u = 0; u < g->n_vertices; u++)
+    {
+        for (e = g->offsets[u]; e < g->offsets[u + 1]; e++)
+        {
+            ru = _cshark_graph_find_root(parent, (uint32_t)u);
+            rv = _cshark_graph_find_root(parent, g->targets[e]);
+            if (ru != rv)
+            {
+                // the smaller root wins, so every root is the lowest vertex of its component
+                parent[ru > rv ? ru : rv] = ru > rv ? rv : ru;
+            }
+        }
+    }
+
+    count = 0;
+    for (u = 0; u < g->n_vertices; u++)
+    {
+        ru = _cshark_graph_find_root(parent, (uint32_t)u);
+        labels[u] = (ru == u) ? (uint32_t)count++ : labels[ru];
+    }
+
+    *n_components = count;
+
+    return SUCCESS;
+}
+
+/**
+ * Single-source shortest paths by Dijkstra with a binary heap
+ * Time complexity: O((V + E)logV)
+ * @param g [in] graph with non-negative weights
+ * @param src [in] source vertex
+ * @param dist [out] distance of every vertex, GRAPH_INF if unreachable
+ * @return \0 on success, or other error code, e.g., on negative weights
+ */
+CODESHARK_INLINE int cshark_graph_dijkstra(cshark_graph_t *g, uint32_t src, int64_t *dist)
+{
+    typedef pair<int64_t, uint32_t> item_t;
+    priority_queue<item_t, vector<item_t>, greater<item_t>> heap;
+    size_t v, e;
+    int64_t d;
+    uint32_t u;
+
+    if (g == NULL or dist == NULL or src >= g->n_vertices)
+    {
+        return ERROR_PARAM;
+    }
+
+    for (e = 0; e < g->n_edges; e++)
+    {
+        if (g->weights[e] < 0)
+        {
+            return ERROR_PARAM;
+        }
+    }
+
+    for (v = 0; v < g->n_vertices; v++)
+    {
+        dist[v] = GRAPH_INF;
+    }
+
+    dist[src] = 0;
+    heap.push(make_pair((int64_t)0, src));
+
+    while (!heap.empty())
+    {
+        d = heap.top().first;
+        u = heap.top().second;
+        heap.pop();
+
+        // stale entry: u was settled with a shorter distance (lazy deletion)
+        if (d > dist[u])
+        {
+            continue;
+        }
+
+        for (e = g->offsets[u]; e < g->offsets[u + 1]; e++)
+        {
+            if (d + g->weights[e] < dist[g->targets[e]])
+            {
+                dist[g->targets[e]] = d + g->weights[e];
+                heap.push(make_pair(dist[g->targets[e]], g->targets[e]));
+            }
+        }
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Topological sort by Kahn's algorithm; in-degrees come from the in-edge offsets
+ * @param g [in] directed graph
+ * @param order [out] vertices in topological order, capacity of n_vertices
+ * @return \0 on success, ERROR_CYCLE if the graph has a cycle, or other error code
+ */
+CODESHARK_INLINE int cshark_graph_toposort(cshark_graph_t *g, uint32_t *order)
+{
+    size_t head, tail, v, e;
+    uint32_t u;
+
+    if (g == NULL or order == NULL or !g->directed)
+    {
+        return ERROR_PARAM;
+    }
+
+    vector<size_t> indegree(g->n_vertices);
+
+    // order[] is the queue: vertices are appended when their in-degree drops to 0
+    tail = 0;
+    for (v = 0; v < g->n_vertices; v++)
+    {
+        indegree[v] = g->in_offsets[v + 1] - g->in_offsets[v];
+        if (indegree[v] == 0)
+        {
+            order[tail++] = (uint32_t)v;
+        }
+    }
+
+    for (head = 0; head < tail; head++)
+    {
+        u = order[head];
+        for (e = g->offsets[u]; e < g->offsets[u + 1]; e++)
+        {
+            if (--indegree[g->targets[e]] == 0)
+            {
+                order[tail++] = g->targets[e];
+            }
+        }
+    }
+
+    return tail == g->n_vertices ? SUCCESS : ERROR_CYCLE;
+}
+
+#endif //CODESHARK_GRAPH_INL_H
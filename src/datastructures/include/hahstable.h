@@ -11,10 +11,12 @@
 #ifndef CODESHARK_HAHSTABLE_H
 #define CODESHARK_HAHSTABLE_H
 
+#include "common/include/node_iterator.h"
 #include "datastructures/include/linklist.h"
 
 #define MAX_HASH_SLOTS 597
 #define HASH_NOT_FOUND "hash_not_found"
+#define HASH_BATCH_GROUP 16         // lookups in flight in hashtable_find_batch()
 
 // hash table is a list of cshark_linklist_t
 typedef struct _hashtable_t
@@ -22,13 +24,84 @@ typedef struct _hashtable_t
     cshark_linklist_t *slots[MAX_HASH_SLOTS];
 }hashtable_t;
 
+/**
+ * @class hashtable_iterator is a forward iterator over entries of a hash table, slot by slot.
+ *        An entry is a node with the key in val and the value in name; name may be changed,
+ *        val must not.
+ */
+class hashtable_iterator
+{
+private:
+    hashtable_t *ht;
+    size_t slot;
+    cshark_node_t *nt;
+
+    // move to the first entry from the current slot on, or to end()
+    void skip_empty_slots()
+    {
+        while (this->nt == NULL and ++this->slot < MAX_HASH_SLOTS)
+        {
+            this->nt = this->ht->slots[this->slot]->head->next;
+        }
+    }
+
+public:
+    typedef forward_iterator_tag iterator_category;
+    typedef cshark_node_t value_type;
+    typedef ptrdiff_t difference_type;
+    typedef cshark_node_t *pointer;
+    typedef cshark_node_t &reference;
+
+    hashtable_iterator() : ht(NULL), slot(MAX_HASH_SLOTS), nt(NULL) {}
+
+    // iterator to the first entry at or after a slot
+    hashtable_iterator(hashtable_t *table, size_t first_slot) : ht(table), slot(first_slot), nt(NULL)
+    {
+        if (this->slot < MAX_HASH_SLOTS)
+        {
+            this->nt = this->ht->slots[this->slot]->head->next;
+            this->skip_empty_slots();
+        }
+    }
+
+    reference operator*() const { return *this->nt; }
+    pointer operator->() const { return this->nt; }
+
+    hashtable_iterator &operator++()
+    {
+        this->nt = this->nt->next;
+        this->skip_empty_slots();
+        return *this;
+    }
+
+    hashtable_iterator operator++(int)
+    {
+        hashtable_iterator it = *this;
+        ++(*this);
+        return it;
+    }
+
+    bool operator==(const hashtable_iterator &other) const { return this->nt == other.nt; }
+    bool operator!=(const hashtable_iterator &other) const { return this->nt != other.nt; }
+};
+
 // Hash table functions
 
 hashtable_t *hashtable_init();
 int hashtable_destroy(hashtable_t *ht);
 string hashtable_find(hashtable_t *ht, int k);
+const string *hashtable_find_ref(hashtable_t *ht, int k);
+bool hashtable_contains(hashtable_t *ht, int k);
+size_t hashtable_find_batch(hashtable_t *ht, const int *keys, size_t n, string *out);
 int hashtable_add(hashtable_t *ht, int k, string val);
-int hashtable_delete(int val);
+int hashtable_delete(hashtable_t *ht, int k);
+hashtable_iterator hashtable_begin(hashtable_t *ht);
+hashtable_iterator hashtable_end(hashtable_t *ht);
+cshark_range<hashtable_iterator> hashtable_entries(hashtable_t *ht);
+
 
+#ifdef CODESHARK_HEADER_ONLY
+#include "datastructures/include/hashtable_inl.h"
+#endif
 
 #endif //CODESHARK_HAHSTABLE_H
@@ -0,0 +1,311 @@
+/*
+ ============================================================================
+ Name        : hashtable_inl.h
+ Description : hashtable inline implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_HASHTABLE_INL_H
+#define CODESHARK_HASHTABLE_INL_H
+
+#include "common/include/common.h"
+#include "common/include/err.h"
+#include "common/include/stats.h"
+#include "datastructures/include/hahstable.h"
+#include "datastructures/include/linklist.h"
+
+/**
+ * Initialize a new hash table
+ * @return hashtable
+ */
+CODESHARK_INLINE hashtable_t *hashtable_init()
+{
+    hashtable_t *ht;
+    int i;
+
+    ht = new hashtable_t();
+
+    for (i = 0; i < MAX_HASH_SLOTS; i++)
+    {
+        ht->slots[i] = cshark_linklist_init(0);
+    }
+
+    return ht;
+}
+
+
+/**
+ * Destroy a hash table
+ * @param ht [in] hashtable
+ * @return \0 on success, or other error code
+ */
+CODESHARK_INLINE int hashtable_destroy(hashtable_t *ht)
+{
+    int i;
+
+    if (ht == NULL)
+    {
+        return ERROR_PARAM;
+    }
+
+    for (i = 0; i < MAX_HASH_SLOTS; i++)
+    {
+        cshark_linklist_destroy(ht->slots[i]);
+    }
+
+    delete(ht);
+    return SUCCESS;
+}
+
+/**
+ * Get the slot of a key; negative keys are taken as unsigned, so they never index out of slots
+ */
+inline size_t _cshark_hashtable_slot(int key)
+{
+    return (size_t)((unsigned int)key % MAX_HASH_SLOTS);
+}
+
+/**
+ * Find the entry of a key
+ * @return entry node, or \NULL if not found
+ */
+inline cshark_node_t *_cshark_hashtable_lookup(hashtable_t *ht, int key)
+{
+    cshark_node_t *nt;
+    size_t probe;
+
+    CSHARK_STAT_INC(STAT_HASHTABLE_FIND);
+
+    probe = 0;
+    for (nt = ht->slots[_cshark_hashtable_slot(key)]->head->next; nt != NULL; nt = nt->next)
+    {
+        probe++;
+        if (nt->val == key)
+        {
+            CSHARK_STAT_RECORD(STAT_HIST_HASHTABLE_PROBE, probe);
+            return nt;
+        }
+    }
+
+    CSHARK_STAT_INC(STAT_HASHTABLE_FIND_MISS);
+    CSHARK_STAT_RECORD(STAT_HIST_HASHTABLE_PROBE, probe);
+    return NULL;
+}
+
+/**
+ * Find a value in hash table
+ * @param ht [in] hash table
+ * @param key [in] key to find
+ * @return copy of the value, or HASH_NOT_FOUND
+ */
+CODESHARK_INLINE string hashtable_find(hashtable_t *ht, int key)
+{
+    cshark_node_t *nt = (ht == NULL) ? NULL : _cshark_hashtable_lookup(ht, key);
+
+    return (nt == NULL) ? HASH_NOT_FOUND : nt->name;
+}
+
+/**
+ * Find a value in hash table without copying it, e.g.,
+ *      const string *v = hashtable_find_ref(ht, key);
+ *      if (v != NULL) { ... *v ... }
+ * The value lives in the entry node, which stays in place until the key is deleted or the table
+ * destroyed; hashtable_add() of the same key changes the string the pointer refers to.
+ * @param ht [in] hash table
+ * @param key [in] key to find
+ * @return pointer to the value in the table, or \NULL if not found
+ */
+CODESHARK_INLINE const string *hashtable_find_ref(hashtable_t *ht, int key)
+{
+    cshark_node_t *nt;
+
+    if (ht == NULL)
+    {
+        return NULL;
+    }
+
+    nt = _cshark_hashtable_lookup(ht, key);
+    return (nt == NULL) ? NULL : &nt->name;
+}
+
+/**
+ * Check if a key is in hash table, without touching its value
+ */
+CODESHARK_INLINE bool hashtable_contains(hashtable_t *ht, int key)
+{
+    return ht != NULL and _cshark_hashtable_lookup(ht, key) != NULL;
+}
+
+/**
+ * Find the values of many keys, overlapping the cache misses of their chains. A single lookup
+ * waits for each node of its chain in turn; here up to HASH_BATCH_GROUP lookups are in flight,
+ * and each step of one prefetches its next node, which arrives while the others take their
+ * steps (asynchronous memory access chaining, AMAC). A finished lookup makes room for the next key.
+ * @param ht [in] hash table
+ * @param keys [in] keys
+ * @param n [in] number of keys
+ * @param out [out] values, HASH_NOT_FOUND for keys not in the table; n strings
+ * @return number of keys found
+ */
+CODESHARK_INLINE size_t hashtable_find_batch(hashtable_t *ht, const int *keys, size_t n, string *out)
+{
+    cshark_node_t *curr[HASH_BATCH_GROUP];
+    size_t pos[HASH_BATCH_GROUP];
+    size_t next;
+    size_t active;
+    size_t found;
+    size_t g;
+    cshark_node_t *nt;
+
+    if (ht == NULL or keys == NULL or out == NULL)
+    {
+        return 0;
+    }
+
+    CSHARK_STAT_ADD(STAT_HASHTABLE_FIND, n);
+
+    // slots, lists and their heads are few and stay cached; chain nodes are the misses
+    for (g = 0, next = 0; g < HASH_BATCH_GROUP and next < n; g++, next++)
+    {
+        pos[g] = next;
+        curr[g] = ht->slots[_cshark_hashtable_slot(keys[next])]->head->next;
+        CSHARK_PREFETCH(curr[g]);
+    }
+    active = g;
+
+    found = 0;
+    while (active > 0)
+    {
+        g = 0;
+        while (g < active)
+        {
+            nt = curr[g];
+            if (nt != NULL and nt->val != keys[pos[g]])
+            {
+                curr[g] = nt->next;
+                CSHARK_PREFETCH(curr[g]);
+                g++;
+                continue;
+            }
+
+            if (nt != NULL)
+            {
+                out[pos[g]] = nt->name;
+                found++;
+            }
+            else
+            {
+                out[pos[g]] = HASH_NOT_FOUND;
+                CSHARK_STAT_INC(STAT_HASHTABLE_FIND_MISS);
+            }
+
+            // refill the lane with the next key, or move the last lane here
+            if (next < n)
+            {
+                pos[g] = next;
+                curr[g] = ht->slots[_cshark_hashtable_slot(keys[next])]->head->next;
+                CSHARK_PREFETCH(curr[g]);
+                next++;
+                g++;
+            }
+            else
+            {
+                active--;
+                pos[g] = pos[active];
+                curr[g] = curr[active];
+            }
+        }
+    }
+
+    return found;
+}
+
+/**
+ * Add an entry in hash table, if exists, update hash slot
+ * @param val [in] value
+ * @param name [in] name
+ * @return SUCCESS
+ */
+CODESHARK_INLINE int hashtable_add(hashtable_t *ht, int key, string value)
+{
+    cshark_linklist_t *llt;
+    size_t chain;
+    cshark_node_t *nt;
+
+    if (ht == NULL)
+    {
+        return ERROR_PARAM;
+    }
+
+    CSHARK_STAT_INC(STAT_HASHTABLE_ADD);
+
+    llt = ht->slots[_cshark_hashtable_slot(key)];
+
+    // update the entry if the key exists
+    chain = 0;
+    for (nt = llt->head->next; nt != NULL; nt = nt->next)
+    {
+        if (nt->val == key)
+        {
+            CSHARK_STAT_RECORD(STAT_HIST_HASHTABLE_CHAIN, chain);
+            nt->name = value;
+            return SUCCESS;
+        }
+        chain++;
+    }
+
+    CSHARK_STAT_RECORD(STAT_HIST_HASHTABLE_CHAIN, chain);
+    return cshark_linklist_add_vals(llt, key, value);
+}
+
+/**
+ * Delete the entry of a key; pointers from hashtable_find_ref() to its value become invalid
+ * @param ht [in] hash table
+ * @param key [in] key
+ * @return \0 on success, ERROR_NOT_FOUND if the key is not in the table, or ERROR_PARAM
+ */
+CODESHARK_INLINE int hashtable_delete(hashtable_t *ht, int key)
+{
+    if (ht == NULL)
+    {
+        return ERROR_PARAM;
+    }
+
+    return cshark_linklist_delete_val(ht->slots[_cshark_hashtable_slot(key)], key);
+}
+
+/**
+ * Get the iterator to the first entry of hash table
+ * @param ht [in] hash table
+ * @return iterator, which equals hashtable_end() if the table is empty
+ */
+CODESHARK_INLINE hashtable_iterator hashtable_begin(hashtable_t *ht)
+{
+    return hashtable_iterator(ht, (ht == NULL) ? MAX_HASH_SLOTS : 0);
+}
+
+/**
+ * Get the iterator past the last entry of hash table
+ * @param ht [in] hash table
+ * @return iterator
+ */
+CODESHARK_INLINE hashtable_iterator hashtable_end(hashtable_t *ht)
+{
+    return hashtable_iterator(ht, MAX_HASH_SLOTS);
+}
+
+/**
+ * Get all entries of hash table as a range, e.g.,
+ *      for (cshark_node_t &entry : hashtable_entries(ht)) { ... }
+ * @param ht [in] hash table
+ * @return range of entries
+ */
+CODESHARK_INLINE cshark_range<hashtable_iterator> hashtable_entries(hashtable_t *ht)
+{
+    return cshark_range<hashtable_iterator>(hashtable_begin(ht), hashtable_end(ht));
+}
+
+#endif //CODESHARK_HASHTABLE_INL_H
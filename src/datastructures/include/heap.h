@@ -0,0 +1,406 @@
+/*
+ ============================================================================
+ Name        : heap.h
+ Description : d-ary heap and priority queue header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_HEAP_H
+#define CODESHARK_HEAP_H
+
+#include <stddef.h>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "common/include/node.h"
+
+using namespace std;
+
+#define PQUEUE_ARITY        4                   // children per node of PriorityQueue
+#define HEAP_INVALID_HANDLE ((size_t)-1)
+
+/**
+ * @class DaryHeap is an array-backed d-ary heap; top() is the element no other element is less than,
+ *        so with less<T> it is a min-heap.
+ *
+ * A d-ary heap is log2(D) times shallower than a binary heap: push() does fewer moves, while pop()
+ * compares D children per level. With D = 4 the children of a node are 4 adjacent elements, usually
+ * in one cache line, which makes it faster than a binary heap for both operations.
+ *
+ *      node i:     children D*i+1 ... D*i+D, parent (i-1)/D
+ */
+template <typename T, size_t D = PQUEUE_ARITY, typename Compare = less<T>>
+class DaryHeap
+{
+private:
+    vector<T> items;
+    Compare comp;
+
+    // move elements along the path instead of swapping, and place the element once at the end
+    void sift_up(size_t i)
+    {
+        T v = std::move(this->items[i]);
+        size_t p;
+
+        while (i > 0)
+        {
+            p = (i - 1) / D;
+            if (!this->comp(v, this->items[p]))
+            {
+                break;
+            }
+            this->items[i] = std::move(this->items[p]);
+            i = p;
+        }
+
+        this->items[i] = std::move(v);
+    }
+
+    void sift_down(size_t i)
+    {
+        size_t n = this->items.size();
+        T v = std::move(this->items[i]);
+        size_t c, k, best, last;
+
+        while (true)
+        {
+            c = D * i + 1;
+            if (c >= n)
+            {
+                break;
+            }
+
+            best = c;
+            last = (c + D < n) ? c + D : n;
+            for (k = c + 1; k < last; k++)
+            {
+                if (this->comp(this->items[k], this->items[best]))
+                {
+                    best = k;
+                }
+            }
+
+            if (!this->comp(this->items[best], v))
+            {
+                break;
+            }
+            this->items[i] = std::move(this->items[best]);
+            i = best;
+        }
+
+        this->items[i] = std::move(v);
+    }
+
+public:
+    DaryHeap(Compare c = Compare()) : comp(c) {}
+
+    bool is_empty() const { return this->items.empty(); }
+    size_t get_size() const { return this->items.size(); }
+    void reserve(size_t n) { this->items.reserve(n); }
+    void clear() { this->items.clear(); }
+
+    // \warning top() and pop() require a non-empty heap
+    const T &top() const { return this->items[0]; }
+
+    // element i of the heap array, in heap order rather than sorted, i < get_size()
+    const T &at(size_t i) const { return this->items[i]; }
+
+    void push(const T &v)
+    {
+        this->items.push_back(v);
+        this->sift_up(this->items.size() - 1);
+    }
+
+    void push(T &&v)
+    {
+        this->items.push_back(std::move(v));
+        this->sift_up(this->items.size() - 1);
+    }
+
+    void pop()
+    {
+        if (this->items.size() > 1)
+        {
+            this->items[0] = std::move(this->items.back());
+            this->items.pop_back();
+            this->sift_down(0);
+        }
+        else
+        {
+            this->items.pop_back();
+        }
+    }
+
+    /**
+     * Add elements in bulk, and rebuild the heap bottom-up
+     * Time complexity: O(N) for all elements, instead of O(NlogN) by pushing one by one
+     */
+    template <typename Iter>
+    void heapify(Iter first, Iter last)
+    {
+        size_t i;
+
+        this->items.insert(this->items.end(), first, last);
+        if (this->items.size() < 2)
+        {
+            return;
+        }
+
+        for (i = (this->items.size() - 2) / D + 1; i > 0; i--)
+        {
+            this->sift_down(i - 1);
+        }
+    }
+};
+
+/**
+ * @class IndexedDaryHeap is a d-ary heap whose elements are addressed by handles, which push()
+ *        returns and which stay valid until the element is popped or erased.
+ *        update() re-positions an element after its key decreased or increased (decrease-key),
+ *        and erase() removes it, both in O(logN). Handles of removed elements are reused.
+ */
+template <typename T, size_t D = PQUEUE_ARITY, typename Compare = less<T>>
+class IndexedDaryHeap
+{
+private:
+    vector<T> items;                // heap order
+    vector<size_t> handles;         // handle of items[i]
+    vector<size_t> positions;       // index in items of each handle, HEAP_INVALID_HANDLE if free
+    vector<size_t> free_handles;
+    Compare comp;
+
+    void place(size_t i, T &&v, size_t h)
+    {
+        this->items[i] = std::move(v);
+        this->handles[i] = h;
+        this->positions[h] = i;
+    }
+
+    void move_item(size_t from, size_t to)
+    {
+        this->place(to, std::move(this->items[from]), this->handles[from]);
+    }
+
+    size_t sift_up(size_t i)
+    {
+        T v = std::move(this->items[i]);
+        size_t h = this->handles[i];
+        size_t p;
+
+        while (i > 0)
+        {
+            p = (i - 1) / D;
+            if (!this->comp(v, this->items[p]))
+            {
+                break;
+            }
+            this->move_item(p, i);
+            i = p;
+        }
+
+        this->place(i, std::move(v), h);
+        return i;
+    }
+
+    size_t sift_down(size_t i)
+    {
+        size_t n = this->items.size();
+        T v = std::move(this->items[i]);
+        size_t h = this->handles[i];
+        size_t c, k, best, last;
+
+        while (true)
+        {
+            c = D * i + 1;
+            if (c >= n)
+            {
+                break;
+            }
+
+            best = c;
+            last = (c + D < n) ? c + D : n;
+            for (k = c + 1; k < last; k++)
+            {
+                if (this->comp(this->items[k], this->items[best]))
+                {
+                    best = k;
+                }
+            }
+
+            if (!this->comp(this->items[best], v))
+            {
+                break;
+            }
+            this->move_item(best, i);
+            i = best;
+        }
+
+        this->place(i, std::move(v), h);
+        return i;
+    }
+
+    // remove items[i], filling the hole with the last element
+    void remove_at(size_t i)
+    {
+        size_t last = this->items.size() - 1;
+
+        this->positions[this->handles[i]] = HEAP_INVALID_HANDLE;
+        this->free_handles.push_back(this->handles[i]);
+
+        if (i != last)
+        {
+            this->move_item(last, i);
+        }
+        this->items.pop_back();
+        this->handles.pop_back();
+
+        if (i != last)
+        {
+            this->sift_down(this->sift_up(i));
+        }
+    }
+
+public:
+    IndexedDaryHeap(Compare c = Compare()) : comp(c) {}
+
+    bool is_empty() const { return this->items.empty(); }
+    size_t get_size() const { return this->items.size(); }
+
+    // \warning top(), top_handle() and pop() require a non-empty heap
+    const T &top() const { return this->items[0]; }
+    size_t top_handle() const { return this->handles[0]; }
+
+    bool contains(size_t h) const
+    {
+        return h < this->positions.size() and this->positions[h] != HEAP_INVALID_HANDLE;
+    }
+
+    // \warning get() requires contains(h)
+    const T &get(size_t h) const { return this->items[this->positions[h]]; }
+
+    /**
+     * Add an element
+     * @return handle of the element
+     */
+    size_t push(T v)
+    {
+        size_t h;
+
+        if (this->free_handles.empty())
+        {
+            h = this->positions.size();
+            this->positions.push_back(HEAP_INVALID_HANDLE);
+        }
+        else
+        {
+            h = this->free_handles.back();
+            this->free_handles.pop_back();
+        }
+
+        this->items.push_back(std::move(v));
+        this->handles.push_back(h);
+        this->positions[h] = this->items.size() - 1;
+        this->sift_up(this->items.size() - 1);
+
+        return h;
+    }
+
+    void pop()
+    {
+        this->remove_at(0);
+    }
+
+    /**
+     * Replace the value of an element, e.g., decrease its key
+     * @return \false if the handle is not in the heap
+     */
+    bool update(size_t h, T v)
+    {
+        size_t i;
+
+        if (!this->contains(h))
+        {
+            return false;
+        }
+
+        i = this->positions[h];
+        this->items[i] = std::move(v);
+        this->sift_down(this->sift_up(i));
+
+        return true;
+    }
+
+    /**
+     * Remove an element by handle
+     * @return \false if the handle is not in the heap
+     */
+    bool erase(size_t h)
+    {
+        if (!this->contains(h))
+        {
+            return false;
+        }
+
+        this->remove_at(this->positions[h]);
+        return true;
+    }
+};
+
+/**
+ * Entries of the node priority queue keep a copy of val next to the node pointer, so comparisons
+ * read the heap array only, instead of dereferencing a node per comparison.
+ * \warning val of a queued node must not be changed
+ */
+typedef pair<int, cshark_node_t *> cshark_pqueue_entry_t;
+
+struct cshark_pqueue_entry_less
+{
+    bool operator()(const cshark_pqueue_entry_t &a, const cshark_pqueue_entry_t &b) const
+    {
+        return a.first < b.first;
+    }
+};
+
+typedef DaryHeap<cshark_pqueue_entry_t, PQUEUE_ARITY, cshark_pqueue_entry_less> cshark_pqueue_t;
+
+/**
+ * @class PriorityQueue keeps nodes ordered by val, and dequeues the node with the smallest val first.
+ *        It replaces a sorted LinkList: enqueue and dequeue are O(logN) instead of O(N).
+ */
+class PriorityQueue
+{
+private:
+    cshark_pqueue_t *heap;
+public:
+    PriorityQueue();
+    ~PriorityQueue();
+
+    bool is_empty();
+    size_t get_size();
+    int enqueue(int val);
+    int enqueue(cshark_node_t *nt);
+    int enqueue_bulk(cshark_node_t **nodes, size_t n);
+    cshark_node_t *dequeue();
+    cshark_node_t *get_top();
+};
+
+// Priority queue functions
+
+cshark_pqueue_t *cshark_pqueue_init();
+void cshark_pqueue_destroy(cshark_pqueue_t *pq);
+int cshark_pqueue_add(cshark_pqueue_t *pq, int val);
+int cshark_pqueue_insert(cshark_pqueue_t *pq, cshark_node_t *node);
+int cshark_pqueue_heapify(cshark_pqueue_t *pq, cshark_node_t **nodes, size_t n);
+cshark_node_t *cshark_pqueue_remove(cshark_pqueue_t *pq);
+cshark_node_t *cshark_pqueue_top(cshark_pqueue_t *pq);
+size_t cshark_pqueue_getsize(cshark_pqueue_t *pq);
+
+#ifdef CODESHARK_HEADER_ONLY
+#include "datastructures/include/heap_inl.h"
+#endif
+
+#endif //CODESHARK_HEAP_H
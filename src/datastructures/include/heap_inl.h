@@ -0,0 +1,238 @@
+/*
+ ============================================================================
+ Name        : heap_inl.h
+ Description : priority queue inline implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_HEAP_INL_H
+#define CODESHARK_HEAP_INL_H
+
+#include "common/include/common.h"
+#include "common/include/node.h"
+#include "common/include/err.h"
+#include "datastructures/include/heap.h"
+
+/**
+ * Initialize an empty priority queue
+ * @return priority queue
+ */
+CODESHARK_INLINE cshark_pqueue_t *cshark_pqueue_init()
+{
+    return new cshark_pqueue_t();
+}
+
+/**
+ * Destroy a priority queue and all nodes in it
+ * @param pq [in] priority queue
+ */
+CODESHARK_INLINE void cshark_pqueue_destroy(cshark_pqueue_t *pq)
+{
+    size_t i;
+
+    if (pq == NULL)
+    {
+        return;
+    }
+
+    // free nodes in array order, O(N) instead of popping them in O(NlogN)
+    for (i = 0; i < pq->get_size(); i++)
+    {
+        cshark_node_free(pq->at(i).second);
+    }
+
+    delete(pq);
+}
+
+/**
+ * Add a new node of a value
+ * @param pq [in,out] priority queue
+ * @param val [in] value, the priority
+ * @return \0 on success, or other error code
+ */
+CODESHARK_INLINE int cshark_pqueue_add(cshark_pqueue_t *pq, int val)
+{
+    cshark_node_t *nt;
+
+    if (pq == NULL)
+    {
+        return ERROR_PARAM;
+    }
+
+    nt = cshark_node_init();
+    nt->val = val;
+    pq->push(make_pair(val, nt));
+
+    return SUCCESS;
+}
+
+/**
+ * Add a node; the queue owns the node until it is removed
+ * @param pq [in,out] priority queue
+ * @param node [in] node, ordered by val
+ * @return \0 on success, or other error code
+ */
+CODESHARK_INLINE int cshark_pqueue_insert(cshark_pqueue_t *pq, cshark_node_t *node)
+{
+    if (pq == NULL or node == NULL)
+    {
+        return ERROR_PARAM;
+    }
+
+    pq->push(make_pair(node->val, node));
+
+    return SUCCESS;
+}
+
+/**
+ * Add nodes in bulk, in O(N) rather than O(NlogN)
+ * @param pq [in,out] priority queue
+ * @param nodes [in] array of nodes
+ * @param n [in] number of nodes
+ * @return \0 on success, or other error code
+ */
+CODESHARK_INLINE int cshark_pqueue_heapify(cshark_pqueue_t *pq, cshark_node_t **nodes, size_t n)
+{
+    vector<cshark_pqueue_entry_t> entries;
+    size_t i;
+
+    if (pq == NULL or (nodes == NULL and n > 0))
+    {
+        return ERROR_PARAM;
+    }
+
+    entries.reserve(n);
+    for (i = 0; i < n; i++)
+    {
+        if (nodes[i] == NULL)
+        {
+            return ERROR_PARAM;
+        }
+        entries.push_back(make_pair(nodes[i]->val, nodes[i]));
+    }
+
+    pq->heapify(entries.begin(), entries.end());
+
+    return SUCCESS;
+}
+
+/**
+ * Remove the node with the smallest val
+ * \warning caller must manually free the node
+ * @param pq [in,out] priority queue
+ * @return node, or \NULL if the queue is empty
+ */
+CODESHARK_INLINE cshark_node_t *cshark_pqueue_remove(cshark_pqueue_t *pq)
+{
+    cshark_node_t *nt;
+
+    if (pq == NULL or pq->is_empty())
+    {
+        return NULL;
+    }
+
+    nt = pq->top().second;
+    pq->pop();
+
+    return nt;
+}
+
+/**
+ * Get the node with the smallest val without removing it
+ * @return node, or \NULL if the queue is empty
+ */
+CODESHARK_INLINE cshark_node_t *cshark_pqueue_top(cshark_pqueue_t *pq)
+{
+    if (pq == NULL or pq->is_empty())
+    {
+        return NULL;
+    }
+
+    return pq->top().second;
+}
+
+CODESHARK_INLINE size_t cshark_pqueue_getsize(cshark_pqueue_t *pq)
+{
+    return pq == NULL ? 0 : pq->get_size();
+}
+
+/**
+ * Initialize an empty priority queue
+ */
+CODESHARK_INLINE PriorityQueue::PriorityQueue()
+{
+    this->heap = cshark_pqueue_init();
+}
+
+/**
+ * Delete the priority queue and the nodes in it
+ */
+CODESHARK_INLINE PriorityQueue::~PriorityQueue()
+{
+    cshark_pqueue_destroy(this->heap);
+}
+
+CODESHARK_INLINE bool PriorityQueue::is_empty()
+{
+    return this->heap->is_empty();
+}
+
+CODESHARK_INLINE size_t PriorityQueue::get_size()
+{
+    return this->heap->get_size();
+}
+
+/**
+ * Enqueue a new node
+ * @param val [in] val of the new node, the priority
+ * @return \0 on success
+ */
+CODESHARK_INLINE int PriorityQueue::enqueue(int val)
+{
+    return cshark_pqueue_add(this->heap, val);
+}
+
+/**
+ * Enqueue a node
+ * @param nt [in] node
+ * @return \0 on success, or other error code
+ */
+CODESHARK_INLINE int PriorityQueue::enqueue(cshark_node_t *nt)
+{
+    return cshark_pqueue_insert(this->heap, nt);
+}
+
+/**
+ * Enqueue nodes in bulk with heapify
+ * @param nodes [in] array of nodes
+ * @param n [in] number of nodes
+ * @return \0 on success, or other error code
+ */
+CODESHARK_INLINE int PriorityQueue::enqueue_bulk(cshark_node_t **nodes, size_t n)
+{
+    return cshark_pqueue_heapify(this->heap, nodes, n);
+}
+
+/**
+ * Dequeue the node with the smallest val
+ * \warning caller must manually free the node
+ * @return node, or \NULL if the queue is empty
+ */
+CODESHARK_INLINE cshark_node_t *PriorityQueue::dequeue()
+{
+    return cshark_pqueue_remove(this->heap);
+}
+
+/**
+ * Get the node with the smallest val
+ * @return node, or \NULL if the queue is empty
+ */
+CODESHARK_INLINE cshark_node_t *PriorityQueue::get_top()
+{
+    return cshark_pqueue_top(this->heap);
+}
+
+#endif //CODESHARK_HEAP_INL_H
@@ -0,0 +1,449 @@
+/*
+ ============================================================================
+ Name        : intrusive.h
+ Description : intrusive list, queue and stack with links embedded in elements
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_INTRUSIVE_H
+#define CODESHARK_INTRUSIVE_H
+
+#include <stddef.h>
+#include <iterator>
+#include <type_traits>
+
+#include "common/include/err.h"
+
+using namespace std;
+
+/**
+ * Intrusive containers link the user's objects themselves instead of nodes pointing to them:
+ * a struct embeds a cshark_list_hook_t per container it may be in, and the container is told
+ * which member to use (a member hook). Adding or removing an element never allocates, and
+ * walking a list touches the objects only, not a node and then its data.
+ *
+ *      struct job
+ *      {
+ *          int id;
+ *          cshark_list_hook_t ready;       // in the ready queue
+ *          cshark_list_hook_t all;         // in the list of all jobs
+ *      };
+ *
+ *      IntrusiveQueue<job, &job::ready> ready;
+ *      IntrusiveList<job, &job::all> jobs;
+ *
+ * Containers never own their elements: an element must outlive its membership, and a container
+ * unlinks what is left in it when it is cleared or destroyed. An element is in at most one
+ * container per hook; adding a linked element fails with ERROR_EXISTS.
+ */
+
+/**
+ * @struct cshark_list_hook_t is the pair of links an element embeds for one intrusive container.
+ *         A copied element gets an unlinked hook, as the copy is in no container.
+ */
+typedef struct _cshark_list_hook_t
+{
+    struct _cshark_list_hook_t *prev;
+    struct _cshark_list_hook_t *next;
+
+    _cshark_list_hook_t() : prev(NULL), next(NULL) {}
+    _cshark_list_hook_t(const _cshark_list_hook_t &) : prev(NULL), next(NULL) {}
+    _cshark_list_hook_t &operator=(const _cshark_list_hook_t &) { return *this; }
+
+    bool is_linked() const { return this->next != NULL; }
+}cshark_list_hook_t;
+
+/**
+ * @class IntrusiveList is a doubly linked list of elements of type T, linked by their member Hook.
+ *        It is circular around a sentinel hook, so insertion and erase() anywhere are O(1) and
+ *        never test for the ends.
+ *
+ *      root <-> [a.hook] <-> [b.hook] <-> [c.hook] <-> root
+ */
+template <typename T, cshark_list_hook_t T::*Hook>
+class IntrusiveList
+{
+private:
+    cshark_list_hook_t root;
+    size_t count;
+
+    // offset of the hook in T, taken on storage of T's size, as offsetof() is only for standard layouts
+    static size_t hook_offset()
+    {
+        static typename aligned_storage<sizeof(T), alignof(T)>::type probe;
+
+        return (size_t)((char *)&(((T *)&probe)->*Hook) - (char *)&probe);
+    }
+
+    static T *to_value(cshark_list_hook_t *h)
+    {
+        return (T *)((char *)h - hook_offset());
+    }
+
+    static const T *to_value(const cshark_list_hook_t *h)
+    {
+        return (const T *)((const char *)h - hook_offset());
+    }
+
+    void link(cshark_list_hook_t *pos, cshark_list_hook_t *h)
+    {
+        h->prev = pos->prev;
+        h->next = pos;
+        pos->prev->next = h;
+        pos->prev = h;
+        this->count++;
+    }
+
+    void unlink(cshark_list_hook_t *h)
+    {
+        h->prev->next = h->next;
+        h->next->prev = h->prev;
+        h->prev = NULL;
+        h->next = NULL;
+        this->count--;
+    }
+
+public:
+    /**
+     * @class iter is a bidirectional iterator dereferencing to the element; end() is the root
+     */
+    template <typename V, typename H>
+    class iter
+    {
+    private:
+        H *h;
+
+    public:
+        typedef bidirectional_iterator_tag iterator_category;
+        typedef V value_type;
+        typedef ptrdiff_t difference_type;
+        typedef V *pointer;
+        typedef V &reference;
+
+        iter() : h(NULL) {}
+        explicit iter(H *hook) : h(hook) {}
+
+        // an iterator converts to a const iterator, but not the other way
+        template <typename U, typename G>
+        iter(const iter<U, G> &other) : h(other.hook()) {}
+
+        H *hook() const { return this->h; }
+
+        reference operator*() const { return *IntrusiveList::to_value(this->h); }
+        pointer operator->() const { return IntrusiveList::to_value(this->h); }
+
+        iter &operator++()
+        {
+            this->h = this->h->next;
+            return *this;
+        }
+
+        iter operator++(int)
+        {
+            iter it = *this;
+            this->h = this->h->next;
+            return it;
+        }
+
+        iter &operator--()
+        {
+            this->h = this->h->prev;
+            return *this;
+        }
+
+        iter operator--(int)
+        {
+            iter it = *this;
+            this->h = this->h->prev;
+            return it;
+        }
+
+        bool operator==(const iter &other) const { return this->h == other.h; }
+        bool operator!=(const iter &other) const { return this->h != other.h; }
+    };
+
+    typedef iter<T, cshark_list_hook_t> iterator;
+    typedef iter<const T, const cshark_list_hook_t> const_iterator;
+
+    IntrusiveList() : count(0)
+    {
+        this->root.prev = &this->root;
+        this->root.next = &this->root;
+    }
+
+    ~IntrusiveList()
+    {
+        this->clear();
+    }
+
+    IntrusiveList(const IntrusiveList &) = delete;
+    IntrusiveList &operator=(const IntrusiveList &) = delete;
+
+    iterator begin() { return iterator(this->root.next); }
+    iterator end() { return iterator(&this->root); }
+    const_iterator begin() const { return const_iterator(this->root.next); }
+    const_iterator end() const { return const_iterator(&this->root); }
+
+    size_t get_size() const { return this->count; }
+    bool is_empty() const { return this->count == 0; }
+
+    /**
+     * Get the first element, or \NULL if the list is empty
+     */
+    T *get_first()
+    {
+        return this->count == 0 ? NULL : to_value(this->root.next);
+    }
+
+    /**
+     * Get the last element, or \NULL if the list is empty
+     */
+    T *get_last()
+    {
+        return this->count == 0 ? NULL : to_value(this->root.prev);
+    }
+
+    /**
+     * Get the element after v in the list, or \NULL if v is the last one
+     * \warning v must be in this list
+     */
+    T *get_next(T &v)
+    {
+        cshark_list_hook_t *h = (v.*Hook).next;
+
+        return h == &this->root ? NULL : to_value(h);
+    }
+
+    /**
+     * Get the element before v in the list, or \NULL if v is the first one
+     * \warning v must be in this list
+     */
+    T *get_prev(T &v)
+    {
+        cshark_list_hook_t *h = (v.*Hook).prev;
+
+        return h == &this->root ? NULL : to_value(h);
+    }
+
+    /**
+     * Add an element at the front
+     * @return \0 on success, or ERROR_EXISTS if the hook of v is linked already
+     */
+    int push_front(T &v)
+    {
+        if ((v.*Hook).is_linked())
+        {
+            return ERROR_EXISTS;
+        }
+
+        this->link(this->root.next, &(v.*Hook));
+        return SUCCESS;
+    }
+
+    /**
+     * Add an element at the back
+     * @return \0 on success, or ERROR_EXISTS if the hook of v is linked already
+     */
+    int push_back(T &v)
+    {
+        if ((v.*Hook).is_linked())
+        {
+            return ERROR_EXISTS;
+        }
+
+        this->link(&this->root, &(v.*Hook));
+        return SUCCESS;
+    }
+
+    /**
+     * Add an element before another one
+     * @param pos [in] element in this list
+     * @param v [in] element to add
+     * @return \0 on success, or ERROR_EXISTS if the hook of v is linked already
+     */
+    int insert_before(T &pos, T &v)
+    {
+        if ((v.*Hook).is_linked())
+        {
+            return ERROR_EXISTS;
+        }
+
+        this->link(&(pos.*Hook), &(v.*Hook));
+        return SUCCESS;
+    }
+
+    /**
+     * Remove and return the first element, or \NULL if the list is empty
+     */
+    T *pop_front()
+    {
+        cshark_list_hook_t *h = this->root.next;
+
+        if (this->count == 0)
+        {
+            return NULL;
+        }
+
+        this->unlink(h);
+        return to_value(h);
+    }
+
+    /**
+     * Remove and return the last element, or \NULL if the list is empty
+     */
+    T *pop_back()
+    {
+        cshark_list_hook_t *h = this->root.prev;
+
+        if (this->count == 0)
+        {
+            return NULL;
+        }
+
+        this->unlink(h);
+        return to_value(h);
+    }
+
+    /**
+     * Remove an element from anywhere in the list, in O(1)
+     * @return \0 on success, or ERROR_NOT_FOUND if the hook of v is not linked
+     * \warning a linked v must be in this list, not in another list of the same hook
+     */
+    int erase(T &v)
+    {
+        if (!(v.*Hook).is_linked())
+        {
+            return ERROR_NOT_FOUND;
+        }
+
+        this->unlink(&(v.*Hook));
+        return SUCCESS;
+    }
+
+    /**
+     * Move an element of the list to the front, as an LRU list does on a hit
+     * \warning v must be in this list
+     */
+    void move_to_front(T &v)
+    {
+        this->unlink(&(v.*Hook));
+        this->link(this->root.next, &(v.*Hook));
+    }
+
+    /**
+     * Unlink all elements, leaving their hooks unlinked; elements are not freed
+     */
+    void clear()
+    {
+        cshark_list_hook_t *h = this->root.next;
+        cshark_list_hook_t *next;
+
+        while (h != &this->root)
+        {
+            next = h->next;
+            h->prev = NULL;
+            h->next = NULL;
+            h = next;
+        }
+
+        this->root.prev = &this->root;
+        this->root.next = &this->root;
+        this->count = 0;
+    }
+};
+
+/**
+ * @class IntrusiveQueue is a FIFO queue of elements linked by their member Hook
+ */
+template <typename T, cshark_list_hook_t T::*Hook>
+class IntrusiveQueue
+{
+private:
+    IntrusiveList<T, Hook> list;
+
+public:
+    typedef typename IntrusiveList<T, Hook>::iterator iterator;
+    typedef typename IntrusiveList<T, Hook>::const_iterator const_iterator;
+
+    iterator begin() { return this->list.begin(); }
+    iterator end() { return this->list.end(); }
+    const_iterator begin() const { return this->list.begin(); }
+    const_iterator end() const { return this->list.end(); }
+
+    size_t get_size() const { return this->list.get_size(); }
+    bool is_empty() const { return this->list.is_empty(); }
+    void clear() { this->list.clear(); }
+
+    /**
+     * Enqueue an element at the rear
+     * @return \0 on success, or ERROR_EXISTS if the hook of v is linked already
+     */
+    int enqueue(T &v) { return this->list.push_back(v); }
+
+    /**
+     * Dequeue the front element, or \NULL if the queue is empty
+     */
+    T *dequeue() { return this->list.pop_front(); }
+
+    /**
+     * Get the front element, or \NULL if the queue is empty
+     */
+    T *get_front() { return this->list.get_first(); }
+
+    /**
+     * Remove an element from anywhere in the queue, in O(1), e.g., a cancelled job
+     * @return \0 on success, or ERROR_NOT_FOUND if the hook of v is not linked
+     */
+    int erase(T &v) { return this->list.erase(v); }
+};
+
+/**
+ * @class IntrusiveStack is a LIFO stack of elements linked by their member Hook; iterators walk
+ *        from the top to the bottom, as Stack does
+ */
+template <typename T, cshark_list_hook_t T::*Hook>
+class IntrusiveStack
+{
+private:
+    IntrusiveList<T, Hook> list;
+
+public:
+    typedef typename IntrusiveList<T, Hook>::iterator iterator;
+    typedef typename IntrusiveList<T, Hook>::const_iterator const_iterator;
+
+    iterator begin() { return this->list.begin(); }
+    iterator end() { return this->list.end(); }
+    const_iterator begin() const { return this->list.begin(); }
+    const_iterator end() const { return this->list.end(); }
+
+    size_t get_size() const { return this->list.get_size(); }
+    bool is_empty() const { return this->list.is_empty(); }
+    void clear() { this->list.clear(); }
+
+    /**
+     * Push an element
+     * @return \0 on success, or ERROR_EXISTS if the hook of v is linked already
+     */
+    int push(T &v) { return this->list.push_front(v); }
+
+    /**
+     * Pop the top element, or \NULL if the stack is empty
+     */
+    T *pop() { return this->list.pop_front(); }
+
+    /**
+     * Get the top element, or \NULL if the stack is empty
+     */
+    T *get_top() { return this->list.get_first(); }
+
+    /**
+     * Remove an element from anywhere in the stack, in O(1)
+     * @return \0 on success, or ERROR_NOT_FOUND if the hook of v is not linked
+     */
+    int erase(T &v) { return this->list.erase(v); }
+};
+
+#endif //CODESHARK_INTRUSIVE_H
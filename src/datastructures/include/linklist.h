@@ -11,21 +11,45 @@
 #ifndef CODESHARK_LINKLIST_H
 #define CODESHARK_LINKLIST_H
 
+#include <iterator>
+
+#include "common/include/err.h"
 #include "common/include/node.h"
+#include "common/include/node_iterator.h"
+
+// node comparator for sorting, e.g., cshark_node_less_val and cshark_node_less_name
+typedef bool (*cshark_node_less_t)(const cshark_node_t *a, const cshark_node_t *b);
 
 /**
  * @class Linklist maintains double-linked list structure
  *        using forward and backward pointers.
+ *        Iterators walk the nodes after head, e.g., for (cshark_node_t &nt : *list) { ... }
  */
 class LinkList
 {
 private:
     cshark_node_t *head;
+    cshark_node_t *tail;        // last node, or head if the list is empty
+    size_t size;
+
+    int insert_chain(cshark_node_t *first, cshark_node_t *last, size_t n);
 
 public:
+    typedef cshark_list_iterator<cshark_node_t> iterator;
+    typedef cshark_list_iterator<const cshark_node_t> const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
     LinkList(size_t n);
     ~LinkList();
 
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+    reverse_iterator rbegin();
+    reverse_iterator rend();
+
     void print();
     size_t get_size();
     cshark_node_t *get_head();
@@ -36,6 +60,9 @@ public:
 
     int insert_node(cshark_node_t *nt);
     int insert_val(int val);
+    int insert_vals(const int *vals, size_t n);
+    template <typename Iter>
+    int insert_range(Iter first, Iter last);
 
     int delete_by_pos(size_t pos);
     int delete_first();
@@ -44,10 +71,57 @@ public:
     cshark_node_t* pop_by_pos(size_t pos);
     cshark_node_t* pop_first();
     cshark_node_t* pop_last();
+    size_t pop_first_batch(int *vals, size_t n);
+    size_t pop_last_batch(int *vals, size_t n);
     int detach(int pos);
     int detach_head();
+
+    int sort();
+    int sort_by(cshark_node_less_t less);
+
+    int splice(cshark_node_t *pos, LinkList *other);
+    int concat(LinkList *other);
+    int split(cshark_node_t *nt, LinkList *other);
+    int move_range(cshark_node_t *pos, LinkList *other, cshark_node_t *first, cshark_node_t *last);
 };
 
+/**
+ * Insert values of a range at the tail of linklist, with all nodes allocated in one block
+ * @param first [in] forward iterator to the first value
+ * @param last [in] iterator past the last value
+ * @return \0 on success, or ERROR_MAX_NODES if the list would exceed MAX_NODES
+ */
+template <typename Iter>
+int LinkList::insert_range(Iter first, Iter last)
+{
+    cshark_node_t *chain;
+    cshark_node_t *nt;
+    cshark_node_t *tail;
+    size_t n;
+
+    n = (size_t)distance(first, last);
+    if (this->size + n > MAX_NODES)
+    {
+        return ERROR_MAX_NODES;
+    }
+
+    if (n == 0)
+    {
+        return SUCCESS;
+    }
+
+    chain = cshark_node_init_batch(n);
+    tail = chain;
+    for (nt = chain; first != last; ++first)
+    {
+        nt->val = *first;
+        tail = nt;
+        nt = nt->next;
+    }
+
+    return this->insert_chain(chain, tail, n);
+}
+
 
 /**
  * @struct linklist structure
@@ -58,7 +132,8 @@ typedef struct _cshark_link_t
 {
     cshark_node_t *head;      // head node always exists for a linklist, even if it's empty
     cshark_node_t *first;     // NULL if the list is empty (with only root)
-    cshark_node_t *last;      // NULL if the list is empty (with only root)
+    cshark_node_t *last;      // head if the list is empty (with only root)
+    size_t size;              // number of nodes, head is not counted
 }cshark_linklist_t;
 
 // Functions
@@ -80,7 +155,9 @@ cshark_node_t* cshark_linklist_find_pos(cshark_linklist_t *llt, size_t pos);
 
 /// linklist add-like functions
 int cshark_linklist_add(cshark_linklist_t *llt, int v);
+int cshark_linklist_add_vals(cshark_linklist_t *llt, int v, string name);
 int cshark_linklist_insert(cshark_linklist_t *llt, cshark_node_t *node);
+int cshark_linklist_add_batch(cshark_linklist_t *llt, const int *vals, size_t n);
 
 // linklist remove-like functions
 int cshark_linklist_delete_val(cshark_linklist_t *llt, int val);
@@ -89,5 +166,23 @@ int cshark_linklist_delete_last(cshark_linklist_t *llt, int *val);
 int cshark_linklist_delete_first(cshark_linklist_t *llt, int *val);
 cshark_node_t* cshark_linklist_pop_first(cshark_linklist_t *llt);
 cshark_node_t* cshark_linklist_pop_last(cshark_linklist_t *llt);
+size_t cshark_linklist_delete_first_batch(cshark_linklist_t *llt, int *vals, size_t n);
+
+// linklist sort functions
+bool cshark_node_less_val(const cshark_node_t *a, const cshark_node_t *b);
+bool cshark_node_less_name(const cshark_node_t *a, const cshark_node_t *b);
+int cshark_linklist_sort(cshark_linklist_t *llt);
+int cshark_linklist_sort_by(cshark_linklist_t *llt, cshark_node_less_t less);
+
+// linklist splice functions, which relink node chains without allocation or copy
+int cshark_linklist_splice(cshark_linklist_t *llt, cshark_node_t *pos, cshark_linklist_t *src);
+int cshark_linklist_concat(cshark_linklist_t *llt, cshark_linklist_t *src);
+int cshark_linklist_split(cshark_linklist_t *llt, cshark_node_t *node, cshark_linklist_t *dst);
+int cshark_linklist_move_range(cshark_linklist_t *llt, cshark_node_t *pos, cshark_linklist_t *src,
+                               cshark_node_t *first, cshark_node_t *last);
+
+#ifdef CODESHARK_HEADER_ONLY
+#include "datastructures/include/linklist_inl.h"
+#endif
 
 #endif //CODESHARK_LINKLIST_H
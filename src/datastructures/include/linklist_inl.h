@@ -0,0 +1,1806 @@
+/*
+ ============================================================================
+ Name        : linklist_inl.h
+ Description : linklist inline implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_LINKLIST_INL_H
+#define CODESHARK_LINKLIST_INL_H
+
+#include <cassert>
+
+#include "common/include/common.h"
+#include "common/include/node.h"
+#include "common/include/err.h"
+#include "common/include/stats.h"
+#include "datastructures/include/linklist.h"
+
+/**
+ * Initialize a link list with given number of nodes
+ * @param n [in] number of nodes(not including head), max MAX_LINKLIST_NODES
+ *               0 for empty link list with only the head
+ * @return valid linklist pointer on success
+ *         \NULL on n > MAX_LINKLIST_NODES
+ */
+CODESHARK_INLINE cshark_linklist_t *cshark_linklist_init(size_t n)
+{
+    cshark_linklist_t *llt;
+    cshark_node_t *nt;
+    int i;
+
+    if (n > MAX_LINKLIST_NODES)
+    {
+        return NULL;
+    }
+
+    llt = cshark_linkist_allocate();
+    for (i = 0; i < n; i++)
+    {
+        nt = cshark_node_init();
+        llt->last->next = nt;
+        nt->prev = llt->last;
+        nt->next = NULL;
+
+        llt->last = nt;
+        nt->val = (i + 1);
+    }
+
+    llt->first = llt->head->next;
+    llt->size = n;
+
+    return llt;
+}
+
+/**
+ * Initialize a new link list with only head node
+ * @return link list pointer
+ */
+CODESHARK_INLINE cshark_linklist_t *cshark_linkist_allocate()
+{
+    cshark_linklist_t *llt;
+
+    llt = new cshark_linklist_t();
+
+    llt->head = new cshark_node_t();
+    llt->head->name = "head";
+    llt->head->val = 0;
+
+    llt->first = NULL;
+    llt->last = llt->head;
+    llt->size = 0;
+
+    return llt;
+}
+
+/**
+ * Make a deep copy of an existing linklist
+ * @param llt [in] linklist to copy
+ * @return new linklist
+ */
+CODESHARK_INLINE cshark_linklist_t *cshark_linklist_copy(cshark_linklist_t *llt)
+{
+    cshark_linklist_t *new_llt;
+    cshark_node_t *nt;
+    cshark_node_t *new_nt;
+    cshark_node_t *curr;
+    cshark_node_t *pre;
+
+    if (llt == NULL or llt->head == NULL)
+    {
+        return NULL;
+    }
+
+    new_llt = cshark_linkist_allocate();
+    cshark_node_copy(llt->head, new_llt->head);
+
+    nt = llt->head->next;  // copy from the first node after head
+    curr = new_llt->head;
+    pre = new_llt->head;
+    while (nt != NULL)
+    {
+        new_nt = cshark_node_init();
+        cshark_node_copy(nt, new_nt);
+
+        curr->next = new_nt;
+        new_nt->prev = curr;
+
+        pre = curr;
+        curr = new_nt;
+        nt = nt->next;
+    }
+
+    curr->next = NULL;
+    curr->prev = pre;
+
+    new_llt->first = new_llt->head->next;
+    new_llt->last = curr;
+    new_llt->size = llt->size;
+
+    return new_llt;
+}
+
+/**
+ * Delete a link list of its all nodes including head
+ * @param llt [in] linklist
+ * @return \0 for success, or other error code
+ */
+CODESHARK_INLINE int cshark_linklist_destroy(cshark_linklist_t *llt)
+{
+    cshark_node_t *p;
+    cshark_node_t *q;
+
+    if (llt == NULL or llt->head == NULL)
+    {
+        return ERROR_PARAM;
+    }
+
+    p = llt->head;
+    while(p != NULL)
+    {
+        q = p;
+        p = p->next;
+
+        delete(q);
+    }
+
+    delete(llt);
+
+    // Caution: delete(llt) ***WILL NOT set llt to NULL***.
+    // set 'llt = NULL' will not change llt value, as it's a pass-by-value parameter;
+    // to change llt, use cshark_linklist_t **llt as parameter, and then '*llt = NULL'.
+    return SUCCESS;
+}
+
+/**
+ * Add a node to the tail of link list
+ * @param llt [in,out] link list
+ * @param v  [in] node value
+ * @return \0 for success, or other error code
+ */
+CODESHARK_INLINE int cshark_linklist_add(cshark_linklist_t *llt, int v)
+{
+    cshark_node_t *nt;
+
+    if (llt == NULL or llt->head == NULL)
+    {
+        return ERROR_PARAM;
+    }
+
+    if (llt->size == MAX_NODES)
+    {
+        return ERROR_MAX_NODES;
+    }
+
+    CSHARK_STAT_INC(STAT_LINKLIST_INSERT);
+
+    nt = cshark_node_init();
+    nt->val = v;
+    assert (nt != NULL);
+
+    llt->last->next = nt;
+    nt->next = NULL;
+    nt->prev = llt->last;
+    llt->last = nt;
+    llt->first = llt->head->next;
+    llt->size++;
+
+    return SUCCESS;
+}
+
+
+/**
+ * Insert a node at the rear of the list
+ * @param llt [in] linklist
+ * @param node [in] node to insert
+ * @return \0 for success, or other error code
+ */
+CODESHARK_INLINE int cshark_linklist_insert(cshark_linklist_t *llt, cshark_node_t *node)
+{
+    if (llt == NULL or llt->head == NULL)
+    {
+        return ERROR_PARAM;
+    }
+
+    if (llt->size == MAX_NODES)
+    {
+        return ERROR_MAX_NODES;
+    }
+
+    CSHARK_STAT_INC(STAT_LINKLIST_INSERT);
+
+    llt->last->next = node;
+    node->next = NULL;
+    node->prev = llt->last;
+    llt->last = node;
+    llt->first = llt->head->next;
+    llt->size++;
+
+    return SUCCESS;
+}
+
+/**
+ * Add values to the tail of link list, with all nodes allocated in one block
+ * @param llt [in,out] link list
+ * @param vals [in] values
+ * @param n [in] number of values
+ * @return \0 for success, or other error code
+ */
+CODESHARK_INLINE int cshark_linklist_add_batch(cshark_linklist_t *llt, const int *vals, size_t n)
+{
+    cshark_node_t *nt;
+    size_t i;
+
+    if (llt == NULL or llt->head == NULL or (vals == NULL and n > 0))
+    {
+        return ERROR_PARAM;
+    }
+
+    if (llt->size + n > MAX_NODES)
+    {
+        return ERROR_MAX_NODES;
+    }
+
+    if (n == 0)
+    {
+        return SUCCESS;
+    }
+
+    CSHARK_STAT_ADD(STAT_LINKLIST_INSERT, n);
+
+    nt = cshark_node_init_batch(n);
+    llt->last->next = nt;
+    nt->prev = llt->last;
+    for (i = 0; i < n; i++)
+    {
+        nt->val = vals[i];
+        llt->last = nt;
+        nt = nt->next;
+    }
+
+    llt->first = llt->head->next;
+    llt->size += n;
+
+    return SUCCESS;
+}
+
+/**
+ * Add a node in linklist
+ * @param llt  [in] link list
+ * @param v    [in] value to be added
+ * @param name [in] optional value
+ * @return \0 for success, or other error code
+ */
+CODESHARK_INLINE int cshark_linklist_add_vals(cshark_linklist_t *llt, int v, string name)
+{
+    cshark_node_t *nt;
+
+    if (llt == NULL or llt->head == NULL)
+    {
+        return ERROR_PARAM;
+    }
+
+    if (llt->size == MAX_NODES)
+    {
+        return ERROR_MAX_NODES;
+    }
+
+    CSHARK_STAT_INC(STAT_LINKLIST_INSERT);
+
+    nt = cshark_node_init();
+    nt->val = v;
+    nt->name = name;
+    assert (nt != NULL);
+
+    llt->last->next = nt;
+    nt->next = NULL;
+    nt->prev = llt->last;
+    llt->last = nt;
+    llt->first = llt->head->next;
+    llt->size++;
+
+    return SUCCESS;
+}
+
+/**
+ * Get item size of a link list; head is not counted.
+ * Time complexity: O(1), the size is maintained by all functions changing the list
+ * @param llt [in] linklist pointer
+ * @return size of link list
+ * @return positive integer for success, or other error code
+ */
+CODESHARK_INLINE size_t cshark_linklist_getsize(cshark_linklist_t *llt)
+{
+    if (llt == NULL or llt->head == NULL)
+    {
+        return ERROR_PARAM;
+    }
+
+    return llt->size;
+}
+
+/**
+ * Find a node in a link list by value. If there are multiple nodes with same value,
+ * return the first node.
+ * @param llt [in] link list
+ * @param v   [in] value to find
+ * @return \NULL if not found, else valid node pointer
+ */
+CODESHARK_INLINE cshark_node_t *cshark_linklist_find_val(cshark_linklist_t *llt, int v)
+{
+    cshark_node_t *nt;
+    cshark_node_t *found;
+
+    if (llt == NULL)
+    {
+        return NULL;
+    }
+
+    found = NULL;
+    nt = llt->head;
+    while (nt != NULL)
+    {
+        if (nt->val != v)
+        {
+            nt = nt->next;
+        }
+        else
+        {
+            found = nt;
+            break;
+        }
+    }
+
+    return found;
+}
+
+/**
+ * Find a node in a link list by position(pos 1 means the first node following head)
+ * @param llt [in] link list
+ * @param pos [in] position
+ * @return \NULL if not found, else valid node pointer
+ */
+CODESHARK_INLINE cshark_node_t *cshark_linklist_find_pos(cshark_linklist_t *llt, size_t pos)
+{
+    cshark_node_t *nt;
+    int i = 0;
+
+    if (llt == NULL)
+    {
+        return NULL;
+    }
+
+    nt = llt->head;
+    while (nt != NULL)
+    {
+        if (i == pos)
+        {
+            break;
+        }
+
+        nt = nt->next;
+        i++;
+    }
+
+    return nt;
+}
+
+
+/**
+ * Print a link list
+ * @param llt [in] link list
+ */
+CODESHARK_INLINE void cshark_linklist_print(cshark_linklist_t *llt)
+{
+    cshark_node_t *nt;
+
+    if (llt == NULL)
+    {
+        return;
+    }
+
+    nt = llt->head;
+    printf("==== Print link list ===\n");
+    while (nt != NULL)
+    {
+        printf("%d  ", nt->val);
+        nt = nt->next;
+    }
+
+    printf("\n");
+}
+
+/**
+ * Delete a node from link list; if there are  nodes having the same value, delete the first one.
+ * @param llt [in,out] link list pointer
+ * @param val [in] value that the node is to be deleted
+ * @return \0 for success, or other error code
+ */
+CODESHARK_INLINE int cshark_linklist_delete_val(cshark_linklist_t *llt, int val)
+{
+    cshark_node_t *nt;
+    cshark_node_t *nxt;
+    cshark_node_t *pre;
+    bool flag;
+    int ret;
+    size_t walk;
+
+    if (llt == NULL or llt->head == NULL)
+    {
+        return -1;
+    }
+
+    nt = llt->head->next;  // head is not a value node
+    flag = false;
+    ret = ERROR_NOT_FOUND;
+    walk = 0;
+    while (nt != NULL)
+    {
+        if (nt->val == val)
+        {
+            CSHARK_STAT_INC(STAT_LINKLIST_DELETE);
+            CSHARK_STAT_RECORD(STAT_HIST_LINKLIST_WALK, walk);
+
+            if (nt->next == NULL)   // last node
+            {
+                llt->last = nt->prev;
+                nt->prev->next = NULL;
+                nt->prev = NULL;
+                nt->next = NULL;
+
+                delete(nt);
+            }
+            else
+            {
+                pre = nt->prev;
+                nxt = nt->next;
+
+                pre->next = nxt;
+                nxt->prev = pre;
+
+                delete(nt);
+            }
+
+            llt->first = llt->head->next;
+            llt->size--;
+            flag = true;
+            break;
+        }
+
+        nt = nt->next;
+        walk++;
+    }
+
+    if (flag == true)   // found node and deleted
+    {
+        ret = 0;
+    }
+
+
+    return ret;
+}
+
+/**
+ * Delete a node in a link list by position, and update the last node
+ * @param llt [in,out] linklist
+ * @param pos [in] position
+ * @param val [out] deleted node's value
+ * @return \0 for success, or other error code
+ */
+CODESHARK_INLINE int cshark_linklist_delete_pos(cshark_linklist_t *llt, size_t pos, int *val)
+{
+    cshark_node_t *nt;
+    cshark_node_t *pre;
+    cshark_node_t *nxt;
+
+    if (llt == NULL || pos == 0 or val == NULL)  // not allowed to delete head
+    {
+        return ERROR_PARAM;
+    }
+
+    nt = cshark_linklist_find_pos(llt, pos);
+
+    if (nt == NULL)
+    {
+        return ERROR_NOT_FOUND;
+    }
+
+    nxt = nt->next;
+    pre = nt->prev;
+
+    if (nt->next == NULL)  // last node
+    {
+        pre->next = NULL;
+        llt->last = pre;
+    }
+    else
+    {
+        pre->next = nxt;
+        nxt->prev = pre;
+    }
+
+    *val = nt->val;
+    delete(nt);
+
+    CSHARK_STAT_INC(STAT_LINKLIST_DELETE);
+    CSHARK_STAT_RECORD(STAT_HIST_LINKLIST_WALK, pos);
+
+    // if linklist has only one node, last will be root (which should be NULL, the first non-root node)
+    llt->first = llt->head->next;
+    llt->size--;
+
+    return SUCCESS;
+}
+
+/**
+ * Reverse a linklist inplace
+ * Time complexity: O(N)
+ * @param llt [in,out] linklist
+ * @return \0 for success, or other error code
+ */
+CODESHARK_INLINE int cshark_linklist_reverse(cshark_linklist_t *llt)
+{
+    size_t n;
+    int i;
+    cshark_node_t *last;
+    cshark_node_t *curr;
+    cshark_node_t *tmp;
+
+    if (llt == NULL or llt->head == NULL)
+    {
+        return ERROR_PARAM;
+    }
+
+    n = cshark_linklist_getsize(llt);
+
+    if (n == 0)  // only head
+    {
+        return SUCCESS;
+    }
+
+    last = llt->last;
+    llt->last = llt->head->next;
+
+    curr = llt->head;
+    for (i = 0; i < n; i++)
+    {
+        tmp = last->prev;
+
+        curr->next = last;
+        last->prev = curr;
+        last->next = NULL;
+        curr = last;
+        last = tmp;
+    }
+
+    llt->first = llt->head->next;
+
+    return SUCCESS;
+}
+
+/**
+ * Get last node of link list
+ * @return last node of linklist
+ * @return NULL if the list has only root, or valid pointer
+ */
+CODESHARK_INLINE cshark_node_t* cshark_linklist_get_last(cshark_linklist_t *llt)
+{
+    cshark_node_t *node;
+
+    if (llt == NULL or llt->size == 0)
+    {
+        return NULL;
+    }
+    else
+    {
+        node = llt->last;
+    }
+
+    assert (node != NULL);
+    return node;
+}
+
+/**
+ * Get first node of link list; return NULL if the list has only root.
+ * @return first node of linklist
+ */
+CODESHARK_INLINE cshark_node_t* cshark_linklist_get_first(cshark_linklist_t *llt)
+{
+    cshark_node_t *node;
+
+    if (llt == NULL or llt->size == 0)
+    {
+        return NULL;
+    }
+    else
+    {
+        node = llt->head->next;
+    }
+
+    assert (node != NULL);
+    return node;
+}
+
+
+/**
+ * Delete the last node of linklist, and keep its value
+ * Time complexity: O(1), the node is unlinked through its prev pointer
+ * @param llt [in,out] linklist
+ * @param val [out] value of deleted node
+ * @return \0 on success, ERROR_PARAM, or ERROR_TARGET_EMPTY if the linklist is empty
+ */
+CODESHARK_INLINE int cshark_linklist_delete_last(cshark_linklist_t *llt, int *val)
+{
+    cshark_node_t *node;
+
+    if (llt == NULL or val == NULL)
+    {
+        return ERROR_PARAM;
+    }
+
+    node = cshark_linklist_get_last(llt);
+    if (node == NULL)
+    {
+        return ERROR_TARGET_EMPTY;
+    }
+
+    node->prev->next = NULL;
+    llt->last = node->prev;
+    *val = node->val;
+    delete(node);
+
+    CSHARK_STAT_INC(STAT_LINKLIST_DELETE);
+
+    // if linklist had only one node, last is the root again
+    llt->first = llt->head->next;
+    llt->size--;
+
+    return SUCCESS;
+}
+
+CODESHARK_INLINE int cshark_linklist_delete_first(cshark_linklist_t *llt, int *val)
+{
+    cshark_node_t *node;
+
+    if (llt == NULL or val == NULL)
+    {
+        return ERROR_PARAM;
+    }
+
+    node = cshark_linklist_get_first(llt);
+    if (node == NULL)
+    {
+        *val = ERROR_INVALID_VALUE;
+        return ERROR_TARGET_EMPTY;
+    }
+
+    cshark_linklist_delete_pos(llt, 1, val);
+    return SUCCESS;
+}
+
+/**
+ * Pop the first node from linklist, and return a copy
+ * \warning caller must manually free the return node
+ * @param llt [in] linklist
+ * @return valid node, or \NULL if the linklikst is empty
+ */
+CODESHARK_INLINE cshark_node_t* cshark_linklist_pop_first(cshark_linklist_t *llt)
+{
+    cshark_node_t *node;
+    cshark_node_t *first;
+    int v;
+
+    if (llt == NULL)
+    {
+        return NULL;
+    }
+
+    first = cshark_linklist_get_first(llt);
+    if (first == NULL)
+    {
+        return NULL;
+    }
+
+    node = cshark_node_init();
+    cshark_node_copy(first, node);
+    cshark_linklist_delete_first(llt, &v);
+
+    return node;
+}
+
+/**
+ * Pop the last node from linklist, which is NOT a copy of last node
+ * \warning caller must manually free the return node
+ * @param llt [in] linklist
+ * @return valid node, or \NULL if the linklikst is empty
+ */
+CODESHARK_INLINE cshark_node_t* cshark_linklist_pop_last(cshark_linklist_t *llt)
+{
+    cshark_node_t *node;
+    cshark_node_t *last;
+    int v;
+
+    if (llt == NULL)
+    {
+        return NULL;
+    }
+
+    last = cshark_linklist_get_last(llt);
+    if (last == NULL)
+    {
+        return NULL;
+    }
+
+    llt->last = last->prev;
+    last->prev->next = NULL;
+    last->prev = NULL;
+    llt->first = llt->head->next;
+    llt->size--;
+    return last;
+}
+
+/**
+ * Delete up to n nodes from the front of linklist, and keep their values
+ * @param llt [in,out] linklist
+ * @param vals [out] values of deleted nodes, in list order
+ * @param n [in] maximum number of nodes to delete
+ * @return number of deleted nodes
+ */
+CODESHARK_INLINE size_t cshark_linklist_delete_first_batch(cshark_linklist_t *llt, int *vals, size_t n)
+{
+    cshark_node_t *nt;
+    cshark_node_t *nxt;
+    size_t k;
+
+    if (llt == NULL or llt->head == NULL or vals == NULL)
+    {
+        return 0;
+    }
+
+    k = 0;
+    nt = llt->head->next;
+    while (k < n and nt != NULL)
+    {
+        vals[k++] = nt->val;
+        nxt = nt->next;
+        delete(nt);
+        nt = nxt;
+    }
+
+    llt->head->next = nt;
+    if (nt != NULL)
+    {
+        nt->prev = llt->head;
+    }
+    else
+    {
+        llt->last = llt->head;
+    }
+    llt->first = nt;
+    llt->size -= k;
+
+    CSHARK_STAT_ADD(STAT_LINKLIST_DELETE, k);
+
+    return k;
+}
+
+/**
+ * Compare nodes by val
+ */
+CODESHARK_INLINE bool cshark_node_less_val(const cshark_node_t *a, const cshark_node_t *b)
+{
+    return a->val < b->val;
+}
+
+/**
+ * Compare nodes by name
+ */
+CODESHARK_INLINE bool cshark_node_less_name(const cshark_node_t *a, const cshark_node_t *b)
+{
+    return a->name < b->name;
+}
+
+/**
+ * Merge two sorted lists linked by next; equal nodes are taken from a first, which keeps sorting stable
+ * @return first node of the merged list
+ */
+template <typename Less>
+inline cshark_node_t *_cshark_linklist_merge(cshark_node_t *a, cshark_node_t *b, Less less)
+{
+    cshark_node_t *first = NULL;
+    cshark_node_t **tail = &first;
+
+    while (a != NULL and b != NULL)
+    {
+        if (less(b, a))
+        {
+            *tail = b;
+            b = b->next;
+        }
+        else
+        {
+            *tail = a;
+            a = a->next;
+        }
+        tail = &(*tail)->next;
+    }
+
+    *tail = (a != NULL) ? a : b;
+    return first;
+}
+
+/**
+ * Sort nodes after head in place by bottom-up merge sort, without recursion or allocation.
+ * bins[i] is NULL or a sorted run of 2^i nodes; each node is merged in like a carry of a
+ * binary counter, so sublists never need to be walked to find their middle.
+ * prev pointers are rebuilt in one pass at the end.
+ * @param head [in,out] head node of the list
+ * @return last node, or head if the list is empty
+ */
+template <typename Less>
+inline cshark_node_t *_cshark_linklist_merge_sort(cshark_node_t *head, Less less)
+{
+    cshark_node_t *bins[64] = {NULL};
+    cshark_node_t *run;
+    cshark_node_t *next;
+    cshark_node_t *prev;
+    int i, max_bin = 0;
+
+    run = head->next;
+    while (run != NULL)
+    {
+        next = run->next;
+        run->next = NULL;
+
+        for (i = 0; i < max_bin and bins[i] != NULL; i++)
+        {
+            run = _cshark_linklist_merge(bins[i], run, less);   // bins[i] holds earlier nodes
+            bins[i] = NULL;
+        }
+
+        bins[i] = run;
+        if (i == max_bin)
+        {
+            max_bin++;
+        }
+
+        run = next;
+    }
+
+    run = NULL;
+    for (i = 0; i < max_bin; i++)
+    {
+        if (bins[i] != NULL)
+        {
+            run = _cshark_linklist_merge(bins[i], run, less);
+        }
+    }
+
+    prev = head;
+    prev->next = run;
+    while (run != NULL)
+    {
+        run->prev = prev;
+        prev = run;
+        run = run->next;
+    }
+
+    return prev;
+}
+
+/**
+ * Sort a linklist by val in ascending order, relinking nodes in place (stable)
+ * Time complexity: O(NlogN), no allocation
+ * @param llt [in,out] linklist
+ * @return \0 on success, or other error code
+ */
+CODESHARK_INLINE int cshark_linklist_sort(cshark_linklist_t *llt)
+{
+    if (llt == NULL or llt->head == NULL)
+    {
+        return ERROR_PARAM;
+    }
+
+    llt->last = _cshark_linklist_merge_sort(llt->head, cshark_node_less_val_op());
+    llt->first = llt->head->next;
+
+    return SUCCESS;
+}
+
+/**
+ * Stable sort of a linklist by a key of nodes, e.g., cshark_node_less_name;
+ * nodes with equal keys keep their order.
+ * @param llt [in,out] linklist
+ * @param less [in] returns \true if the key of a is less than the key of b
+ * @return \0 on success, or other error code
+ */
+CODESHARK_INLINE int cshark_linklist_sort_by(cshark_linklist_t *llt, cshark_node_less_t less)
+{
+    if (llt == NULL or llt->head == NULL or less == NULL)
+    {
+        return ERROR_PARAM;
+    }
+
+    llt->last = _cshark_linklist_merge_sort(llt->head, less);
+    llt->first = llt->head->next;
+
+    return SUCCESS;
+}
+
+/**
+ * Link the chain first...last after pos
+ */
+inline void _cshark_linklist_link_after(cshark_node_t *pos, cshark_node_t *first, cshark_node_t *last)
+{
+    last->next = pos->next;
+    if (pos->next != NULL)
+    {
+        pos->next->prev = last;
+    }
+
+    pos->next = first;
+    first->prev = pos;
+}
+
+/**
+ * Unlink the chain first...last from its list; first->prev always exists, as head precedes all nodes
+ */
+inline void _cshark_linklist_unlink(cshark_node_t *first, cshark_node_t *last)
+{
+    first->prev->next = last->next;
+    if (last->next != NULL)
+    {
+        last->next->prev = first->prev;
+    }
+
+    first->prev = NULL;
+    last->next = NULL;
+}
+
+/**
+ * Count nodes of the chain first...last
+ */
+inline size_t _cshark_linklist_count(cshark_node_t *first, cshark_node_t *last)
+{
+    size_t n = 1;
+
+    while (first != last)
+    {
+        first = first->next;
+        n++;
+    }
+
+    return n;
+}
+
+/**
+ * Move all nodes of src after a node of llt, and leave src empty
+ * Time complexity: O(1), no allocation or copy
+ * @param llt [in,out] linklist
+ * @param pos [in] node of llt, or \NULL to insert in front of the first node
+ * @param src [in,out] linklist to take nodes from
+ * @return \0 on success, or other error code
+ */
+CODESHARK_INLINE int cshark_linklist_splice(cshark_linklist_t *llt, cshark_node_t *pos, cshark_linklist_t *src)
+{
+    if (llt == NULL or src == NULL or llt == src)
+    {
+        return ERROR_PARAM;
+    }
+
+    if (src->size == 0)
+    {
+        return SUCCESS;
+    }
+
+    if (llt->size + src->size > MAX_NODES)
+    {
+        return ERROR_MAX_NODES;
+    }
+
+    if (pos == NULL)
+    {
+        pos = llt->head;
+    }
+
+    if (pos == llt->last)
+    {
+        llt->last = src->last;
+    }
+    _cshark_linklist_link_after(pos, src->head->next, src->last);
+    llt->first = llt->head->next;
+    llt->size += src->size;
+
+    src->head->next = NULL;
+    src->first = NULL;
+    src->last = src->head;
+    src->size = 0;
+
+    return SUCCESS;
+}
+
+/**
+ * Append all nodes of src to llt, and leave src empty, e.g., to merge per-thread results
+ * Time complexity: O(1), no allocation or copy
+ * @param llt [in,out] linklist
+ * @param src [in,out] linklist to take nodes from
+ * @return \0 on success, or other error code
+ */
+CODESHARK_INLINE int cshark_linklist_concat(cshark_linklist_t *llt, cshark_linklist_t *src)
+{
+    if (llt == NULL)
+    {
+        return ERROR_PARAM;
+    }
+
+    return cshark_linklist_splice(llt, llt->last, src);
+}
+
+/**
+ * Split llt before a node: the node and all nodes following it are appended to dst
+ * Time complexity: O(1) relinking, plus O(K) to count the K nodes moved
+ * @param llt [in,out] linklist
+ * @param node [in] node of llt
+ * @param dst [in,out] linklist to receive the nodes
+ * @return \0 on success, or other error code
+ */
+CODESHARK_INLINE int cshark_linklist_split(cshark_linklist_t *llt, cshark_node_t *node, cshark_linklist_t *dst)
+{
+    cshark_node_t *last;
+    size_t k;
+
+    if (llt == NULL or dst == NULL or llt == dst or node == NULL or node == llt->head)
+    {
+        return ERROR_PARAM;
+    }
+
+    last = llt->last;
+    k = _cshark_linklist_count(node, last);
+    if (dst->size + k > MAX_NODES)
+    {
+        return ERROR_MAX_NODES;
+    }
+
+    llt->last = node->prev;
+    _cshark_linklist_unlink(node, last);
+    llt->first = llt->head->next;
+    llt->size -= k;
+
+    _cshark_linklist_link_after(dst->last, node, last);
+    dst->last = last;
+    dst->first = dst->head->next;
+    dst->size += k;
+
+    return SUCCESS;
+}
+
+/**
+ * Move the nodes first...last of src after a node of llt; src may be llt itself,
+ * in which case pos must not be in first...last.
+ * Time complexity: O(1) within a list; O(K) to count the K nodes moved between lists
+ * @param llt [in,out] linklist
+ * @param pos [in] node of llt, or \NULL to insert in front of the first node
+ * @param src [in,out] linklist holding first...last
+ * @param first [in] first node to move
+ * @param last [in] last node to move, which is first or follows first in src
+ * @return \0 on success, or other error code
+ */
+CODESHARK_INLINE int cshark_linklist_move_range(cshark_linklist_t *llt, cshark_node_t *pos, cshark_linklist_t *src,
+                                                cshark_node_t *first, cshark_node_t *last)
+{
+    size_t k;
+
+    if (llt == NULL or src == NULL or first == NULL or last == NULL or first == src->head)
+    {
+        return ERROR_PARAM;
+    }
+
+    if (pos == NULL)
+    {
+        pos = llt->head;
+    }
+
+    k = 0;
+    if (llt != src)
+    {
+        k = _cshark_linklist_count(first, last);
+        if (llt->size + k > MAX_NODES)
+        {
+            return ERROR_MAX_NODES;
+        }
+    }
+
+    if (src->last == last)
+    {
+        src->last = first->prev;
+    }
+    _cshark_linklist_unlink(first, last);
+    src->first = src->head->next;
+    src->size -= k;
+
+    if (llt->last == pos)
+    {
+        llt->last = last;
+    }
+    _cshark_linklist_link_after(pos, first, last);
+    llt->first = llt->head->next;
+    llt->size += k;
+
+    return SUCCESS;
+}
+
+/**
+ * Initialize a linklist with values [0, 1, 2, ... n-1]
+ * @param n [in] number of nodes
+ */
+CODESHARK_INLINE LinkList::LinkList(size_t n)
+{
+    this->head = cshark_node_init();
+    this->head->val = 0xbeef;
+    this->tail = this->head;
+    this->size = 0;
+
+    cshark_node_t *nt;
+    cshark_node_t *curr;
+    int i;
+
+    if (n > MAX_LINKLIST_NODES)
+    {
+        return;
+    }
+
+    curr = head;
+    for (i = 0; i < n; i++)
+    {
+        nt = cshark_node_init();
+        nt->val = i;
+        curr->next = nt;
+        nt->prev = curr;
+        nt->next = NULL;
+        curr = nt;
+    }
+
+    this->tail = curr;
+    this->size = n;
+}
+
+/**
+ * Linklist destructor, which delete all nodes in the list including head
+ */
+CODESHARK_INLINE LinkList::~LinkList()
+{
+    cshark_node_t *curr;
+    cshark_node_t *tmp;
+    curr = this->head;
+
+    while (curr != NULL)
+    {
+        tmp = curr;
+        curr = curr->next;
+        delete(tmp);
+    }
+}
+
+/**
+ * Get the iterator to the first node
+ */
+CODESHARK_INLINE LinkList::iterator LinkList::begin()
+{
+    return iterator(this->head->next, &this->tail);
+}
+
+/**
+ * Get the iterator past the last node
+ */
+CODESHARK_INLINE LinkList::iterator LinkList::end()
+{
+    return iterator(NULL, &this->tail);
+}
+
+CODESHARK_INLINE LinkList::const_iterator LinkList::begin() const
+{
+    return const_iterator(this->head->next, &this->tail);
+}
+
+CODESHARK_INLINE LinkList::const_iterator LinkList::end() const
+{
+    return const_iterator(NULL, &this->tail);
+}
+
+/**
+ * Get the reverse iterator to the last node
+ */
+CODESHARK_INLINE LinkList::reverse_iterator LinkList::rbegin()
+{
+    return reverse_iterator(this->end());
+}
+
+CODESHARK_INLINE LinkList::reverse_iterator LinkList::rend()
+{
+    return reverse_iterator(this->begin());
+}
+
+/**
+ * Print a linklist
+ */
+CODESHARK_INLINE void LinkList::print()
+{
+    cshark_node_t *curr;
+
+    curr = head->next;
+    while (curr != NULL)
+    {
+        printf("%d,", curr->val);
+        curr = curr->next;
+    }
+
+    printf("\n");
+}
+
+/**
+ * Get the size of linklist
+ * @return size of linklist
+ */
+CODESHARK_INLINE size_t LinkList::get_size()
+{
+    return this->size;
+}
+
+/**
+ * Get the first node of the linklist
+ * @return  node
+ */
+CODESHARK_INLINE cshark_node_t* LinkList::get_first()
+{
+    return this->head->next;
+}
+
+/**
+ * Get the last node of the linklist
+ * @return  NULL or valid pointer of the node
+ */
+CODESHARK_INLINE cshark_node_t* LinkList::get_last()
+{
+    return (this->tail == this->head) ? NULL : this->tail;
+}
+
+/**
+ * Find node by position, the first position is 0
+ * @param pos [in] position
+ * @return NULL or valid pointer of the node
+ */
+CODESHARK_INLINE cshark_node_t* LinkList::find_by_pos(size_t pos)
+{
+    size_t i;
+    cshark_node_t *curr;
+
+    curr = head->next;
+    i = 0;
+    while (curr != NULL and i != pos)
+    {
+        curr = curr->next;
+        i++;
+    }
+
+    return curr;
+}
+
+/**
+ * Find the first node holding the value
+ * @param val [in] value to search
+ * @return NULL or valid pointer of the node
+ */
+CODESHARK_INLINE cshark_node_t* LinkList::find_by_val(int val)
+{
+    size_t i;
+    cshark_node_t *curr;
+
+    curr = head->next;
+    while (curr != NULL and curr->val != val)
+    {
+        curr = curr->next;
+        i++;
+    }
+
+    return curr;
+}
+
+/**
+ * Insert a new node at the tail of linklist
+ * @param nt [in] node
+ * @return \0 on success
+ */
+CODESHARK_INLINE int LinkList::insert_node(cshark_node_t *nt)
+{
+    CSHARK_STAT_INC(STAT_LINKLIST_INSERT);
+
+    // tail is head for an empty list
+    this->tail->next = nt;
+    nt->prev = this->tail;
+    nt->next = NULL;
+
+    this->tail = nt;
+    this->size++;
+
+    return SUCCESS;
+}
+
+/**
+ * Link a chain of n nodes first...last at the tail of linklist
+ * @return \0 on success
+ */
+CODESHARK_INLINE int LinkList::insert_chain(cshark_node_t *first, cshark_node_t *last, size_t n)
+{
+    CSHARK_STAT_ADD(STAT_LINKLIST_INSERT, n);
+
+    _cshark_linklist_link_after(this->tail, first, last);
+    this->tail = last;
+    this->size += n;
+
+    return SUCCESS;
+}
+
+/**
+ * Insert values at the tail of linklist, with all nodes allocated in one block
+ * @param vals [in] values
+ * @param n [in] number of values
+ * @return \0 on success, or other error code
+ */
+CODESHARK_INLINE int LinkList::insert_vals(const int *vals, size_t n)
+{
+    if (vals == NULL and n > 0)
+    {
+        return ERROR_PARAM;
+    }
+
+    return this->insert_range(vals, vals + n);
+}
+
+/**
+ * Insert a value at the tail of linklist
+ * @param val [in] value
+ * @return \0 on success
+ */
+CODESHARK_INLINE int LinkList::insert_val(int val)
+{
+    cshark_node_t *nt;
+    nt = cshark_node_init();
+    nt->val = val;
+
+    this->insert_node(nt);
+
+    return SUCCESS;
+}
+
+/**
+ * Delete a node by position
+ * @param pos [0] position
+ * @return \0 on success or other error code
+ */
+CODESHARK_INLINE int LinkList::delete_by_pos(size_t pos)
+{
+    size_t i;
+    cshark_node_t *curr;
+    cshark_node_t *pre;
+    cshark_node_t *nxt;
+
+    curr = head->next;
+    if (curr == NULL or (pos > (this->get_size() - 1)))  // empty list or max position
+    {
+        return ERROR_PARAM;
+    }
+
+    if (pos == this->size - 1)  // last node, without walking
+    {
+        curr = this->tail;
+    }
+
+    i = 0;
+    while (i != pos and curr != this->tail)
+    {
+        curr = curr->next;
+        i++;
+    }
+
+    CSHARK_STAT_INC(STAT_LINKLIST_DELETE);
+    CSHARK_STAT_RECORD(STAT_HIST_LINKLIST_WALK, pos);
+
+    nxt = curr->next;
+    pre = curr->prev;
+
+    pre->next = nxt;
+
+    // nxt = NULL indicating curr is the last node
+    if (nxt != NULL)
+    {
+        nxt->prev = pre;
+    }
+    else
+    {
+        this->tail = pre;
+    }
+    this->size--;
+    delete(curr);
+
+    return SUCCESS;
+}
+
+/**
+ * Delete the first node of the linklist
+ * \note: if the list is empty with only head, return ERR_PARAM
+ * @return \0 on success or other error code
+ */
+CODESHARK_INLINE int LinkList::delete_first()
+{
+    return this->delete_by_pos(0);
+}
+
+/**
+ * Delete the last node of the linklist
+ * \note: if the list is empty with only head, return ERR_PARAM
+ * @return \0 on success or other error code
+ */
+CODESHARK_INLINE int LinkList::delete_last()
+{
+    return this->delete_by_pos(this->size - 1);
+}
+
+/**
+ * Pop a node by position
+ * \warning the caller must manually free the node
+ * @param pos [in] position
+ * @return NULL or valid pointer of the node
+ */
+CODESHARK_INLINE cshark_node_t* LinkList::pop_by_pos(size_t pos)
+{
+    size_t i;
+    cshark_node_t *curr;
+    cshark_node_t *pre;
+    cshark_node_t *nxt;
+
+    curr = head->next;
+    if (curr == NULL or (pos > (this->get_size() - 1)))  // empty list or max position
+    {
+        return NULL;
+    }
+
+    if (pos == this->size - 1)  // last node, without walking
+    {
+        curr = this->tail;
+    }
+
+    i = 0;
+    while (i != pos and curr != this->tail)
+    {
+        curr = curr->next;
+        i++;
+    }
+
+    CSHARK_STAT_INC(STAT_LINKLIST_DELETE);
+    CSHARK_STAT_RECORD(STAT_HIST_LINKLIST_WALK, pos);
+
+    nxt = curr->next;
+    pre = curr->prev;
+
+    pre->next = nxt;
+
+    // nxt = NULL indicating curr is the last node
+    if (nxt != NULL)
+    {
+        nxt->prev = pre;
+    }
+    else
+    {
+        this->tail = pre;
+    }
+    this->size--;
+
+    return curr;
+}
+
+/**
+ * Pop the first node from linklist. If list is empty, return NULL
+ * \warning the caller must manually free the node
+ * @return NULL or valid pointer of the node
+ */
+CODESHARK_INLINE cshark_node_t* LinkList::pop_first()
+{
+    return this->pop_by_pos(0);
+}
+
+/**
+ * Pop the last node from linklist. If list is empty, return NULL
+ * \warning the caller must manually free the node
+ * @return \NULL or valid pointer of the node
+ */
+CODESHARK_INLINE cshark_node_t* LinkList::pop_last()
+{
+    return this->pop_by_pos(this->size - 1);
+}
+
+/**
+ * Pop up to n nodes from the front of linklist, keep their values and free the nodes
+ * @param vals [out] values, in list order
+ * @param n [in] maximum number of nodes
+ * @return number of popped nodes
+ */
+CODESHARK_INLINE size_t LinkList::pop_first_batch(int *vals, size_t n)
+{
+    cshark_node_t *nt;
+    cshark_node_t *nxt;
+    size_t k;
+
+    if (vals == NULL)
+    {
+        return 0;
+    }
+
+    k = 0;
+    nt = this->head->next;
+    while (k < n and nt != NULL)
+    {
+        vals[k++] = nt->val;
+        nxt = nt->next;
+        delete(nt);
+        nt = nxt;
+    }
+
+    this->head->next = nt;
+    if (nt != NULL)
+    {
+        nt->prev = this->head;
+    }
+    else
+    {
+        this->tail = this->head;
+    }
+    this->size -= k;
+
+    CSHARK_STAT_ADD(STAT_LINKLIST_DELETE, k);
+
+    return k;
+}
+
+/**
+ * Pop up to n nodes from the tail of linklist, keep their values and free the nodes
+ * @param vals [out] values, the last node first
+ * @param n [in] maximum number of nodes
+ * @return number of popped nodes
+ */
+CODESHARK_INLINE size_t LinkList::pop_last_batch(int *vals, size_t n)
+{
+    cshark_node_t *nt;
+    cshark_node_t *prv;
+    size_t k;
+
+    if (vals == NULL)
+    {
+        return 0;
+    }
+
+    k = 0;
+    nt = this->tail;
+    while (k < n and nt != this->head)
+    {
+        vals[k++] = nt->val;
+        prv = nt->prev;
+        delete(nt);
+        nt = prv;
+    }
+
+    nt->next = NULL;
+    this->tail = nt;
+    this->size -= k;
+
+    CSHARK_STAT_ADD(STAT_LINKLIST_DELETE, k);
+
+    return k;
+}
+
+/**
+ * Detach a linklist from head, e.g.,
+ *      original: head->0->1->2->....
+ *      now: head->(NULL)
+ * \warning Use this function at caution, as detached nodes will be  out of control!
+ * @return \0 on success
+ */
+CODESHARK_INLINE int LinkList::detach_head()
+{
+    cshark_node_t *p;
+
+    p = this->head->next;
+    this->head->next = NULL;
+    this->tail = this->head;
+    this->size = 0;
+
+    if (p != NULL)
+    {
+        p->prev = NULL;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Detach a linklist from given position
+ * \warning detach() should be used at caution, as detached nodes are out of scope
+ *          currently only support detaching head
+ * @param pos [in] position
+ *         -1: head
+ * @return \0 on success
+ */
+CODESHARK_INLINE int LinkList::detach(int pos)
+{
+    cshark_node_t *p;
+    if (pos != -1)
+    {
+        return ERROR_PARAM;
+    }
+
+    p = this->head->next;
+    this->head->next = NULL;
+    this->tail = this->head;
+    this->size = 0;
+    if (p != NULL)
+    {
+        p->prev = NULL;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Sort the linklist by val in ascending order, relinking nodes in place (stable)
+ * @return \0 on success
+ */
+CODESHARK_INLINE int LinkList::sort()
+{
+    this->tail = _cshark_linklist_merge_sort(this->head, cshark_node_less_val_op());
+
+    return SUCCESS;
+}
+
+/**
+ * Stable sort of the linklist by a key of nodes, e.g., cshark_node_less_name
+ * @param less [in] returns \true if the key of a is less than the key of b
+ * @return \0 on success, or other error code
+ */
+CODESHARK_INLINE int LinkList::sort_by(cshark_node_less_t less)
+{
+    if (less == NULL)
+    {
+        return ERROR_PARAM;
+    }
+
+    this->tail = _cshark_linklist_merge_sort(this->head, less);
+
+    return SUCCESS;
+}
+
+/**
+ * Move all nodes of another linklist after a node, and leave the other list empty
+ * Time complexity: O(1), no allocation or copy
+ * @param pos [in] node of this list, or \NULL to insert in front of the first node
+ * @param other [in,out] linklist to take nodes from
+ * @return \0 on success, or other error code
+ */
+CODESHARK_INLINE int LinkList::splice(cshark_node_t *pos, LinkList *other)
+{
+    if (other == NULL or other == this)
+    {
+        return ERROR_PARAM;
+    }
+
+    if (other->size == 0)
+    {
+        return SUCCESS;
+    }
+
+    if (pos == NULL)
+    {
+        pos = this->head;
+    }
+
+    if (pos == this->tail)
+    {
+        this->tail = other->tail;
+    }
+    _cshark_linklist_link_after(pos, other->head->next, other->tail);
+    this->size += other->size;
+
+    other->head->next = NULL;
+    other->tail = other->head;
+    other->size = 0;
+
+    return SUCCESS;
+}
+
+/**
+ * Append all nodes of another linklist, and leave the other list empty
+ * Time complexity: O(1), no allocation or copy
+ * @param other [in,out] linklist to take nodes from
+ * @return \0 on success, or other error code
+ */
+CODESHARK_INLINE int LinkList::concat(LinkList *other)
+{
+    return this->splice(this->tail, other);
+}
+
+/**
+ * Split the linklist before a node: the node and all nodes following it are appended to another list
+ * Time complexity: O(1) relinking, plus O(K) to count the K nodes moved
+ * @param nt [in] node of this list
+ * @param other [in,out] linklist to receive the nodes
+ * @return \0 on success, or other error code
+ */
+CODESHARK_INLINE int LinkList::split(cshark_node_t *nt, LinkList *other)
+{
+    cshark_node_t *last;
+    size_t k;
+
+    if (nt == NULL or nt == this->head or other == NULL or other == this)
+    {
+        return ERROR_PARAM;
+    }
+
+    last = this->tail;
+    k = _cshark_linklist_count(nt, last);
+
+    this->tail = nt->prev;
+    _cshark_linklist_unlink(nt, last);
+    this->size -= k;
+
+    _cshark_linklist_link_after(other->tail, nt, last);
+    other->tail = last;
+    other->size += k;
+
+    return SUCCESS;
+}
+
+/**
+ * Move the nodes first...last of a linklist after a node; other may be this list,
+ * in which case pos must not be in first...last.
+ * Time complexity: O(1) within a list; O(K) to count the K nodes moved between lists
+ * @param pos [in] node of this list, or \NULL to insert in front of the first node
+ * @param other [in,out] linklist holding first...last
+ * @param first [in] first node to move
+ * @param last [in] last node to move, which is first or follows first in other
+ * @return \0 on success, or other error code
+ */
+CODESHARK_INLINE int LinkList::move_range(cshark_node_t *pos, LinkList *other, cshark_node_t *first, cshark_node_t *last)
+{
+    size_t k;
+
+    if (other == NULL or first == NULL or last == NULL or first == other->head)
+    {
+        return ERROR_PARAM;
+    }
+
+    if (pos == NULL)
+    {
+        pos = this->head;
+    }
+
+    k = (other == this) ? 0 : _cshark_linklist_count(first, last);
+
+    if (other->tail == last)
+    {
+        other->tail = first->prev;
+    }
+    _cshark_linklist_unlink(first, last);
+    other->size -= k;
+
+    if (this->tail == pos)
+    {
+        this->tail = last;
+    }
+    _cshark_linklist_link_after(pos, first, last);
+    this->size += k;
+
+    return SUCCESS;
+}
+
+#endif //CODESHARK_LINKLIST_INL_H
@@ -0,0 +1,89 @@
+/*
+ ============================================================================
+ Name        : lockfree_hashtable.h
+ Description : split-ordered lock-free hash table header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_LOCKFREE_HASHTABLE_H
+#define CODESHARK_LOCKFREE_HASHTABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <string>
+
+#include "common/include/epoch.h"
+#include "datastructures/include/hahstable.h"
+
+using namespace std;
+
+#define LFHT_MAX_SEGMENTS   33          // bucket directory segments, for up to 2^32 buckets
+#define LFHT_LOAD_FACTOR    2           // entries per bucket before the bucket count doubles
+
+/**
+ * A lock-free hash table of int keys and string values (Shalev-Shavit split-ordered list).
+ *
+ * All entries are in one lock-free sorted linked list, ordered by the bit-reversed hash of
+ * their key. A bucket is a pointer to a dummy node in that list, before the entries of the
+ * bucket, so a lookup starts at its bucket and walks a few nodes only. With 4 buckets and
+ * entries of hashes 4, 3 and 7:
+ *
+ *      bucket  0            2       1       3
+ *              |            |       |       |
+ *              v            v       v       v
+ *            [d0] -> 4 -> [d2] -> [d1] -> [d3] -> 3 -> 7
+ *
+ * Reversed bits keep the entries of bucket b together, and when the bucket count doubles, the
+ * entries of the new bucket b + size follow those of b, already in place. Doubling is a single
+ * CAS of the bucket count; a new bucket gets its dummy node on first use, by splitting its
+ * parent bucket, so the table grows without moving entries or pausing threads.
+ *
+ * Buckets are kept in segments of growing size, allocated on demand, so the directory never
+ * has to be copied either. Deleted entries are marked in their next pointer, unlinked by CAS,
+ * and retired to an EpochDomain, as in LockFreeSkipList.
+ *
+ * Values are set once: lockfree_hashtable_add() does not update an existing key, since readers
+ * copy values without locks. Delete and add again to replace one.
+ */
+typedef struct _lockfree_hashtable_node_t
+{
+    uint64_t so_key;                            // split-order key, odd for entries, even for dummies
+    struct _lockfree_hashtable_node_t *next;    // low bit marks the node deleted
+    int key;
+}lockfree_hashtable_node_t;
+
+typedef struct _lockfree_hashtable_entry_t : lockfree_hashtable_node_t
+{
+    string value;
+}lockfree_hashtable_entry_t;
+
+typedef struct _lockfree_hashtable_t
+{
+    lockfree_hashtable_node_t **segments[LFHT_MAX_SEGMENTS];    // segment s holds 2^(s-1) buckets, s > 0
+    EpochDomain *domain;
+    char pad[EPOCH_CACHE_LINE];
+    atomic<size_t> buckets;                     // a power of two
+    char pad2[EPOCH_CACHE_LINE];
+    atomic<size_t> size;
+}lockfree_hashtable_t;
+
+// Lock-free hash table functions
+
+lockfree_hashtable_t *lockfree_hashtable_init(EpochDomain *domain);
+int lockfree_hashtable_destroy(lockfree_hashtable_t *ht);
+string lockfree_hashtable_find(lockfree_hashtable_t *ht, int k);
+bool lockfree_hashtable_contains(lockfree_hashtable_t *ht, int k);
+int lockfree_hashtable_add(lockfree_hashtable_t *ht, int k, const string &val);
+int lockfree_hashtable_delete(lockfree_hashtable_t *ht, int k);
+size_t lockfree_hashtable_getsize(lockfree_hashtable_t *ht);
+size_t lockfree_hashtable_get_buckets(lockfree_hashtable_t *ht);
+
+#ifdef CODESHARK_HEADER_ONLY
+#include "datastructures/include/lockfree_hashtable_inl.h"
+#endif
+
+#endif //CODESHARK_LOCKFREE_HASHTABLE_H
@@ -0,0 +1,469 @@
+/*
+ ============================================================================
+ Name        : lockfree_hashtable_inl.h
+ Description : split-ordered lock-free hash table inline implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_LOCKFREE_HASHTABLE_INL_H
+#define CODESHARK_LOCKFREE_HASHTABLE_INL_H
+
+#include "common/include/common.h"
+#include "common/include/err.h"
+#include "common/include/stats.h"
+#include "datastructures/include/lockfree_hashtable.h"
+
+#define LFHT_MARK   ((uintptr_t)1)              // nodes are 8-byte aligned, so bit 0 is free
+
+inline lockfree_hashtable_node_t *_cshark_lfht_load(lockfree_hashtable_node_t **ref)
+{
+    return __atomic_load_n(ref, __ATOMIC_ACQUIRE);
+}
+
+inline bool _cshark_lfht_cas(lockfree_hashtable_node_t **ref, lockfree_hashtable_node_t *expected,
+                             lockfree_hashtable_node_t *desired)
+{
+    return __atomic_compare_exchange_n(ref, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+
+inline bool _cshark_lfht_marked(lockfree_hashtable_node_t *p)
+{
+    return ((uintptr_t)p & LFHT_MARK) != 0;
+}
+
+inline lockfree_hashtable_node_t *_cshark_lfht_strip(lockfree_hashtable_node_t *p)
+{
+    return (lockfree_hashtable_node_t *)((uintptr_t)p & ~LFHT_MARK);
+}
+
+/**
+ * Hash a key with the finalizer of MurmurHash3, which is a bijection of 32-bit words, so
+ * different keys never share a split-order key
+ */
+inline uint32_t _cshark_lfht_hash(int key)
+{
+    uint32_t h = (uint32_t)key;
+
+    h ^= h >> 16;
+    h *= 0x85ebca6bU;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35U;
+    h ^= h >> 16;
+
+    return h;
+}
+
+inline uint64_t _cshark_lfht_reverse(uint64_t x)
+{
+    x = ((x >> 1) & 0x5555555555555555ULL) | ((x & 0x5555555555555555ULL) << 1);
+    x = ((x >> 2) & 0x3333333333333333ULL) | ((x & 0x3333333333333333ULL) << 2);
+    x = ((x >> 4) & 0x0f0f0f0f0f0f0f0fULL) | ((x & 0x0f0f0f0f0f0f0f0fULL) << 4);
+
+    return __builtin_bswap64(x);
+}
+
+// an entry sorts after the dummy of its bucket, as the top bit becomes the lowest one
+inline uint64_t _cshark_lfht_so_entry(uint32_t hash)
+{
+    return _cshark_lfht_reverse((uint64_t)hash | (1ULL << 63));
+}
+
+inline uint64_t _cshark_lfht_so_dummy(size_t bucket)
+{
+    return _cshark_lfht_reverse((uint64_t)bucket);
+}
+
+inline void _cshark_lfht_free_node(void *p)
+{
+    lockfree_hashtable_node_t *node = (lockfree_hashtable_node_t *)p;
+
+    if (node->so_key & 1)
+    {
+        delete((lockfree_hashtable_entry_t *)node);
+    }
+    else
+    {
+        delete(node);
+    }
+}
+
+/**
+ * Get the slot of a bucket in the directory, allocating its segment on first use
+ * @return slot holding the dummy node of the bucket, or \NULL until it is initialized
+ */
+inline lockfree_hashtable_node_t **_cshark_lfht_bucket_ref(lockfree_hashtable_t *ht, size_t bucket)
+{
+    lockfree_hashtable_node_t **segment;
+    lockfree_hashtable_node_t **fresh;
+    size_t s = (bucket == 0) ? 0 : 64 - __builtin_clzll(bucket);
+    size_t base = (s == 0) ? 0 : (size_t)1 << (s - 1);
+
+    segment = __atomic_load_n(&ht->segments[s], __ATOMIC_ACQUIRE);
+    if (segment == NULL)
+    {
+        fresh = new lockfree_hashtable_node_t *[(s == 0) ? 1 : base]();
+        if (__atomic_compare_exchange_n(&ht->segments[s], &segment, fresh, false,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+        {
+            segment = fresh;
+        }
+        else
+        {
+            delete[] fresh;
+        }
+    }
+
+    return &segment[bucket - base];
+}
+
+/**
+ * Find the position of a split-order key in the list after a dummy node, unlinking and retiring
+ * deleted nodes on the way
+ * @param head [in] dummy node to start from
+ * @param so_key [in] split-order key
+ * @param pred [out] last node before so_key, never deleted when found
+ * @param curr [out] first node from so_key on, or \NULL
+ * @return \true if curr holds so_key
+ * \warning the calling thread must be pinned
+ */
+inline bool _cshark_lfht_list_find(lockfree_hashtable_t *ht, lockfree_hashtable_node_t *head, uint64_t so_key,
+                                   lockfree_hashtable_node_t **pred, lockfree_hashtable_node_t **curr)
+{
+    lockfree_hashtable_node_t *p;
+    lockfree_hashtable_node_t *c;
+    lockfree_hashtable_node_t *succ;
+
+retry:
+    p = head;
+    c = _cshark_lfht_strip(_cshark_lfht_load(&p->next));
+    while (c != NULL)
+    {
+        succ = _cshark_lfht_load(&c->next);
+        if (_cshark_lfht_marked(succ))
+        {
+            // a marked p fails the CAS; the thread which unlinks a node retires it
+            if (!_cshark_lfht_cas(&p->next, c, _cshark_lfht_strip(succ)))
+            {
+                goto retry;
+            }
+            ht->domain->retire(c, _cshark_lfht_free_node);
+            c = _cshark_lfht_strip(succ);
+            continue;
+        }
+
+        if (c->so_key >= so_key)
+        {
+            break;
+        }
+
+        p = c;
+        c = succ;
+    }
+
+    *pred = p;
+    *curr = c;
+    return c != NULL and c->so_key == so_key;
+}
+
+/**
+ * Get the dummy node of a bucket, splitting it off its parent bucket on first use; the parent
+ * is the bucket without the top bit, whose entries the new bucket takes over
+ */
+inline lockfree_hashtable_node_t *_cshark_lfht_get_bucket(lockfree_hashtable_t *ht, size_t bucket)
+{
+    lockfree_hashtable_node_t **ref = _cshark_lfht_bucket_ref(ht, bucket);
+    lockfree_hashtable_node_t *dummy = _cshark_lfht_load(ref);
+    lockfree_hashtable_node_t *parent;
+    lockfree_hashtable_node_t *pred;
+    lockfree_hashtable_node_t *curr;
+
+    if (dummy != NULL)
+    {
+        return dummy;
+    }
+
+    parent = _cshark_lfht_get_bucket(ht, bucket & ~((size_t)1 << (63 - __builtin_clzll(bucket))));
+
+    dummy = new lockfree_hashtable_node_t();
+    dummy->so_key = _cshark_lfht_so_dummy(bucket);
+    dummy->key = 0;
+    while (true)
+    {
+        // another thread may have linked the dummy first
+        if (_cshark_lfht_list_find(ht, parent, dummy->so_key, &pred, &curr))
+        {
+            delete(dummy);
+            dummy = curr;
+            break;
+        }
+
+        dummy->next = curr;
+        if (_cshark_lfht_cas(&pred->next, curr, dummy))
+        {
+            break;
+        }
+    }
+
+    __atomic_store_n(ref, dummy, __ATOMIC_RELEASE);
+    return dummy;
+}
+
+/**
+ * Get the dummy node of the bucket of a hash, at the current bucket count
+ */
+inline lockfree_hashtable_node_t *_cshark_lfht_head(lockfree_hashtable_t *ht, uint32_t hash)
+{
+    return _cshark_lfht_get_bucket(ht, hash & (ht->buckets.load(memory_order_acquire) - 1));
+}
+
+/**
+ * Find an entry without writing to the list; deleted entries are passed, not unlinked
+ * \warning the calling thread must be pinned
+ */
+inline lockfree_hashtable_entry_t *_cshark_lfht_lookup(lockfree_hashtable_t *ht, int key)
+{
+    uint32_t hash = _cshark_lfht_hash(key);
+    uint64_t so_key = _cshark_lfht_so_entry(hash);
+    lockfree_hashtable_node_t *curr;
+
+    curr = _cshark_lfht_strip(_cshark_lfht_load(&_cshark_lfht_head(ht, hash)->next));
+    while (curr != NULL and curr->so_key < so_key)
+    {
+        curr = _cshark_lfht_strip(_cshark_lfht_load(&curr->next));
+    }
+
+    if (curr == NULL or curr->so_key != so_key or _cshark_lfht_marked(_cshark_lfht_load(&curr->next)))
+    {
+        return NULL;
+    }
+
+    return (lockfree_hashtable_entry_t *)curr;
+}
+
+/**
+ * Initialize a new lock-free hash table, with 2 buckets
+ * @param domain [in] domain retiring deleted entries, \NULL for EpochDomain::get_default()
+ * @return hash table
+ */
+CODESHARK_INLINE lockfree_hashtable_t *lockfree_hashtable_init(EpochDomain *domain)
+{
+    lockfree_hashtable_t *ht;
+    lockfree_hashtable_node_t *dummy;
+
+    ht = new lockfree_hashtable_t();
+    ht->domain = (domain == NULL) ? EpochDomain::get_default() : domain;
+    ht->buckets.store(2);
+    ht->size.store(0);
+
+    dummy = new lockfree_hashtable_node_t();
+    dummy->so_key = _cshark_lfht_so_dummy(0);
+    dummy->next = NULL;
+    dummy->key = 0;
+    *_cshark_lfht_bucket_ref(ht, 0) = dummy;
+
+    return ht;
+}
+
+/**
+ * Destroy a lock-free hash table and the entries in it; entries deleted before are freed by
+ * the domain
+ * @param ht [in] hash table
+ * @return \0 on success, or ERROR_PARAM
+ * \warning no other thread may use the table any more
+ */
+CODESHARK_INLINE int lockfree_hashtable_destroy(lockfree_hashtable_t *ht)
+{
+    lockfree_hashtable_node_t *node;
+    lockfree_hashtable_node_t *next;
+    size_t s;
+
+    if (ht == NULL)
+    {
+        return ERROR_PARAM;
+    }
+
+    for (node = ht->segments[0][0]; node != NULL; node = next)
+    {
+        next = _cshark_lfht_strip(node->next);
+        _cshark_lfht_free_node(node);
+    }
+
+    for (s = 0; s < LFHT_MAX_SEGMENTS; s++)
+    {
+        delete[] ht->segments[s];
+    }
+
+    delete(ht);
+    return SUCCESS;
+}
+
+/**
+ * Find the value of a key
+ * @param ht [in] hash table
+ * @param key [in] key
+ * @return value, or HASH_NOT_FOUND
+ */
+CODESHARK_INLINE string lockfree_hashtable_find(lockfree_hashtable_t *ht, int key)
+{
+    EpochGuard guard(ht->domain);
+    lockfree_hashtable_entry_t *entry;
+
+    CSHARK_STAT_INC(STAT_HASHTABLE_FIND);
+
+    entry = _cshark_lfht_lookup(ht, key);
+    if (entry == NULL)
+    {
+        CSHARK_STAT_INC(STAT_HASHTABLE_FIND_MISS);
+        return HASH_NOT_FOUND;
+    }
+
+    return entry->value;
+}
+
+/**
+ * Check if a key is in the table
+ */
+CODESHARK_INLINE bool lockfree_hashtable_contains(lockfree_hashtable_t *ht, int key)
+{
+    EpochGuard guard(ht->domain);
+
+    return _cshark_lfht_lookup(ht, key) != NULL;
+}
+
+/**
+ * Add an entry; the table doubles its bucket count once entries exceed LFHT_LOAD_FACTOR per bucket
+ * @param ht [in] hash table
+ * @param key [in] key
+ * @param value [in] value
+ * @return \0 on success, ERROR_EXISTS if the key is in the table, or ERROR_PARAM
+ */
+CODESHARK_INLINE int lockfree_hashtable_add(lockfree_hashtable_t *ht, int key, const string &value)
+{
+    lockfree_hashtable_entry_t *entry;
+    lockfree_hashtable_node_t *head;
+    lockfree_hashtable_node_t *pred;
+    lockfree_hashtable_node_t *curr;
+    uint32_t hash;
+    size_t buckets;
+    size_t size;
+
+    if (ht == NULL)
+    {
+        return ERROR_PARAM;
+    }
+
+    CSHARK_STAT_INC(STAT_HASHTABLE_ADD);
+
+    hash = _cshark_lfht_hash(key);
+    entry = new lockfree_hashtable_entry_t();
+    entry->so_key = _cshark_lfht_so_entry(hash);
+    entry->key = key;
+    entry->value = value;
+
+    {
+        EpochGuard guard(ht->domain);
+
+        head = _cshark_lfht_head(ht, hash);
+        while (true)
+        {
+            if (_cshark_lfht_list_find(ht, head, entry->so_key, &pred, &curr))
+            {
+                delete(entry);
+                return ERROR_EXISTS;
+            }
+
+            entry->next = curr;
+            if (_cshark_lfht_cas(&pred->next, curr, entry))
+            {
+                break;
+            }
+        }
+    }
+
+    // the thread crossing the load factor doubles the buckets; new ones are split off lazily
+    size = ht->size.fetch_add(1) + 1;
+    buckets = ht->buckets.load(memory_order_relaxed);
+    if (size > buckets * LFHT_LOAD_FACTOR and buckets < ((size_t)1 << (LFHT_MAX_SEGMENTS - 1)))
+    {
+        ht->buckets.compare_exchange_strong(buckets, buckets * 2);
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Delete the entry of a key
+ * @param ht [in] hash table
+ * @param key [in] key
+ * @return \0 on success, ERROR_NOT_FOUND if the key is not in the table, or another thread
+ *         deleted it first, or ERROR_PARAM
+ */
+CODESHARK_INLINE int lockfree_hashtable_delete(lockfree_hashtable_t *ht, int key)
+{
+    lockfree_hashtable_node_t *head;
+    lockfree_hashtable_node_t *pred;
+    lockfree_hashtable_node_t *curr;
+    lockfree_hashtable_node_t *succ;
+    uint64_t so_key;
+    uint32_t hash;
+
+    if (ht == NULL)
+    {
+        return ERROR_PARAM;
+    }
+
+    EpochGuard guard(ht->domain);
+
+    hash = _cshark_lfht_hash(key);
+    so_key = _cshark_lfht_so_entry(hash);
+    head = _cshark_lfht_head(ht, hash);
+
+    // the thread which marks the entry deletes it
+    while (true)
+    {
+        if (!_cshark_lfht_list_find(ht, head, so_key, &pred, &curr))
+        {
+            return ERROR_NOT_FOUND;
+        }
+
+        succ = _cshark_lfht_load(&curr->next);
+        if (!_cshark_lfht_marked(succ) and
+            _cshark_lfht_cas(&curr->next, succ, (lockfree_hashtable_node_t *)((uintptr_t)succ | LFHT_MARK)))
+        {
+            break;
+        }
+    }
+    ht->size.fetch_sub(1);
+
+    if (_cshark_lfht_cas(&pred->next, curr, succ))
+    {
+        ht->domain->retire(curr, _cshark_lfht_free_node);
+    }
+    else
+    {
+        _cshark_lfht_list_find(ht, head, so_key, &pred, &curr);
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Get the number of entries; it may be outdated as soon as it is returned
+ */
+CODESHARK_INLINE size_t lockfree_hashtable_getsize(lockfree_hashtable_t *ht)
+{
+    return ht->size.load();
+}
+
+/**
+ * Get the number of buckets, a power of two; buckets get their dummy node on first use
+ */
+CODESHARK_INLINE size_t lockfree_hashtable_get_buckets(lockfree_hashtable_t *ht)
+{
+    return ht->buckets.load();
+}
+
+#endif //CODESHARK_LOCKFREE_HASHTABLE_INL_H
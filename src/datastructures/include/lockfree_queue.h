@@ -0,0 +1,64 @@
+/*
+ ============================================================================
+ Name        : lockfree_queue.h
+ Description : lock-free queue header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_LOCKFREE_QUEUE_H
+#define CODESHARK_LOCKFREE_QUEUE_H
+
+#include <stddef.h>
+#include <atomic>
+
+#include "common/include/node.h"
+#include "common/include/epoch.h"
+
+using namespace std;
+
+/**
+ * @class LockFreeQueue is a multi-producer, multi-consumer FIFO queue without locks
+ *        (Michael-Scott queue), for threads which would otherwise share a Queue under a mutex.
+ *
+ * The queue is a list of cshark_node_t linked by next, starting with a dummy node:
+ *
+ *      head -> dummy -> n1 -> n2 -> ... -> nk <- tail
+ *
+ * enqueue() links a node after the last one with a CAS on next, and dequeue() moves head
+ * to the next node with a CAS, which becomes the new dummy. A thread may be delayed at any
+ * step, so others finish its step, e.g., advance a lagging tail, instead of waiting for it.
+ * The old dummy is retired to an EpochDomain, as other threads may still read it.
+ *
+ * head and tail are on separate cache lines, so producers and consumers do not contend
+ * while the queue is not empty.
+ */
+class LockFreeQueue
+{
+private:
+    atomic<cshark_node_t *> head;
+    char pad_head[EPOCH_CACHE_LINE];
+    atomic<cshark_node_t *> tail;
+    char pad_tail[EPOCH_CACHE_LINE];
+    EpochDomain *domain;
+
+public:
+    LockFreeQueue(EpochDomain *domain = NULL);
+    ~LockFreeQueue();
+
+    LockFreeQueue(const LockFreeQueue &) = delete;
+    LockFreeQueue &operator=(const LockFreeQueue &) = delete;
+
+    bool is_empty();
+    int enqueue(int val);
+    int enqueue(cshark_node_t *nt);
+    int dequeue(int *val);
+};
+
+#ifdef CODESHARK_HEADER_ONLY
+#include "datastructures/include/lockfree_queue_inl.h"
+#endif
+
+#endif //CODESHARK_LOCKFREE_QUEUE_H
@@ -0,0 +1,167 @@
+/*
+ ============================================================================
+ Name        : lockfree_queue_inl.h
+ Description : lock-free queue inline implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_LOCKFREE_QUEUE_INL_H
+#define CODESHARK_LOCKFREE_QUEUE_INL_H
+
+#include "common/include/common.h"
+#include "common/include/err.h"
+#include "datastructures/include/lockfree_queue.h"
+
+// next of a queued node is written by CAS while other threads read it, like bitmap words
+inline cshark_node_t *_cshark_lfqueue_load_next(cshark_node_t *nt)
+{
+    return __atomic_load_n(&nt->next, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * Initialize an empty queue
+ * @param domain [in] domain retiring dequeued nodes, \NULL for EpochDomain::get_default()
+ */
+CODESHARK_INLINE LockFreeQueue::LockFreeQueue(EpochDomain *domain)
+{
+    cshark_node_t *dummy = cshark_node_init();
+
+    this->head.store(dummy, memory_order_relaxed);
+    this->tail.store(dummy, memory_order_relaxed);
+    this->domain = (domain == NULL) ? EpochDomain::get_default() : domain;
+}
+
+/**
+ * Delete the queue and the nodes in it
+ * \warning no other thread may use the queue any more
+ */
+CODESHARK_INLINE LockFreeQueue::~LockFreeQueue()
+{
+    cshark_node_t *nt = this->head.load(memory_order_relaxed);
+    cshark_node_t *next;
+
+    while (nt != NULL)
+    {
+        next = nt->next;
+        cshark_node_free(nt);
+        nt = next;
+    }
+}
+
+CODESHARK_INLINE bool LockFreeQueue::is_empty()
+{
+    EpochGuard guard(this->domain);
+
+    return _cshark_lfqueue_load_next(this->head.load(memory_order_acquire)) == NULL;
+}
+
+/**
+ * Enqueue a new node of a value
+ * @param val [in] value
+ * @return \0 on success
+ */
+CODESHARK_INLINE int LockFreeQueue::enqueue(int val)
+{
+    cshark_node_t *nt = cshark_node_init();
+
+    nt->val = val;
+    return this->enqueue(nt);
+}
+
+/**
+ * Enqueue a node; the queue owns the node, which is freed after it is dequeued
+ * @param nt [in] node, with next set by the queue
+ * @return \0 on success, or other error code
+ */
+CODESHARK_INLINE int LockFreeQueue::enqueue(cshark_node_t *nt)
+{
+    cshark_node_t *tail;
+    cshark_node_t *next;
+
+    if (nt == NULL)
+    {
+        return ERROR_PARAM;
+    }
+
+    nt->next = NULL;
+
+    EpochGuard guard(this->domain);
+    while (true)
+    {
+        tail = this->tail.load(memory_order_acquire);
+        next = _cshark_lfqueue_load_next(tail);
+        if (tail != this->tail.load(memory_order_acquire))
+        {
+            continue;
+        }
+
+        if (next != NULL)
+        {
+            // tail is lagging behind; help the enqueue in progress before retrying
+            this->tail.compare_exchange_weak(tail, next, memory_order_release, memory_order_relaxed);
+            continue;
+        }
+
+        if (__atomic_compare_exchange_n(&tail->next, &next, nt, false, __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+        {
+            // may fail if another thread has already advanced it
+            this->tail.compare_exchange_strong(tail, nt, memory_order_release, memory_order_relaxed);
+            return SUCCESS;
+        }
+    }
+}
+
+/**
+ * Dequeue the value at the front
+ * @param val [out] value
+ * @return \0 on success, ERROR_TARGET_EMPTY if the queue is empty, or other error code
+ */
+CODESHARK_INLINE int LockFreeQueue::dequeue(int *val)
+{
+    cshark_node_t *head;
+    cshark_node_t *tail;
+    cshark_node_t *next;
+    int v;
+
+    if (val == NULL)
+    {
+        return ERROR_PARAM;
+    }
+
+    EpochGuard guard(this->domain);
+    while (true)
+    {
+        head = this->head.load(memory_order_acquire);
+        tail = this->tail.load(memory_order_acquire);
+        next = _cshark_lfqueue_load_next(head);
+        if (head != this->head.load(memory_order_acquire))
+        {
+            continue;
+        }
+
+        if (next == NULL)
+        {
+            return ERROR_TARGET_EMPTY;
+        }
+
+        if (head == tail)
+        {
+            this->tail.compare_exchange_weak(tail, next, memory_order_release, memory_order_relaxed);
+            continue;
+        }
+
+        // next becomes the dummy once head moves to it, so its value is read before
+        v = next->val;
+        if (this->head.compare_exchange_weak(head, next, memory_order_acq_rel, memory_order_relaxed))
+        {
+            *val = v;
+            this->domain->retire_node(head);
+            return SUCCESS;
+        }
+    }
+}
+
+#endif //CODESHARK_LOCKFREE_QUEUE_INL_H
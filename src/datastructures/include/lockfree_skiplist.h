@@ -0,0 +1,72 @@
+/*
+ ============================================================================
+ Name        : lockfree_skiplist.h
+ Description : lock-free skip list header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_LOCKFREE_SKIPLIST_H
+#define CODESHARK_LOCKFREE_SKIPLIST_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+#include "common/include/node.h"
+#include "common/include/epoch.h"
+#include "datastructures/include/skiplist.h"
+
+using namespace std;
+
+/**
+ * @class LockFreeSkipList is an ordered set of int keys for many threads, without locks
+ *        (Herlihy-Shavit skip list). Nodes and towers are those of SkipList.
+ *
+ * Deletion is in two steps. erase() marks the next pointers of the node, top level first, by
+ * setting their low bit; the mark at level 0 removes the key. Any thread which later meets a
+ * marked node on its way unlinks it with a CAS on the predecessor. A marked pointer is never
+ * changed, so no node can be linked after a deleted one.
+ *
+ *      pred -> [17|m] -> 23        17 is deleted, but still linked
+ *      pred ----------> 23         after a search passes it
+ *
+ * insert() links the bottom level first, which adds the key, then the levels above. A node is
+ * retired to an EpochDomain when both its inserter and its deleter are done with it, after a
+ * last search has unlinked it from every level.
+ *
+ * contains() and range() never write, and skip marked nodes. range() is weakly consistent:
+ * it returns keys present at some point during the call.
+ */
+class LockFreeSkipList
+{
+private:
+    cshark_node_t *head;
+    char pad[EPOCH_CACHE_LINE];
+    atomic<size_t> size;
+    EpochDomain *domain;
+
+    bool find(int key, cshark_node_t **preds, cshark_node_t **succs, cshark_node_t *target);
+    void release(cshark_node_t *nt);
+
+public:
+    LockFreeSkipList(EpochDomain *domain = NULL);
+    ~LockFreeSkipList();
+
+    LockFreeSkipList(const LockFreeSkipList &) = delete;
+    LockFreeSkipList &operator=(const LockFreeSkipList &) = delete;
+
+    size_t get_size();
+    bool contains(int key);
+    int insert(int key);
+    int erase(int key);
+    size_t range(int lo, int hi, int *keys, size_t max);
+};
+
+#ifdef CODESHARK_HEADER_ONLY
+#include "datastructures/include/lockfree_skiplist_inl.h"
+#endif
+
+#endif //CODESHARK_LOCKFREE_SKIPLIST_H
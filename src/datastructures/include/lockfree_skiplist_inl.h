@@ -0,0 +1,381 @@
+/*
+ ============================================================================
+ Name        : lockfree_skiplist_inl.h
+ Description : lock-free skip list inline implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_LOCKFREE_SKIPLIST_INL_H
+#define CODESHARK_LOCKFREE_SKIPLIST_INL_H
+
+#include "common/include/common.h"
+#include "common/include/err.h"
+#include "datastructures/include/lockfree_skiplist.h"
+
+#define LFSKIPLIST_MARK  ((uintptr_t)1)         // nodes are 16-byte aligned, so bit 0 is free
+
+// next pointers of linked nodes are written by CAS while other threads read them, like bitmap words
+inline cshark_node_t *_cshark_lfskip_load(cshark_node_t *nt, size_t level)
+{
+    return __atomic_load_n(cshark_skiplist_next_ref(nt, level), __ATOMIC_ACQUIRE);
+}
+
+inline bool _cshark_lfskip_cas(cshark_node_t *nt, size_t level, cshark_node_t *expected, cshark_node_t *desired)
+{
+    return __atomic_compare_exchange_n(cshark_skiplist_next_ref(nt, level), &expected, desired, false,
+                                       __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+
+inline bool _cshark_lfskip_marked(cshark_node_t *p)
+{
+    return ((uintptr_t)p & LFSKIPLIST_MARK) != 0;
+}
+
+inline cshark_node_t *_cshark_lfskip_strip(cshark_node_t *p)
+{
+    return (cshark_node_t *)((uintptr_t)p & ~LFSKIPLIST_MARK);
+}
+
+/**
+ * Draw the height of a new node from a per-thread state
+ */
+inline size_t _cshark_lfskip_height()
+{
+    static thread_local uint64_t state = 0;
+
+    if (state == 0)
+    {
+        state = (uint64_t)(uintptr_t)&state | 1;
+    }
+
+    return cshark_skiplist_random_height(&state);
+}
+
+/**
+ * Initialize an empty list
+ * @param domain [in] domain retiring deleted nodes, \NULL for EpochDomain::get_default()
+ */
+CODESHARK_INLINE LockFreeSkipList::LockFreeSkipList(EpochDomain *domain)
+{
+    this->head = cshark_skiplist_node_init(0, SKIPLIST_MAX_LEVEL);
+    this->size.store(0, memory_order_relaxed);
+    this->domain = (domain == NULL) ? EpochDomain::get_default() : domain;
+}
+
+/**
+ * Delete the list and the nodes in it
+ * \warning no other thread may use the list any more
+ */
+CODESHARK_INLINE LockFreeSkipList::~LockFreeSkipList()
+{
+    cshark_node_t *nt = this->head;
+    cshark_node_t *next;
+
+    while (nt != NULL)
+    {
+        next = _cshark_lfskip_strip(nt->next);
+        cshark_node_free(nt);
+        nt = next;
+    }
+}
+
+/**
+ * Find the predecessor and successor of key at every level, unlinking marked nodes on the way
+ * @param key [in] key
+ * @param preds [out] last node before key by level
+ * @param succs [out] node after preds by level
+ * @param target [in] node to unlink, which the search passes even behind nodes of the same key;
+ *        \NULL for an ordinary search
+ * @return \true if succs[0] holds key
+ * \warning the calling thread must be pinned
+ */
+CODESHARK_INLINE bool LockFreeSkipList::find(int key, cshark_node_t **preds, cshark_node_t **succs, cshark_node_t *target)
+{
+    cshark_node_t *pred;
+    cshark_node_t *curr;
+    cshark_node_t *succ;
+    size_t l;
+
+retry:
+    pred = this->head;
+    curr = NULL;
+    for (l = SKIPLIST_MAX_LEVEL; l-- > 0;)
+    {
+        curr = _cshark_lfskip_strip(_cshark_lfskip_load(pred, l));
+        while (curr != NULL)
+        {
+            succ = _cshark_lfskip_load(curr, l);
+            while (_cshark_lfskip_marked(succ))
+            {
+                // a marked pred fails the CAS, and the search restarts from head
+                if (!_cshark_lfskip_cas(pred, l, curr, _cshark_lfskip_strip(succ)))
+                {
+                    goto retry;
+                }
+
+                curr = _cshark_lfskip_strip(succ);
+                if (curr == NULL)
+                {
+                    break;
+                }
+                succ = _cshark_lfskip_load(curr, l);
+            }
+
+            if (curr == NULL or curr->val > key or (curr->val == key and (target == NULL or curr == target)))
+            {
+                break;
+            }
+
+            pred = curr;
+            curr = _cshark_lfskip_strip(succ);
+        }
+
+        preds[l] = pred;
+        succs[l] = curr;
+    }
+
+    return curr != NULL and curr->val == key;
+}
+
+/**
+ * Drop one of the two owners of a node, its inserter and its deleter. The last one unlinks the
+ * node from every level, which no thread links again, and retires it.
+ */
+CODESHARK_INLINE void LockFreeSkipList::release(cshark_node_t *nt)
+{
+    cshark_skiplist_tower_t *tower = (cshark_skiplist_tower_t *)nt->data;
+    cshark_node_t *preds[SKIPLIST_MAX_LEVEL];
+    cshark_node_t *succs[SKIPLIST_MAX_LEVEL];
+
+    if (__atomic_sub_fetch(&tower->links, 1, __ATOMIC_ACQ_REL) == 0)
+    {
+        this->find(nt->val, preds, succs, nt);
+        this->domain->retire_node(nt);
+    }
+}
+
+/**
+ * Get the number of keys; it may be outdated as soon as it is returned
+ */
+CODESHARK_INLINE size_t LockFreeSkipList::get_size()
+{
+    return this->size.load();
+}
+
+/**
+ * Check if a key is in the list; never writes, so readers do not contend
+ */
+CODESHARK_INLINE bool LockFreeSkipList::contains(int key)
+{
+    EpochGuard guard(this->domain);
+    cshark_node_t *pred = this->head;
+    cshark_node_t *curr = NULL;
+    cshark_node_t *succ;
+    size_t l;
+
+    for (l = SKIPLIST_MAX_LEVEL; l-- > 0;)
+    {
+        curr = _cshark_lfskip_strip(_cshark_lfskip_load(pred, l));
+        while (curr != NULL)
+        {
+            succ = _cshark_lfskip_load(curr, l);
+            if (_cshark_lfskip_marked(succ))
+            {
+                curr = _cshark_lfskip_strip(succ);
+            }
+            else if (curr->val < key)
+            {
+                pred = curr;
+                curr = _cshark_lfskip_strip(succ);
+            }
+            else
+            {
+                break;
+            }
+        }
+    }
+
+    return curr != NULL and curr->val == key;
+}
+
+/**
+ * Add a key
+ * @param key [in] key
+ * @return \0 on success, or ERROR_EXISTS if the key is in the list
+ */
+CODESHARK_INLINE int LockFreeSkipList::insert(int key)
+{
+    EpochGuard guard(this->domain);
+    cshark_node_t *preds[SKIPLIST_MAX_LEVEL];
+    cshark_node_t *succs[SKIPLIST_MAX_LEVEL];
+    cshark_skiplist_tower_t *tower;
+    cshark_node_t *next;
+    cshark_node_t *nt;
+    size_t height = _cshark_lfskip_height();
+    size_t l;
+
+    nt = cshark_skiplist_node_init(key, height);
+    tower = (cshark_skiplist_tower_t *)nt->data;
+    tower->links = 2;
+
+    // linking the bottom level adds the key
+    while (true)
+    {
+        if (this->find(key, preds, succs, NULL))
+        {
+            cshark_node_free(nt);
+            return ERROR_EXISTS;
+        }
+
+        for (l = 0; l < height; l++)
+        {
+            *cshark_skiplist_next_ref(nt, l) = succs[l];
+        }
+
+        if (_cshark_lfskip_cas(preds[0], 0, succs[0], nt))
+        {
+            break;
+        }
+    }
+    this->size.fetch_add(1);
+
+    // link the levels above, unless erase() has marked them meanwhile
+    for (l = 1; l < height; l++)
+    {
+        while (true)
+        {
+            next = _cshark_lfskip_load(nt, l);
+            if (_cshark_lfskip_marked(next) or
+                (next != succs[l] and !_cshark_lfskip_cas(nt, l, next, succs[l])))
+            {
+                this->release(nt);
+                return SUCCESS;
+            }
+
+            if (_cshark_lfskip_cas(preds[l], l, succs[l], nt))
+            {
+                break;
+            }
+
+            this->find(key, preds, succs, NULL);
+        }
+    }
+
+    this->release(nt);
+    return SUCCESS;
+}
+
+/**
+ * Delete a key
+ * @param key [in] key
+ * @return \0 on success, or ERROR_NOT_FOUND if the key is not in the list, or another thread
+ *         deleted it first
+ */
+CODESHARK_INLINE int LockFreeSkipList::erase(int key)
+{
+    EpochGuard guard(this->domain);
+    cshark_node_t *preds[SKIPLIST_MAX_LEVEL];
+    cshark_node_t *succs[SKIPLIST_MAX_LEVEL];
+    cshark_node_t *succ;
+    cshark_node_t *nt;
+    size_t l;
+
+    if (!this->find(key, preds, succs, NULL))
+    {
+        return ERROR_NOT_FOUND;
+    }
+
+    nt = succs[0];
+    for (l = cshark_skiplist_height(nt) - 1; l > 0; l--)
+    {
+        succ = _cshark_lfskip_load(nt, l);
+        while (!_cshark_lfskip_marked(succ))
+        {
+            _cshark_lfskip_cas(nt, l, succ, (cshark_node_t *)((uintptr_t)succ | LFSKIPLIST_MARK));
+            succ = _cshark_lfskip_load(nt, l);
+        }
+    }
+
+    // the thread which marks level 0 deletes the key
+    succ = _cshark_lfskip_load(nt, 0);
+    while (true)
+    {
+        if (_cshark_lfskip_marked(succ))
+        {
+            return ERROR_NOT_FOUND;
+        }
+
+        if (_cshark_lfskip_cas(nt, 0, succ, (cshark_node_t *)((uintptr_t)succ | LFSKIPLIST_MARK)))
+        {
+            break;
+        }
+        succ = _cshark_lfskip_load(nt, 0);
+    }
+    this->size.fetch_sub(1);
+
+    this->find(key, preds, succs, NULL);
+    this->release(nt);
+    return SUCCESS;
+}
+
+/**
+ * Copy keys in [lo, hi) in order; weakly consistent, each key was in the list during the call
+ * @param lo [in] smallest key
+ * @param hi [in] key past the range
+ * @param keys [out] keys
+ * @param max [in] most keys to copy
+ * @return number of keys copied
+ */
+CODESHARK_INLINE size_t LockFreeSkipList::range(int lo, int hi, int *keys, size_t max)
+{
+    EpochGuard guard(this->domain);
+    cshark_node_t *pred = this->head;
+    cshark_node_t *curr = NULL;
+    cshark_node_t *succ;
+    size_t n = 0;
+    size_t l;
+
+    if (keys == NULL)
+    {
+        return 0;
+    }
+
+    for (l = SKIPLIST_MAX_LEVEL; l-- > 0;)
+    {
+        curr = _cshark_lfskip_strip(_cshark_lfskip_load(pred, l));
+        while (curr != NULL)
+        {
+            succ = _cshark_lfskip_load(curr, l);
+            if (_cshark_lfskip_marked(succ))
+            {
+                curr = _cshark_lfskip_strip(succ);
+            }
+            else if (curr->val < lo)
+            {
+                pred = curr;
+                curr = _cshark_lfskip_strip(succ);
+            }
+            else
+            {
+                break;
+            }
+        }
+    }
+
+    while (curr != NULL and curr->val < hi and n < max)
+    {
+        succ = _cshark_lfskip_load(curr, 0);
+        if (!_cshark_lfskip_marked(succ))
+        {
+            keys[n++] = curr->val;
+        }
+        curr = _cshark_lfskip_strip(succ);
+    }
+
+    return n;
+}
+
+#endif //CODESHARK_LOCKFREE_SKIPLIST_INL_H
@@ -0,0 +1,77 @@
+/*
+ ============================================================================
+ Name        : lockfree_stack.h
+ Description : lock-free stack header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_LOCKFREE_STACK_H
+#define CODESHARK_LOCKFREE_STACK_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+#include "common/include/node.h"
+#include "common/include/epoch.h"
+
+using namespace std;
+
+#define LFSTACK_ELIM_SLOTS  8           // slots of the elimination array
+#define LFSTACK_ELIM_SPINS  128         // polls of a slot before giving up an exchange
+
+/**
+ * @class LockFreeStack is a stack shared by threads without locks (Treiber stack), e.g.,
+ *        a free list or a job stack, with the push()/pop()/get_top()/is_empty() interface of Stack.
+ *
+ * push() and pop() swap the top pointer with a CAS. Popped nodes are retired to an EpochDomain,
+ * so a node is never freed, or reused at the same address, while another thread may still read
+ * it; this also rules out ABA on the top pointer.
+ *
+ * Under contention every thread retries the same CAS. A thread whose CAS fails meets a thread
+ * of the opposite operation in the elimination array instead: a push offers its node in a
+ * random slot, and a pop takes it, so both finish without touching the top at all.
+ *
+ *      slot:   EMPTY -> node (offered by push) -> TAKEN (by pop) -> EMPTY (by push)
+ */
+class LockFreeStack
+{
+private:
+    typedef struct _lfstack_slot_t
+    {
+        atomic<uintptr_t> val;
+        char pad[EPOCH_CACHE_LINE - sizeof(atomic<uintptr_t>)];
+    }lfstack_slot_t;
+
+    atomic<cshark_node_t *> top;
+    char pad_top[EPOCH_CACHE_LINE];
+    lfstack_slot_t elim[LFSTACK_ELIM_SLOTS];
+    EpochDomain *domain;
+
+    bool eliminate_push(cshark_node_t *nt);
+    cshark_node_t *eliminate_pop();
+    cshark_node_t *pop_node(bool *shared);
+
+public:
+    LockFreeStack(EpochDomain *domain = NULL);
+    ~LockFreeStack();
+
+    LockFreeStack(const LockFreeStack &) = delete;
+    LockFreeStack &operator=(const LockFreeStack &) = delete;
+
+    bool is_empty();
+    int push(int val);
+    int push(cshark_node_t *nt);
+    int pop(int *val);
+    cshark_node_t *pop();
+    int get_top(int *val);
+};
+
+#ifdef CODESHARK_HEADER_ONLY
+#include "datastructures/include/lockfree_stack_inl.h"
+#endif
+
+#endif //CODESHARK_LOCKFREE_STACK_H
@@ -0,0 +1,306 @@
+/*
+ ============================================================================
+ Name        : lockfree_stack_inl.h
+ Description : lock-free stack inline implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_LOCKFREE_STACK_INL_H
+#define CODESHARK_LOCKFREE_STACK_INL_H
+
+#include "common/include/common.h"
+#include "common/include/err.h"
+#include "datastructures/include/lockfree_stack.h"
+
+#define LFSTACK_SLOT_EMPTY  ((uintptr_t)0)
+#define LFSTACK_SLOT_TAKEN  ((uintptr_t)1)     // nodes are 16-byte aligned, never 1
+
+/**
+ * Pick a random elimination slot; xorshift on a per-thread state, so threads spread over slots
+ */
+inline size_t _cshark_lfstack_slot()
+{
+    static thread_local uint32_t state = 0;
+
+    if (state == 0)
+    {
+        state = (uint32_t)(uintptr_t)&state | 1;
+    }
+
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+
+    return state % LFSTACK_ELIM_SLOTS;
+}
+
+/**
+ * Initialize an empty stack
+ * @param domain [in] domain retiring popped nodes, \NULL for EpochDomain::get_default()
+ */
+CODESHARK_INLINE LockFreeStack::LockFreeStack(EpochDomain *domain)
+{
+    size_t i;
+
+    this->top.store(NULL, memory_order_relaxed);
+    for (i = 0; i < LFSTACK_ELIM_SLOTS; i++)
+    {
+        this->elim[i].val.store(LFSTACK_SLOT_EMPTY, memory_order_relaxed);
+    }
+    this->domain = (domain == NULL) ? EpochDomain::get_default() : domain;
+}
+
+/**
+ * Delete the stack and the nodes in it
+ * \warning no other thread may use the stack any more
+ */
+CODESHARK_INLINE LockFreeStack::~LockFreeStack()
+{
+    cshark_node_t *nt = this->top.load(memory_order_relaxed);
+    cshark_node_t *next;
+
+    while (nt != NULL)
+    {
+        next = nt->next;
+        cshark_node_free(nt);
+        nt = next;
+    }
+}
+
+/**
+ * Offer a node to a pop waiting in the elimination array
+ * @return \true if a pop has taken the node
+ */
+CODESHARK_INLINE bool LockFreeStack::eliminate_push(cshark_node_t *nt)
+{
+    atomic<uintptr_t> &slot = this->elim[_cshark_lfstack_slot()].val;
+    uintptr_t expected = LFSTACK_SLOT_EMPTY;
+    size_t i;
+
+    if (!slot.compare_exchange_strong(expected, (uintptr_t)nt, memory_order_release, memory_order_relaxed))
+    {
+        return false;
+    }
+
+    for (i = 0; i < LFSTACK_ELIM_SPINS; i++)
+    {
+        if (slot.load(memory_order_acquire) == LFSTACK_SLOT_TAKEN)
+        {
+            slot.store(LFSTACK_SLOT_EMPTY, memory_order_release);
+            return true;
+        }
+    }
+
+    // withdraw the offer, unless a pop takes it at the last moment
+    expected = (uintptr_t)nt;
+    if (slot.compare_exchange_strong(expected, LFSTACK_SLOT_EMPTY, memory_order_acquire, memory_order_acquire))
+    {
+        return false;
+    }
+
+    slot.store(LFSTACK_SLOT_EMPTY, memory_order_release);
+    return true;
+}
+
+/**
+ * Take a node offered by a push in the elimination array
+ * @return node, which has never been in the stack, or \NULL if no push came
+ */
+CODESHARK_INLINE cshark_node_t *LockFreeStack::eliminate_pop()
+{
+    atomic<uintptr_t> &slot = this->elim[_cshark_lfstack_slot()].val;
+    uintptr_t v;
+    size_t i;
+
+    for (i = 0; i < LFSTACK_ELIM_SPINS; i++)
+    {
+        v = slot.load(memory_order_acquire);
+        if (v != LFSTACK_SLOT_EMPTY and v != LFSTACK_SLOT_TAKEN and
+            slot.compare_exchange_strong(v, LFSTACK_SLOT_TAKEN, memory_order_acquire, memory_order_relaxed))
+        {
+            return (cshark_node_t *)v;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Pop the top node; the caller must be pinned in the domain
+ * @param shared [out] \true if the node was in the stack, and others may still read it
+ * @return node, or \NULL if the stack is empty
+ */
+CODESHARK_INLINE cshark_node_t *LockFreeStack::pop_node(bool *shared)
+{
+    cshark_node_t *top;
+    cshark_node_t *nt;
+
+    while (true)
+    {
+        top = this->top.load(memory_order_acquire);
+        if (top == NULL)
+        {
+            return NULL;
+        }
+
+        // top cannot be freed while pinned, so next is still readable if another pop has won
+        if (this->top.compare_exchange_strong(top, top->next, memory_order_acquire, memory_order_relaxed))
+        {
+            *shared = true;
+            return top;
+        }
+
+        nt = this->eliminate_pop();
+        if (nt != NULL)
+        {
+            *shared = false;
+            return nt;
+        }
+    }
+}
+
+CODESHARK_INLINE bool LockFreeStack::is_empty()
+{
+    return this->top.load(memory_order_acquire) == NULL;
+}
+
+/**
+ * Push a new node of a value
+ * @param val [in] value
+ * @return \0 on success
+ */
+CODESHARK_INLINE int LockFreeStack::push(int val)
+{
+    cshark_node_t *nt = cshark_node_init();
+
+    nt->val = val;
+    return this->push(nt);
+}
+
+/**
+ * Push a node; the stack owns the node
+ * @param nt [in] node, with next set by the stack
+ * @return \0 on success, or other error code
+ */
+CODESHARK_INLINE int LockFreeStack::push(cshark_node_t *nt)
+{
+    cshark_node_t *top;
+
+    if (nt == NULL)
+    {
+        return ERROR_PARAM;
+    }
+
+    // push only compares the top pointer and never reads shared nodes, so it is not pinned
+    while (true)
+    {
+        top = this->top.load(memory_order_relaxed);
+        nt->next = top;
+        if (this->top.compare_exchange_strong(top, nt, memory_order_release, memory_order_relaxed))
+        {
+            return SUCCESS;
+        }
+
+        if (this->eliminate_push(nt))
+        {
+            return SUCCESS;
+        }
+    }
+}
+
+/**
+ * Pop the top value, and free its node once no thread reads it
+ * @param val [out] value
+ * @return \0 on success, ERROR_TARGET_EMPTY if the stack is empty, or other error code
+ */
+CODESHARK_INLINE int LockFreeStack::pop(int *val)
+{
+    cshark_node_t *nt;
+    bool shared;
+
+    if (val == NULL)
+    {
+        return ERROR_PARAM;
+    }
+
+    EpochGuard guard(this->domain);
+    nt = this->pop_node(&shared);
+    if (nt == NULL)
+    {
+        return ERROR_TARGET_EMPTY;
+    }
+
+    *val = nt->val;
+    if (shared)
+    {
+        this->domain->retire_node(nt);
+    }
+    else
+    {
+        cshark_node_free(nt);
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Pop the top node, as Stack::pop() does
+ * \warning caller must manually free the node. The node may be a copy of the popped one,
+ *          as other threads can read a popped node until it is retired; pop(int *) avoids the copy.
+ * @return node, or \NULL if the stack is empty
+ */
+CODESHARK_INLINE cshark_node_t *LockFreeStack::pop()
+{
+    cshark_node_t *nt;
+    cshark_node_t *copy;
+    bool shared;
+
+    EpochGuard guard(this->domain);
+    nt = this->pop_node(&shared);
+    if (nt == NULL)
+    {
+        return NULL;
+    }
+
+    if (!shared)
+    {
+        nt->next = NULL;
+        return nt;
+    }
+
+    copy = cshark_node_init();
+    cshark_node_copy(nt, copy);
+    this->domain->retire_node(nt);
+
+    return copy;
+}
+
+/**
+ * Get the top value without popping it
+ * @param val [out] value
+ * @return \0 on success, ERROR_TARGET_EMPTY if the stack is empty, or other error code
+ */
+CODESHARK_INLINE int LockFreeStack::get_top(int *val)
+{
+    cshark_node_t *top;
+
+    if (val == NULL)
+    {
+        return ERROR_PARAM;
+    }
+
+    EpochGuard guard(this->domain);
+    top = this->top.load(memory_order_acquire);
+    if (top == NULL)
+    {
+        return ERROR_TARGET_EMPTY;
+    }
+
+    *val = top->val;
+    return SUCCESS;
+}
+
+#endif //CODESHARK_LOCKFREE_STACK_INL_H
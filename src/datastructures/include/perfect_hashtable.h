@@ -0,0 +1,98 @@
+/*
+ ============================================================================
+ Name        : perfect_hashtable.h
+ Description : minimal perfect hash function and static hash table header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_PERFECT_HASHTABLE_H
+#define CODESHARK_PERFECT_HASHTABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+using namespace std;
+
+#define MPHF_BUCKET_FACTOR      5           // buckets per log2(n) keys; fewer buckets take fewer bits, more search
+#define MPHF_LOAD_PCT           98          // keys per 100 slots while searching pilots
+#define MPHF_MAX_PILOT          (1 << 20)   // pilots tried for a bucket before a new seed is tried
+#define MPHF_MAX_SEEDS          16
+#define PERFECT_HT_MAGIC        0x48505343  // "CSPH"
+#define PERFECT_HT_VERSION      1
+
+/**
+ * A minimal perfect hash function (PTHash): it maps each of n fixed keys to its own index in
+ * [0, n), in a constant number of steps and without storing the keys.
+ *
+ * A key hashes to a bucket of a few keys; 60% of keys go to 30% of the buckets, so the large
+ * buckets are placed first while the table is empty. Each bucket stores a pilot, the first
+ * number whose hash moves all keys of the bucket to free slots:
+ *
+ *      slot = (hash(key) ^ hash(pilot[bucket(key)])) % table_size
+ *
+ * The search runs on a table slightly larger than n, which keeps it short. A key landing in a
+ * slot >= n is sent to one of the free slots below n by a small remap array. Pilots are mostly
+ * small and are packed with just enough bits for the largest one, a few bits per key in all.
+ *
+ * The function returns some index for any key, so a caller that may look up other keys must
+ * store the keys too and compare, as perfect_hashtable_t does.
+ */
+typedef struct _mphf_t
+{
+    uint64_t seed;
+    size_t n;                           // keys and indexes
+    size_t table_size;                  // slots of the pilot search, at least n
+    size_t buckets;
+    size_t dense_buckets;               // buckets taking 60% of the keys
+    uint32_t pilot_bits;
+    uint64_t *pilots;                   // pilot_bits per bucket, with a spare word at the end
+    uint32_t *remap;                    // free slots below n, of the slots n to table_size - 1
+}mphf_t;
+
+/**
+ * A read-only hash table built once from a fixed set of keys and values, e.g., a lookup table
+ * loaded at startup. A key is found in one probe of its mphf_t index, with no chains and
+ * no empty slots:
+ *
+ *      keys    |  17  |   3  |  42  |  8   |       index i is mphf_lookup() of keys[i]
+ *      offsets |  0   |  2   |  2   |  7   |  9   |
+ *      values  | v0 v0 | v2 v2 v2 v2 v2 | v3 v3 |   value i is values[offsets[i]] to values[offsets[i + 1]]
+ *
+ * Beyond the function, a key costs its 4 bytes, a 4-byte offset and its value bytes. A table is
+ * saved to and loaded from a byte buffer, in the byte order of the host.
+ */
+typedef struct _perfect_hashtable_t
+{
+    mphf_t *mphf;
+    int *keys;
+    uint32_t *offsets;                  // n + 1 offsets into values
+    char *values;
+}perfect_hashtable_t;
+
+// Minimal perfect hash functions
+
+mphf_t *mphf_build(const int *keys, size_t n);
+int mphf_destroy(mphf_t *f);
+size_t mphf_lookup(const mphf_t *f, int k);
+size_t mphf_get_bits(const mphf_t *f);
+
+// Perfect hash table functions
+
+perfect_hashtable_t *perfect_hashtable_build(const int *keys, const string *values, size_t n);
+int perfect_hashtable_destroy(perfect_hashtable_t *t);
+const char *perfect_hashtable_find(perfect_hashtable_t *t, int k, size_t *val_len);
+bool perfect_hashtable_contains(perfect_hashtable_t *t, int k);
+size_t perfect_hashtable_getsize(perfect_hashtable_t *t);
+size_t perfect_hashtable_get_memory(perfect_hashtable_t *t);
+int perfect_hashtable_save(perfect_hashtable_t *t, string *out);
+perfect_hashtable_t *perfect_hashtable_load(const char *buf, size_t len);
+
+#ifdef CODESHARK_HEADER_ONLY
+#include "datastructures/include/perfect_hashtable_inl.h"
+#endif
+
+#endif //CODESHARK_PERFECT_HASHTABLE_H
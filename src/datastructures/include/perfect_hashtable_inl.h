@@ -0,0 +1,595 @@
+/*
+ ============================================================================
+ Name        : perfect_hashtable_inl.h
+ Description : minimal perfect hash function and static hash table inline implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_PERFECT_HASHTABLE_INL_H
+#define CODESHARK_PERFECT_HASHTABLE_INL_H
+
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+#include "common/include/bitmap.h"
+#include "common/include/common.h"
+#include "common/include/err.h"
+#include "datastructures/include/perfect_hashtable.h"
+
+#define MPHF_DENSE_KEYS     0x99999999ULL   // 60% of 2^32: hashes below go to the dense buckets
+
+/**
+ * Mix the bits of a value (fmix64 of MurmurHash3); it is a bijection, so distinct keys never
+ * share a hash
+ */
+inline uint64_t _cshark_mphf_mix(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+
+    return h;
+}
+
+inline uint64_t _cshark_mphf_hash(const mphf_t *f, int k)
+{
+    return _cshark_mphf_mix((uint64_t)(uint32_t)k ^ f->seed);
+}
+
+/**
+ * Get the bucket of a hash; the low half picks the dense or sparse buckets, the high half a bucket
+ */
+inline size_t _cshark_mphf_bucket(const mphf_t *f, uint64_t h)
+{
+    uint64_t hi = h >> 32;
+
+    if ((h & 0xffffffff) < MPHF_DENSE_KEYS)
+    {
+        return (size_t)((hi * f->dense_buckets) >> 32);
+    }
+    return f->dense_buckets + (size_t)((hi * (f->buckets - f->dense_buckets)) >> 32);
+}
+
+inline size_t _cshark_mphf_slot(const mphf_t *f, uint64_t h, uint64_t pilot)
+{
+    return (size_t)((h ^ _cshark_mphf_mix(pilot ^ f->seed)) % f->table_size);
+}
+
+inline size_t _cshark_mphf_pilot_words(size_t buckets, size_t pilot_bits)
+{
+    return (buckets * pilot_bits + 63) / 64 + 1;
+}
+
+inline uint64_t _cshark_mphf_get_pilot(const mphf_t *f, size_t b)
+{
+    size_t bit = b * f->pilot_bits;
+    size_t off = bit % 64;
+    uint64_t v = f->pilots[bit / 64] >> off;
+
+    // a pilot crossing a word boundary; the spare word keeps the read in bounds
+    if (off + f->pilot_bits > 64)
+    {
+        v |= f->pilots[bit / 64 + 1] << (64 - off);
+    }
+    return v & (((uint64_t)1 << f->pilot_bits) - 1);
+}
+
+inline void _cshark_mphf_set_pilot(mphf_t *f, size_t b, uint64_t pilot)
+{
+    size_t bit = b * f->pilot_bits;
+    size_t off = bit % 64;
+
+    f->pilots[bit / 64] |= pilot << off;
+    if (off + f->pilot_bits > 64)
+    {
+        f->pilots[bit / 64 + 1] |= pilot >> (64 - off);
+    }
+}
+
+/**
+ * Search a pilot for every bucket, largest buckets first, with the seed of the function
+ * @param hashes [in] hashes of the keys
+ * @param pilots [out] pilot of each bucket
+ * @param taken [out] slots taken by keys
+ * @return \0 on success, ERROR_EXISTS if keys repeat, or ERROR_NOT_FOUND if a bucket has no pilot
+ */
+inline int _cshark_mphf_search(mphf_t *f, const vector<uint64_t> &hashes, vector<uint32_t> &pilots,
+                               cshark_bitmap_t *taken)
+{
+    vector<size_t> starts(f->buckets + 1, 0);
+    vector<uint64_t> grouped(f->n);
+    vector<size_t> slots;
+    vector<size_t> order;
+    vector<size_t> by_size;
+    uint64_t ph;
+    size_t i, j, b, s, pos, max_size = 0;
+    uint32_t p;
+
+    // group hashes by bucket
+    for (i = 0; i < f->n; i++)
+    {
+        starts[_cshark_mphf_bucket(f, hashes[i]) + 1]++;
+    }
+    for (b = 0; b < f->buckets; b++)
+    {
+        max_size = max(max_size, starts[b + 1]);
+        starts[b + 1] += starts[b];
+    }
+    order.assign(starts.begin(), starts.end() - 1);
+    for (i = 0; i < f->n; i++)
+    {
+        grouped[order[_cshark_mphf_bucket(f, hashes[i])]++] = hashes[i];
+    }
+
+    // equal keys have equal hashes in the same bucket, and no pilot separates them
+    for (b = 0; b < f->buckets; b++)
+    {
+        sort(grouped.begin() + starts[b], grouped.begin() + starts[b + 1]);
+        for (i = starts[b] + 1; i < starts[b + 1]; i++)
+        {
+            if (grouped[i] == grouped[i - 1])
+            {
+                return ERROR_EXISTS;
+            }
+        }
+    }
+
+    // order buckets by size, largest first
+    by_size.assign(max_size + 2, 0);
+    for (b = 0; b < f->buckets; b++)
+    {
+        by_size[max_size - (starts[b + 1] - starts[b]) + 1]++;
+    }
+    for (s = 0; s <= max_size; s++)
+    {
+        by_size[s + 1] += by_size[s];
+    }
+    order.resize(f->buckets);
+    for (b = 0; b < f->buckets; b++)
+    {
+        order[by_size[max_size - (starts[b + 1] - starts[b])]++] = b;
+    }
+
+    slots.resize(max_size);
+    for (i = 0; i < f->buckets; i++)
+    {
+        b = order[i];
+        if (starts[b] == starts[b + 1])
+        {
+            break;
+        }
+
+        for (p = 0; p < MPHF_MAX_PILOT; p++)
+        {
+            ph = _cshark_mphf_mix((uint64_t)p ^ f->seed);
+            for (j = 0; j < starts[b + 1] - starts[b]; j++)
+            {
+                pos = (size_t)((grouped[starts[b] + j] ^ ph) % f->table_size);
+                if (cshark_bitmap_test(taken, pos) or find(slots.begin(), slots.begin() + j, pos) != slots.begin() + j)
+                {
+                    break;
+                }
+                slots[j] = pos;
+            }
+
+            if (j == starts[b + 1] - starts[b])
+            {
+                break;
+            }
+        }
+
+        if (p == MPHF_MAX_PILOT)
+        {
+            return ERROR_NOT_FOUND;
+        }
+
+        pilots[b] = p;
+        for (j = 0; j < starts[b + 1] - starts[b]; j++)
+        {
+            cshark_bitmap_set(taken, slots[j]);
+        }
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Build a minimal perfect hash function of a set of keys
+ * @param keys [in] distinct keys
+ * @param n [in] number of keys, at least 1
+ * @return function, or \NULL if keys repeat or there are none
+ */
+CODESHARK_INLINE mphf_t *mphf_build(const int *keys, size_t n)
+{
+    mphf_t *f;
+    cshark_bitmap_t taken;
+    vector<uint64_t> hashes(n);
+    vector<uint32_t> pilots;
+    uint32_t max_pilot;
+    size_t i, j, log2n, next_free;
+    int ret = ERROR_NOT_FOUND;
+
+    if (keys == NULL or n == 0)
+    {
+        return NULL;
+    }
+
+    f = new mphf_t();
+    f->n = n;
+    f->table_size = max(n, n * 100 / MPHF_LOAD_PCT);
+    for (log2n = 1; ((size_t)1 << (log2n + 1)) <= n; log2n++)
+    {
+    }
+    f->buckets = max((size_t)2, MPHF_BUCKET_FACTOR * n / log2n + 1);
+    f->dense_buckets = max((size_t)1, f->buckets * 3 / 10);
+
+    cshark_bitmap_init(&taken, f->table_size);
+    for (i = 0; i < MPHF_MAX_SEEDS and ret == ERROR_NOT_FOUND; i++)
+    {
+        f->seed = _cshark_mphf_mix(i + 0x9e3779b97f4a7c15ULL);
+        for (j = 0; j < n; j++)
+        {
+            hashes[j] = _cshark_mphf_hash(f, keys[j]);
+        }
+
+        pilots.assign(f->buckets, 0);
+        cshark_bitmap_clear_all(&taken);
+        ret = _cshark_mphf_search(f, hashes, pilots, &taken);
+    }
+
+    if (ret != SUCCESS)
+    {
+        cshark_bitmap_free(&taken);
+        delete(f);
+        return NULL;
+    }
+
+    // pack pilots with the bits of the largest one
+    max_pilot = *max_element(pilots.begin(), pilots.end());
+    for (f->pilot_bits = 1; ((uint64_t)1 << f->pilot_bits) <= max_pilot; f->pilot_bits++)
+    {
+    }
+    f->pilots = new uint64_t[_cshark_mphf_pilot_words(f->buckets, f->pilot_bits)]();
+    for (i = 0; i < f->buckets; i++)
+    {
+        _cshark_mphf_set_pilot(f, i, pilots[i]);
+    }
+
+    // keys in slots n and above take the free slots below n, in order
+    f->remap = new uint32_t[f->table_size - f->n + 1]();
+    next_free = 0;
+    for (i = f->n; i < f->table_size; i++)
+    {
+        if (cshark_bitmap_test(&taken, i))
+        {
+            while (cshark_bitmap_test(&taken, next_free))
+            {
+                next_free++;
+            }
+            f->remap[i - f->n] = (uint32_t)next_free++;
+        }
+    }
+
+    cshark_bitmap_free(&taken);
+    return f;
+}
+
+/**
+ * Destroy a minimal perfect hash function
+ * @param f [in] function
+ * @return \0 on success, or ERROR_PARAM
+ */
+CODESHARK_INLINE int mphf_destroy(mphf_t *f)
+{
+    if (f == NULL)
+    {
+        return ERROR_PARAM;
+    }
+
+    delete[] f->pilots;
+    delete[] f->remap;
+    delete(f);
+    return SUCCESS;
+}
+
+/**
+ * Get the index of a key
+ * @param f [in] function
+ * @param k [in] key
+ * @return index in [0, n), distinct for each key the function was built with; any index for
+ *         other keys
+ */
+CODESHARK_INLINE size_t mphf_lookup(const mphf_t *f, int k)
+{
+    uint64_t h = _cshark_mphf_hash(f, k);
+    size_t slot = _cshark_mphf_slot(f, h, _cshark_mphf_get_pilot(f, _cshark_mphf_bucket(f, h)));
+
+    if (slot >= f->n)
+    {
+        slot = f->remap[slot - f->n];
+    }
+    return slot;
+}
+
+/**
+ * Get the bits of a function: packed pilots and the remap array
+ */
+CODESHARK_INLINE size_t mphf_get_bits(const mphf_t *f)
+{
+    return f->buckets * f->pilot_bits + (f->table_size - f->n) * 32;
+}
+
+/**
+ * Build a static hash table of keys and values
+ * @param keys [in] distinct keys
+ * @param values [in] value of each key
+ * @param n [in] number of keys, at least 1
+ * @return table, or \NULL if keys repeat, there are none, or values take 4 GB or more
+ */
+CODESHARK_INLINE perfect_hashtable_t *perfect_hashtable_build(const int *keys, const string *values, size_t n)
+{
+    perfect_hashtable_t *t;
+    mphf_t *f;
+    vector<uint32_t> index(n);
+    uint64_t total = 0;
+    size_t i;
+
+    if (keys == NULL or values == NULL)
+    {
+        return NULL;
+    }
+
+    for (i = 0; i < n; i++)
+    {
+        total += values[i].size();
+    }
+    if (total > UINT32_MAX)
+    {
+        return NULL;
+    }
+
+    f = mphf_build(keys, n);
+    if (f == NULL)
+    {
+        return NULL;
+    }
+
+    t = new perfect_hashtable_t();
+    t->mphf = f;
+    t->keys = new int[n];
+    t->offsets = new uint32_t[n + 1]();
+    t->values = new char[total + 1];
+
+    for (i = 0; i < n; i++)
+    {
+        index[i] = (uint32_t)mphf_lookup(f, keys[i]);
+        t->keys[index[i]] = keys[i];
+        t->offsets[index[i] + 1] = (uint32_t)values[i].size();
+    }
+    for (i = 0; i < n; i++)
+    {
+        t->offsets[i + 1] += t->offsets[i];
+    }
+    for (i = 0; i < n; i++)
+    {
+        memcpy(t->values + t->offsets[index[i]], values[i].data(), values[i].size());
+    }
+
+    return t;
+}
+
+/**
+ * Destroy a static hash table
+ * @param t [in] table
+ * @return \0 on success, or ERROR_PARAM
+ */
+CODESHARK_INLINE int perfect_hashtable_destroy(perfect_hashtable_t *t)
+{
+    if (t == NULL)
+    {
+        return ERROR_PARAM;
+    }
+
+    if (t->mphf != NULL)
+    {
+        mphf_destroy(t->mphf);
+    }
+    delete[] t->keys;
+    delete[] t->offsets;
+    delete[] t->values;
+    delete(t);
+    return SUCCESS;
+}
+
+/**
+ * Find the value of a key, in one probe
+ * @param t [in] table
+ * @param k [in] key
+ * @param val_len [out] value length, may be \NULL
+ * @return value bytes, not terminated, valid until the table is destroyed; or \NULL if not found
+ */
+CODESHARK_INLINE const char *perfect_hashtable_find(perfect_hashtable_t *t, int k, size_t *val_len)
+{
+    size_t i;
+
+    if (t == NULL)
+    {
+        return NULL;
+    }
+
+    i = mphf_lookup(t->mphf, k);
+    if (t->keys[i] != k)
+    {
+        return NULL;
+    }
+
+    if (val_len != NULL)
+    {
+        *val_len = t->offsets[i + 1] - t->offsets[i];
+    }
+    return t->values + t->offsets[i];
+}
+
+CODESHARK_INLINE bool perfect_hashtable_contains(perfect_hashtable_t *t, int k)
+{
+    return t != NULL and t->keys[mphf_lookup(t->mphf, k)] == k;
+}
+
+CODESHARK_INLINE size_t perfect_hashtable_getsize(perfect_hashtable_t *t)
+{
+    return t->mphf->n;
+}
+
+/**
+ * Get the bytes used by the table: the function, keys, offsets and values
+ */
+CODESHARK_INLINE size_t perfect_hashtable_get_memory(perfect_hashtable_t *t)
+{
+    const mphf_t *f = t->mphf;
+
+    return sizeof(perfect_hashtable_t) + sizeof(mphf_t) +
+           _cshark_mphf_pilot_words(f->buckets, f->pilot_bits) * sizeof(uint64_t) +
+           (f->table_size - f->n + 1) * sizeof(uint32_t) +
+           f->n * (sizeof(int) + sizeof(uint32_t)) + sizeof(uint32_t) + t->offsets[f->n];
+}
+
+inline void _cshark_perfect_ht_put(string *out, const void *p, size_t n)
+{
+    out->append((const char *)p, n);
+}
+
+inline void _cshark_perfect_ht_put64(string *out, uint64_t v)
+{
+    _cshark_perfect_ht_put(out, &v, sizeof(v));
+}
+
+/**
+ * Read count items of a size from a buffer, if it holds that many
+ * @param pos [in/out] read position
+ * @return \true on success
+ */
+inline bool _cshark_perfect_ht_get(const char *buf, size_t len, size_t *pos, void *dst, size_t count, size_t size)
+{
+    if (count > (len - *pos) / size)
+    {
+        return false;
+    }
+
+    memcpy(dst, buf + *pos, count * size);
+    *pos += count * size;
+    return true;
+}
+
+/**
+ * Append a table to a buffer: a header, the function, keys, offsets and values, in host byte order
+ * @param t [in] table
+ * @param out [out] buffer
+ * @return \0 on success, or ERROR_PARAM
+ */
+CODESHARK_INLINE int perfect_hashtable_save(perfect_hashtable_t *t, string *out)
+{
+    const mphf_t *f;
+    uint32_t header[2] = {PERFECT_HT_MAGIC, PERFECT_HT_VERSION};
+
+    if (t == NULL or out == NULL)
+    {
+        return ERROR_PARAM;
+    }
+
+    f = t->mphf;
+    _cshark_perfect_ht_put(out, header, sizeof(header));
+    _cshark_perfect_ht_put64(out, f->seed);
+    _cshark_perfect_ht_put64(out, f->n);
+    _cshark_perfect_ht_put64(out, f->table_size);
+    _cshark_perfect_ht_put64(out, f->buckets);
+    _cshark_perfect_ht_put64(out, f->dense_buckets);
+    _cshark_perfect_ht_put64(out, f->pilot_bits);
+    _cshark_perfect_ht_put(out, f->pilots, _cshark_mphf_pilot_words(f->buckets, f->pilot_bits) * sizeof(uint64_t));
+    _cshark_perfect_ht_put(out, f->remap, (f->table_size - f->n) * sizeof(uint32_t));
+    _cshark_perfect_ht_put(out, t->keys, f->n * sizeof(int));
+    _cshark_perfect_ht_put(out, t->offsets, (f->n + 1) * sizeof(uint32_t));
+    _cshark_perfect_ht_put(out, t->values, t->offsets[f->n]);
+
+    return SUCCESS;
+}
+
+/**
+ * Load a table saved by perfect_hashtable_save(). The buffer is copied and checked, so a
+ * truncated or damaged buffer is rejected rather than read out of bounds.
+ * @param buf [in] buffer
+ * @param len [in] buffer length
+ * @return table, or \NULL if the buffer does not hold exactly one valid table
+ */
+CODESHARK_INLINE perfect_hashtable_t *perfect_hashtable_load(const char *buf, size_t len)
+{
+    perfect_hashtable_t *t;
+    mphf_t *f;
+    uint32_t header[2];
+    uint64_t fields[6];
+    size_t i, pos = 0;
+    bool ok;
+
+    if (buf == NULL or !_cshark_perfect_ht_get(buf, len, &pos, header, 2, sizeof(uint32_t)) or
+        !_cshark_perfect_ht_get(buf, len, &pos, fields, 6, sizeof(uint64_t)) or
+        header[0] != PERFECT_HT_MAGIC or header[1] != PERFECT_HT_VERSION)
+    {
+        return NULL;
+    }
+
+    // every count is checked against the buffer before it is used as an allocation size
+    if (fields[1] == 0 or fields[1] > len or fields[2] < fields[1] or fields[2] - fields[1] > len or
+        fields[3] < 2 or fields[3] / 8 > len or fields[4] == 0 or fields[4] >= fields[3] or
+        fields[5] == 0 or fields[5] > 32)
+    {
+        return NULL;
+    }
+
+    f = new mphf_t();
+    f->seed = fields[0];
+    f->n = fields[1];
+    f->table_size = fields[2];
+    f->buckets = fields[3];
+    f->dense_buckets = fields[4];
+    f->pilot_bits = (uint32_t)fields[5];
+    f->pilots = new uint64_t[_cshark_mphf_pilot_words(f->buckets, f->pilot_bits)];
+    f->remap = new uint32_t[f->table_size - f->n + 1]();
+
+    t = new perfect_hashtable_t();
+    t->mphf = f;
+    t->keys = new int[f->n];
+    t->offsets = new uint32_t[f->n + 1];
+
+    ok = _cshark_perfect_ht_get(buf, len, &pos, f->pilots, _cshark_mphf_pilot_words(f->buckets, f->pilot_bits),
+                                sizeof(uint64_t)) and
+         _cshark_perfect_ht_get(buf, len, &pos, f->remap, f->table_size - f->n, sizeof(uint32_t)) and
+         _cshark_perfect_ht_get(buf, len, &pos, t->keys, f->n, sizeof(int)) and
+         _cshark_perfect_ht_get(buf, len, &pos, t->offsets, f->n + 1, sizeof(uint32_t)) and
+         t->offsets[0] == 0 and t->offsets[f->n] == len - pos;
+
+    for (i = 0; ok and i < f->table_size - f->n; i++)
+    {
+        ok = f->remap[i] < f->n;
+    }
+    for (i = 0; ok and i < f->n; i++)
+    {
+        ok = t->offsets[i] <= t->offsets[i + 1];
+    }
+
+    if (!ok)
+    {
+        perfect_hashtable_destroy(t);
+        return NULL;
+    }
+
+    t->values = new char[len - pos + 1];
+    memcpy(t->values, buf + pos, len - pos);
+    return t;
+}
+
+#endif //CODESHARK_PERFECT_HASHTABLE_INL_H
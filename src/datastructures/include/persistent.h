@@ -0,0 +1,207 @@
+/*
+ ============================================================================
+ Name        : persistent.h
+ Description : persistent list and tree header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_PERSISTENT_H
+#define CODESHARK_PERSISTENT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Persistent containers share nodes between versions. A snapshot is a copy of the container
+ * object, O(1), which takes a reference on the root node only.
+ *
+ * A node is immutable while it is shared (refs > 1). A mutation copies the shared nodes on the
+ * path to the change (path copying) and changes nodes owned by one version in place, so a
+ * version without snapshots is updated like an ordinary container, and snapshot memory grows
+ * with changes rather than size. Reference counts are atomic: snapshots may be read and released
+ * by other threads while the writer keeps changing its own version, and readers never lock.
+ */
+
+/**
+ * @struct cshark_plist_node_t
+ * Node of PersistentList; next is shared by all versions containing the node.
+ */
+typedef struct _cshark_plist_node_t
+{
+    int val;
+    string name;
+    atomic<size_t> refs;
+    struct _cshark_plist_node_t *next;
+}cshark_plist_node_t;
+
+/**
+ * @struct cshark_ptree_node_t
+ * Node of PersistentTree, ordered by key, and a max-heap by prio (a treap)
+ */
+typedef struct _cshark_ptree_node_t
+{
+    int key;
+    string name;
+    uint32_t prio;                      // derived from key, so every version has the same shape
+    atomic<size_t> refs;
+    struct _cshark_ptree_node_t *left;
+    struct _cshark_ptree_node_t *right;
+}cshark_ptree_node_t;
+
+/**
+ * @class PersistentList is a singly linked list with O(1) snapshots. push_front() and pop_front()
+ *        are O(1); set(), insert() and erase() at position i copy at most i + 1 shared nodes.
+ */
+class PersistentList
+{
+private:
+    cshark_plist_node_t *head;
+    size_t size;
+
+    cshark_plist_node_t **mutable_link(size_t pos);
+
+public:
+    class const_iterator
+    {
+    private:
+        const cshark_plist_node_t *nt;
+
+    public:
+        typedef forward_iterator_tag iterator_category;
+        typedef const cshark_plist_node_t value_type;
+        typedef ptrdiff_t difference_type;
+        typedef const cshark_plist_node_t *pointer;
+        typedef const cshark_plist_node_t &reference;
+
+        const_iterator(const cshark_plist_node_t *node = NULL) : nt(node) {}
+
+        reference operator*() const { return *this->nt; }
+        pointer operator->() const { return this->nt; }
+        const_iterator &operator++() { this->nt = this->nt->next; return *this; }
+        const_iterator operator++(int) { const_iterator it = *this; this->nt = this->nt->next; return it; }
+        bool operator==(const const_iterator &other) const { return this->nt == other.nt; }
+        bool operator!=(const const_iterator &other) const { return this->nt != other.nt; }
+    };
+
+    PersistentList();
+    PersistentList(const PersistentList &other);
+    PersistentList &operator=(const PersistentList &other);
+    ~PersistentList();
+
+    PersistentList snapshot() const;
+    size_t get_size() const;
+    bool is_empty() const;
+    const cshark_plist_node_t *get_first() const;
+    const cshark_plist_node_t *find_by_pos(size_t pos) const;
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    int push_front(int val, const string &name = "");
+    int pop_front();
+    int set(size_t pos, int val);
+    int insert(size_t pos, int val, const string &name = "");
+    int erase(size_t pos);
+    void clear();
+};
+
+/**
+ * @class PersistentTree is an ordered map from int keys to names with O(1) snapshots.
+ *        It is a treap, so its depth is O(logN) with high probability; insert() and erase()
+ *        copy at most the O(logN) shared nodes on the path to the key.
+ */
+class PersistentTree
+{
+private:
+    cshark_ptree_node_t *root;
+    size_t size;
+
+public:
+    /**
+     * @class const_iterator visits nodes in key order
+     */
+    class const_iterator
+    {
+    private:
+        vector<const cshark_ptree_node_t *> path;   // nodes whose left subtree is being visited
+
+        void push_left(const cshark_ptree_node_t *p)
+        {
+            while (p != NULL)
+            {
+                this->path.push_back(p);
+                p = p->left;
+            }
+        }
+
+    public:
+        typedef forward_iterator_tag iterator_category;
+        typedef const cshark_ptree_node_t value_type;
+        typedef ptrdiff_t difference_type;
+        typedef const cshark_ptree_node_t *pointer;
+        typedef const cshark_ptree_node_t &reference;
+
+        const_iterator(const cshark_ptree_node_t *root = NULL) { this->push_left(root); }
+
+        reference operator*() const { return *this->path.back(); }
+        pointer operator->() const { return this->path.back(); }
+
+        const_iterator &operator++()
+        {
+            const cshark_ptree_node_t *p = this->path.back();
+
+            this->path.pop_back();
+            this->push_left(p->right);
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator it = *this;
+            ++(*this);
+            return it;
+        }
+
+        bool operator==(const const_iterator &other) const
+        {
+            return this->path.empty() ? other.path.empty()
+                                      : (!other.path.empty() and this->path.back() == other.path.back());
+        }
+        bool operator!=(const const_iterator &other) const { return !(*this == other); }
+    };
+
+    PersistentTree();
+    PersistentTree(const PersistentTree &other);
+    PersistentTree &operator=(const PersistentTree &other);
+    ~PersistentTree();
+
+    PersistentTree snapshot() const;
+    size_t get_size() const;
+    bool is_empty() const;
+    const cshark_ptree_node_t *find(int key) const;
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    int insert(int key, const string &name);
+    int erase(int key);
+    void clear();
+};
+
+// Persistent node functions
+
+void cshark_plist_node_release(cshark_plist_node_t *nt);
+void cshark_ptree_node_release(cshark_ptree_node_t *nt);
+
+#ifdef CODESHARK_HEADER_ONLY
+#include "datastructures/include/persistent_inl.h"
+#endif
+
+#endif //CODESHARK_PERSISTENT_H
@@ -0,0 +1,616 @@
+/*
+ ============================================================================
+ Name        : persistent_inl.h
+ Description : persistent list and tree inline implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_PERSISTENT_INL_H
+#define CODESHARK_PERSISTENT_INL_H
+
+#include "common/include/common.h"
+#include "common/include/err.h"
+#include "datastructures/include/persistent.h"
+
+/**
+ * Take a reference on a list node
+ */
+inline void _cshark_plist_node_retain(cshark_plist_node_t *nt)
+{
+    if (nt != NULL)
+    {
+        nt->refs.fetch_add(1, memory_order_relaxed);
+    }
+}
+
+/**
+ * Create a list node with one reference, taking over the reference the caller holds on next
+ */
+inline cshark_plist_node_t *_cshark_plist_node_new(int val, const string &name, cshark_plist_node_t *next)
+{
+    cshark_plist_node_t *nt = new cshark_plist_node_t();
+
+    nt->val = val;
+    nt->name = name;
+    nt->refs.store(1, memory_order_relaxed);
+    nt->next = next;
+
+    return nt;
+}
+
+/**
+ * Make the node a link points to owned by this version only, copying it if it is shared
+ * @param link [in,out] &head or &next of an exclusive node
+ * @return the exclusive node
+ */
+inline cshark_plist_node_t *_cshark_plist_make_exclusive(cshark_plist_node_t **link)
+{
+    cshark_plist_node_t *nt = *link;
+    cshark_plist_node_t *copy;
+
+    if (nt->refs.load(memory_order_acquire) == 1)
+    {
+        return nt;
+    }
+
+    _cshark_plist_node_retain(nt->next);
+    copy = _cshark_plist_node_new(nt->val, nt->name, nt->next);
+    *link = copy;
+    cshark_plist_node_release(nt);
+
+    return copy;
+}
+
+/**
+ * Release a reference on a list node; nodes no version refers to are freed,
+ * iteratively so that long lists do not overflow the stack
+ * @param nt [in] node, or \NULL
+ */
+CODESHARK_INLINE void cshark_plist_node_release(cshark_plist_node_t *nt)
+{
+    cshark_plist_node_t *next;
+
+    while (nt != NULL and nt->refs.fetch_sub(1, memory_order_acq_rel) == 1)
+    {
+        next = nt->next;
+        delete(nt);
+        nt = next;
+    }
+}
+
+/**
+ * Initialize an empty persistent list
+ */
+CODESHARK_INLINE PersistentList::PersistentList()
+{
+    this->head = NULL;
+    this->size = 0;
+}
+
+/**
+ * Make a snapshot of another list, sharing all its nodes
+ * Time complexity: O(1)
+ */
+CODESHARK_INLINE PersistentList::PersistentList(const PersistentList &other)
+{
+    this->head = other.head;
+    this->size = other.size;
+    _cshark_plist_node_retain(this->head);
+}
+
+CODESHARK_INLINE PersistentList &PersistentList::operator=(const PersistentList &other)
+{
+    _cshark_plist_node_retain(other.head);  // before releasing, in case of self-assignment
+    cshark_plist_node_release(this->head);
+
+    this->head = other.head;
+    this->size = other.size;
+
+    return *this;
+}
+
+/**
+ * Release the list; nodes shared with snapshots are kept for them
+ */
+CODESHARK_INLINE PersistentList::~PersistentList()
+{
+    cshark_plist_node_release(this->head);
+}
+
+/**
+ * Make a snapshot of the list; later changes of either list are not visible to the other
+ * Time complexity: O(1)
+ */
+CODESHARK_INLINE PersistentList PersistentList::snapshot() const
+{
+    return PersistentList(*this);
+}
+
+CODESHARK_INLINE size_t PersistentList::get_size() const
+{
+    return this->size;
+}
+
+CODESHARK_INLINE bool PersistentList::is_empty() const
+{
+    return this->size == 0;
+}
+
+CODESHARK_INLINE const cshark_plist_node_t *PersistentList::get_first() const
+{
+    return this->head;
+}
+
+/**
+ * Find node by position, the first position is 0
+ * @param pos [in] position
+ * @return \NULL or valid pointer of the node
+ */
+CODESHARK_INLINE const cshark_plist_node_t *PersistentList::find_by_pos(size_t pos) const
+{
+    const cshark_plist_node_t *nt;
+    size_t i;
+
+    nt = this->head;
+    for (i = 0; nt != NULL and i < pos; i++)
+    {
+        nt = nt->next;
+    }
+
+    return nt;
+}
+
+CODESHARK_INLINE PersistentList::const_iterator PersistentList::begin() const
+{
+    return const_iterator(this->head);
+}
+
+CODESHARK_INLINE PersistentList::const_iterator PersistentList::end() const
+{
+    return const_iterator(NULL);
+}
+
+/**
+ * Make the first pos nodes exclusive, copying shared ones (path copying)
+ * @param pos [in] position, at most size
+ * @return address of the link to the node at pos
+ */
+CODESHARK_INLINE cshark_plist_node_t **PersistentList::mutable_link(size_t pos)
+{
+    cshark_plist_node_t **link;
+    size_t i;
+
+    link = &this->head;
+    for (i = 0; i < pos; i++)
+    {
+        link = &_cshark_plist_make_exclusive(link)->next;
+    }
+
+    return link;
+}
+
+/**
+ * Add a node in front of the list
+ * Time complexity: O(1)
+ * @param val [in] value
+ * @param name [in] name
+ * @return \0 on success
+ */
+CODESHARK_INLINE int PersistentList::push_front(int val, const string &name)
+{
+    this->head = _cshark_plist_node_new(val, name, this->head);
+    this->size++;
+
+    return SUCCESS;
+}
+
+/**
+ * Remove the first node
+ * Time complexity: O(1)
+ * @return \0 on success, or ERROR_TARGET_EMPTY
+ */
+CODESHARK_INLINE int PersistentList::pop_front()
+{
+    if (this->size == 0)
+    {
+        return ERROR_TARGET_EMPTY;
+    }
+
+    return this->erase(0);
+}
+
+/**
+ * Set the value of a node
+ * @param pos [in] position, the first position is 0
+ * @param val [in] value
+ * @return \0 on success, or other error code
+ */
+CODESHARK_INLINE int PersistentList::set(size_t pos, int val)
+{
+    cshark_plist_node_t **link;
+
+    if (pos >= this->size)
+    {
+        return ERROR_PARAM;
+    }
+
+    link = this->mutable_link(pos);
+    _cshark_plist_make_exclusive(link)->val = val;
+
+    return SUCCESS;
+}
+
+/**
+ * Insert a node before position pos, or at the tail if pos is the size
+ * @param pos [in] position
+ * @param val [in] value
+ * @param name [in] name
+ * @return \0 on success, or other error code
+ */
+CODESHARK_INLINE int PersistentList::insert(size_t pos, int val, const string &name)
+{
+    cshark_plist_node_t **link;
+
+    if (pos > this->size)
+    {
+        return ERROR_PARAM;
+    }
+
+    link = this->mutable_link(pos);
+    *link = _cshark_plist_node_new(val, name, *link);
+    this->size++;
+
+    return SUCCESS;
+}
+
+/**
+ * Remove the node at a position
+ * @param pos [in] position
+ * @return \0 on success, or other error code
+ */
+CODESHARK_INLINE int PersistentList::erase(size_t pos)
+{
+    cshark_plist_node_t **link;
+    cshark_plist_node_t *nt;
+
+    if (pos >= this->size)
+    {
+        return ERROR_PARAM;
+    }
+
+    link = this->mutable_link(pos);
+    nt = *link;
+    *link = nt->next;
+    _cshark_plist_node_retain(nt->next);
+    cshark_plist_node_release(nt);
+    this->size--;
+
+    return SUCCESS;
+}
+
+/**
+ * Remove all nodes of this version
+ */
+CODESHARK_INLINE void PersistentList::clear()
+{
+    cshark_plist_node_release(this->head);
+    this->head = NULL;
+    this->size = 0;
+}
+
+/**
+ * Priority of a key, a bijective hash, so distinct keys never tie
+ */
+inline uint32_t _cshark_ptree_prio(int key)
+{
+    uint32_t x = (uint32_t)key;
+
+    x ^= x >> 16;
+    x *= 0x7feb352dU;
+    x ^= x >> 15;
+    x *= 0x846ca68bU;
+    x ^= x >> 16;
+
+    return x;
+}
+
+inline void _cshark_ptree_node_retain(cshark_ptree_node_t *nt)
+{
+    if (nt != NULL)
+    {
+        nt->refs.fetch_add(1, memory_order_relaxed);
+    }
+}
+
+inline cshark_ptree_node_t *_cshark_ptree_node_new(int key, const string &name,
+                                                   cshark_ptree_node_t *left, cshark_ptree_node_t *right)
+{
+    cshark_ptree_node_t *nt = new cshark_ptree_node_t();
+
+    nt->key = key;
+    nt->name = name;
+    nt->prio = _cshark_ptree_prio(key);
+    nt->refs.store(1, memory_order_relaxed);
+    nt->left = left;
+    nt->right = right;
+
+    return nt;
+}
+
+/**
+ * Release a reference on a tree node, and free the subtree no version refers to
+ * @param nt [in] node, or \NULL
+ */
+CODESHARK_INLINE void cshark_ptree_node_release(cshark_ptree_node_t *nt)
+{
+    if (nt != NULL and nt->refs.fetch_sub(1, memory_order_acq_rel) == 1)
+    {
+        cshark_ptree_node_release(nt->left);
+        cshark_ptree_node_release(nt->right);
+        delete(nt);
+    }
+}
+
+/**
+ * Turn a reference on a node into a reference on an exclusive node, copying the node if shared
+ */
+inline cshark_ptree_node_t *_cshark_ptree_make_exclusive(cshark_ptree_node_t *nt)
+{
+    cshark_ptree_node_t *copy;
+
+    if (nt->refs.load(memory_order_acquire) == 1)
+    {
+        return nt;
+    }
+
+    _cshark_ptree_node_retain(nt->left);
+    _cshark_ptree_node_retain(nt->right);
+    copy = _cshark_ptree_node_new(nt->key, nt->name, nt->left, nt->right);
+    cshark_ptree_node_release(nt);
+
+    return copy;
+}
+
+/**
+ * Insert or update a key in the subtree t
+ * @param t [in] reference on the subtree, which is consumed
+ * @return reference on the new subtree, whose root is exclusive
+ */
+inline cshark_ptree_node_t *_cshark_ptree_insert(cshark_ptree_node_t *t, int key, const string &name, bool *added)
+{
+    cshark_ptree_node_t *child;
+
+    if (t == NULL)
+    {
+        *added = true;
+        return _cshark_ptree_node_new(key, name, NULL, NULL);
+    }
+
+    t = _cshark_ptree_make_exclusive(t);
+    if (key == t->key)
+    {
+        t->name = name;
+    }
+    else if (key < t->key)
+    {
+        t->left = _cshark_ptree_insert(t->left, key, name, added);
+        if (t->left->prio > t->prio)    // rotate right
+        {
+            child = t->left;
+            t->left = child->right;
+            child->right = t;
+            t = child;
+        }
+    }
+    else
+    {
+        t->right = _cshark_ptree_insert(t->right, key, name, added);
+        if (t->right->prio > t->prio)   // rotate left
+        {
+            child = t->right;
+            t->right = child->left;
+            child->left = t;
+            t = child;
+        }
+    }
+
+    return t;
+}
+
+/**
+ * Merge subtrees a and b, where all keys of a are less than keys of b; references are consumed
+ */
+inline cshark_ptree_node_t *_cshark_ptree_merge(cshark_ptree_node_t *a, cshark_ptree_node_t *b)
+{
+    if (a == NULL)
+    {
+        return b;
+    }
+    if (b == NULL)
+    {
+        return a;
+    }
+
+    if (a->prio > b->prio)
+    {
+        a = _cshark_ptree_make_exclusive(a);
+        a->right = _cshark_ptree_merge(a->right, b);
+        return a;
+    }
+
+    b = _cshark_ptree_make_exclusive(b);
+    b->left = _cshark_ptree_merge(a, b->left);
+    return b;
+}
+
+/**
+ * Remove a key, which must be in the subtree t
+ * @param t [in] reference on the subtree, which is consumed
+ * @return reference on the new subtree
+ */
+inline cshark_ptree_node_t *_cshark_ptree_erase(cshark_ptree_node_t *t, int key)
+{
+    cshark_ptree_node_t *left;
+    cshark_ptree_node_t *right;
+
+    if (key == t->key)
+    {
+        left = t->left;
+        right = t->right;
+        _cshark_ptree_node_retain(left);
+        _cshark_ptree_node_retain(right);
+        cshark_ptree_node_release(t);
+
+        return _cshark_ptree_merge(left, right);
+    }
+
+    t = _cshark_ptree_make_exclusive(t);
+    if (key < t->key)
+    {
+        t->left = _cshark_ptree_erase(t->left, key);
+    }
+    else
+    {
+        t->right = _cshark_ptree_erase(t->right, key);
+    }
+
+    return t;
+}
+
+/**
+ * Initialize an empty persistent tree
+ */
+CODESHARK_INLINE PersistentTree::PersistentTree()
+{
+    this->root = NULL;
+    this->size = 0;
+}
+
+/**
+ * Make a snapshot of another tree, sharing all its nodes
+ * Time complexity: O(1)
+ */
+CODESHARK_INLINE PersistentTree::PersistentTree(const PersistentTree &other)
+{
+    this->root = other.root;
+    this->size = other.size;
+    _cshark_ptree_node_retain(this->root);
+}
+
+CODESHARK_INLINE PersistentTree &PersistentTree::operator=(const PersistentTree &other)
+{
+    _cshark_ptree_node_retain(other.root);
+    cshark_ptree_node_release(this->root);
+
+    this->root = other.root;
+    this->size = other.size;
+
+    return *this;
+}
+
+CODESHARK_INLINE PersistentTree::~PersistentTree()
+{
+    cshark_ptree_node_release(this->root);
+}
+
+/**
+ * Make a snapshot of the tree; later changes of either tree are not visible to the other
+ * Time complexity: O(1)
+ */
+CODESHARK_INLINE PersistentTree PersistentTree::snapshot() const
+{
+    return PersistentTree(*this);
+}
+
+CODESHARK_INLINE size_t PersistentTree::get_size() const
+{
+    return this->size;
+}
+
+CODESHARK_INLINE bool PersistentTree::is_empty() const
+{
+    return this->size == 0;
+}
+
+/**
+ * Find the node of a key
+ * @param key [in] key
+ * @return \NULL if not found, else valid node pointer
+ */
+CODESHARK_INLINE const cshark_ptree_node_t *PersistentTree::find(int key) const
+{
+    const cshark_ptree_node_t *nt;
+
+    nt = this->root;
+    while (nt != NULL and nt->key != key)
+    {
+        nt = (key < nt->key) ? nt->left : nt->right;
+    }
+
+    return nt;
+}
+
+CODESHARK_INLINE PersistentTree::const_iterator PersistentTree::begin() const
+{
+    return const_iterator(this->root);
+}
+
+CODESHARK_INLINE PersistentTree::const_iterator PersistentTree::end() const
+{
+    return const_iterator(NULL);
+}
+
+/**
+ * Insert a key, or update its name if the key exists
+ * Time complexity: O(logN), copying shared nodes on the path only
+ * @param key [in] key
+ * @param name [in] name
+ * @return \0 on success
+ */
+CODESHARK_INLINE int PersistentTree::insert(int key, const string &name)
+{
+    bool added = false;
+
+    this->root = _cshark_ptree_insert(this->root, key, name, &added);
+    if (added)
+    {
+        this->size++;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Remove a key
+ * Time complexity: O(logN), copying shared nodes on the path only
+ * @param key [in] key
+ * @return \0 on success, or ERROR_NOT_FOUND
+ */
+CODESHARK_INLINE int PersistentTree::erase(int key)
+{
+    // look up first, so a missing key copies nothing
+    if (this->find(key) == NULL)
+    {
+        return ERROR_NOT_FOUND;
+    }
+
+    this->root = _cshark_ptree_erase(this->root, key);
+    this->size--;
+
+    return SUCCESS;
+}
+
+/**
+ * Remove all keys of this version
+ */
+CODESHARK_INLINE void PersistentTree::clear()
+{
+    cshark_ptree_node_release(this->root);
+    this->root = NULL;
+    this->size = 0;
+}
+
+#endif //CODESHARK_PERSISTENT_INL_H
@@ -11,25 +11,49 @@
 #ifndef CODESHARK_QUEUE_H
 #define CODESHARK_QUEUE_H
 
+#include "common/include/stats.h"
 #include "datastructures/include/linklist.h"
 
 /**
  * @class Queue maintains queue structure, which is a linklist internally.
+ *        Iterators walk from the front to the rear, the order of dequeue().
  */
 class Queue
 {
 private:
     LinkList *list;
 public:
+    typedef LinkList::iterator iterator;
+
     Queue();
     ~Queue();
 
+    iterator begin();
+    iterator end();
+
     bool is_empty();
     bool is_full();
     int enqueue(int n);
+    int enqueue_batch(const int *vals, size_t n);
+    template <typename Iter>
+    int enqueue_range(Iter first, Iter last);
     cshark_node_t * dequeue();
+    size_t dequeue_batch(int *vals, size_t n);
 };
 
+/**
+ * Enqueue values of a range in order, with all nodes allocated in one block
+ * @param first [in] forward iterator to the first value
+ * @param last [in] iterator past the last value
+ * @return \0 on success
+ */
+template <typename Iter>
+int Queue::enqueue_range(Iter first, Iter last)
+{
+    CSHARK_STAT_ADD(STAT_QUEUE_ENQUEUE, distance(first, last));
+    return this->list->insert_range(first, last);
+}
+
 typedef cshark_linklist_t cshark_queue;
 
 // Queue functions
@@ -37,11 +61,17 @@ typedef cshark_linklist_t cshark_queue;
 cshark_queue *cshark_queue_init();
 void cshark_queue_destroy(cshark_queue *queue);
 int cshark_queue_add(cshark_queue *queue, int val);
+int cshark_queue_add_batch(cshark_queue *queue, const int *vals, size_t n);
 int cshark_queue_insert(cshark_queue *queue, cshark_node_t *node);
 int cshark_queue_remove_clone(cshark_queue *queue, cshark_node_t **repli);
 cshark_node_t* cshark_queue_remove(cshark_queue *queue);
 size_t  cshark_queue_getsize(cshark_queue *queue);
 cshark_node_t *cshark_queue_visit(cshark_queue *queue);
 int cshark_queue_pop(cshark_queue *queue, int *val);
+size_t cshark_queue_pop_batch(cshark_queue *queue, int *vals, size_t n);
+
+#ifdef CODESHARK_HEADER_ONLY
+#include "datastructures/include/queue_inl.h"
+#endif
 
 #endif //CODESHARK_QUEUE_H
@@ -0,0 +1,333 @@
+/*
+============================================================================
+ Name        : queue_inl.h
+ Description : queue inline implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_QUEUE_INL_H
+#define CODESHARK_QUEUE_INL_H
+
+#include "common/include/common.h"
+#include "datastructures/include/linklist.h"
+#include "datastructures/include/queue.h"
+#include "common/include/err.h"
+#include "common/include/stats.h"
+
+/**
+ * Initialize a new and empty queue
+ */
+CODESHARK_INLINE Queue::Queue()
+{
+    this->list = new LinkList(0);
+}
+
+/**
+ * Delete the queue
+ */
+CODESHARK_INLINE Queue::~Queue()
+{
+    delete(this->list);
+}
+
+/**
+ * Get the iterator to the front node
+ */
+CODESHARK_INLINE Queue::iterator Queue::begin()
+{
+    return this->list->begin();
+}
+
+/**
+ * Get the iterator past the rear node
+ */
+CODESHARK_INLINE Queue::iterator Queue::end()
+{
+    return this->list->end();
+}
+
+/**
+ * Push a node into queue
+ * @param x [in] val
+ * @return always SUCCESS
+ */
+CODESHARK_INLINE int Queue::enqueue(int x)
+{
+    cshark_node_t *nt = cshark_node_init();
+    nt->val = x;
+
+    CSHARK_STAT_INC(STAT_QUEUE_ENQUEUE);
+    this->list->insert_node(nt);
+
+    return SUCCESS;
+}
+
+/**
+ * Enqueue values in order
+ * @param vals [in] values
+ * @param n [in] number of values
+ * @return \0 on success, or other error code
+ */
+CODESHARK_INLINE int Queue::enqueue_batch(const int *vals, size_t n)
+{
+    if (vals == NULL and n > 0)
+    {
+        return ERROR_PARAM;
+    }
+
+    return this->enqueue_range(vals, vals + n);
+}
+
+/**
+ * Pop the first node of the queue
+ * \warning caller must manually free the node
+ * @return the first node of the queue
+ */
+CODESHARK_INLINE cshark_node_t *Queue::dequeue()
+{
+    cshark_node_t *ret;
+
+    // an empty queue is not a dequeue, so the counter matches values taken out
+    ret = this->list->pop_first();
+    if (ret != NULL)
+    {
+        CSHARK_STAT_INC(STAT_QUEUE_DEQUEUE);
+    }
+
+    return ret;
+}
+
+/**
+ * Dequeue up to n values into a buffer, and free their nodes
+ * @param vals [out] values, in queue order
+ * @param n [in] maximum number of values
+ * @return number of dequeued values
+ */
+CODESHARK_INLINE size_t Queue::dequeue_batch(int *vals, size_t n)
+{
+    size_t k;
+
+    k = this->list->pop_first_batch(vals, n);
+    CSHARK_STAT_ADD(STAT_QUEUE_DEQUEUE, k);
+
+    return k;
+}
+
+/**
+ * Check if queue is full
+ * \note queue can increase dynamically, so always return 'no'
+ * @return false
+ */
+CODESHARK_INLINE bool Queue::is_full()
+{
+    return false;
+}
+
+/**
+ * Check if queue is empty
+ * @return 'yes' if empty otherwise 'no'
+ */
+CODESHARK_INLINE bool Queue::is_empty()
+{
+    return this->list->get_size() == 0;
+}
+
+/**
+ * Initiate an empty queue
+ * @return head node the new queue
+ */
+CODESHARK_INLINE cshark_queue *cshark_queue_init()
+{
+    return cshark_linklist_init(0);  /* only head */
+}
+
+/**
+ * Destroy a queue
+ * @param queue [in] queue to detory
+ */
+CODESHARK_INLINE void cshark_queue_destroy(cshark_queue *queue)
+{
+    cshark_linklist_destroy(queue);
+}
+
+/**
+ * Visit the first node (after root) of a queue
+ * @param queue [in] queue
+ * @return \NULL if queue is empty, else the first node
+ */
+CODESHARK_INLINE cshark_node_t *cshark_queue_visit(cshark_queue *queue)
+{
+    return cshark_linklist_get_first(queue);
+}
+
+/**
+ * Add a new node in queue
+ * @param queue [in,out] queue
+ * @param val   [in] value for the new node
+ * @return 0 on success
+ */
+CODESHARK_INLINE int cshark_queue_add(cshark_queue *queue, int val)
+{
+    if (queue == NULL)
+    {
+        return ERROR_PARAM;
+    }
+
+    CSHARK_STAT_INC(STAT_QUEUE_ENQUEUE);
+    cshark_linklist_add(queue, val);
+
+    return SUCCESS;
+}
+
+/**
+ * Insert a node insert queue
+ * @param queue [in,out] queue
+ * @param node [in] node
+ * @return \0 on success or other error code
+ */
+CODESHARK_INLINE int cshark_queue_insert(cshark_queue *queue, cshark_node_t *node)
+{
+    if (queue == NULL or node == NULL)
+    {
+        return ERROR_PARAM;
+    }
+
+    CSHARK_STAT_INC(STAT_QUEUE_ENQUEUE);
+    cshark_linklist_insert(queue, node);
+
+    return SUCCESS;
+}
+
+
+/**
+ * Get queue size
+ * @param queue [in] queue
+ * @return queue size
+ */
+CODESHARK_INLINE size_t cshark_queue_getsize(cshark_queue *queue)
+{
+    return cshark_linklist_getsize(queue);
+}
+
+/**
+ * Remove the first element of a queue, and make a copy of the element
+ * \warning caller must manually free repli
+ * @param queue [in] queue
+ * @param repli [out] a copy of the first element
+ * @return \0 on success
+ */
+CODESHARK_INLINE int cshark_queue_remove_clone(cshark_queue *queue, cshark_node_t **repli)
+{
+    cshark_node_t *last;
+    size_t queue_size;
+    int v;
+
+    queue_size = cshark_queue_getsize(queue);
+    if (queue_size == 0)
+    {
+        *repli = NULL;
+    }
+    else
+    {
+        *repli = cshark_node_init();
+    }
+
+    if (queue_size > 0)
+    {
+        CSHARK_STAT_INC(STAT_QUEUE_DEQUEUE);
+    }
+    last = cshark_linklist_get_first(queue);
+    cshark_node_copy(last, *repli);
+
+    cshark_linklist_delete_first(queue, &v);
+
+    return SUCCESS;
+}
+
+/**
+ * Remove the first element of a queue
+ * @param queue [in] queue
+ * @return \0 on success
+ */
+CODESHARK_INLINE cshark_node_t* cshark_queue_remove(cshark_queue *queue)
+{
+    cshark_node_t *first;
+    size_t queue_size;
+    int v;
+
+    queue_size = cshark_queue_getsize(queue);
+    if (queue_size == 0)
+    {
+        first = NULL;
+    }
+
+    if (queue_size > 0)
+    {
+        CSHARK_STAT_INC(STAT_QUEUE_DEQUEUE);
+    }
+    first = cshark_linklist_get_first(queue);
+    cshark_linklist_delete_first(queue, &v);
+
+    return SUCCESS;
+}
+
+/**
+ * Pop the first element's value and do not delete the element
+ * @param queue [in] queue
+ * @param val [out] the first element's value
+ * @return \0 on success
+ */
+CODESHARK_INLINE int cshark_queue_pop(cshark_queue *queue, int *val)
+{
+    int ret;
+
+    ret = cshark_linklist_delete_first(queue, val);
+    if (ret == SUCCESS)
+    {
+        CSHARK_STAT_INC(STAT_QUEUE_DEQUEUE);
+    }
+
+    return ret;
+}
+
+/**
+ * Add values to the rear of queue in order
+ * @param queue [in,out] queue
+ * @param vals [in] values
+ * @param n [in] number of values
+ * @return \0 on success, or other error code
+ */
+CODESHARK_INLINE int cshark_queue_add_batch(cshark_queue *queue, const int *vals, size_t n)
+{
+    int ret;
+
+    ret = cshark_linklist_add_batch(queue, vals, n);
+    if (ret == SUCCESS)
+    {
+        CSHARK_STAT_ADD(STAT_QUEUE_ENQUEUE, n);
+    }
+
+    return ret;
+}
+
+/**
+ * Pop up to n values from the front of queue
+ * @param queue [in,out] queue
+ * @param vals [out] values, in queue order
+ * @param n [in] maximum number of values
+ * @return number of popped values
+ */
+CODESHARK_INLINE size_t cshark_queue_pop_batch(cshark_queue *queue, int *vals, size_t n)
+{
+    size_t k;
+
+    k = cshark_linklist_delete_first_batch(queue, vals, n);
+    CSHARK_STAT_ADD(STAT_QUEUE_DEQUEUE, k);
+
+    return k;
+}
+
+#endif //CODESHARK_QUEUE_INL_H
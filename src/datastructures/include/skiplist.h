@@ -0,0 +1,122 @@
+/*
+ ============================================================================
+ Name        : skiplist.h
+ Description : skip list header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_SKIPLIST_H
+#define CODESHARK_SKIPLIST_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <iterator>
+#include <string>
+
+#include "common/include/err.h"
+#include "common/include/node.h"
+#include "common/include/node_iterator.h"
+
+using namespace std;
+
+#define SKIPLIST_MAX_LEVEL   32      // enough for 4^32 nodes with a branching factor of 4
+
+/**
+ * @struct cshark_skiplist_tower_t
+ * Forward pointers of a skip list node above the bottom level. The tower is allocated right
+ * after its node, and the node's data points to it; level 0 is the node's own next, so the
+ * bottom level is a linklist.
+ *
+ *      | header | cshark_node_t | height | next[1] | ... | next[height - 1] |
+ */
+typedef struct _cshark_skiplist_tower_t
+{
+    size_t height;                      // levels of the node, the bottom one included
+    size_t links;                       // LockFreeSkipList: owners left before the node is retired
+    struct _cshark_node_t *next[1];     // next at levels 1 to height - 1
+}cshark_skiplist_tower_t;
+
+// Skip list node functions, shared by SkipList and LockFreeSkipList
+
+cshark_node_t *cshark_skiplist_node_init(int key, size_t height);
+size_t cshark_skiplist_random_height(uint64_t *state);
+
+/**
+ * Get the address of the next pointer of a node at a level
+ * \warning level must be below the height of the node
+ */
+inline cshark_node_t **cshark_skiplist_next_ref(cshark_node_t *nt, size_t level)
+{
+    return (level == 0) ? &nt->next : &((cshark_skiplist_tower_t *)nt->data)->next[level - 1];
+}
+
+inline size_t cshark_skiplist_height(const cshark_node_t *nt)
+{
+    return ((const cshark_skiplist_tower_t *)nt->data)->height;
+}
+
+/**
+ * @class SkipList is an ordered set or map of int keys, with search, insertion and deletion in
+ *        O(log n) expected time and no rebalancing. A node has the key in val and the value in
+ *        name, and a random height: each level holds about a quarter of the nodes below it.
+ *
+ *      level 2: head ---------------------------> 40 -------------> NULL
+ *      level 1: head ---------> 17 -------------> 40 ----> 52 ----> NULL
+ *      level 0: head <-> 5 <-> 17 <-> 23 <-> 31 <-> 40 <-> 52 <-> 60 -> NULL
+ *
+ * A search starts at the top of head, moves right while the next key is smaller, and down
+ * otherwise. Level 0 is a sorted, double-linked list like LinkList, so iterators and ranges walk
+ * it in key order, and --end() reaches the last node.
+ */
+class SkipList
+{
+private:
+    cshark_node_t *head;
+    cshark_node_t *tail;                // last node, or head if the list is empty
+    size_t size;
+    size_t level;                       // levels in use, at least 1
+    uint64_t seed;
+
+    cshark_node_t *find_preds(int key, cshark_node_t **preds);
+    cshark_node_t *insert_key(int key, cshark_node_t **preds);
+
+public:
+    typedef cshark_list_iterator<cshark_node_t> iterator;
+    typedef cshark_list_iterator<const cshark_node_t> const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+
+    SkipList();
+    ~SkipList();
+
+    SkipList(const SkipList &) = delete;
+    SkipList &operator=(const SkipList &) = delete;
+
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+    reverse_iterator rbegin();
+    reverse_iterator rend();
+    cshark_range<iterator> range(int lo, int hi);
+
+    size_t get_size();
+    cshark_node_t *get_first();
+    cshark_node_t *get_last();
+    cshark_node_t *find(int key);
+    cshark_node_t *lower_bound(int key);
+    bool contains(int key);
+
+    int insert(int key);
+    int put(int key, const string &value);
+    int erase(int key);
+    void clear();
+};
+
+#ifdef CODESHARK_HEADER_ONLY
+#include "datastructures/include/skiplist_inl.h"
+#endif
+
+#endif //CODESHARK_SKIPLIST_H
@@ -0,0 +1,362 @@
+/*
+ ============================================================================
+ Name        : skiplist_inl.h
+ Description : skip list inline implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_SKIPLIST_INL_H
+#define CODESHARK_SKIPLIST_INL_H
+
+#include <new>
+
+#include "common/include/common.h"
+#include "common/include/err.h"
+#include "common/include/stats.h"
+#include "datastructures/include/skiplist.h"
+
+/**
+ * Create a node with a tower of a height in one allocation; it is freed by cshark_node_free(),
+ * as its header marks it allocated alone
+ * @param key [in] key, stored in val
+ * @param height [in] levels, from 1 to SKIPLIST_MAX_LEVEL
+ * @return node, with all next pointers \NULL
+ */
+CODESHARK_INLINE cshark_node_t *cshark_skiplist_node_init(int key, size_t height)
+{
+    cshark_skiplist_tower_t *tower;
+    cshark_node_t *nt;
+    size_t i;
+    char *p;
+
+    p = (char *)::operator new(NODE_HEADER_SIZE + sizeof(cshark_node_t) + sizeof(cshark_skiplist_tower_t) +
+                               (height - 1) * sizeof(cshark_node_t *));
+    *(cshark_node_block_t **)p = NULL;
+    nt = new(p + NODE_HEADER_SIZE) cshark_node_t();
+    CSHARK_STAT_INC(STAT_NODE_ALLOC);
+
+    tower = (cshark_skiplist_tower_t *)(p + NODE_HEADER_SIZE + sizeof(cshark_node_t));
+    tower->height = height;
+    tower->links = 0;
+    for (i = 0; i + 1 < height; i++)
+    {
+        tower->next[i] = NULL;
+    }
+
+    nt->val = key;
+    nt->name = "unused";
+    nt->data = tower;
+    nt->visited = false;
+    nt->prev = NULL;
+    nt->next = NULL;
+    nt->left = NULL;
+    nt->right = NULL;
+
+    return nt;
+}
+
+/**
+ * Draw the height of a new node: each pair of zero low bits of a random word adds a level,
+ * so a level holds a quarter of the nodes of the level below
+ * @param state [in,out] xorshift state, never 0
+ * @return height from 1 to SKIPLIST_MAX_LEVEL
+ */
+CODESHARK_INLINE size_t cshark_skiplist_random_height(uint64_t *state)
+{
+    uint64_t x = *state;
+
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    x *= 0x2545f4914f6cdd1dULL;
+
+    return 1 + (size_t)__builtin_ctzll(x | (1ULL << (2 * SKIPLIST_MAX_LEVEL - 2))) / 2;
+}
+
+/**
+ * Initialize an empty skip list
+ */
+CODESHARK_INLINE SkipList::SkipList()
+{
+    this->head = cshark_skiplist_node_init(0, SKIPLIST_MAX_LEVEL);
+    this->tail = this->head;
+    this->size = 0;
+    this->level = 1;
+    this->seed = 0x9e3779b97f4a7c15ULL;
+}
+
+CODESHARK_INLINE SkipList::~SkipList()
+{
+    this->clear();
+    cshark_node_free(this->head);
+}
+
+/**
+ * Find the last node before key at each level in use
+ * @param key [in] key
+ * @param preds [out] predecessors by level, may be \NULL
+ * @return first node with a key not less than key, or \NULL
+ */
+CODESHARK_INLINE cshark_node_t *SkipList::find_preds(int key, cshark_node_t **preds)
+{
+    cshark_node_t *x = this->head;
+    cshark_node_t *next;
+    size_t l = this->level;
+
+    while (l-- > 0)
+    {
+        while ((next = *cshark_skiplist_next_ref(x, l)) != NULL and next->val < key)
+        {
+            x = next;
+        }
+
+        if (preds != NULL)
+        {
+            preds[l] = x;
+        }
+    }
+
+    return x->next;
+}
+
+/**
+ * Link a new node after its predecessors
+ * @return new node
+ */
+CODESHARK_INLINE cshark_node_t *SkipList::insert_key(int key, cshark_node_t **preds)
+{
+    cshark_node_t *nt;
+    size_t height;
+    size_t l;
+
+    height = cshark_skiplist_random_height(&this->seed);
+    while (this->level < height)
+    {
+        preds[this->level++] = this->head;
+    }
+
+    nt = cshark_skiplist_node_init(key, height);
+    for (l = 0; l < height; l++)
+    {
+        *cshark_skiplist_next_ref(nt, l) = *cshark_skiplist_next_ref(preds[l], l);
+        *cshark_skiplist_next_ref(preds[l], l) = nt;
+    }
+
+    nt->prev = preds[0];
+    if (nt->next != NULL)
+    {
+        nt->next->prev = nt;
+    }
+    else
+    {
+        this->tail = nt;
+    }
+
+    this->size++;
+    return nt;
+}
+
+CODESHARK_INLINE SkipList::iterator SkipList::begin()
+{
+    return iterator(this->head->next, &this->tail);
+}
+
+CODESHARK_INLINE SkipList::iterator SkipList::end()
+{
+    return iterator(NULL, &this->tail);
+}
+
+CODESHARK_INLINE SkipList::const_iterator SkipList::begin() const
+{
+    return const_iterator(this->head->next, &this->tail);
+}
+
+CODESHARK_INLINE SkipList::const_iterator SkipList::end() const
+{
+    return const_iterator(NULL, &this->tail);
+}
+
+CODESHARK_INLINE SkipList::reverse_iterator SkipList::rbegin()
+{
+    return reverse_iterator(this->end());
+}
+
+CODESHARK_INLINE SkipList::reverse_iterator SkipList::rend()
+{
+    return reverse_iterator(this->begin());
+}
+
+/**
+ * Get the nodes with keys in [lo, hi) as a range, in key order, e.g.,
+ *      for (cshark_node_t &nt : list->range(10, 20)) { ... }
+ * @param lo [in] smallest key
+ * @param hi [in] key past the range
+ * @return range, empty if hi <= lo
+ */
+CODESHARK_INLINE cshark_range<SkipList::iterator> SkipList::range(int lo, int hi)
+{
+    cshark_node_t *first = this->find_preds(lo, NULL);
+    cshark_node_t *last = (hi <= lo) ? first : this->find_preds(hi, NULL);
+
+    return cshark_range<iterator>(iterator(first, &this->tail), iterator(last, &this->tail));
+}
+
+CODESHARK_INLINE size_t SkipList::get_size()
+{
+    return this->size;
+}
+
+/**
+ * Get the node of the smallest key, or \NULL if the list is empty
+ */
+CODESHARK_INLINE cshark_node_t *SkipList::get_first()
+{
+    return this->head->next;
+}
+
+/**
+ * Get the node of the largest key, or \NULL if the list is empty
+ */
+CODESHARK_INLINE cshark_node_t *SkipList::get_last()
+{
+    return (this->tail == this->head) ? NULL : this->tail;
+}
+
+/**
+ * Find the node of a key
+ * @param key [in] key
+ * @return node, or \NULL if not found
+ */
+CODESHARK_INLINE cshark_node_t *SkipList::find(int key)
+{
+    cshark_node_t *nt = this->find_preds(key, NULL);
+
+    return (nt != NULL and nt->val == key) ? nt : NULL;
+}
+
+/**
+ * Find the first node with a key not less than key
+ * @return node, or \NULL if all keys are less
+ */
+CODESHARK_INLINE cshark_node_t *SkipList::lower_bound(int key)
+{
+    return this->find_preds(key, NULL);
+}
+
+CODESHARK_INLINE bool SkipList::contains(int key)
+{
+    return this->find(key) != NULL;
+}
+
+/**
+ * Add a key, as a set
+ * @param key [in] key
+ * @return \0 on success, or ERROR_EXISTS if the key is in the list
+ */
+CODESHARK_INLINE int SkipList::insert(int key)
+{
+    cshark_node_t *preds[SKIPLIST_MAX_LEVEL];
+    cshark_node_t *nt = this->find_preds(key, preds);
+
+    if (nt != NULL and nt->val == key)
+    {
+        return ERROR_EXISTS;
+    }
+
+    this->insert_key(key, preds);
+    return SUCCESS;
+}
+
+/**
+ * Add a key with a value, or update the value of a key in the list, as a map
+ * @param key [in] key
+ * @param value [in] value, stored in name
+ * @return \0 on success
+ */
+CODESHARK_INLINE int SkipList::put(int key, const string &value)
+{
+    cshark_node_t *preds[SKIPLIST_MAX_LEVEL];
+    cshark_node_t *nt = this->find_preds(key, preds);
+
+    if (nt == NULL or nt->val != key)
+    {
+        nt = this->insert_key(key, preds);
+    }
+
+    nt->name = value;
+    return SUCCESS;
+}
+
+/**
+ * Delete the node of a key
+ * @param key [in] key
+ * @return \0 on success, or ERROR_NOT_FOUND
+ */
+CODESHARK_INLINE int SkipList::erase(int key)
+{
+    cshark_node_t *preds[SKIPLIST_MAX_LEVEL];
+    cshark_node_t *nt = this->find_preds(key, preds);
+    size_t height;
+    size_t l;
+
+    if (nt == NULL or nt->val != key)
+    {
+        return ERROR_NOT_FOUND;
+    }
+
+    height = cshark_skiplist_height(nt);
+    for (l = 0; l < height; l++)
+    {
+        *cshark_skiplist_next_ref(preds[l], l) = *cshark_skiplist_next_ref(nt, l);
+    }
+
+    if (nt->next != NULL)
+    {
+        nt->next->prev = preds[0];
+    }
+    else
+    {
+        this->tail = preds[0];
+    }
+
+    while (this->level > 1 and *cshark_skiplist_next_ref(this->head, this->level - 1) == NULL)
+    {
+        this->level--;
+    }
+
+    cshark_node_free(nt);
+    this->size--;
+    return SUCCESS;
+}
+
+/**
+ * Delete all nodes
+ */
+CODESHARK_INLINE void SkipList::clear()
+{
+    cshark_node_t *nt = this->head->next;
+    cshark_node_t *next;
+    size_t l;
+
+    while (nt != NULL)
+    {
+        next = nt->next;
+        cshark_node_free(nt);
+        nt = next;
+    }
+
+    for (l = 0; l < SKIPLIST_MAX_LEVEL; l++)
+    {
+        *cshark_skiplist_next_ref(this->head, l) = NULL;
+    }
+
+    this->tail = this->head;
+    this->size = 0;
+    this->level = 1;
+}
+
+#endif //CODESHARK_SKIPLIST_INL_H
@@ -12,27 +12,55 @@
 #define CODESHARK_STACK_H
 
 #include "common/include/node.h"
+#include "common/include/stats.h"
 #include "datastructures/include/linklist.h"
 
 /**
  * @class Stack maintains stack structure, which is a linklist internally
+ *        Iterators walk from the top to the bottom, the order of pop().
  */
 class Stack
 {
 private:
     LinkList *list;
 public:
+    typedef LinkList::reverse_iterator iterator;
+
     Stack();
     ~Stack();
 
+    iterator begin();
+    iterator end();
+
     bool is_empty();
     bool is_full();
     string print();
 
     int push(int n);
     int push(cshark_node_t *);
+    int push_batch(const int *vals, size_t n);
+    template <typename Iter>
+    int push_range(Iter first, Iter last);
     cshark_node_t* pop();
+    size_t pop_batch(int *vals, size_t n);
     cshark_node_t* get_top();
 };
 
+/**
+ * Push values of a range in order, with all nodes allocated in one block
+ * @param first [in] forward iterator to the first value
+ * @param last [in] iterator past the last value
+ * @return \0 on success
+ */
+template <typename Iter>
+int Stack::push_range(Iter first, Iter last)
+{
+    CSHARK_STAT_ADD(STAT_STACK_PUSH, distance(first, last));
+    return this->list->insert_range(first, last);
+}
+
+#ifdef CODESHARK_HEADER_ONLY
+#include "datastructures/include/stack_inl.h"
+#endif
+
 #endif //CODESHARK_STACK_H
@@ -0,0 +1,178 @@
+/*
+============================================================================
+ Name        : stack_inl.h
+ Description : stack inline implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_STACK_INL_H
+#define CODESHARK_STACK_INL_H
+
+#include "common/include/common.h"
+#include "common/include/node.h"
+#include "common/include/err.h"
+#include "common/include/stats.h"
+#include "datastructures/include/linklist.h"
+#include "datastructures/include/stack.h"
+
+/**
+ * Initialize a new and empty stack, which could shrink when pop()
+ */
+CODESHARK_INLINE Stack::Stack()
+{
+    this->list = new LinkList(0);
+}
+
+/**
+ * Delete the stack
+ */
+CODESHARK_INLINE Stack::~Stack()
+{
+    delete(this->list);
+}
+
+/**
+ * Get the iterator to the top node
+ */
+CODESHARK_INLINE Stack::iterator Stack::begin()
+{
+    return this->list->rbegin();
+}
+
+/**
+ * Get the iterator past the bottom node
+ */
+CODESHARK_INLINE Stack::iterator Stack::end()
+{
+    return this->list->rend();
+}
+
+/**
+ * Push a node into stack
+ * @param x [in] val of the new node
+ * @return \0 on  success
+ */
+CODESHARK_INLINE int Stack::push(int x)
+{
+    cshark_node_t *nt = cshark_node_init();
+    nt->val = x;
+
+    CSHARK_STAT_INC(STAT_STACK_PUSH);
+    this->list->insert_node(nt);
+    return SUCCESS;
+}
+
+/**
+ * Push a node into stack
+ * @param nt [in] node
+ * @return \0 on success
+ */
+CODESHARK_INLINE int Stack::push(cshark_node_t *nt)
+{
+    CSHARK_STAT_INC(STAT_STACK_PUSH);
+    this->list->insert_node(nt);
+    return SUCCESS;
+}
+
+/**
+ * Push values in order, so the last value is on the top
+ * @param vals [in] values
+ * @param n [in] number of values
+ * @return \0 on success, or other error code
+ */
+CODESHARK_INLINE int Stack::push_batch(const int *vals, size_t n)
+{
+    if (vals == NULL and n > 0)
+    {
+        return ERROR_PARAM;
+    }
+
+    return this->push_range(vals, vals + n);
+}
+
+/**
+ * Pop an element from stack
+ * \warning caller must manually free the node
+ * @return \NULL if the stack is empty
+ *          valid pointer of the node
+ */
+CODESHARK_INLINE cshark_node_t *Stack::pop()
+{
+    cshark_node_t *ret;
+
+    ret = this->list->pop_last();
+    if (ret != NULL)
+    {
+        CSHARK_STAT_INC(STAT_STACK_POP);
+    }
+
+    return ret;
+}
+
+/**
+ * Pop up to n elements into a buffer, the top first, and free their nodes
+ * @param vals [out] values
+ * @param n [in] maximum number of elements
+ * @return number of popped elements
+ */
+CODESHARK_INLINE size_t Stack::pop_batch(int *vals, size_t n)
+{
+    size_t k;
+
+    k = this->list->pop_last_batch(vals, n);
+    CSHARK_STAT_ADD(STAT_STACK_POP, k);
+
+    return k;
+}
+
+/**
+ * Get the top element from stack
+ * @return \NULL if the stack is empty
+ *          valid pointer of the node
+ */
+CODESHARK_INLINE cshark_node_t *Stack::get_top()
+{
+    return this->list->get_last();
+}
+
+/**
+ * Check if stack is full
+ * \note stack can increase dynamically, so always return 'false'
+ * @return false
+ */
+CODESHARK_INLINE bool Stack::is_full()
+{
+    return false;
+}
+
+/**
+ * Check if stack is empty
+ * @return \true if empty otherwise \false
+ */
+CODESHARK_INLINE bool Stack::is_empty()
+{
+    return this->list->get_size() == 0;
+}
+
+/**
+ * Print a stack
+ * @return printable string
+ */
+CODESHARK_INLINE string Stack::print()
+{
+    string s;
+
+    printf("-----------\n    top  \n-----------");
+    for (const cshark_node_t &nt : *this->list)
+    {
+        s = s + "," + to_string(nt.val);
+    }
+
+    printf("%s\n", s.c_str());
+    return s;
+}
+
+#endif //CODESHARK_STACK_INL_H
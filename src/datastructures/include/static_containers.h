@@ -0,0 +1,545 @@
+/*
+ ============================================================================
+ Name        : static_containers.h
+ Description : fixed-capacity containers with inline storage
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_STATIC_CONTAINERS_H
+#define CODESHARK_STATIC_CONTAINERS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <functional>
+#include <iterator>
+
+#include "common/include/err.h"
+#include "datastructures/include/tree.h"
+
+using namespace std;
+
+#define STATIC_TREE_MAX_DEPTH   64      // depth of a complete tree of up to 2^64 - 1 nodes
+
+/**
+ * Fixed-capacity containers keep their N elements inline, and never allocate: a container is
+ * one object, which may live on the stack, in a static or in shared memory. Elements are stored
+ * by value and linked by index, never by pointer, so a container of trivially copyable T is
+ * trivially copyable too.
+ *
+ * Capacity is a template argument, so a full container is an error code (ERROR_MAX_NODES)
+ * instead of a MAX_NODES runtime limit. T must be default-constructible and copy-assignable.
+ *
+ * Constructors and observers (get_size(), is_empty(), capacity() ...) are constexpr, so an empty
+ * container of a literal T can be a constexpr or constant-initialized static. C++11 constexpr
+ * functions cannot modify objects, so changes are run-time only.
+ */
+
+/**
+ * @class StaticStack is a stack of at most N elements; iterators walk from the top to the bottom,
+ *        as Stack does.
+ */
+template <typename T, size_t N>
+class StaticStack
+{
+    static_assert(N > 0, "capacity must not be 0");
+
+private:
+    T items[N];
+    size_t count;
+
+public:
+    typedef reverse_iterator<T *> iterator;
+    typedef reverse_iterator<const T *> const_iterator;
+
+    constexpr StaticStack() : items(), count(0) {}
+
+    static constexpr size_t capacity() { return N; }
+    constexpr size_t get_size() const { return this->count; }
+    constexpr bool is_empty() const { return this->count == 0; }
+    constexpr bool is_full() const { return this->count == N; }
+
+    iterator begin() { return iterator(this->items + this->count); }
+    iterator end() { return iterator(this->items); }
+    const_iterator begin() const { return const_iterator(this->items + this->count); }
+    const_iterator end() const { return const_iterator(this->items); }
+
+    void clear() { this->count = 0; }
+
+    /**
+     * Push an element
+     * @return \0 on success, or ERROR_MAX_NODES if the stack is full
+     */
+    int push(const T &v)
+    {
+        if (this->count == N)
+        {
+            return ERROR_MAX_NODES;
+        }
+
+        this->items[this->count++] = v;
+        return SUCCESS;
+    }
+
+    /**
+     * Pop the top element
+     * @param v [out] element, or \NULL to drop it
+     * @return \0 on success, or ERROR_TARGET_EMPTY if the stack is empty
+     */
+    int pop(T *v)
+    {
+        if (this->count == 0)
+        {
+            return ERROR_TARGET_EMPTY;
+        }
+
+        this->count--;
+        if (v != NULL)
+        {
+            *v = this->items[this->count];
+        }
+        return SUCCESS;
+    }
+
+    /**
+     * Get the top element
+     * @return element, or \NULL if the stack is empty
+     */
+    const T *get_top() const
+    {
+        return this->count == 0 ? NULL : &this->items[this->count - 1];
+    }
+};
+
+/**
+ * @class StaticQueue is a FIFO queue of at most N elements in a ring buffer.
+ *        A power of two N turns the index wrap into a mask.
+ */
+template <typename T, size_t N>
+class StaticQueue
+{
+    static_assert(N > 0, "capacity must not be 0");
+
+private:
+    T items[N];
+    size_t head;                // index of the front element
+    size_t count;
+
+public:
+    constexpr StaticQueue() : items(), head(0), count(0) {}
+
+    static constexpr size_t capacity() { return N; }
+    constexpr size_t get_size() const { return this->count; }
+    constexpr bool is_empty() const { return this->count == 0; }
+    constexpr bool is_full() const { return this->count == N; }
+
+    void clear()
+    {
+        this->head = 0;
+        this->count = 0;
+    }
+
+    /**
+     * Enqueue an element at the rear
+     * @return \0 on success, or ERROR_MAX_NODES if the queue is full
+     */
+    int enqueue(const T &v)
+    {
+        if (this->count == N)
+        {
+            return ERROR_MAX_NODES;
+        }
+
+        this->items[(this->head + this->count) % N] = v;
+        this->count++;
+        return SUCCESS;
+    }
+
+    /**
+     * Dequeue the front element
+     * @param v [out] element, or \NULL to drop it
+     * @return \0 on success, or ERROR_TARGET_EMPTY if the queue is empty
+     */
+    int dequeue(T *v)
+    {
+        if (this->count == 0)
+        {
+            return ERROR_TARGET_EMPTY;
+        }
+
+        if (v != NULL)
+        {
+            *v = this->items[this->head];
+        }
+        this->head = (this->head + 1) % N;
+        this->count--;
+        return SUCCESS;
+    }
+
+    /**
+     * Get the front element
+     * @return element, or \NULL if the queue is empty
+     */
+    const T *get_front() const
+    {
+        return this->count == 0 ? NULL : &this->items[this->head];
+    }
+
+    /**
+     * Get the i-th element from the front
+     * \warning i must be less than get_size()
+     */
+    const T &at(size_t i) const
+    {
+        return this->items[(this->head + i) % N];
+    }
+};
+
+/**
+ * @struct cshark_static_hash hashes a key with std::hash and mixes the bits (fmix64 of MurmurHash3),
+ *         since std::hash of integers is the identity, which clusters consecutive keys in
+ *         linear probing.
+ */
+template <typename K>
+struct cshark_static_hash
+{
+    size_t operator()(const K &key) const
+    {
+        uint64_t h = (uint64_t)hash<K>()(key);
+
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+
+        return (size_t)h;
+    }
+};
+
+/**
+ * @class StaticHashTable maps up to N keys to values, in N slots with linear probing.
+ *        N is a power of two; keep the table at most about 3/4 full, as probes grow quickly beyond.
+ *        erase() shifts later entries of the probe run back, so there are no tombstones and
+ *        lookups never slow down after deletions.
+ */
+template <typename K, typename V, size_t N, typename Hash = cshark_static_hash<K>>
+class StaticHashTable
+{
+    static_assert(N > 0 and (N & (N - 1)) == 0, "capacity must be a power of two");
+
+private:
+    K keys[N];
+    V vals[N];
+    bool used[N];
+    size_t count;
+
+    size_t home(const K &key) const
+    {
+        return Hash()(key) & (N - 1);
+    }
+
+    // slot of a key, or N if it is not in the table
+    size_t lookup(const K &key) const
+    {
+        size_t i = this->home(key);
+        size_t probe;
+
+        for (probe = 0; probe < N and this->used[i]; probe++)
+        {
+            if (this->keys[i] == key)
+            {
+                return i;
+            }
+            i = (i + 1) & (N - 1);
+        }
+
+        return N;
+    }
+
+public:
+    constexpr StaticHashTable() : keys(), vals(), used(), count(0) {}
+
+    static constexpr size_t capacity() { return N; }
+    constexpr size_t get_size() const { return this->count; }
+    constexpr bool is_empty() const { return this->count == 0; }
+    constexpr bool is_full() const { return this->count == N; }
+
+    void clear()
+    {
+        size_t i;
+
+        for (i = 0; i < N; i++)
+        {
+            this->used[i] = false;
+        }
+        this->count = 0;
+    }
+
+    /**
+     * Add an entry; if the key exists, update its value
+     * @return \0 on success, or ERROR_MAX_NODES if the table is full
+     */
+    int insert(const K &key, const V &val)
+    {
+        size_t i = this->home(key);
+        size_t probe;
+
+        for (probe = 0; probe < N; probe++)
+        {
+            if (!this->used[i])
+            {
+                this->keys[i] = key;
+                this->vals[i] = val;
+                this->used[i] = true;
+                this->count++;
+                return SUCCESS;
+            }
+
+            if (this->keys[i] == key)
+            {
+                this->vals[i] = val;
+                return SUCCESS;
+            }
+            i = (i + 1) & (N - 1);
+        }
+
+        return ERROR_MAX_NODES;
+    }
+
+    /**
+     * Find the value of a key
+     * @return value, or \NULL if the key is not found
+     */
+    const V *find(const K &key) const
+    {
+        size_t i = this->lookup(key);
+
+        return i == N ? NULL : &this->vals[i];
+    }
+
+    V *find(const K &key)
+    {
+        size_t i = this->lookup(key);
+
+        return i == N ? NULL : &this->vals[i];
+    }
+
+    bool contains(const K &key) const
+    {
+        return this->lookup(key) != N;
+    }
+
+    /**
+     * Delete an entry
+     * @return \0 on success, or ERROR_NOT_FOUND if the key is not found
+     */
+    int erase(const K &key)
+    {
+        size_t i = this->lookup(key);
+        size_t j, h;
+
+        if (i == N)
+        {
+            return ERROR_NOT_FOUND;
+        }
+
+        // move back each later entry of the run whose home is not cyclically in (i, j]
+        j = i;
+        while (true)
+        {
+            j = (j + 1) & (N - 1);
+            if (!this->used[j])
+            {
+                break;
+            }
+
+            h = this->home(this->keys[j]);
+            if (((j - h) & (N - 1)) >= ((j - i) & (N - 1)))
+            {
+                this->keys[i] = this->keys[j];
+                this->vals[i] = this->vals[j];
+                i = j;
+            }
+        }
+
+        this->used[i] = false;
+        this->count--;
+        return SUCCESS;
+    }
+
+    /**
+     * Visit all entries in slot order
+     * @param fn [in] function called as fn(key, value)
+     */
+    template <typename Fn>
+    void for_each(Fn fn) const
+    {
+        size_t i;
+
+        for (i = 0; i < N; i++)
+        {
+            if (this->used[i])
+            {
+                fn(this->keys[i], this->vals[i]);
+            }
+        }
+    }
+};
+
+/**
+ * @class StaticBTree is a complete binary tree of at most N elements, built level by level as
+ *        BTree::create_by_level() does, and stored in level order without child pointers:
+ *
+ *      node i:     children 2*i+1 and 2*i+2, parent (i-1)/2
+ *
+ * Traversals use a stack of STATIC_TREE_MAX_DEPTH indices inside the call, so they do not allocate.
+ */
+template <typename T, size_t N>
+class StaticBTree
+{
+    static_assert(N > 0, "capacity must not be 0");
+
+private:
+    T items[N];
+    size_t count;
+
+public:
+    constexpr StaticBTree() : items(), count(0) {}
+
+    static constexpr size_t capacity() { return N; }
+    static constexpr size_t left(size_t i) { return 2 * i + 1; }
+    static constexpr size_t right(size_t i) { return 2 * i + 2; }
+    static constexpr size_t parent(size_t i) { return (i - 1) / 2; }
+
+    constexpr size_t get_size() const { return this->count; }
+    constexpr bool is_empty() const { return this->count == 0; }
+    constexpr bool is_full() const { return this->count == N; }
+    constexpr bool has_node(size_t i) const { return i < this->count; }
+
+    void clear() { this->count = 0; }
+
+    /**
+     * Add a node at the next position in level order
+     * @return \0 on success, or ERROR_MAX_NODES if the tree is full
+     */
+    int insert(const T &v)
+    {
+        if (this->count == N)
+        {
+            return ERROR_MAX_NODES;
+        }
+
+        this->items[this->count++] = v;
+        return SUCCESS;
+    }
+
+    /**
+     * Get the root
+     * @return root, or \NULL if the tree is empty
+     */
+    const T *get_root() const
+    {
+        return this->count == 0 ? NULL : &this->items[0];
+    }
+
+    /**
+     * Get node i in level order
+     * \warning i must be less than get_size()
+     */
+    const T &at(size_t i) const { return this->items[i]; }
+    T &at(size_t i) { return this->items[i]; }
+
+    /**
+     * Traverse the tree
+     * @param order [in] PREORDER, INORDER, POSTORDER or LEVELORDER
+     * @param out [out] nodes in the order, at most max of them
+     * @param max [in] size of out
+     * @return number of nodes written
+     */
+    size_t traverse(ORDER_TYPE order, T *out, size_t max) const
+    {
+        size_t stack[STATIC_TREE_MAX_DEPTH];
+        size_t top = 0;
+        size_t n = 0;
+        size_t i, last;
+
+        if (out == NULL)
+        {
+            return 0;
+        }
+
+        if (order == LEVELORDER)
+        {
+            for (i = 0; i < this->count and n < max; i++)
+            {
+                out[n++] = this->items[i];
+            }
+        }
+        else if (order == PREORDER)
+        {
+            // the stack keeps right children still to visit, at most one per level
+            i = 0;
+            while (n < max and (this->has_node(i) or top > 0))
+            {
+                if (!this->has_node(i))
+                {
+                    i = stack[--top];
+                }
+                out[n++] = this->items[i];
+                if (this->has_node(right(i)))
+                {
+                    stack[top++] = right(i);
+                }
+                i = left(i);
+            }
+        }
+        else if (order == INORDER)
+        {
+            i = 0;
+            while (n < max and (this->has_node(i) or top > 0))
+            {
+                while (this->has_node(i))
+                {
+                    stack[top++] = i;
+                    i = left(i);
+                }
+                i = stack[--top];
+                out[n++] = this->items[i];
+                i = right(i);
+            }
+        }
+        else if (order == POSTORDER)
+        {
+            // a node is visited when coming up from its right child, or it has none
+            i = 0;
+            last = N;
+            while (n < max and (this->has_node(i) or top > 0))
+            {
+                while (this->has_node(i))
+                {
+                    stack[top++] = i;
+                    i = left(i);
+                }
+
+                i = stack[top - 1];
+                if (this->has_node(right(i)) and right(i) != last)
+                {
+                    i = right(i);
+                    continue;
+                }
+
+                out[n++] = this->items[i];
+                last = i;
+                top--;
+                i = N;              // no node, so the next step pops
+            }
+        }
+
+        return n;
+    }
+};
+
+#endif //CODESHARK_STATIC_CONTAINERS_H
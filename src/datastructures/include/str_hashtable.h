@@ -0,0 +1,87 @@
+/*
+ ============================================================================
+ Name        : str_hashtable.h
+ Description : string-keyed hash table with arena storage header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_STR_HASHTABLE_H
+#define CODESHARK_STR_HASHTABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+#include "common/include/arena.h"
+
+using namespace std;
+
+#define STR_HT_MIN_CAPACITY     16
+#define STR_HT_MAX_LOAD_PCT     87          // slots in use, deleted ones included, before a rehash
+#define STR_HT_TAG_EMPTY        0x00
+#define STR_HT_TAG_DELETED      0x01        // tags of entries have the top bit set
+
+/**
+ * A hash table of byte-string keys and values, e.g., names, paths or serialized ids.
+ *
+ * An entry is one record in an Arena: its full 64-bit hash, the lengths, then the key and value
+ * bytes, with no per-entry allocation and no std::string. Slots are in two arrays, probed
+ * linearly from the home slot of a hash:
+ *
+ *      tags    | 0x00 | 0x9f | 0xc3 | 0x01 | 0x00 |       1 byte: empty, deleted, or 7 hash bits
+ *      slots   |      |  *   |  *   |      |      |       pointer to the entry
+ *                        |      |
+ *                        v      v
+ *      arena   | hash | klen | vlen | key bytes | value bytes | hash | ...
+ *
+ * A probe compares the tag, a fingerprint of 7 hash bits, before it reads the entry, so only 1 in
+ * 128 unrelated slots costs a memory access, and the cached hash before comparing key bytes.
+ * Rehashing moves slot pointers only, using the cached hashes, never the entries.
+ *
+ * Keys are looked up by pointer and length, so a caller never builds a temporary string. A
+ * found value is returned as a pointer into the arena; it stays valid until its key is updated
+ * or deleted, str_hashtable_compact() is called, or the table is destroyed. Updated and deleted
+ * entries stay in the arena until str_hashtable_compact().
+ */
+typedef struct _str_hashtable_entry_t
+{
+    uint64_t hash;
+    uint32_t key_len;
+    uint32_t val_len;
+    // key bytes, then value bytes
+}str_hashtable_entry_t;
+
+typedef struct _str_hashtable_t
+{
+    uint8_t *tags;
+    str_hashtable_entry_t **slots;
+    size_t capacity;                    // a power of two
+    size_t size;
+    size_t deleted;                     // slots with STR_HT_TAG_DELETED
+    size_t garbage;                     // arena bytes of updated and deleted entries
+    Arena *arena;
+}str_hashtable_t;
+
+// String hash table functions
+
+str_hashtable_t *str_hashtable_init(size_t n);
+int str_hashtable_destroy(str_hashtable_t *ht);
+int str_hashtable_add(str_hashtable_t *ht, const char *key, size_t key_len, const char *val, size_t val_len);
+int str_hashtable_add(str_hashtable_t *ht, const string &key, const string &val);
+const char *str_hashtable_find(str_hashtable_t *ht, const char *key, size_t key_len, size_t *val_len);
+const char *str_hashtable_find(str_hashtable_t *ht, const string &key, size_t *val_len);
+bool str_hashtable_contains(str_hashtable_t *ht, const char *key, size_t key_len);
+int str_hashtable_delete(str_hashtable_t *ht, const char *key, size_t key_len);
+int str_hashtable_compact(str_hashtable_t *ht);
+size_t str_hashtable_getsize(str_hashtable_t *ht);
+size_t str_hashtable_get_memory(str_hashtable_t *ht);
+uint64_t cshark_str_hash(const char *p, size_t n);
+
+#ifdef CODESHARK_HEADER_ONLY
+#include "datastructures/include/str_hashtable_inl.h"
+#endif
+
+#endif //CODESHARK_STR_HASHTABLE_H
@@ -0,0 +1,409 @@
+/*
+ ============================================================================
+ Name        : str_hashtable_inl.h
+ Description : string-keyed hash table with arena storage inline implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_STR_HASHTABLE_INL_H
+#define CODESHARK_STR_HASHTABLE_INL_H
+
+#include <string.h>
+
+#include "common/include/common.h"
+#include "common/include/err.h"
+#include "common/include/stats.h"
+#include "datastructures/include/str_hashtable.h"
+
+inline uint8_t _cshark_str_ht_tag(uint64_t hash)
+{
+    return (uint8_t)(0x80 | (hash >> 57));
+}
+
+inline const char *_cshark_str_ht_key(const str_hashtable_entry_t *e)
+{
+    return (const char *)(e + 1);
+}
+
+inline size_t _cshark_str_ht_entry_size(const str_hashtable_entry_t *e)
+{
+    return sizeof(str_hashtable_entry_t) + e->key_len + e->val_len;
+}
+
+/**
+ * Find the slot of a key
+ * @param free_slot [out] first deleted slot of the probe, or the empty slot ending it
+ * @return slot, or the capacity if the key is not in the table
+ */
+inline size_t _cshark_str_ht_probe(str_hashtable_t *ht, uint64_t hash, const char *key, size_t key_len,
+                                   size_t *free_slot)
+{
+    size_t mask = ht->capacity - 1;
+    size_t i = hash & mask;
+    uint8_t tag = _cshark_str_ht_tag(hash);
+    str_hashtable_entry_t *e;
+
+    *free_slot = ht->capacity;
+    while (ht->tags[i] != STR_HT_TAG_EMPTY)
+    {
+        if (ht->tags[i] == tag)
+        {
+            e = ht->slots[i];
+            if (e->hash == hash and e->key_len == key_len and memcmp(_cshark_str_ht_key(e), key, key_len) == 0)
+            {
+                return i;
+            }
+        }
+        else if (ht->tags[i] == STR_HT_TAG_DELETED and *free_slot == ht->capacity)
+        {
+            *free_slot = i;
+        }
+        i = (i + 1) & mask;
+    }
+
+    if (*free_slot == ht->capacity)
+    {
+        *free_slot = i;
+    }
+    return ht->capacity;
+}
+
+/**
+ * Move slots into arrays of a new capacity by their cached hashes, dropping deleted slots
+ */
+inline void _cshark_str_ht_rehash(str_hashtable_t *ht, size_t capacity)
+{
+    uint8_t *tags = new uint8_t[capacity]();
+    str_hashtable_entry_t **slots = new str_hashtable_entry_t *[capacity];
+    str_hashtable_entry_t *e;
+    size_t i, j;
+
+    for (i = 0; i < ht->capacity; i++)
+    {
+        if (ht->tags[i] & 0x80)
+        {
+            e = ht->slots[i];
+            for (j = e->hash & (capacity - 1); tags[j] != STR_HT_TAG_EMPTY; j = (j + 1) & (capacity - 1))
+            {
+            }
+            tags[j] = ht->tags[i];
+            slots[j] = e;
+        }
+    }
+
+    delete[] ht->tags;
+    delete[] ht->slots;
+    ht->tags = tags;
+    ht->slots = slots;
+    ht->capacity = capacity;
+    ht->deleted = 0;
+}
+
+/**
+ * Hash bytes (MurmurHash64A), reading 8 bytes at a time
+ * @param p [in] bytes
+ * @param n [in] number of bytes
+ * @return hash
+ */
+CODESHARK_INLINE uint64_t cshark_str_hash(const char *p, size_t n)
+{
+    const uint64_t m = 0xc6a4a7935bd1e995ULL;
+    uint64_t h = 0x9747b28cULL ^ (n * m);
+    uint64_t k;
+    size_t i, j;
+
+    for (i = 0; i + 8 <= n; i += 8)
+    {
+        memcpy(&k, p + i, 8);
+        k *= m;
+        k ^= k >> 47;
+        k *= m;
+        h ^= k;
+        h *= m;
+    }
+
+    if (n > i)
+    {
+        for (k = 0, j = n; j > i; j--)
+        {
+            k = (k << 8) | (uint8_t)p[j - 1];
+        }
+        h ^= k;
+        h *= m;
+    }
+
+    h ^= h >> 47;
+    h *= m;
+    h ^= h >> 47;
+    return h;
+}
+
+/**
+ * Initialize a new string hash table
+ * @param n [in] number of keys expected, which fit without a rehash; 0 if unknown
+ * @return hash table
+ */
+CODESHARK_INLINE str_hashtable_t *str_hashtable_init(size_t n)
+{
+    str_hashtable_t *ht;
+    size_t capacity = STR_HT_MIN_CAPACITY;
+
+    while (capacity * STR_HT_MAX_LOAD_PCT / 100 < n)
+    {
+        capacity *= 2;
+    }
+
+    ht = new str_hashtable_t();
+    ht->tags = new uint8_t[capacity]();
+    ht->slots = new str_hashtable_entry_t *[capacity];
+    ht->capacity = capacity;
+    ht->size = 0;
+    ht->deleted = 0;
+    ht->garbage = 0;
+    ht->arena = new Arena();
+
+    return ht;
+}
+
+/**
+ * Destroy a string hash table, and all keys and values in its arena
+ * @param ht [in] hash table
+ * @return \0 on success, or ERROR_PARAM
+ */
+CODESHARK_INLINE int str_hashtable_destroy(str_hashtable_t *ht)
+{
+    if (ht == NULL)
+    {
+        return ERROR_PARAM;
+    }
+
+    delete[] ht->tags;
+    delete[] ht->slots;
+    delete(ht->arena);
+    delete(ht);
+    return SUCCESS;
+}
+
+/**
+ * Add an entry, or update the value of a key in the table
+ * @param ht [in] hash table
+ * @param key [in] key bytes, need not be terminated
+ * @param key_len [in] key length
+ * @param val [in] value bytes
+ * @param val_len [in] value length
+ * @return \0 on success, or ERROR_PARAM
+ */
+CODESHARK_INLINE int str_hashtable_add(str_hashtable_t *ht, const char *key, size_t key_len, const char *val, size_t val_len)
+{
+    str_hashtable_entry_t *e;
+    uint64_t hash;
+    size_t free_slot;
+    size_t i;
+    char *p;
+
+    if (ht == NULL or (key == NULL and key_len > 0) or (val == NULL and val_len > 0) or
+        key_len > UINT32_MAX or val_len > UINT32_MAX)
+    {
+        return ERROR_PARAM;
+    }
+
+    CSHARK_STAT_INC(STAT_HASHTABLE_ADD);
+
+    hash = cshark_str_hash(key, key_len);
+    i = _cshark_str_ht_probe(ht, hash, key, key_len, &free_slot);
+
+    e = (str_hashtable_entry_t *)ht->arena->allocate(sizeof(str_hashtable_entry_t) + key_len + val_len, 8);
+    e->hash = hash;
+    e->key_len = (uint32_t)key_len;
+    e->val_len = (uint32_t)val_len;
+    p = (char *)(e + 1);
+    if (key_len > 0)
+    {
+        memcpy(p, key, key_len);
+    }
+    if (val_len > 0)
+    {
+        memcpy(p + key_len, val, val_len);
+    }
+
+    if (i < ht->capacity)
+    {
+        ht->garbage += _cshark_str_ht_entry_size(ht->slots[i]);
+        ht->slots[i] = e;
+        return SUCCESS;
+    }
+
+    // grow when live entries fill half the limit, otherwise only clear the deleted slots
+    if ((ht->size + ht->deleted + 1) * 100 > ht->capacity * STR_HT_MAX_LOAD_PCT)
+    {
+        _cshark_str_ht_rehash(ht, ((ht->size + 1) * 200 > ht->capacity * STR_HT_MAX_LOAD_PCT) ?
+                                  ht->capacity * 2 : ht->capacity);
+        _cshark_str_ht_probe(ht, hash, key, key_len, &free_slot);
+    }
+
+    if (ht->tags[free_slot] == STR_HT_TAG_DELETED)
+    {
+        ht->deleted--;
+    }
+    ht->tags[free_slot] = _cshark_str_ht_tag(hash);
+    ht->slots[free_slot] = e;
+    ht->size++;
+    return SUCCESS;
+}
+
+/**
+ * Add an entry, or update the value of a key, from strings
+ */
+CODESHARK_INLINE int str_hashtable_add(str_hashtable_t *ht, const string &key, const string &val)
+{
+    return str_hashtable_add(ht, key.data(), key.size(), val.data(), val.size());
+}
+
+/**
+ * Find the value of a key, without copying it
+ * @param ht [in] hash table
+ * @param key [in] key bytes, need not be terminated
+ * @param key_len [in] key length
+ * @param val_len [out] value length, may be \NULL
+ * @return value bytes in the table, not terminated, or \NULL if not found
+ */
+CODESHARK_INLINE const char *str_hashtable_find(str_hashtable_t *ht, const char *key, size_t key_len, size_t *val_len)
+{
+    str_hashtable_entry_t *e;
+    size_t free_slot;
+    size_t i;
+
+    if (ht == NULL or (key == NULL and key_len > 0))
+    {
+        return NULL;
+    }
+
+    CSHARK_STAT_INC(STAT_HASHTABLE_FIND);
+
+    i = _cshark_str_ht_probe(ht, cshark_str_hash(key, key_len), key, key_len, &free_slot);
+    if (i == ht->capacity)
+    {
+        CSHARK_STAT_INC(STAT_HASHTABLE_FIND_MISS);
+        return NULL;
+    }
+
+    e = ht->slots[i];
+    if (val_len != NULL)
+    {
+        *val_len = e->val_len;
+    }
+    return _cshark_str_ht_key(e) + e->key_len;
+}
+
+/**
+ * Find the value of a key given as a string
+ */
+CODESHARK_INLINE const char *str_hashtable_find(str_hashtable_t *ht, const string &key, size_t *val_len)
+{
+    return str_hashtable_find(ht, key.data(), key.size(), val_len);
+}
+
+/**
+ * Check if a key is in the table
+ */
+CODESHARK_INLINE bool str_hashtable_contains(str_hashtable_t *ht, const char *key, size_t key_len)
+{
+    return str_hashtable_find(ht, key, key_len, NULL) != NULL;
+}
+
+/**
+ * Delete the entry of a key; its bytes stay in the arena until str_hashtable_compact()
+ * @param ht [in] hash table
+ * @param key [in] key bytes
+ * @param key_len [in] key length
+ * @return \0 on success, ERROR_NOT_FOUND if the key is not in the table, or ERROR_PARAM
+ */
+CODESHARK_INLINE int str_hashtable_delete(str_hashtable_t *ht, const char *key, size_t key_len)
+{
+    size_t free_slot;
+    size_t i;
+
+    if (ht == NULL or (key == NULL and key_len > 0))
+    {
+        return ERROR_PARAM;
+    }
+
+    i = _cshark_str_ht_probe(ht, cshark_str_hash(key, key_len), key, key_len, &free_slot);
+    if (i == ht->capacity)
+    {
+        return ERROR_NOT_FOUND;
+    }
+
+    ht->garbage += _cshark_str_ht_entry_size(ht->slots[i]);
+    ht->size--;
+
+    // a slot before an empty one ends no probe, so it can be empty too
+    if (ht->tags[(i + 1) & (ht->capacity - 1)] == STR_HT_TAG_EMPTY)
+    {
+        ht->tags[i] = STR_HT_TAG_EMPTY;
+    }
+    else
+    {
+        ht->tags[i] = STR_HT_TAG_DELETED;
+        ht->deleted++;
+    }
+    return SUCCESS;
+}
+
+/**
+ * Copy the live entries into a new arena, freeing the bytes of updated and deleted entries,
+ * and clear deleted slots
+ * @return \0 on success, or ERROR_PARAM
+ * \warning values found before become invalid
+ */
+CODESHARK_INLINE int str_hashtable_compact(str_hashtable_t *ht)
+{
+    Arena *arena;
+    str_hashtable_entry_t *e;
+    size_t i;
+
+    if (ht == NULL)
+    {
+        return ERROR_PARAM;
+    }
+
+    arena = new Arena();
+    for (i = 0; i < ht->capacity; i++)
+    {
+        if (ht->tags[i] & 0x80)
+        {
+            e = (str_hashtable_entry_t *)arena->allocate(_cshark_str_ht_entry_size(ht->slots[i]), 8);
+            memcpy(e, ht->slots[i], _cshark_str_ht_entry_size(ht->slots[i]));
+            ht->slots[i] = e;
+        }
+    }
+
+    delete(ht->arena);
+    ht->arena = arena;
+    ht->garbage = 0;
+
+    if (ht->deleted > 0)
+    {
+        _cshark_str_ht_rehash(ht, ht->capacity);
+    }
+    return SUCCESS;
+}
+
+CODESHARK_INLINE size_t str_hashtable_getsize(str_hashtable_t *ht)
+{
+    return ht->size;
+}
+
+/**
+ * Get the bytes used by the table: slots, tags and arena blocks
+ */
+CODESHARK_INLINE size_t str_hashtable_get_memory(str_hashtable_t *ht)
+{
+    return sizeof(str_hashtable_t) + ht->capacity * (sizeof(uint8_t) + sizeof(str_hashtable_entry_t *)) +
+           ht->arena->get_reserved();
+}
+
+#endif //CODESHARK_STR_HASHTABLE_INL_H
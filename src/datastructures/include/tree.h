@@ -11,7 +11,10 @@
 #ifndef CODESHARK_TREE_H
 #define CODESHARK_TREE_H
 
+#include <vector>
+
 #include "common/include/node.h"
+#include "common/include/node_iterator.h"
 #include "datastructures/include/linklist.h"
 
 enum ORDER_TYPE {
@@ -21,6 +24,165 @@ enum ORDER_TYPE {
     LEVELORDER = 8
 };
 
+/**
+ * @class cshark_btree_iterator is a forward iterator visiting nodes of a binary tree in
+ *        preorder, inorder, postorder or level order, with an explicit stack (or queue for
+ *        level order) instead of recursion. It follows left and right only, so the tree
+ *        is not changed, and each step is amortized O(1).
+ */
+class cshark_btree_iterator
+{
+private:
+    ORDER_TYPE order;
+    cshark_node_t *nt;                  // current node, NULL for end()
+    vector<cshark_node_t *> pending;    // ancestors still to visit, or children for level order
+    size_t level_pos;                   // next node in pending for level order
+
+    // inorder: push p and its left descendants
+    void push_left(cshark_node_t *p)
+    {
+        while (p != NULL)
+        {
+            this->pending.push_back(p);
+            p = p->left;
+        }
+    }
+
+    // postorder: push the path from p down to the first leaf in postorder
+    void push_first_leaf(cshark_node_t *p)
+    {
+        while (p != NULL)
+        {
+            this->pending.push_back(p);
+            p = (p->left != NULL) ? p->left : p->right;
+        }
+    }
+
+    cshark_node_t *pop()
+    {
+        cshark_node_t *p;
+
+        if (this->pending.empty())
+        {
+            return NULL;
+        }
+
+        p = this->pending.back();
+        this->pending.pop_back();
+        return p;
+    }
+
+    // level order: take the next node of the queue and queue its children
+    cshark_node_t *next_level()
+    {
+        cshark_node_t *p;
+
+        if (this->level_pos == this->pending.size())
+        {
+            return NULL;
+        }
+
+        p = this->pending[this->level_pos++];
+        if (p->left != NULL)
+        {
+            this->pending.push_back(p->left);
+        }
+        if (p->right != NULL)
+        {
+            this->pending.push_back(p->right);
+        }
+        return p;
+    }
+
+public:
+    typedef forward_iterator_tag iterator_category;
+    typedef cshark_node_t value_type;
+    typedef ptrdiff_t difference_type;
+    typedef cshark_node_t *pointer;
+    typedef cshark_node_t &reference;
+
+    cshark_btree_iterator() : order(INORDER), nt(NULL), level_pos(0) {}
+
+    cshark_btree_iterator(cshark_node_t *root, ORDER_TYPE ord) : order(ord), nt(NULL), level_pos(0)
+    {
+        if (root == NULL)
+        {
+            return;
+        }
+
+        if (this->order == PREORDER)
+        {
+            this->nt = root;
+        }
+        else if (this->order == INORDER)
+        {
+            this->push_left(root);
+            this->nt = this->pop();
+        }
+        else if (this->order == POSTORDER)
+        {
+            this->push_first_leaf(root);
+            this->nt = this->pop();
+        }
+        else
+        {
+            this->pending.push_back(root);
+            this->nt = this->next_level();
+        }
+    }
+
+    reference operator*() const { return *this->nt; }
+    pointer operator->() const { return this->nt; }
+
+    cshark_btree_iterator &operator++()
+    {
+        cshark_node_t *parent;
+
+        if (this->order == PREORDER)
+        {
+            if (this->nt->right != NULL)
+            {
+                this->pending.push_back(this->nt->right);
+            }
+            this->nt = (this->nt->left != NULL) ? this->nt->left : this->pop();
+        }
+        else if (this->order == INORDER)
+        {
+            this->push_left(this->nt->right);
+            this->nt = this->pop();
+        }
+        else if (this->order == POSTORDER)
+        {
+            // coming up from the left child, the right subtree goes first
+            if (!this->pending.empty())
+            {
+                parent = this->pending.back();
+                if (parent->left == this->nt)
+                {
+                    this->push_first_leaf(parent->right);
+                }
+            }
+            this->nt = this->pop();
+        }
+        else
+        {
+            this->nt = this->next_level();
+        }
+
+        return *this;
+    }
+
+    cshark_btree_iterator operator++(int)
+    {
+        cshark_btree_iterator it = *this;
+        ++(*this);
+        return it;
+    }
+
+    bool operator==(const cshark_btree_iterator &other) const { return this->nt == other.nt; }
+    bool operator!=(const cshark_btree_iterator &other) const { return this->nt != other.nt; }
+};
+
 /**
  * BTree maintains binary tree structure
  */
@@ -39,6 +201,10 @@ public:
     void get_size();
     cshark_node_t *get_root();
 
+    cshark_btree_iterator begin(ORDER_TYPE order);
+    cshark_btree_iterator end();
+    cshark_range<cshark_btree_iterator> traversal(ORDER_TYPE order);
+
     void traverse_preorder(LinkList **list);
     void traverse_inorder(LinkList **list);
     void traverse_postorder(LinkList **list);
@@ -58,8 +224,13 @@ typedef cshark_node_t cshark_btree_t;
 
 int cshark_btree_create(cshark_btree_t **bt, size_t n);
 int cshark_btree_destroy(cshark_btree_t *bt);
+cshark_range<cshark_btree_iterator> cshark_btree_traversal(cshark_btree_t *bt, ORDER_TYPE order);
 
 void _cshark_btree_traverse_preorder_recur(cshark_btree_t *bt);
 int _cshark_btree_traverse_level(cshark_btree_t *bt, size_t *n, cshark_linklist_t **nodes_list);
 
+#ifdef CODESHARK_HEADER_ONLY
+#include "datastructures/include/tree_inl.h"
+#endif
+
 #endif //CODESHARK_TREE_H
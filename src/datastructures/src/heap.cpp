@@ -0,0 +1,16 @@
+/*
+ ============================================================================
+ Name        : heap.cpp
+ Description : priority queue implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#include "datastructures/include/heap.h"
+
+// implementation is shared with header-only builds, see CODESHARK_HEADER_ONLY in common.h
+#ifndef CODESHARK_HEADER_ONLY
+#include "datastructures/include/heap_inl.h"
+#endif
@@ -0,0 +1,16 @@
+/*
+ ============================================================================
+ Name        : lockfree_hashtable.cpp
+ Description : split-ordered lock-free hash table implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#include "datastructures/include/lockfree_hashtable.h"
+
+// implementation is shared with header-only builds, see CODESHARK_HEADER_ONLY in common.h
+#ifndef CODESHARK_HEADER_ONLY
+#include "datastructures/include/lockfree_hashtable_inl.h"
+#endif
@@ -0,0 +1,16 @@
+/*
+ ============================================================================
+ Name        : str_hashtable.cpp
+ Description : string-keyed hash table with arena storage implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#include "datastructures/include/str_hashtable.h"
+
+// implementation is shared with header-only builds, see CODESHARK_HEADER_ONLY in common.h
+#ifndef CODESHARK_HEADER_ONLY
+#include "datastructures/include/str_hashtable_inl.h"
+#endif
@@ -0,0 +1,16 @@
+/*
+ ============================================================================
+ Name        : sort_test.h
+ Description : sort_test header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_SORT_TEST_H
+#define CODESHARK_SORT_TEST_H
+
+void test_sort_main();
+
+#endif //CODESHARK_SORT_TEST_H
@@ -0,0 +1,26 @@
+/*
+ ============================================================================
+ Name        : algorithms_test_main.cpp
+ Description : algorithms test main program
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#include <iostream>
+
+#include "algorithms_test/include/sort_test.h"
+
+using namespace std;
+
+int main()
+{
+    printf("=== algorithms test ===\n");
+
+    // test functions implemented in other cpp files within same directory
+    // Do not write test code in this file
+    test_sort_main();
+
+    printf("[SUCCESS] algorithms test\n");
+}
@@ -0,0 +1,249 @@
+/*
+ ============================================================================
+ Name        : sort_test.cpp
+ Description : sort_test implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#include <cassert>
+#include <limits.h>
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/include/err.h"
+#include "algorithms/include/sort.h"
+#include "algorithms_test/include/sort_test.h"
+
+typedef int (*sort_func_t)(int *arr, size_t n);
+
+enum SORT_TEST_DIST {
+    DIST_RANDOM = 0,
+    DIST_SORTED,
+    DIST_REVERSED,
+    DIST_FEW_UNIQUE,
+    DIST_ORGAN_PIPE,
+    DIST_NEARLY_SORTED,
+    DIST_ALL_EQUAL,
+    DIST_EXTREMES,
+    DIST_MAX
+};
+
+/**
+ * Generate test input of a distribution
+ */
+static vector<int> gen_input(SORT_TEST_DIST dist, size_t n, mt19937 &rng)
+{
+    vector<int> v(n);
+    size_t i;
+
+    for (i = 0; i < n; i++)
+    {
+        switch (dist)
+        {
+            case DIST_RANDOM:        v[i] = (int)rng(); break;
+            case DIST_SORTED:        v[i] = (int)i; break;
+            case DIST_REVERSED:      v[i] = (int)(n - i); break;
+            case DIST_FEW_UNIQUE:    v[i] = (int)(rng() % 4); break;
+            case DIST_ORGAN_PIPE:    v[i] = (int)(i < n / 2 ? i : n - i); break;
+            case DIST_NEARLY_SORTED: v[i] = (int)i; break;
+            case DIST_ALL_EQUAL:     v[i] = 7; break;
+            case DIST_EXTREMES:      v[i] = (rng() & 1) ? INT_MIN : INT_MAX - (int)(rng() % 3); break;
+            default: break;
+        }
+    }
+
+    if (dist == DIST_NEARLY_SORTED and n > 1)
+    {
+        for (i = 0; i < n / 100 + 1; i++)
+        {
+            swap(v[rng() % n], v[rng() % n]);
+        }
+    }
+
+    return v;
+}
+
+/**
+ * Check a sort function against std::sort on all distributions and sizes
+ */
+static void check_sort_func(const char *name, sort_func_t func)
+{
+    const size_t sizes[] = {0, 1, 2, 3, 15, 16, 17, 23, 24, 25, 63, 64, 65, 128, 129, 1000, 20000};
+    mt19937 rng(42);
+    size_t i;
+    int d;
+
+    for (d = 0; d < DIST_MAX; d++)
+    {
+        for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+        {
+            vector<int> v = gen_input((SORT_TEST_DIST)d, sizes[i], rng);
+            vector<int> expected = v;
+
+            sort(expected.begin(), expected.end());
+            assert (func(v.data(), v.size()) == SUCCESS);
+            assert (v == expected);
+        }
+    }
+
+    assert (func(NULL, 0) == SUCCESS);
+    assert (func(NULL, 10) == ERROR_PARAM);
+
+    printf("[SUCCESS] %s\n", name);
+}
+
+static int parallel_merge_2(int *arr, size_t n)
+{
+    return cshark_sort_parallel_merge(arr, n, 2);
+}
+
+static int parallel_merge_4(int *arr, size_t n)
+{
+    return cshark_sort_parallel_merge(arr, n, 4);
+}
+
+/**
+ * Test the sorting network on all 0-1 inputs (0-1 principle) and on random inputs
+ */
+static void test_sort_network()
+{
+    int arr[SORT_NETWORK_MAX + 1];
+    mt19937 rng(7);
+    uint32_t bits;
+    size_t n, i;
+
+    for (bits = 0; bits < (1u << SORT_NETWORK_MAX); bits++)
+    {
+        for (i = 0; i < SORT_NETWORK_MAX; i++)
+        {
+            arr[i] = (bits >> i) & 1;
+        }
+        cshark_sort_network(arr, SORT_NETWORK_MAX);
+        assert (is_sorted(arr, arr + SORT_NETWORK_MAX));
+    }
+
+    for (n = 0; n <= SORT_NETWORK_MAX; n++)
+    {
+        for (i = 0; i < n; i++)
+        {
+            arr[i] = (int)(rng() % 10) - 5;
+        }
+        arr[n] = INT_MIN;    // guard: must not be touched
+        cshark_sort_network(arr, n);
+        assert (is_sorted(arr, arr + n) and arr[n] == INT_MIN);
+    }
+
+    assert (cshark_sort_network(arr, SORT_NETWORK_MAX + 1) == ERROR_PARAM);
+
+    printf("[SUCCESS] sort network\n");
+}
+
+/**
+ * Test templates with other types and comparators
+ */
+static void test_sort_templates()
+{
+    mt19937 rng(3);
+    vector<string> s, expected_s;
+    vector<int> v, expected_v;
+    size_t i;
+
+    for (i = 0; i < 5000; i++)
+    {
+        s.push_back(to_string(rng() % 1000));
+        v.push_back((int)(rng() % 100));
+    }
+
+    expected_s = s;
+    sort(expected_s.begin(), expected_s.end());
+    cshark_pdqsort(s.begin(), s.end(), less<string>());
+    assert (s == expected_s);
+
+    shuffle(s.begin(), s.end(), rng);
+    cshark_introsort(s.begin(), s.end(), less<string>());
+    assert (s == expected_s);
+
+    expected_v = v;
+    sort(expected_v.begin(), expected_v.end(), greater<int>());
+    cshark_pdqsort(v.begin(), v.end(), greater<int>());
+    assert (v == expected_v);
+
+    shuffle(v.begin(), v.end(), rng);
+    cshark_introsort(v.begin(), v.end(), greater<int>());
+    assert (v == expected_v);
+
+    printf("[SUCCESS] sort templates\n");
+}
+
+/**
+ * Test sorting a link list, which must be stable and keep backward pointers
+ */
+static void test_sort_linklist()
+{
+    cshark_linklist_t *llt;
+    cshark_node_t *nt;
+    mt19937 rng(11);
+    size_t n, i;
+    int val;
+
+    assert (cshark_sort_linklist(NULL) == ERROR_PARAM);
+
+    llt = cshark_linkist_allocate();
+    assert (cshark_sort_linklist(llt) == SUCCESS);
+    assert (llt->head->next == NULL and llt->last == llt->head);
+    cshark_linklist_destroy(llt);
+
+    for (n = 1; n <= 2000; n = n * 3 + 1)
+    {
+        llt = cshark_linkist_allocate();
+        for (i = 0; i < n; i++)
+        {
+            cshark_linklist_add_vals(llt, (int)(rng() % 8), to_string(i));    // name records the order
+        }
+
+        assert (cshark_sort_linklist(llt) == SUCCESS);
+
+        i = 0;
+        val = INT_MIN;
+        for (nt = llt->head->next; nt != NULL; nt = nt->next)
+        {
+            assert (nt->val >= val);
+            if (nt->val == val)
+            {
+                assert (stoi(nt->name) > stoi(nt->prev->name));
+            }
+            assert (nt->prev->next == nt);
+            val = nt->val;
+            i++;
+        }
+
+        assert (i == n);
+        assert (llt->last->next == NULL and llt->first == llt->head->next);
+        cshark_linklist_destroy(llt);
+    }
+
+    printf("[SUCCESS] sort linklist\n");
+}
+
+/**
+ * Main function for sort testing
+ */
+void test_sort_main()
+{
+    check_sort_func("sort introsort", cshark_sort_introsort);
+    check_sort_func("sort pdqsort", cshark_sort_pdqsort);
+    check_sort_func("sort radix lsd", cshark_sort_radix_lsd);
+    check_sort_func("sort radix msd", cshark_sort_radix_msd);
+    check_sort_func("sort parallel merge, 2 threads", parallel_merge_2);
+    check_sort_func("sort parallel merge, 4 threads", parallel_merge_4);
+
+    test_sort_network();
+    test_sort_templates();
+    test_sort_linklist();
+}
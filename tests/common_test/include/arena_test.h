@@ -0,0 +1,16 @@
+/*
+ ============================================================================
+ Name        : arena_test.h
+ Description : arena_test header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_ARENA_TEST_H
+#define CODESHARK_ARENA_TEST_H
+
+void test_arena_main();
+
+#endif //CODESHARK_ARENA_TEST_H
@@ -0,0 +1,16 @@
+/*
+ ============================================================================
+ Name        : epoch_test.h
+ Description : epoch_test header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_EPOCH_TEST_H
+#define CODESHARK_EPOCH_TEST_H
+
+void test_epoch_main();
+
+#endif //CODESHARK_EPOCH_TEST_H
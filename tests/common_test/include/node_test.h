@@ -12,5 +12,6 @@
 #define CODESHARK_NODE_TEST_H
 
 void test_node_init();
+void test_node_init_batch();
 
 #endif //CODESHARK_NODE_TEST_H
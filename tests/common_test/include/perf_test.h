@@ -0,0 +1,16 @@
+/*
+ ============================================================================
+ Name        : perf_test.h
+ Description : perf_test header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_PERF_TEST_H
+#define CODESHARK_PERF_TEST_H
+
+void test_perf_main();
+
+#endif //CODESHARK_PERF_TEST_H
@@ -0,0 +1,16 @@
+/*
+ ============================================================================
+ Name        : stats_test.h
+ Description : stats_test header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_STATS_TEST_H
+#define CODESHARK_STATS_TEST_H
+
+void test_stats_main();
+
+#endif //CODESHARK_STATS_TEST_H
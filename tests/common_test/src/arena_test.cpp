@@ -0,0 +1,63 @@
+/*
+ ============================================================================
+ Name        : arena_test.cpp
+ Description : arena_test implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#include <cassert>
+#include <stdio.h>
+#include <string.h>
+
+#include "common/include/arena.h"
+#include "common_test/include/arena_test.h"
+
+/**
+ * Test alignment, block reuse, large requests and clear()
+ */
+static void test_arena_allocate()
+{
+    Arena arena(1024);
+    char *p, *q, *big;
+    size_t i;
+
+    assert (arena.get_used() == 0 and arena.get_reserved() == 0);
+
+    // allocations of a block are contiguous apart from alignment
+    p = (char *)arena.allocate(3, 1);
+    q = (char *)arena.allocate(8, 8);
+    assert (q >= p + 3 and q < p + 16 and (uintptr_t)q % 8 == 0);
+    assert (arena.get_used() == 11 and arena.get_reserved() == 1024);
+
+    // a large request gets its own block, and the current block stays in use
+    big = (char *)arena.allocate(4000, 64);
+    assert ((uintptr_t)big % 64 == 0 and arena.get_reserved() > 1024 + 4000);
+    memset(big, 0xab, 4000);
+    p = (char *)arena.allocate(8, 8);
+    assert (p > q and p < q + 32);
+
+    // many small objects fill new blocks, and all stay valid
+    for (i = 0; i < 1000; i++)
+    {
+        p = arena.copy("0123456789", 10);
+        assert (memcmp(p, "0123456789", 10) == 0);
+    }
+    assert (arena.get_used() == 11 + 4000 + 8 + 10000 and big[3999] == (char)0xab);
+
+    arena.clear();
+    assert (arena.get_used() == 0 and arena.get_reserved() == 0);
+    assert (arena.allocate(16) != NULL and arena.get_reserved() == 1024);
+
+    printf("[SUCCESS] arena allocate(), copy(), clear()\n");
+}
+
+/**
+ * Main function for arena testing
+ */
+void test_arena_main()
+{
+    test_arena_allocate();
+}
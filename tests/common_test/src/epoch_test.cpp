@@ -0,0 +1,141 @@
+/*
+ ============================================================================
+ Name        : epoch_test.cpp
+ Description : epoch_test implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#include <cassert>
+#include <thread>
+#include <vector>
+
+#include "common/include/epoch.h"
+#include "common_test/include/epoch_test.h"
+
+static atomic<size_t> epoch_freed(0);
+
+static void epoch_count_free(void *p)
+{
+    delete (int *)p;
+    epoch_freed.fetch_add(1);
+}
+
+/**
+ * Reclaim until nothing more can be freed
+ */
+static void epoch_drain(EpochDomain *domain)
+{
+    int i;
+
+    for (i = 0; i < 4; i++)
+    {
+        domain->reclaim();
+    }
+}
+
+/**
+ * Test a retired object is freed only after the threads pinned before have left
+ */
+static void test_epoch_pinned()
+{
+    EpochDomain domain;
+    atomic<int> step(0);
+    thread reader;
+
+    epoch_freed.store(0);
+
+    // a reader pinned in another thread holds back reclamation
+    reader = thread([&]() {
+        EpochGuard guard(&domain);
+        step.store(1);
+        while (step.load() != 2)
+        {
+            this_thread::yield();
+        }
+    });
+    while (step.load() != 1)
+    {
+        this_thread::yield();
+    }
+
+    domain.retire(new int(1), epoch_count_free);
+    epoch_drain(&domain);
+    assert (epoch_freed.load() == 0);
+
+    step.store(2);
+    reader.join();
+    epoch_drain(&domain);
+    assert (epoch_freed.load() == 1);
+
+    // the calling thread's own pin, nested, holds it back too
+    {
+        EpochGuard outer(&domain);
+        {
+            EpochGuard inner(&domain);
+        }
+        domain.retire(new int(2), epoch_count_free);
+        epoch_drain(&domain);
+        assert (epoch_freed.load() == 1);
+    }
+    epoch_drain(&domain);
+    assert (epoch_freed.load() == 2);
+
+    domain.retire(NULL, epoch_count_free);
+    domain.retire_node(cshark_node_init());
+
+    printf("[SUCCESS] epoch retire(), reclaim() with pinned threads\n");
+}
+
+/**
+ * Test objects retired by exited threads, and by the domain destructor, are all freed
+ */
+static void test_epoch_threads()
+{
+    vector<thread> workers;
+    size_t i;
+
+    epoch_freed.store(0);
+
+    {
+        EpochDomain domain;
+
+        for (i = 0; i < 8; i++)
+        {
+            workers.push_back(thread([&domain]() {
+                int k;
+
+                for (k = 0; k < 1000; k++)
+                {
+                    EpochGuard guard(&domain);
+                    domain.retire(new int(k), epoch_count_free);
+                }
+            }));
+        }
+        for (i = 0; i < workers.size(); i++)
+        {
+            workers[i].join();
+        }
+
+        // retired every EPOCH_RECLAIM_BATCH, most are freed already
+        assert (epoch_freed.load() <= 8000);
+        epoch_drain(&domain);
+        assert (epoch_freed.load() == 8000);
+
+        domain.retire(new int(0), epoch_count_free);
+    }
+    assert (epoch_freed.load() == 8001);
+
+    printf("[SUCCESS] epoch objects of exited threads and destroyed domains\n");
+}
+
+/**
+ * Main function for epoch testing
+ */
+void test_epoch_main()
+{
+    test_epoch_pinned();
+    test_epoch_threads();
+}
@@ -25,5 +25,39 @@ void test_node_init()
     cshark_node_free(nt);
 }
 
+/**
+ * Test nodes allocated in one block, freed in any order
+ */
+void test_node_init_batch()
+{
+    cshark_node_t *first;
+    cshark_node_t *nt;
+    cshark_node_t *nodes[64];
+    size_t i, n;
 
+    assert (cshark_node_init_batch(0) == NULL);
 
+    n = 0;
+    first = cshark_node_init_batch(64);
+    for (nt = first; nt != NULL; nt = nt->next)
+    {
+        assert (nt->prev == (n == 0 ? NULL : nodes[n - 1]) and nt->left == NULL and nt->right == NULL);
+        assert (((size_t)nt % NODE_HEADER_SIZE) == 0);
+        nt->name = "node " + to_string(n);     // owns heap memory, which must be freed too
+        nodes[n++] = nt;
+    }
+    assert (n == 64);
+
+    // free odd nodes first, then even ones; the block is released with the last node
+    for (i = 1; i < n; i += 2)
+    {
+        cshark_node_free(nodes[i]);
+    }
+    for (i = 0; i < n; i += 2)
+    {
+        assert (nodes[i]->name == "node " + to_string(i));
+        cshark_node_free(nodes[i]);
+    }
+
+    printf("[SUCCESS] cshark_node_init_batch()\n");
+}
@@ -11,6 +11,10 @@
 #include <iostream>
 
 #include "common_test/include/node_test.h"
+#include "common_test/include/stats_test.h"
+#include "common_test/include/perf_test.h"
+#include "common_test/include/epoch_test.h"
+#include "common_test/include/arena_test.h"
 
 using namespace std;
 
@@ -21,6 +25,11 @@ int main(int argc, char *argv[])
     // test functions implemented in other cpp files within same directory
     // Do not write test code in this file
     test_node_init();
+    test_node_init_batch();
+    test_stats_main();
+    test_perf_main();
+    test_epoch_main();
+    test_arena_main();
 
     printf("[SUCCESS] common test\n");
 
@@ -0,0 +1,159 @@
+/*
+ ============================================================================
+ Name        : perf_test.cpp
+ Description : perf_test implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#include <cassert>
+#include <thread>
+#include <vector>
+
+#include "common/include/err.h"
+#include "common/include/perf.h"
+#include "common_test/include/perf_test.h"
+
+/**
+ * Test the cycle counter against a sleep of known length.
+ */
+static void test_perf_timer()
+{
+    uint64_t t0, t1, ns, scoped_ns;
+
+    assert (perf_cycles_per_ns() > 0);
+
+    t0 = perf_now_ns();
+    t1 = perf_now_ns();
+    assert (t1 >= t0);
+
+    t0 = perf_cycles_begin();
+    this_thread::sleep_for(milliseconds(20));
+    ns = perf_cycles_to_ns(perf_cycles_end() - t0);
+    assert (ns >= 20000000 and ns < 2000000000);
+
+    {
+        ScopedTimer timer(&scoped_ns);
+        this_thread::sleep_for(milliseconds(5));
+    }
+    assert (scoped_ns >= 5000000 and scoped_ns < 2000000000);
+
+    printf("[SUCCESS] perf timer, %s, %.3f cycles/ns\n",
+           perf_tsc_enabled() ? "cycle counter" : "steady_clock", perf_cycles_per_ns());
+}
+
+/**
+ * Test histogram buckets and percentiles.
+ */
+static void test_perf_hist()
+{
+    perf_hist_t *hist;
+    perf_hist_t *other;
+    uint64_t p;
+    int i;
+
+    hist = new perf_hist_t();
+    other = new perf_hist_t();
+    perf_hist_init(hist);
+    perf_hist_init(other);
+    assert (perf_hist_percentile(hist, 50) == 0);
+
+    // small values are exact
+    for (i = 1; i <= 50; i++)
+    {
+        perf_hist_record(hist, i);
+    }
+    assert (perf_hist_percentile(hist, 50) == 25);
+    assert (perf_hist_percentile(hist, 100) == 50);
+    assert (hist->min == 1 and hist->max == 50 and hist->total == 50);
+
+    // large values are within ~3%
+    for (i = 0; i < 1000; i++)
+    {
+        perf_hist_record(other, 1000000);
+    }
+    p = perf_hist_percentile(other, 99);
+    assert (p >= 1000000 and p <= 1000000 * 1.04);
+
+    perf_hist_merge(hist, other);
+    assert (hist->total == 1050 and hist->max == 1000000 and hist->min == 1);
+    assert (perf_hist_percentile(hist, 1) <= 50);
+    assert (perf_hist_summary(hist).find("count=1050") == 0);
+    assert (perf_hist_merge(NULL, other) == ERROR_PARAM);
+
+    // the top buckets hold values up to UINT64_MAX, without touching total, min or max
+    perf_hist_init(other);
+    perf_hist_record(other, 1ULL << 63);
+    perf_hist_record(other, UINT64_MAX);
+    assert (other->total == 2 and other->min == 1ULL << 63 and other->max == UINT64_MAX);
+    assert (other->counts[PERF_HIST_BUCKETS - 1] == 1);
+    p = perf_hist_percentile(other, 50);
+    assert (p >= 1ULL << 63 and p < (1ULL << 63) + (1ULL << 59));
+    assert (perf_hist_percentile(other, 100) == UINT64_MAX);
+
+    perf_hist_record(perf_hist_local(), 7);
+    assert (perf_hist_local()->total == 1);
+
+    delete(hist);
+    delete(other);
+
+    printf("[SUCCESS] perf histogram record(), merge(), percentile()\n");
+}
+
+/**
+ * Workers record into their local histograms, and the values are collected once they exit
+ */
+static void test_perf_hist_threads()
+{
+    const int n_threads = 4;
+    const uint64_t n_values = 1000;
+    vector<thread> workers;
+    perf_hist_t *hist = new perf_hist_t();
+    int i;
+
+    perf_hist_reset_all();
+    for (i = 0; i < n_threads; i++)
+    {
+        // thread i records i * 1000 + 1 ... i * 1000 + 1000
+        workers.push_back(thread([i, n_values]() {
+            uint64_t v;
+
+            for (v = 1; v <= n_values; v++)
+            {
+                perf_hist_record(perf_hist_local(), i * n_values + v);
+            }
+        }));
+    }
+    for (i = 0; i < n_threads; i++)
+    {
+        workers[i].join();
+    }
+    perf_hist_record(perf_hist_local(), 5);
+
+    perf_hist_init(hist);
+    assert (perf_hist_collect(hist) == SUCCESS);
+    assert (hist->total == n_threads * n_values + 1);
+    assert (hist->min == 1 and hist->max == n_threads * n_values);
+    assert (perf_hist_collect(NULL) == ERROR_PARAM);
+
+    perf_hist_reset_all();
+    perf_hist_init(hist);
+    perf_hist_collect(hist);
+    assert (hist->total == 0 and perf_hist_local()->total == 0);
+
+    delete(hist);
+
+    printf("[SUCCESS] perf histogram of %d threads, perf_hist_collect()\n", n_threads);
+}
+
+/**
+ * Main function for perf testing
+ */
+void test_perf_main()
+{
+    test_perf_timer();
+    test_perf_hist();
+    test_perf_hist_threads();
+}
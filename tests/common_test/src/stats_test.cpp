@@ -0,0 +1,104 @@
+/*
+ ============================================================================
+ Name        : stats_test.cpp
+ Description : stats_test implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#include <cassert>
+#include <thread>
+#include <vector>
+
+#include "common/include/err.h"
+#include "common/include/node.h"
+#include "common/include/stats.h"
+#include "common_test/include/stats_test.h"
+
+/**
+ * Record counters in a worker thread
+ */
+static void stats_worker(int n)
+{
+    int i;
+
+    for (i = 0; i < n; i++)
+    {
+        cshark_stats_add(STAT_STACK_PUSH, 1);
+        cshark_stats_record(STAT_HIST_LINKLIST_WALK, 5);    // bucket [4, 8)
+    }
+}
+
+/**
+ * Test counters are summed across threads, including threads that have exited.
+ */
+static void test_stats_threads()
+{
+    cshark_stats_t stats;
+    vector<thread> workers;
+    int i, status;
+
+    cshark_stats_reset();
+    status = cshark_stats_snapshot(&stats);
+    assert (status == SUCCESS);
+    assert (stats.counters[STAT_STACK_PUSH] == 0 and stats.histograms[STAT_HIST_LINKLIST_WALK][3] == 0);
+
+    for (i = 0; i < 4; i++)
+    {
+        workers.push_back(thread(stats_worker, 1000));
+    }
+    for (i = 0; i < 4; i++)
+    {
+        workers[i].join();
+    }
+    stats_worker(10);
+
+    cshark_stats_snapshot(&stats);
+    assert (stats.counters[STAT_STACK_PUSH] == 4010);
+    assert (stats.histograms[STAT_HIST_LINKLIST_WALK][3] == 4010);
+    assert (cshark_stats_export(&stats).find("codeshark_stack_push 4010\n") != string::npos);
+
+    cshark_stats_reset();
+    cshark_stats_snapshot(&stats);
+    assert (stats.counters[STAT_STACK_PUSH] == 0 and stats.histograms[STAT_HIST_LINKLIST_WALK][3] == 0);
+
+    assert (cshark_stats_snapshot(NULL) == ERROR_PARAM);
+
+    printf("[SUCCESS] stats snapshot(), reset(), export() across threads\n");
+}
+
+/**
+ * Test hooks inside the library follow the build option.
+ */
+static void test_stats_hooks()
+{
+    cshark_stats_t stats;
+    cshark_node_t *nt;
+
+    cshark_stats_reset();
+    nt = cshark_node_init();
+    cshark_node_free(nt);
+    cshark_stats_snapshot(&stats);
+
+    if (cshark_stats_enabled())
+    {
+        assert (stats.counters[STAT_NODE_ALLOC] == 1);
+    }
+    else
+    {
+        assert (stats.counters[STAT_NODE_ALLOC] == 0);
+    }
+
+    printf("[SUCCESS] stats hooks, instrumentation %s\n", cshark_stats_enabled() ? "enabled" : "disabled");
+}
+
+/**
+ * Main function for stats testing
+ */
+void test_stats_main()
+{
+    test_stats_threads();
+    test_stats_hooks();
+}
@@ -0,0 +1,33 @@
+/*
+ ============================================================================
+ Name        : cache_test.h
+ Description : cache test header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_CACHE_TEST_H
+#define CODESHARK_CACHE_TEST_H
+
+#include "datastructures/include/cache.h"
+
+/**
+ * @class CacheTest is a test class to test 'Cache' with LRU, SLRU and CLOCK policies
+ */
+class CacheTest
+{
+public:
+    CacheTest();
+    ~CacheTest();
+    void test_main();
+    void test_lru();
+    void test_slru();
+    void test_clock();
+    void test_bytes();
+};
+
+void cpp_test_cache_main();
+
+#endif //CODESHARK_CACHE_TEST_H
@@ -0,0 +1,34 @@
+/*
+ ============================================================================
+ Name        : concurrent_cache_test.h
+ Description : concurrent cache test header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_CONCURRENT_CACHE_TEST_H
+#define CODESHARK_CONCURRENT_CACHE_TEST_H
+
+#include "datastructures/include/concurrent_cache.h"
+
+/**
+ * @class ConcurrentCacheTest is a test class to test 'FrequencySketch' and 'ConcurrentCache'
+ */
+class ConcurrentCacheTest
+{
+public:
+    ConcurrentCacheTest();
+    ~ConcurrentCacheTest();
+    void test_main();
+    void test_sketch();
+    void test_cache();
+    void test_admission();
+    void test_threads();
+    void test_async();
+};
+
+void cpp_test_concurrent_cache_main();
+
+#endif //CODESHARK_CONCURRENT_CACHE_TEST_H
@@ -0,0 +1,33 @@
+/*
+ ============================================================================
+ Name        : flat_map_test.h
+ Description : flat map test header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_FLAT_MAP_TEST_H
+#define CODESHARK_FLAT_MAP_TEST_H
+
+#include "datastructures/include/flat_map.h"
+
+/**
+ * @class FlatMapTest is a test class to test 'FlatMap' and 'FlatSet'
+ */
+class FlatMapTest
+{
+public:
+    FlatMapTest();
+    ~FlatMapTest();
+    void test_main();
+    void test_lower_bound();
+    void test_build_find();
+    void test_insert_batch();
+    void test_range();
+};
+
+void cpp_test_flat_map_main();
+
+#endif //CODESHARK_FLAT_MAP_TEST_H
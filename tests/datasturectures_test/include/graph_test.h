@@ -0,0 +1,18 @@
+/*
+ ============================================================================
+ Name        : graph_test.h
+ Description : graph test header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_GRAPH_TEST_H
+#define CODESHARK_GRAPH_TEST_H
+
+#include "datastructures/include/graph.h"
+
+void test_graph_main();
+
+#endif //CODESHARK_GRAPH_TEST_H
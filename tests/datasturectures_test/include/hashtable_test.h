@@ -18,5 +18,8 @@ static void test_hashtable_init();
 static void test_hashtable_destroy();
 static void test_hashtble_add();
 static void test_hashtalbe_bulk_add();
+static void test_hashtable_iterator();
+static void test_hashtable_find_batch();
+static void test_hashtable_find_ref();
 
 #endif //CODESHARK_HASHTABLE_TEST_H
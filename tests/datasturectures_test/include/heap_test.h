@@ -0,0 +1,32 @@
+/*
+ ============================================================================
+ Name        : heap_test.h
+ Description : heap test header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_HEAP_TEST_H
+#define CODESHARK_HEAP_TEST_H
+
+#include "datastructures/include/heap.h"
+
+/**
+ * @class HeapTest is a test class to test 'DaryHeap', 'IndexedDaryHeap' and 'PriorityQueue'
+ */
+class HeapTest
+{
+public:
+    HeapTest();
+    ~HeapTest();
+    void test_main();
+    void test_dary_heap();
+    void test_indexed_heap();
+    void test_priority_queue();
+};
+
+void cpp_test_heap_main();
+
+#endif //CODESHARK_HEAP_TEST_H
@@ -0,0 +1,32 @@
+/*
+ ============================================================================
+ Name        : intrusive_test.h
+ Description : intrusive containers test header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_INTRUSIVE_TEST_H
+#define CODESHARK_INTRUSIVE_TEST_H
+
+#include "datastructures/include/intrusive.h"
+
+/**
+ * @class IntrusiveTest is a test class to test 'IntrusiveList', 'IntrusiveQueue' and 'IntrusiveStack'
+ */
+class IntrusiveTest
+{
+public:
+    IntrusiveTest();
+    ~IntrusiveTest();
+    void test_main();
+    void test_list();
+    void test_queue_stack();
+    void test_multiple_lists();
+};
+
+void cpp_test_intrusive_main();
+
+#endif //CODESHARK_INTRUSIVE_TEST_H
@@ -29,6 +29,10 @@ public:
     void test_insert();
     void test_delete();
     void test_pop();
+    void test_sort();
+    void test_splice();
+    void test_batch();
+    void test_iterator();
 };
 
 
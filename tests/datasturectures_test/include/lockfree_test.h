@@ -0,0 +1,38 @@
+/*
+ ============================================================================
+ Name        : lockfree_test.h
+ Description : lock-free containers test header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_LOCKFREE_TEST_H
+#define CODESHARK_LOCKFREE_TEST_H
+
+#include "datastructures/include/lockfree_queue.h"
+#include "datastructures/include/lockfree_stack.h"
+#include "datastructures/include/lockfree_hashtable.h"
+
+/**
+ * @class LockFreeTest is a test class to test 'LockFreeQueue', 'LockFreeStack'
+ *        and 'lockfree_hashtable_t'
+ */
+class LockFreeTest
+{
+public:
+    LockFreeTest();
+    ~LockFreeTest();
+    void test_main();
+    void test_queue();
+    void test_queue_threads();
+    void test_stack();
+    void test_stack_threads();
+    void test_hashtable();
+    void test_hashtable_threads();
+};
+
+void cpp_test_lockfree_main();
+
+#endif //CODESHARK_LOCKFREE_TEST_H
@@ -0,0 +1,32 @@
+/*
+ ============================================================================
+ Name        : perfect_hashtable_test.h
+ Description : minimal perfect hash and static hash table test header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_PERFECT_HASHTABLE_TEST_H
+#define CODESHARK_PERFECT_HASHTABLE_TEST_H
+
+#include "datastructures/include/perfect_hashtable.h"
+
+/**
+ * @class PerfectHashTableTest is a test class to test 'mphf_t' and 'perfect_hashtable_t'
+ */
+class PerfectHashTableTest
+{
+public:
+    PerfectHashTableTest();
+    ~PerfectHashTableTest();
+    void test_main();
+    void test_mphf();
+    void test_find();
+    void test_save_load();
+};
+
+void cpp_test_perfect_hashtable_main();
+
+#endif //CODESHARK_PERFECT_HASHTABLE_TEST_H
@@ -0,0 +1,32 @@
+/*
+ ============================================================================
+ Name        : persistent_test.h
+ Description : persistent list and tree test header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_PERSISTENT_TEST_H
+#define CODESHARK_PERSISTENT_TEST_H
+
+#include "datastructures/include/persistent.h"
+
+/**
+ * @class PersistentTest is a test class to test 'PersistentList' and 'PersistentTree'
+ */
+class PersistentTest
+{
+public:
+    PersistentTest();
+    ~PersistentTest();
+    void test_main();
+    void test_list();
+    void test_tree();
+    void test_snapshot_threads();
+};
+
+void cpp_test_persistent_main();
+
+#endif //CODESHARK_PERSISTENT_TEST_H
@@ -20,6 +20,8 @@ public:
     QueueTest();
     ~QueueTest();
     void test_main();
+    void test_batch();
+    void test_iterator();
 };
 
 void cpp_test_queue_main();
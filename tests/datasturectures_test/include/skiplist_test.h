@@ -0,0 +1,36 @@
+/*
+ ============================================================================
+ Name        : skiplist_test.h
+ Description : skip list test header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_SKIPLIST_TEST_H
+#define CODESHARK_SKIPLIST_TEST_H
+
+#include "datastructures/include/skiplist.h"
+#include "datastructures/include/lockfree_skiplist.h"
+
+/**
+ * @class SkipListTest is a test class to test 'SkipList' and 'LockFreeSkipList'
+ */
+class SkipListTest
+{
+public:
+    SkipListTest();
+    ~SkipListTest();
+    void test_main();
+    void test_set();
+    void test_map();
+    void test_iterators();
+    void test_random();
+    void test_lockfree();
+    void test_lockfree_threads();
+};
+
+void cpp_test_skiplist_main();
+
+#endif //CODESHARK_SKIPLIST_TEST_H
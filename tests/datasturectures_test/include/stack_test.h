@@ -22,6 +22,8 @@ public:
     StackTest();
     ~StackTest();
     void test_main();
+    void test_batch();
+    void test_iterator();
 };
 
 void cpp_test_stack_main();
@@ -0,0 +1,34 @@
+/*
+ ============================================================================
+ Name        : static_test.h
+ Description : fixed-capacity containers test header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_STATIC_TEST_H
+#define CODESHARK_STATIC_TEST_H
+
+#include "datastructures/include/static_containers.h"
+
+/**
+ * @class StaticTest is a test class to test 'StaticStack', 'StaticQueue', 'StaticHashTable'
+ *        and 'StaticBTree'
+ */
+class StaticTest
+{
+public:
+    StaticTest();
+    ~StaticTest();
+    void test_main();
+    void test_stack();
+    void test_queue();
+    void test_hashtable();
+    void test_tree();
+};
+
+void cpp_test_static_main();
+
+#endif //CODESHARK_STATIC_TEST_H
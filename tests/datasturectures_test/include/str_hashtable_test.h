@@ -0,0 +1,32 @@
+/*
+ ============================================================================
+ Name        : str_hashtable_test.h
+ Description : string-keyed hash table test header
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#ifndef CODESHARK_STR_HASHTABLE_TEST_H
+#define CODESHARK_STR_HASHTABLE_TEST_H
+
+#include "datastructures/include/str_hashtable.h"
+
+/**
+ * @class StrHashTableTest is a test class to test 'str_hashtable_t'
+ */
+class StrHashTableTest
+{
+public:
+    StrHashTableTest();
+    ~StrHashTableTest();
+    void test_main();
+    void test_add_find();
+    void test_random();
+    void test_compact();
+};
+
+void cpp_test_str_hashtable_main();
+
+#endif //CODESHARK_STR_HASHTABLE_TEST_H
@@ -18,6 +18,7 @@ public:
     TreeTest();
     ~TreeTest();
     void test_main();
+    void test_iterator();
 };
 
 void cpp_tree_test_main();
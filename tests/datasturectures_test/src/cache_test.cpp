@@ -0,0 +1,220 @@
+/*
+ ============================================================================
+ Name        : cache_test.cpp
+ Description : cache test implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#include <assert.h>
+#include <algorithm>
+#include <list>
+#include <random>
+
+#include "common/include/err.h"
+#include "datasturectures_test/include/cache_test.h"
+
+CacheTest::CacheTest()
+{
+}
+
+CacheTest::~CacheTest()
+{
+
+}
+
+void CacheTest::test_main()
+{
+    this->test_lru();
+    this->test_slru();
+    this->test_clock();
+    this->test_bytes();
+}
+
+void CacheTest::test_lru()
+{
+    Cache *cache;
+    list<int> model;                    // keys, most recent first
+    list<int>::iterator pos;
+    cshark_cache_stats_t stats;
+    mt19937 rng(11);
+    const string *v;
+    int key, i;
+
+    cache = new Cache(CACHE_LRU, 3);
+    assert (cache->get(1) == NULL);
+
+    cache->put(1, "one");
+    cache->put(2, "two");
+    cache->put(3, "three");
+    assert (*cache->get(1) == "one");       // 1 is now the most recent
+    cache->put(4, "four");                  // evicts 2
+    assert (cache->contains(1) and !cache->contains(2) and cache->contains(3) and cache->contains(4));
+
+    assert (cache->put(3, "THREE") == SUCCESS and cache->get_size() == 3);
+    assert (*cache->get(3) == "THREE");
+    assert (cache->erase(3) == SUCCESS and cache->erase(3) == ERROR_NOT_FOUND);
+    assert (cache->get_size() == 2);
+
+    stats = cache->get_stats();
+    assert (stats.hits == 2 and stats.misses == 1 and stats.inserts == 4 and stats.evictions == 1);
+    delete(cache);
+
+    // random accesses against a list model of LRU
+    cache = new Cache(CACHE_LRU, 50);
+    for (i = 0; i < 20000; i++)
+    {
+        key = (int)(rng() % 100);
+        pos = find(model.begin(), model.end(), key);
+        v = cache->get(key);
+        assert ((v != NULL) == (pos != model.end()));
+
+        if (v != NULL)
+        {
+            assert (*v == to_string(key));
+            model.erase(pos);
+        }
+        else
+        {
+            cache->put(key, to_string(key));
+            if (model.size() == 50)
+            {
+                model.pop_back();
+            }
+        }
+        model.push_front(key);
+    }
+    assert (cache->get_size() == 50);
+    delete(cache);
+
+    printf("[SUCCESS] Cache LRU get(), put(), erase(), counters\n");
+}
+
+void CacheTest::test_slru()
+{
+    Cache lru(CACHE_LRU, 10);
+    Cache slru(CACHE_SLRU, 10);
+    int round, key;
+    size_t hot_lru, hot_slru;
+
+    // 5 hot keys used repeatedly, then a scan of 100 one-time keys
+    for (round = 0; round < 3; round++)
+    {
+        for (key = 0; key < 5; key++)
+        {
+            if (lru.get(key) == NULL)
+            {
+                lru.put(key, "hot");
+            }
+            if (slru.get(key) == NULL)
+            {
+                slru.put(key, "hot");
+            }
+        }
+    }
+
+    for (key = 1000; key < 1100; key++)
+    {
+        lru.put(key, "scan");
+        slru.put(key, "scan");
+    }
+
+    hot_lru = 0;
+    hot_slru = 0;
+    for (key = 0; key < 5; key++)
+    {
+        hot_lru += lru.contains(key);
+        hot_slru += slru.contains(key);
+    }
+
+    // the scan flushes LRU, while SLRU keeps the protected hot keys
+    assert (hot_lru == 0 and hot_slru == 5);
+    assert (slru.get_size() == 10);
+
+    printf("[SUCCESS] Cache SLRU keeps hot entries through a scan\n");
+}
+
+void CacheTest::test_clock()
+{
+    Cache cache(CACHE_CLOCK, 3);
+
+    cache.put(1, "one");
+    cache.put(2, "two");
+    cache.put(3, "three");
+
+    // 1 and 3 get a second chance, 2 is evicted
+    assert (cache.get(1) != NULL and cache.get(3) != NULL);
+    cache.put(4, "four");
+    assert (cache.contains(1) and !cache.contains(2) and cache.contains(3) and cache.contains(4));
+
+    // the hand cleared the bits of 1 and 3 on its way, so 1 is next
+    cache.put(5, "five");
+    assert (!cache.contains(1) and cache.contains(3) and cache.contains(4) and cache.contains(5));
+
+    assert (cache.erase(4) == SUCCESS and cache.get_size() == 2);
+    cache.put(6, "six");
+    cache.put(7, "seven");
+    assert (cache.get_size() == 3 and cache.get_stats().evictions == 3);
+
+    printf("[SUCCESS] Cache CLOCK second chance\n");
+}
+
+void CacheTest::test_bytes()
+{
+    Cache cache(CACHE_LRU, 0, 10);
+    Cache slru(CACHE_SLRU, 0, 100);
+    Cache ring(CACHE_CLOCK, 0, 12);
+    int key;
+
+    assert (cache.put(1, "aaaa") == SUCCESS and cache.put(2, "bbbb") == SUCCESS);
+    assert (cache.get_bytes() == 8);
+
+    // 4 more bytes evict the oldest entry
+    assert (cache.put(3, "cccc") == SUCCESS);
+    assert (!cache.contains(1) and cache.get_bytes() == 8);
+
+    // an explicit charge instead of the value length
+    assert (cache.put(4, "d", 6) == SUCCESS);
+    assert (cache.get_size() == 2 and cache.get_bytes() == 10);
+
+    // growing an entry evicts others, but never the entry itself
+    assert (cache.put(4, "dddddddddd") == SUCCESS);
+    assert (cache.get_size() == 1 and cache.get_bytes() == 10 and *cache.get(4) == "dddddddddd");
+
+    assert (cache.put(5, "this value is too large") == ERROR_MAX_NODES);
+    assert (cache.get_size() == 1);
+
+    cache.clear();
+    assert (cache.get_size() == 0 and cache.get_bytes() == 0);
+
+    for (key = 0; key < 100; key++)
+    {
+        slru.put(key, "0123456789");
+        slru.get(key);
+        assert (slru.get_bytes() <= 100);
+    }
+    assert (slru.get_size() == 10);
+
+    // all entries are visited, and the hand reaches the growing entry 1 first; it is passed over
+    for (key = 1; key <= 3; key++)
+    {
+        ring.put(key, "abc");
+        ring.get(key);
+    }
+    assert (ring.put(1, "0123456789") == SUCCESS);
+    assert (ring.get_size() == 1 and ring.get_bytes() == 10 and *ring.get(1) == "0123456789");
+    assert (ring.get_stats().evictions == 2);
+
+    printf("[SUCCESS] Cache limits by bytes\n");
+}
+
+void cpp_test_cache_main()
+{
+    printf("\n=== Cache test ===\n");
+
+    CacheTest *cache_test = new CacheTest();
+    cache_test->test_main();
+    delete(cache_test);
+}
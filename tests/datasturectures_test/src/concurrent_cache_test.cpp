@@ -0,0 +1,225 @@
+/*
+ ============================================================================
+ Name        : concurrent_cache_test.cpp
+ Description : concurrent cache test implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#include <assert.h>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "common/include/err.h"
+#include "datasturectures_test/include/concurrent_cache_test.h"
+
+ConcurrentCacheTest::ConcurrentCacheTest()
+{
+}
+
+ConcurrentCacheTest::~ConcurrentCacheTest()
+{
+
+}
+
+void ConcurrentCacheTest::test_main()
+{
+    this->test_sketch();
+    this->test_cache();
+    this->test_admission();
+    this->test_threads();
+    this->test_async();
+}
+
+void ConcurrentCacheTest::test_sketch()
+{
+    FrequencySketch sketch(1024);
+    uint64_t k;
+    int i;
+
+    for (i = 0; i < 20; i++)
+    {
+        sketch.increment(1);
+    }
+    for (i = 0; i < 3; i++)
+    {
+        sketch.increment(2);
+    }
+
+    assert (sketch.estimate(1) == 15);      // saturated
+    assert (sketch.estimate(2) >= 3);
+    assert (sketch.estimate(3) <= sketch.estimate(2));
+
+    // many other keys age the counts
+    for (k = 100; k < 100 + SKETCH_SAMPLE_FACTOR * 1024; k++)
+    {
+        sketch.increment(k * 0x9e3779b97f4a7c15ULL);
+    }
+    assert (sketch.estimate(1) < 15);
+
+    sketch.clear();
+    assert (sketch.estimate(1) == 0 and sketch.estimate(2) == 0);
+
+    printf("[SUCCESS] FrequencySketch counts and ages keys\n");
+}
+
+void ConcurrentCacheTest::test_cache()
+{
+    ConcurrentCache cache(100, 1);
+    cshark_cache_stats_t stats;
+    string v;
+    int key;
+
+    assert (cache.get_shards() == 1);
+    assert (cache.get(1, &v) == ERROR_NOT_FOUND);
+
+    assert (cache.put(1, "one") == SUCCESS and cache.put(2, "two") == SUCCESS);
+    assert (cache.get(1, &v) == SUCCESS and v == "one");
+    assert (cache.put(1, "ONE") == SUCCESS and cache.get_size() == 2);
+    assert (cache.get(1, &v) == SUCCESS and v == "ONE");
+    assert (cache.get(2, NULL) == SUCCESS);
+    assert (cache.erase(2) == SUCCESS and cache.erase(2) == ERROR_NOT_FOUND);
+    assert (!cache.contains(2) and cache.contains(1));
+
+    stats = cache.get_stats();
+    assert (stats.hits == 3 and stats.misses == 1 and stats.inserts == 2 and stats.evictions == 0);
+
+    // the cache never holds more than max_entries, and values always match keys
+    for (key = 0; key < 1000; key++)
+    {
+        cache.put(key, to_string(key));
+        assert (cache.get_size() <= 100);
+    }
+    for (key = 0; key < 1000; key++)
+    {
+        if (cache.get(key, &v) == SUCCESS)
+        {
+            assert (v == to_string(key));
+        }
+    }
+    assert (cache.get_size() == 100);
+
+    cache.clear();
+    assert (cache.get_size() == 0 and !cache.contains(999));
+
+    // shards are a power of two, and never more than entries
+    assert (ConcurrentCache(1000, 6).get_shards() == 8);
+    assert (ConcurrentCache(3, 16).get_shards() == 2);
+
+    printf("[SUCCESS] ConcurrentCache get, put and erase\n");
+}
+
+/**
+ * Keys used repeatedly survive a scan of one-time keys ten times larger than the cache
+ */
+void ConcurrentCacheTest::test_admission()
+{
+    ConcurrentCache cache(100, 1);
+    int hot, key, round;
+
+    for (round = 0; round < 10; round++)
+    {
+        for (key = 0; key < 50; key++)
+        {
+            if (cache.get(key, NULL) != SUCCESS)
+            {
+                cache.put(key, "hot");
+            }
+        }
+    }
+
+    for (key = 1000; key < 2000; key++)
+    {
+        if (cache.get(key, NULL) != SUCCESS)
+        {
+            cache.put(key, "scan");
+        }
+    }
+    cache.cleanup();
+
+    hot = 0;
+    for (key = 0; key < 50; key++)
+    {
+        hot += cache.contains(key) ? 1 : 0;
+    }
+    assert (hot >= 45 and cache.get_size() == 100);
+
+    printf("[SUCCESS] ConcurrentCache admission resists scans, %d of 50 hot keys kept\n", hot);
+}
+
+void ConcurrentCacheTest::test_threads()
+{
+    ConcurrentCache cache(1000, 8);
+    vector<thread> workers;
+    int t;
+
+    for (t = 0; t < 4; t++)
+    {
+        workers.push_back(thread([&cache, t]() {
+            mt19937 rng(t);
+            string v;
+            int key, i;
+
+            for (i = 0; i < 20000; i++)
+            {
+                key = (int)(rng() % 5000);
+                if (i % 100 == 0)
+                {
+                    cache.erase(key);
+                }
+                else if (cache.get(key, &v) == SUCCESS)
+                {
+                    assert (v == to_string(key));
+                }
+                else
+                {
+                    cache.put(key, to_string(key));
+                }
+            }
+        }));
+    }
+
+    for (t = 0; t < 4; t++)
+    {
+        workers[t].join();
+    }
+
+    cache.cleanup();
+    assert (cache.get_size() <= 1000);
+
+    printf("[SUCCESS] ConcurrentCache shared by 4 threads\n");
+}
+
+void ConcurrentCacheTest::test_async()
+{
+    ConcurrentCache cache(100, 2, true);
+    int key, i;
+
+    for (key = 0; key < 10000; key++)
+    {
+        cache.put(key, to_string(key));
+        assert (cache.get_size() <= 2 * 100 + 2);
+    }
+
+    // the background thread evicts down to max_entries
+    for (i = 0; i < 500 and cache.get_size() > 100; i++)
+    {
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+    assert (cache.get_size() <= 100);
+
+    printf("[SUCCESS] ConcurrentCache with eviction on a background thread\n");
+}
+
+void cpp_test_concurrent_cache_main()
+{
+    printf("\n=== ConcurrentCache test ===\n");
+
+    ConcurrentCacheTest *concurrent_cache_test = new ConcurrentCacheTest();
+    concurrent_cache_test->test_main();
+    delete(concurrent_cache_test);
+}
@@ -14,6 +14,18 @@
 #include "datasturectures_test/include/queue_test.h"
 #include "datasturectures_test/include/hashtable_test.h"
 #include "datasturectures_test/include/tree_test.h"
+#include "datasturectures_test/include/graph_test.h"
+#include "datasturectures_test/include/heap_test.h"
+#include "datasturectures_test/include/persistent_test.h"
+#include "datasturectures_test/include/lockfree_test.h"
+#include "datasturectures_test/include/static_test.h"
+#include "datasturectures_test/include/cache_test.h"
+#include "datasturectures_test/include/concurrent_cache_test.h"
+#include "datasturectures_test/include/skiplist_test.h"
+#include "datasturectures_test/include/intrusive_test.h"
+#include "datasturectures_test/include/str_hashtable_test.h"
+#include "datasturectures_test/include/perfect_hashtable_test.h"
+#include "datasturectures_test/include/flat_map_test.h"
 
 int main(int argc, char *argv[])
 {
@@ -23,6 +35,19 @@ int main(int argc, char *argv[])
     cpp_test_stack_main();
     cpp_test_queue_main();
     cpp_tree_test_main();
+    cpp_test_heap_main();
+    cpp_test_persistent_main();
+    cpp_test_lockfree_main();
+    cpp_test_static_main();
+    cpp_test_cache_main();
+    cpp_test_concurrent_cache_main();
+    cpp_test_skiplist_main();
+    cpp_test_intrusive_main();
+    cpp_test_str_hashtable_main();
+    cpp_test_perfect_hashtable_main();
+    cpp_test_flat_map_main();
+    test_hashtable_main();
+    test_graph_main();
 
     codeshark_epilogue();
 
@@ -0,0 +1,225 @@
+/*
+ ============================================================================
+ Name        : flat_map_test.cpp
+ Description : flat map test implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#include <assert.h>
+#include <limits.h>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "datasturectures_test/include/flat_map_test.h"
+
+FlatMapTest::FlatMapTest()
+{
+}
+
+FlatMapTest::~FlatMapTest()
+{
+
+}
+
+void FlatMapTest::test_main()
+{
+    this->test_lower_bound();
+    this->test_build_find();
+    this->test_insert_batch();
+    this->test_range();
+}
+
+/**
+ * Branchless, SIMD and Eytzinger searches agree with std::lower_bound for every array size up to
+ * a few windows, with repeated keys and keys outside the array
+ */
+void FlatMapTest::test_lower_bound()
+{
+    vector<int> a, e;
+    size_t n, i, k, expected;
+    int key;
+
+    for (n = 0; n <= 70; n++)
+    {
+        a.clear();
+        for (i = 0; i < n; i++)
+        {
+            a.push_back((int)(i / 2 * 3));
+        }
+
+        // the Eytzinger layout of distinct keys, filled in order
+        e.assign(n + 1, 0);
+        for (i = 0, k = cshark_eytzinger_first(n); i < n; i++, k = cshark_eytzinger_next(k, n))
+        {
+            e[k] = (int)i;
+        }
+        assert (k == 0);
+
+        for (key = -2; key <= (int)(n * 2); key++)
+        {
+            expected = lower_bound(a.begin(), a.end(), key) - a.begin();
+            assert (cshark_lower_bound_branchless(a.data(), n, key) == expected);
+            assert (cshark_lower_bound_simd(a.data(), n, key) == expected);
+
+            k = cshark_eytzinger_lower_bound(e.data(), n, key);
+            assert (key < 0 ? k == cshark_eytzinger_first(n) : (key >= (int)n ? k == 0 : e[k] == key));
+        }
+    }
+
+    a.assign(1, INT_MIN);
+    assert (cshark_lower_bound_simd(a.data(), 1, INT_MIN) == 0 and cshark_lower_bound_simd(a.data(), 1, INT_MAX) == 1);
+
+    printf("[SUCCESS] cshark_lower_bound_branchless(), _simd(), cshark_eytzinger_lower_bound()\n");
+}
+
+/**
+ * Build from unsorted keys and look up every key, in sorted and Eytzinger order
+ */
+void FlatMapTest::test_build_find()
+{
+    FlatMap<string> flat;
+    std::map<int, string> model;
+    vector<int> keys;
+    vector<string> values;
+    uint32_t x = 2463534242u;
+    size_t i;
+    int key;
+
+    for (i = 0; i < 20000; i++)
+    {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        keys.push_back((int)(x % 50000) - 25000);
+        values.push_back("v" + to_string(i));
+        model[keys.back()] = values.back();
+    }
+
+    assert (flat.find(1) == NULL and flat.build(NULL, NULL, 1) == ERROR_PARAM);
+    assert (flat.build(keys.data(), values.data(), keys.size()) == SUCCESS);
+    assert (flat.get_size() == model.size());
+    assert (flat.get_memory() == model.size() * (sizeof(int) + sizeof(string)));
+
+    for (i = 0; i < 2; i++)
+    {
+        flat.set_eytzinger(i == 1);
+        for (key = -25001; key <= 25001; key++)
+        {
+            assert (model.count(key) == 0 ? flat.find(key) == NULL : *flat.find(key) == model[key]);
+        }
+    }
+
+    *flat.find(keys[0]) = "updated";
+    flat.set_eytzinger(false);
+    assert (*flat.find(keys[0]) == "updated" and flat.contains(keys[1]) and !flat.contains(25000));
+
+    printf("[SUCCESS] FlatMap build(), find(), set_eytzinger()\n");
+}
+
+/**
+ * Merge batches with new keys, updated keys and repeated keys, into a map in either order
+ */
+void FlatMapTest::test_insert_batch()
+{
+    FlatMap<int> flat;
+    FlatSet set;
+    std::map<int, int> model;
+    vector<int> keys, values;
+    size_t b, i;
+    int expected;
+
+    for (b = 0; b < 20; b++)
+    {
+        keys.clear();
+        values.clear();
+        for (i = 0; i < 500; i++)
+        {
+            keys.push_back((int)((i * 7919 + b * 104729) % 3000));
+            values.push_back((int)(b * 1000 + i));
+            model[keys.back()] = values.back();
+        }
+
+        flat.set_eytzinger(b % 2 == 1);
+        set.set_eytzinger(b % 3 == 1);
+        assert (flat.insert_batch(keys.data(), values.data(), keys.size()) == SUCCESS);
+        assert (set.insert_batch(keys.data(), NULL, keys.size()) == SUCCESS);
+        assert (flat.get_size() == model.size() and set.get_size() == model.size());
+        assert (flat.is_eytzinger() == (b % 2 == 1));
+    }
+
+    for (std::map<int, int>::iterator it = model.begin(); it != model.end(); it++)
+    {
+        assert (*flat.find(it->first) == it->second and set.contains(it->first));
+    }
+
+    // equal keys of one batch: the last value wins
+    keys.assign(3, 5000);
+    values.clear();
+    values.push_back(1);
+    values.push_back(2);
+    values.push_back(3);
+    assert (flat.insert_batch(keys.data(), values.data(), 3) == SUCCESS and *flat.find(5000) == 3);
+    assert (flat.insert_batch(NULL, NULL, 0) == SUCCESS and flat.get_size() == model.size() + 1);
+
+    // a set takes only its keys
+    assert (set.get_memory() == set.get_size() * sizeof(int) + (set.is_eytzinger() ? sizeof(int) : 0));
+
+    expected = INT_MIN;
+    set.for_each([&](int k, const cshark_flat_no_value &) {
+        assert (k > expected);
+        expected = k;
+    });
+
+    printf("[SUCCESS] FlatMap insert_batch(), FlatSet\n");
+}
+
+void FlatMapTest::test_range()
+{
+    FlatMap<int> flat;
+    vector<int> keys;
+    vector<int> seen;
+    size_t i, n;
+
+    for (i = 0; i < 1000; i++)
+    {
+        keys.push_back((int)((i * 617) % 1000) * 10);
+    }
+    flat.build(keys.data(), keys.data(), keys.size());
+
+    for (i = 0; i < 2; i++)
+    {
+        flat.set_eytzinger(i == 1);
+
+        seen.clear();
+        n = flat.for_each_range(95, 151, [&](int k, int v) {
+            assert (k == v);
+            seen.push_back(k);
+        });
+        assert (n == 6 and seen.size() == 6 and seen[0] == 100 and seen[5] == 150);
+
+        assert (flat.for_each_range(9991, INT_MAX, [](int, int) {}) == 0);
+        assert (flat.for_each_range(INT_MIN, 0, [](int, int) {}) == 0);
+
+        seen.clear();
+        flat.for_each([&](int k, int) {
+            seen.push_back(k);
+        });
+        assert (seen.size() == 1000 and is_sorted(seen.begin(), seen.end()));
+    }
+
+    printf("[SUCCESS] FlatMap for_each_range(), for_each()\n");
+}
+
+void cpp_test_flat_map_main()
+{
+    printf("\n=== Flat map test ===\n");
+
+    FlatMapTest *flat_map_test = new FlatMapTest();
+    flat_map_test->test_main();
+    delete(flat_map_test);
+}
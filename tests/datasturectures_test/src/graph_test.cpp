@@ -0,0 +1,154 @@
+/*
+ ============================================================================
+ Name        : graph_test.cpp
+ Description : graph test implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#include <cassert>
+#include <random>
+#include <vector>
+
+#include "common/include/err.h"
+#include "datastructures/include/graph.h"
+#include "datasturectures_test/include/graph_test.h"
+
+using namespace std;
+
+/**
+ * Test CSR building on a small directed graph
+ *      0 -> 1, 0 -> 2, 2 -> 1, 3 -> 4
+ */
+static void test_graph_build()
+{
+    const cshark_edge_t edges[] = {{0, 1, 5}, {2, 1, 1}, {0, 2, 2}, {3, 4, 1}};
+    const cshark_edge_t bad_edges[] = {{0, 9, 1}};
+    cshark_graph_t *g;
+
+    g = cshark_graph_build(5, edges, 4, true);
+    assert (g != NULL and g->n_vertices == 5 and g->n_edges == 4);
+    assert (g->offsets[0] == 0 and g->offsets[1] == 2 and g->offsets[5] == 4);
+    assert (g->targets[0] == 1 and g->weights[0] == 5 and g->targets[1] == 2);
+    assert (cshark_graph_degree(g, 0) == 2 and cshark_graph_degree(g, 1) == 0);
+    assert (g->in_offsets[2] - g->in_offsets[1] == 2);    // 1 has in-edges from 0 and 2
+    cshark_graph_destroy(g);
+
+    g = cshark_graph_build(5, edges, 4, false);
+    assert (g != NULL and g->n_edges == 8 and cshark_graph_degree(g, 1) == 2);
+    assert (g->in_offsets == g->offsets);
+    cshark_graph_destroy(g);
+
+    assert (cshark_graph_build(5, bad_edges, 1, true) == NULL);
+    assert (cshark_graph_destroy(NULL) == ERROR_PARAM);
+
+    printf("[SUCCESS] graph build\n");
+}
+
+/**
+ * Test traversals on the small graph
+ */
+static void test_graph_traverse()
+{
+    const cshark_edge_t edges[] = {{0, 1, 5}, {2, 1, 1}, {0, 2, 2}, {3, 4, 1}};
+    cshark_graph_t *g;
+    uint32_t order[5];
+    uint32_t labels[5];
+    int64_t dist[5];
+    int levels[6];          // a spare entry: the compiler cannot see that source 5 is rejected below
+    size_t n;
+
+    g = cshark_graph_build(5, edges, 4, true);
+
+    assert (cshark_graph_bfs(g, 0, levels) == SUCCESS);
+    assert (levels[0] == 0 and levels[1] == 1 and levels[2] == 1 and levels[3] == GRAPH_UNREACHED);
+
+    assert (cshark_graph_dfs(g, 0, order, &n) == SUCCESS);
+    assert (n == 3 and order[0] == 0 and order[1] == 1 and order[2] == 2);
+
+    assert (cshark_graph_components(g, labels, &n) == SUCCESS);
+    assert (n == 2 and labels[0] == 0 and labels[1] == 0 and labels[2] == 0 and labels[3] == 1 and labels[4] == 1);
+
+    assert (cshark_graph_dijkstra(g, 0, dist) == SUCCESS);
+    assert (dist[1] == 3 and dist[2] == 2 and dist[4] == GRAPH_INF);
+
+    assert (cshark_graph_toposort(g, order) == SUCCESS);
+    assert (order[0] == 0 and order[1] == 3);
+
+    assert (cshark_graph_bfs(g, 5, levels) == ERROR_PARAM);
+    assert (cshark_graph_dfs(NULL, 0, order, &n) == ERROR_PARAM);
+    cshark_graph_destroy(g);
+
+    printf("[SUCCESS] graph bfs(), dfs(), components(), dijkstra(), toposort()\n");
+}
+
+/**
+ * Test toposort detects cycles, and Dijkstra rejects negative weights
+ */
+static void test_graph_invalid()
+{
+    const cshark_edge_t cycle[] = {{0, 1, 1}, {1, 2, -1}, {2, 0, 1}};
+    cshark_graph_t *g;
+    uint32_t order[3];
+    int64_t dist[3];
+
+    g = cshark_graph_build(3, cycle, 3, true);
+    assert (cshark_graph_toposort(g, order) == ERROR_CYCLE);
+    assert (cshark_graph_dijkstra(g, 0, dist) == ERROR_PARAM);
+    cshark_graph_destroy(g);
+
+    g = cshark_graph_build(3, cycle, 3, false);
+    assert (cshark_graph_toposort(g, order) == ERROR_PARAM);
+    cshark_graph_destroy(g);
+
+    printf("[SUCCESS] graph toposort() cycle, dijkstra() negative weight\n");
+}
+
+/**
+ * Test parallel BFS against sequential BFS on random graphs large enough to
+ * switch between top-down and bottom-up steps
+ */
+static void test_graph_bfs_parallel()
+{
+    const size_t n = 20000;
+    vector<cshark_edge_t> edges;
+    vector<int> expected(n), levels(n);
+    cshark_graph_t *g;
+    mt19937 rng(5);
+    size_t i;
+    int directed;
+
+    for (i = 0; i < n * 8; i++)
+    {
+        cshark_edge_t e = {(uint32_t)(rng() % n), (uint32_t)(rng() % n), 1};
+        edges.push_back(e);
+    }
+
+    for (directed = 0; directed <= 1; directed++)
+    {
+        g = cshark_graph_build(n, edges.data(), edges.size(), directed == 1);
+        cshark_graph_bfs(g, 0, expected.data());
+
+        assert (cshark_graph_bfs_parallel(g, 0, levels.data(), 1) == SUCCESS);
+        assert (levels == expected);
+        assert (cshark_graph_bfs_parallel(g, 0, levels.data(), 4) == SUCCESS);
+        assert (levels == expected);
+
+        cshark_graph_destroy(g);
+    }
+
+    printf("[SUCCESS] graph bfs_parallel()\n");
+}
+
+/**
+ * Main function for graph testing
+ */
+void test_graph_main()
+{
+    test_graph_build();
+    test_graph_traverse();
+    test_graph_invalid();
+    test_graph_bfs_parallel();
+}
@@ -9,6 +9,8 @@ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license
 */
 
 #include <assert.h>
+#include <algorithm>
+#include <vector>
 
 #include "common/include/node.h"
 #include "common/include/err.h"
@@ -26,6 +28,9 @@ void test_hashtable_main()
     test_hashtable_destroy();
     test_hashtble_add();
     test_hashtalbe_bulk_add();
+    test_hashtable_iterator();
+    test_hashtable_find_batch();
+    test_hashtable_find_ref();
 
 }
 
@@ -121,4 +126,134 @@ static void test_hashtalbe_bulk_add()
     perf_get_elapsed_time(&start, &end, &elapsed);
     printf("[PASSED] hashtable_bulk_add() and _find(), %llu nodes, elapsed:%s seconds\n", max_hash_nodes, elapsed.time_str.c_str());
 
-}
\ No newline at end of file
+}
+
+/**
+ * Test iterating all entries of hash table
+ */
+static void test_hashtable_iterator()
+{
+    hashtable_t *ht;
+    vector<int> keys;
+    int i, n;
+
+    ht = hashtable_init();
+    assert (hashtable_begin(ht) == hashtable_end(ht));
+    assert (hashtable_begin(NULL) == hashtable_end(NULL));
+
+    // keys sharing slots, and slots left empty between them
+    n = 3 * MAX_HASH_SLOTS;
+    for (i = 0; i < n; i += 2)
+    {
+        hashtable_add(ht, i, "name" + to_string(i));
+    }
+
+    for (cshark_node_t &entry : hashtable_entries(ht))
+    {
+        assert (entry.name == "name" + to_string(entry.val));
+        entry.name = "new";
+        keys.push_back(entry.val);
+    }
+
+    sort(keys.begin(), keys.end());
+    assert ((int)keys.size() == (n + 1) / 2);
+    for (i = 0; i < (int)keys.size(); i++)
+    {
+        assert (keys[i] == 2 * i);
+    }
+
+    assert (hashtable_find(ht, 4) == "new");
+    assert (count_if(hashtable_begin(ht), hashtable_end(ht), [](const cshark_node_t &e) { return e.val < 10; }) == 5);
+
+    hashtable_destroy(ht);
+
+    printf("[PASSED] hashtable_begin(), hashtable_end(), hashtable_entries()\n");
+}
+
+/**
+ * Test batched lookups against single ones, with more keys than lookups in flight
+ */
+static void test_hashtable_find_batch()
+{
+    hashtable_t *ht;
+    vector<int> keys;
+    vector<string> out;
+    size_t found;
+    int i, n;
+
+    ht = hashtable_init();
+    n = 10 * MAX_HASH_SLOTS;
+    for (i = 0; i < n; i += 3)
+    {
+        hashtable_add(ht, i, "name" + to_string(i));
+    }
+
+    // hits, misses, repeated keys and keys of empty chains, in one batch
+    for (i = 0; i < n + 100; i += 2)
+    {
+        keys.push_back(i);
+        keys.push_back((i * 7) % n);
+    }
+    out.resize(keys.size());
+
+    found = hashtable_find_batch(ht, keys.data(), keys.size(), out.data());
+    for (i = 0; i < (int)keys.size(); i++)
+    {
+        if (keys[i] < n and keys[i] % 3 == 0)
+        {
+            assert (out[i] == "name" + to_string(keys[i]) and out[i] == hashtable_find(ht, keys[i]));
+            found--;
+        }
+        else
+        {
+            assert (out[i] == HASH_NOT_FOUND);
+        }
+    }
+    assert (found == 0);
+
+    // batches smaller than the group, and empty ones
+    assert (hashtable_find_batch(ht, keys.data(), 3, out.data()) == 2 and out[1] == "name0" and out[2] == HASH_NOT_FOUND);
+    assert (hashtable_find_batch(ht, keys.data(), 0, out.data()) == 0);
+    assert (hashtable_find_batch(NULL, keys.data(), 3, out.data()) == 0);
+
+    hashtable_destroy(ht);
+
+    printf("[PASSED] hashtable_find_batch()\n");
+}
+
+/**
+ * Test lookups without copies, hashtable_contains() and hashtable_delete()
+ */
+static void test_hashtable_find_ref()
+{
+    hashtable_t *ht;
+    const string *v;
+
+    ht = hashtable_init();
+
+    // an empty slot and a missing key in a used slot are both not found
+    assert (hashtable_find(ht, 7) == HASH_NOT_FOUND and hashtable_find_ref(ht, 7) == NULL);
+    hashtable_add(ht, 7, "name7");
+    assert (hashtable_find(ht, 7 + MAX_HASH_SLOTS) == HASH_NOT_FOUND);
+    assert (!hashtable_contains(ht, 7 + MAX_HASH_SLOTS) and hashtable_contains(ht, 7));
+
+    // the pointer refers to the stored value, and follows updates of the key
+    v = hashtable_find_ref(ht, 7);
+    assert (v != NULL and *v == "name7");
+    hashtable_add(ht, 7 + MAX_HASH_SLOTS, "other");
+    hashtable_add(ht, 7, "renamed");
+    assert (hashtable_find_ref(ht, 7) == v and *v == "renamed");
+
+    // negative keys
+    assert (hashtable_add(ht, -7, "minus7") == SUCCESS and *hashtable_find_ref(ht, -7) == "minus7");
+    assert (hashtable_find(ht, -8) == HASH_NOT_FOUND);
+
+    assert (hashtable_delete(ht, 7) == SUCCESS and hashtable_delete(ht, 7) == ERROR_NOT_FOUND);
+    assert (!hashtable_contains(ht, 7) and hashtable_find(ht, 7 + MAX_HASH_SLOTS) == "other");
+    assert (hashtable_delete(ht, -7) == SUCCESS and hashtable_find_ref(ht, -7) == NULL);
+    assert (hashtable_delete(NULL, 1) == ERROR_PARAM and hashtable_find_ref(NULL, 1) == NULL);
+
+    hashtable_destroy(ht);
+
+    printf("[PASSED] hashtable_find_ref(), hashtable_contains(), hashtable_delete()\n");
+}
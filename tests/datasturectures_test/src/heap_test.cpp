@@ -0,0 +1,209 @@
+/*
+ ============================================================================
+ Name        : heap_test.cpp
+ Description : heap test implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#include <assert.h>
+#include <algorithm>
+#include <map>
+#include <random>
+
+#include "common/include/err.h"
+#include "datasturectures_test/include/heap_test.h"
+
+HeapTest::HeapTest()
+{
+}
+
+HeapTest::~HeapTest()
+{
+
+}
+
+void HeapTest::test_main()
+{
+    this->test_dary_heap();
+    this->test_indexed_heap();
+    this->test_priority_queue();
+}
+
+/**
+ * Pop all elements of a heap, which must come out in order
+ */
+template <typename Heap>
+static void check_heap_order(Heap &heap, vector<int> expected)
+{
+    size_t i;
+
+    sort(expected.begin(), expected.end());
+    assert (heap.get_size() == expected.size());
+
+    for (i = 0; i < expected.size(); i++)
+    {
+        assert (heap.top() == expected[i]);
+        heap.pop();
+    }
+    assert (heap.is_empty());
+}
+
+void HeapTest::test_dary_heap()
+{
+    DaryHeap<int, 2> heap2;
+    DaryHeap<int, 4> heap4;
+    DaryHeap<int, 8> heap8;
+    DaryHeap<int, 4, greater<int>> max_heap;
+    vector<int> v, w, sorted_v;
+    mt19937 rng(9);
+    size_t i;
+
+    for (i = 0; i < 5000; i++)
+    {
+        v.push_back((int)(rng() % 1000));
+        heap2.push(v.back());
+        heap4.push(v.back());
+    }
+
+    check_heap_order(heap2, v);
+    check_heap_order(heap4, v);
+
+    heap8.heapify(v.begin(), v.end());
+
+    // at() reads the heap array: the top first, and every element once
+    for (i = 0; i < heap8.get_size(); i++)
+    {
+        w.push_back(heap8.at(i));
+    }
+    assert (w[0] == heap8.top());
+    sorted_v = v;
+    sort(sorted_v.begin(), sorted_v.end());
+    sort(w.begin(), w.end());
+    assert (w == sorted_v);
+
+    check_heap_order(heap8, v);
+
+    max_heap.heapify(v.begin(), v.end());
+    assert (max_heap.top() == *max_element(v.begin(), v.end()));
+
+    heap4.push(3);
+    heap4.pop();
+    assert (heap4.is_empty());
+
+    printf("[SUCCESS] DaryHeap push(), pop(), top(), at(), heapify()\n");
+}
+
+void HeapTest::test_indexed_heap()
+{
+    IndexedDaryHeap<int> heap;
+    map<size_t, int> alive;     // handle -> value
+    mt19937 rng(4);
+    size_t h, i;
+    int v, min_v;
+
+    for (i = 0; i < 10000; i++)
+    {
+        switch (rng() % 4)
+        {
+            case 0:
+            case 1:
+                v = (int)(rng() % 100000);
+                h = heap.push(v);
+                assert (alive.count(h) == 0);
+                alive[h] = v;
+                break;
+            case 2:
+                if (!alive.empty())
+                {
+                    h = next(alive.begin(), rng() % alive.size())->first;
+                    v = alive[h] - (int)(rng() % 1000);       // decrease-key
+                    assert (heap.update(h, v));
+                    alive[h] = v;
+                    assert (heap.get(h) == v);
+                }
+                break;
+            default:
+                if (!alive.empty())
+                {
+                    h = next(alive.begin(), rng() % alive.size())->first;
+                    assert (heap.erase(h) and !heap.contains(h));
+                    alive.erase(h);
+                    assert (!heap.erase(h));
+                }
+                break;
+        }
+
+        assert (heap.get_size() == alive.size());
+        if (!alive.empty())
+        {
+            min_v = alive.begin()->second;
+            for (map<size_t, int>::iterator it = alive.begin(); it != alive.end(); ++it)
+            {
+                min_v = min(min_v, it->second);
+            }
+            assert (heap.top() == min_v and alive[heap.top_handle()] == min_v);
+        }
+    }
+
+    while (!heap.is_empty())
+    {
+        alive.erase(heap.top_handle());
+        heap.pop();
+    }
+    assert (alive.empty() and !heap.update(0, 1));
+
+    printf("[SUCCESS] IndexedDaryHeap push(), pop(), update(), erase()\n");
+}
+
+void HeapTest::test_priority_queue()
+{
+    PriorityQueue *pq = new PriorityQueue();
+    cshark_pqueue_t *cpq;
+    cshark_node_t *nodes[4];
+    cshark_node_t *nt;
+    int i;
+
+    assert (pq->is_empty() and pq->dequeue() == NULL and pq->get_top() == NULL);
+
+    pq->enqueue(5);
+    pq->enqueue(1);
+    pq->enqueue(3);
+    assert (pq->get_size() == 3 and pq->get_top()->val == 1);
+
+    nt = pq->dequeue();
+    assert (nt != NULL and nt->val == 1);
+    delete(nt);
+
+    for (i = 0; i < 4; i++)
+    {
+        nodes[i] = cshark_node_init();
+        nodes[i]->val = 10 - i;
+    }
+    assert (pq->enqueue_bulk(nodes, 4) == SUCCESS);
+    assert (pq->get_size() == 6 and pq->get_top()->val == 3);
+    delete(pq);     // frees remaining nodes
+
+    cpq = cshark_pqueue_init();
+    assert (cshark_pqueue_add(cpq, 2) == SUCCESS and cshark_pqueue_add(cpq, -2) == SUCCESS);
+    assert (cshark_pqueue_insert(cpq, NULL) == ERROR_PARAM);
+    assert (cshark_pqueue_getsize(cpq) == 2 and cshark_pqueue_top(cpq)->val == -2);
+
+    nt = cshark_pqueue_remove(cpq);
+    assert (nt->val == -2);
+    cshark_node_free(nt);
+    cshark_pqueue_destroy(cpq);
+
+    printf("[SUCCESS] PriorityQueue enqueue(), dequeue(), enqueue_bulk(), cshark_pqueue_*()\n");
+}
+
+void cpp_test_heap_main()
+{
+    printf("\n=== Heap test ===\n");
+
+    HeapTest *heap_test = new HeapTest();
+    heap_test->test_main();
+    delete(heap_test);
+}
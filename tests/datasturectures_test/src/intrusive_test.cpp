@@ -0,0 +1,191 @@
+/*
+ ============================================================================
+ Name        : intrusive_test.cpp
+ Description : intrusive containers test implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#include <assert.h>
+#include <string>
+#include <vector>
+
+#include "common/include/err.h"
+#include "datasturectures_test/include/intrusive_test.h"
+
+// an element in up to three containers at once, with a field before the hooks
+typedef struct _intrusive_item_t
+{
+    string name;
+    int val;
+    cshark_list_hook_t all;
+    cshark_list_hook_t ready;
+    cshark_list_hook_t undo;
+}intrusive_item_t;
+
+typedef IntrusiveList<intrusive_item_t, &intrusive_item_t::all> item_list;
+typedef IntrusiveQueue<intrusive_item_t, &intrusive_item_t::ready> item_queue;
+typedef IntrusiveStack<intrusive_item_t, &intrusive_item_t::undo> item_stack;
+
+IntrusiveTest::IntrusiveTest()
+{
+}
+
+IntrusiveTest::~IntrusiveTest()
+{
+
+}
+
+void IntrusiveTest::test_main()
+{
+    this->test_list();
+    this->test_queue_stack();
+    this->test_multiple_lists();
+}
+
+void IntrusiveTest::test_list()
+{
+    intrusive_item_t items[8];
+    item_list list;
+    vector<int> vals;
+    int i;
+
+    assert (list.is_empty() and list.get_first() == NULL and list.pop_front() == NULL);
+    assert (list.erase(items[0]) == ERROR_NOT_FOUND);
+
+    for (i = 0; i < 8; i++)
+    {
+        items[i].val = i;
+        assert (list.push_back(items[i]) == SUCCESS);
+    }
+    assert (list.get_size() == 8 and list.get_first() == &items[0] and list.get_last() == &items[7]);
+    assert (list.push_front(items[3]) == ERROR_EXISTS);
+
+    // O(1) erase from the middle, the ends, and insertion before an element
+    assert (list.erase(items[3]) == SUCCESS and !items[3].all.is_linked());
+    assert (list.erase(items[0]) == SUCCESS and list.erase(items[7]) == SUCCESS);
+    assert (list.insert_before(items[4], items[3]) == SUCCESS);
+    assert (list.get_next(items[2]) == &items[3] and list.get_prev(items[4]) == &items[3]);
+    assert (list.get_prev(items[1]) == NULL and list.get_next(items[6]) == NULL);
+
+    list.move_to_front(items[5]);
+    for (intrusive_item_t &it : list)
+    {
+        vals.push_back(it.val);
+    }
+    assert ((vals == vector<int>{5, 1, 2, 3, 4, 6}));
+
+    // iterators walk both ways, and convert to const iterators
+    item_list::const_iterator cit = list.end();
+    --cit;
+    assert (cit->val == 6 and (--cit)->val == 4);
+    cit = list.begin();
+    assert (cit->val == 5);
+
+    assert (list.pop_back() == &items[6] and list.pop_front() == &items[5] and list.get_size() == 4);
+
+    // a copied element is not in the list
+    intrusive_item_t copy = items[1];
+    assert (!copy.all.is_linked() and copy.val == 1);
+
+    list.clear();
+    assert (list.is_empty() and !items[1].all.is_linked() and !items[4].all.is_linked());
+    assert (list.push_back(items[1]) == SUCCESS and list.get_size() == 1);
+
+    printf("[SUCCESS] IntrusiveList push, pop, erase(), insert_before(), iterators\n");
+}
+
+void IntrusiveTest::test_queue_stack()
+{
+    intrusive_item_t items[4];
+    item_queue queue;
+    item_stack stack;
+    vector<int> vals;
+    int i;
+
+    assert (queue.dequeue() == NULL and stack.pop() == NULL and stack.get_top() == NULL);
+
+    for (i = 0; i < 4; i++)
+    {
+        items[i].val = i;
+        assert (queue.enqueue(items[i]) == SUCCESS);
+        assert (stack.push(items[i]) == SUCCESS);
+    }
+    assert (queue.enqueue(items[0]) == ERROR_EXISTS and stack.push(items[0]) == ERROR_EXISTS);
+
+    // iterators walk from the top of the stack
+    for (intrusive_item_t &it : stack)
+    {
+        vals.push_back(it.val);
+    }
+    assert ((vals == vector<int>{3, 2, 1, 0}));
+
+    // a cancelled element leaves the middle of the queue
+    assert (queue.erase(items[1]) == SUCCESS and queue.get_size() == 3);
+    assert (queue.get_front() == &items[0]);
+    assert (queue.dequeue() == &items[0] and queue.dequeue() == &items[2] and queue.dequeue() == &items[3]);
+    assert (queue.is_empty());
+
+    assert (stack.get_top() == &items[3] and stack.pop() == &items[3]);
+    assert (stack.erase(items[1]) == SUCCESS and stack.pop() == &items[2] and stack.pop() == &items[0]);
+    assert (stack.is_empty());
+
+    printf("[SUCCESS] IntrusiveQueue enqueue(), dequeue(); IntrusiveStack push(), pop()\n");
+}
+
+void IntrusiveTest::test_multiple_lists()
+{
+    intrusive_item_t items[16];
+    item_list all;
+    item_queue ready;
+    item_stack undo;
+    int i;
+
+    for (i = 0; i < 16; i++)
+    {
+        items[i].val = i;
+        items[i].name = "item" + to_string(i);
+        all.push_back(items[i]);
+        if (i % 2 == 0)
+        {
+            ready.enqueue(items[i]);
+        }
+        if (i % 4 == 0)
+        {
+            undo.push(items[i]);
+        }
+    }
+    assert (all.get_size() == 16 and ready.get_size() == 8 and undo.get_size() == 4);
+
+    // leaving one container keeps an element in the others
+    assert (ready.erase(items[4]) == SUCCESS);
+    assert (items[4].all.is_linked() and items[4].undo.is_linked() and !items[4].ready.is_linked());
+    assert (all.erase(items[8]) == SUCCESS and items[8].ready.is_linked());
+
+    for (i = 0; i < 7; i++)
+    {
+        assert (ready.dequeue()->val == (i < 2 ? 2 * i : 2 * i + 2));
+    }
+    assert (undo.pop()->name == "item12" and all.get_size() == 15);
+
+    // elements leave containers destroyed before them
+    assert (all.erase(items[0]) == SUCCESS);
+    {
+        item_list scoped;
+        assert (scoped.push_back(items[0]) == SUCCESS and all.push_back(items[0]) == ERROR_EXISTS);
+    }
+    assert (!items[0].all.is_linked() and all.push_back(items[0]) == SUCCESS);
+
+    printf("[SUCCESS] Intrusive elements in several containers at once\n");
+}
+
+void cpp_test_intrusive_main()
+{
+    printf("\n=== Intrusive containers test ===\n");
+
+    IntrusiveTest *intrusive_test = new IntrusiveTest();
+    intrusive_test->test_main();
+    delete(intrusive_test);
+}
@@ -9,6 +9,9 @@
  */
 
 #include <cassert>
+#include <algorithm>
+#include <numeric>
+#include <vector>
 
 #include "common/include/node.h"
 #include "common/include/err.h"
@@ -34,6 +37,10 @@ void TestLinkList::test_main()
     this->test_insert();
     this->test_delete();
     this->test_pop();
+    this->test_sort();
+    this->test_splice();
+    this->test_batch();
+    this->test_iterator();
 }
 
 void TestLinkList::test_common()
@@ -264,6 +271,293 @@ void TestLinkList::test_pop()
     printf("[SUCCESS] Linklist pop[pop_first(), pop_last()]\n");
 }
 
+void TestLinkList::test_sort()
+{
+    cshark_linklist_t *llt;
+    cshark_node_t *nt;
+    LinkList *empty_list;
+    LinkList *big_list;
+    size_t i, n;
+
+    empty_list = new LinkList(0);
+    big_list = new LinkList(0);
+
+    assert (empty_list->sort() == SUCCESS and empty_list->get_first() == NULL);
+
+    // a permutation of 0, 1, ..., n-1 (7919 is a prime not dividing n)
+    for (i = 0; i < this->n_big; i++)
+    {
+        big_list->insert_val((int)((i * 7919) % this->n_big));
+    }
+    assert (big_list->sort() == SUCCESS);
+
+    n = 0;
+    for (nt = big_list->get_first(); nt != NULL; nt = nt->next)
+    {
+        assert (nt->val == (int)n and nt->prev->next == nt);
+        n++;
+    }
+    assert (n == this->n_big and big_list->get_last()->val == (int)(this->n_big - 1));
+    assert (big_list->sort_by(NULL) == ERROR_PARAM);
+
+    // stable sort by val keeps the order of names, then by name
+    llt = cshark_linkist_allocate();
+    for (i = 0; i < this->n_big; i++)
+    {
+        cshark_linklist_add_vals(llt, (int)(i % 3), to_string(this->n_big + i));
+    }
+    assert (cshark_linklist_sort_by(llt, cshark_node_less_val) == SUCCESS);
+
+    for (nt = llt->head->next; nt->next != NULL; nt = nt->next)
+    {
+        assert (nt->val < nt->next->val or (nt->val == nt->next->val and nt->name < nt->next->name));
+        assert (nt->next->prev == nt);
+    }
+    assert (llt->last == nt and llt->first == llt->head->next);
+
+    assert (cshark_linklist_sort_by(llt, cshark_node_less_name) == SUCCESS);
+    for (nt = llt->head->next, i = 0; nt != NULL; nt = nt->next, i++)
+    {
+        assert (nt->name == to_string(this->n_big + i));
+    }
+
+    assert (cshark_linklist_sort(NULL) == ERROR_PARAM);
+    assert (cshark_linklist_sort_by(llt, NULL) == ERROR_PARAM);
+
+    cshark_linklist_destroy(llt);
+    delete(empty_list);
+    delete(big_list);
+
+    printf("[SUCCESS] Linklist sort[sort(), sort_by(), cshark_linklist_sort()]\n");
+}
+
+/**
+ * Check a linklist against expected values, walking both directions
+ */
+static void check_linklist(LinkList *list, const vector<int> &vals)
+{
+    cshark_node_t *nt;
+    size_t i;
+
+    assert (list->get_size() == vals.size());
+
+    i = 0;
+    for (nt = list->get_first(); nt != NULL; nt = nt->next, i++)
+    {
+        assert (i < vals.size() and nt->val == vals[i]);
+        assert (nt->next == NULL or nt->next->prev == nt);
+    }
+    assert (i == vals.size());
+
+    nt = list->get_last();
+    assert ((vals.empty() and nt == NULL) or (nt != NULL and nt->next == NULL and nt->val == vals.back()));
+}
+
+void TestLinkList::test_splice()
+{
+    cshark_linklist_t *llt;
+    cshark_linklist_t *src;
+    cshark_node_t *nt;
+    LinkList *a;
+    LinkList *b;
+    int v;
+    size_t i;
+
+    a = new LinkList(3);    // 0, 1, 2
+    b = new LinkList(0);
+    for (i = 0; i < 3; i++)
+    {
+        b->insert_val((int)(10 + i));
+    }
+
+    // concat empties b, and the tail of a is maintained
+    assert (a->concat(b) == SUCCESS);
+    check_linklist(a, {0, 1, 2, 10, 11, 12});
+    check_linklist(b, {});
+    assert (a->insert_val(13) == SUCCESS);
+    check_linklist(a, {0, 1, 2, 10, 11, 12, 13});
+
+    // split at 10 moves 10...13 to b
+    assert (a->split(a->find_by_val(10), b) == SUCCESS);
+    check_linklist(a, {0, 1, 2});
+    check_linklist(b, {10, 11, 12, 13});
+
+    // splice in the middle and in front
+    assert (a->splice(a->find_by_val(0), b) == SUCCESS);
+    check_linklist(a, {0, 10, 11, 12, 13, 1, 2});
+    b->insert_val(20);
+    assert (a->splice(NULL, b) == SUCCESS);
+    check_linklist(a, {20, 0, 10, 11, 12, 13, 1, 2});
+
+    // move a range within a list, to the tail, and to another list
+    assert (a->move_range(a->get_last(), a, a->find_by_val(10), a->find_by_val(12)) == SUCCESS);
+    check_linklist(a, {20, 0, 13, 1, 2, 10, 11, 12});
+    assert (b->move_range(NULL, a, a->find_by_val(11), a->get_last()) == SUCCESS);
+    check_linklist(a, {20, 0, 13, 1, 2, 10});
+    check_linklist(b, {11, 12});
+    assert (a->move_range(NULL, a, a->get_last(), a->get_last()) == SUCCESS);
+    check_linklist(a, {10, 20, 0, 13, 1, 2});
+
+    // bookkeeping still holds for pop and delete
+    nt = a->pop_last();
+    assert (nt->val == 2);
+    delete(nt);
+    assert (a->delete_last() == SUCCESS);
+    check_linklist(a, {10, 20, 0, 13});
+
+    assert (a->splice(NULL, a) == ERROR_PARAM and a->split(NULL, b) == ERROR_PARAM);
+    assert (a->concat(NULL) == ERROR_PARAM);
+
+    delete(a);
+    delete(b);
+
+    // C functions
+    llt = cshark_linklist_init(3);  // 1, 2, 3
+    src = cshark_linklist_init(2);  // 1, 2
+
+    assert (cshark_linklist_concat(llt, src) == SUCCESS);
+    assert (cshark_linklist_getsize(llt) == 5 and cshark_linklist_getsize(src) == 0);
+    assert (src->head->next == NULL and src->last == src->head and src->first == NULL);
+    assert (llt->last->val == 2 and llt->last->prev->val == 1 and llt->first == llt->head->next);
+
+    assert (cshark_linklist_split(llt, cshark_linklist_find_pos(llt, 4), src) == SUCCESS);
+    assert (cshark_linklist_getsize(llt) == 3 and llt->last->val == 3 and llt->last->next == NULL);
+    assert (cshark_linklist_getsize(src) == 2 and src->first->val == 1 and src->last->val == 2);
+
+    assert (cshark_linklist_splice(llt, NULL, src) == SUCCESS);
+    assert (llt->first->val == 1 and llt->first->next->val == 2 and llt->first->next->next->val == 1);
+    assert (cshark_linklist_getsize(llt) == 5 and llt->last->val == 3);
+
+    assert (cshark_linklist_move_range(src, NULL, llt, llt->first, llt->first->next) == SUCCESS);
+    assert (cshark_linklist_getsize(llt) == 3 and cshark_linklist_getsize(src) == 2);
+    assert (cshark_linklist_delete_last(llt, &v) == SUCCESS and v == 3 and llt->last->val == 2);
+    assert (cshark_linklist_reverse(llt) == SUCCESS and llt->first->val == 2 and llt->last->val == 1);
+
+    assert (cshark_linklist_concat(llt, llt) == ERROR_PARAM);
+    assert (cshark_linklist_split(llt, llt->head, src) == ERROR_PARAM);
+
+    // deleting the last nodes one by one leaves an empty list ending at the root
+    while (cshark_linklist_delete_last(llt, &v) == SUCCESS)
+    {
+    }
+    assert (v == 2 and cshark_linklist_getsize(llt) == 0 and llt->first == NULL and llt->last == llt->head);
+
+    cshark_linklist_destroy(llt);
+    cshark_linklist_destroy(src);
+
+    printf("[SUCCESS] Linklist splice[splice(), concat(), split(), move_range()]\n");
+}
+
+void TestLinkList::test_batch()
+{
+    cshark_linklist_t *llt;
+    LinkList *list;
+    vector<int> vals, many;
+    int out[4];
+    size_t i;
+
+    for (i = 0; i < this->n_small; i++)
+    {
+        vals.push_back((int)i);
+    }
+
+    list = new LinkList(0);
+    assert (list->insert_vals(vals.data(), vals.size()) == SUCCESS);
+    assert (list->insert_range(vals.begin(), vals.begin() + 2) == SUCCESS);
+    vals.push_back(0);
+    vals.push_back(1);
+    check_linklist(list, vals);
+
+    assert (list->pop_first_batch(out, 3) == 3 and out[0] == 0 and out[2] == 2);
+    assert (list->pop_last_batch(out, 3) == 3 and out[0] == 1 and out[1] == 0 and out[2] == (int)(this->n_small - 1));
+    vals.erase(vals.begin(), vals.begin() + 3);
+    vals.resize(vals.size() - 3);
+    check_linklist(list, vals);
+
+    assert (list->pop_last_batch(out, 0) == 0 and list->pop_first_batch(NULL, 1) == 0);
+    while (list->pop_last_batch(out, 4) > 0)
+    {
+    }
+    check_linklist(list, {});
+    list->insert_val(5);
+    check_linklist(list, {5});
+
+    // batches are limited to MAX_NODES as one by one inserts are, and a rejected batch adds nothing
+    many.assign(MAX_NODES, 0);
+    assert (list->insert_vals(many.data(), many.size()) == ERROR_MAX_NODES and list->get_size() == 1);
+    assert (list->insert_range(many.begin(), many.end() - 1) == SUCCESS and list->get_size() == MAX_NODES);
+    assert (list->insert_range(vals.begin(), vals.begin() + 1) == ERROR_MAX_NODES);
+    assert (list->insert_vals(vals.data(), 0) == SUCCESS and list->get_size() == MAX_NODES);
+    delete(list);
+
+    llt = cshark_linkist_allocate();
+    assert (cshark_linklist_add_batch(llt, vals.data(), vals.size()) == SUCCESS);
+    assert (cshark_linklist_getsize(llt) == vals.size() and llt->last->val == vals.back());
+    assert (cshark_linklist_add_batch(llt, NULL, 1) == ERROR_PARAM);
+    assert (cshark_linklist_add_batch(llt, vals.data(), MAX_NODES) == ERROR_MAX_NODES);
+    assert (cshark_linklist_delete_first_batch(llt, out, 2) == 2 and out[1] == vals[1]);
+    assert (llt->first->val == vals[2] and llt->first->prev == llt->head);
+    assert (cshark_linklist_delete_first_batch(llt, out, 0) == 0);
+    cshark_linklist_destroy(llt);
+
+    printf("[SUCCESS] Linklist batch[insert_vals(), insert_range(), pop_first_batch(), pop_last_batch()]\n");
+}
+
+void TestLinkList::test_iterator()
+{
+    LinkList *list;
+    LinkList::iterator it;
+    LinkList::reverse_iterator rit;
+    vector<int> vals;
+    size_t i;
+    int sum;
+
+    list = new LinkList(0);
+    assert (list->begin() == list->end() and list->rbegin() == list->rend());
+
+    for (i = 0; i < this->n_big; i++)
+    {
+        list->insert_val((int)i);
+    }
+
+    // range-for, and changing nodes through references
+    sum = 0;
+    for (cshark_node_t &nt : *list)
+    {
+        sum += nt.val;
+        nt.val *= 2;
+    }
+    assert (sum == (int)(this->n_big * (this->n_big - 1) / 2));
+
+    // <algorithm> and <numeric> on const iterators
+    const LinkList *clist = list;
+    assert (count_if(clist->begin(), clist->end(), [](const cshark_node_t &nt) { return nt.val % 4 == 0; })
+            == (long)((this->n_big + 1) / 2));
+    assert (accumulate(clist->begin(), clist->end(), 0, [](int s, const cshark_node_t &nt) { return s + nt.val; })
+            == 2 * sum);
+    assert ((size_t)distance(clist->begin(), clist->end()) == this->n_big);
+
+    it = find_if(list->begin(), list->end(), [](const cshark_node_t &nt) { return nt.val == 20; });
+    assert (it != list->end() and it->val == 20 and (++it)->val == 22 and (--it)->val == 20);
+
+    // --end() is the last node, also after the list grows
+    it = list->end();
+    list->insert_val(-1);
+    assert ((--it)->val == -1);
+
+    // reverse iteration
+    for (rit = list->rbegin(); rit != list->rend(); ++rit)
+    {
+        vals.push_back(rit->val);
+    }
+    assert (vals.size() == this->n_big + 1 and vals[0] == -1 and vals.back() == 0);
+    assert (is_sorted(vals.begin() + 1, vals.end(), greater<int>()));
+
+    delete(list);
+
+    printf("[SUCCESS] Linklist iterator[begin(), end(), rbegin(), rend()]\n");
+}
+
 /**
  * Linklist test entrance function
  */
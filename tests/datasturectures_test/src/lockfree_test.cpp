@@ -0,0 +1,398 @@
+/*
+ ============================================================================
+ Name        : lockfree_test.cpp
+ Description : lock-free containers test implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#include <assert.h>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/include/err.h"
+#include "datasturectures_test/include/lockfree_test.h"
+
+#define LOCKFREE_TEST_THREADS   4
+#define LOCKFREE_TEST_VALUES    20000       // values per producer
+
+LockFreeTest::LockFreeTest()
+{
+}
+
+LockFreeTest::~LockFreeTest()
+{
+
+}
+
+void LockFreeTest::test_main()
+{
+    this->test_queue();
+    this->test_queue_threads();
+    this->test_stack();
+    this->test_stack_threads();
+    this->test_hashtable();
+    this->test_hashtable_threads();
+}
+
+void LockFreeTest::test_queue()
+{
+    LockFreeQueue queue;
+    cshark_node_t *nt;
+    int val;
+    int i;
+
+    assert (queue.is_empty());
+    assert (queue.dequeue(&val) == ERROR_TARGET_EMPTY);
+    assert (queue.dequeue(NULL) == ERROR_PARAM);
+    assert (queue.enqueue((cshark_node_t *)NULL) == ERROR_PARAM);
+
+    for (i = 0; i < 100; i++)
+    {
+        assert (queue.enqueue(i) == SUCCESS);
+    }
+    nt = cshark_node_init();
+    nt->val = 100;
+    assert (queue.enqueue(nt) == SUCCESS);
+    assert (!queue.is_empty());
+
+    for (i = 0; i <= 100; i++)
+    {
+        assert (queue.dequeue(&val) == SUCCESS and val == i);
+    }
+    assert (queue.is_empty());
+    assert (queue.dequeue(&val) == ERROR_TARGET_EMPTY);
+
+    // nodes left in the queue are freed by the destructor
+    queue.enqueue(1);
+    queue.enqueue(2);
+
+    printf("[SUCCESS] LockFreeQueue enqueue(), dequeue()\n");
+}
+
+/**
+ * Producers and consumers share a queue; every value is dequeued once, and values of
+ * one producer come out in the order they were enqueued
+ */
+void LockFreeTest::test_queue_threads()
+{
+    EpochDomain domain;
+    LockFreeQueue queue(&domain);
+    vector<thread> threads;
+    vector<vector<int>> got(LOCKFREE_TEST_THREADS);
+    atomic<size_t> remaining(LOCKFREE_TEST_THREADS * LOCKFREE_TEST_VALUES);
+    vector<bool> seen(LOCKFREE_TEST_THREADS * LOCKFREE_TEST_VALUES, false);
+    size_t i, k;
+    int val, p;
+
+    for (i = 0; i < LOCKFREE_TEST_THREADS; i++)
+    {
+        threads.push_back(thread([&queue, i]() {
+            int k;
+
+            for (k = 0; k < LOCKFREE_TEST_VALUES; k++)
+            {
+                queue.enqueue((int)(i * LOCKFREE_TEST_VALUES + k));
+            }
+        }));
+
+        threads.push_back(thread([&queue, &got, &remaining, i]() {
+            int v;
+
+            while (remaining.load() > 0)
+            {
+                if (queue.dequeue(&v) == SUCCESS)
+                {
+                    got[i].push_back(v);
+                    remaining.fetch_sub(1);
+                }
+            }
+        }));
+    }
+
+    for (i = 0; i < threads.size(); i++)
+    {
+        threads[i].join();
+    }
+
+    assert (queue.is_empty());
+
+    for (i = 0; i < LOCKFREE_TEST_THREADS; i++)
+    {
+        // a consumer sees values of each producer in increasing order
+        vector<int> prev(LOCKFREE_TEST_THREADS, -1);
+
+        for (k = 0; k < got[i].size(); k++)
+        {
+            val = got[i][k];
+            p = val / LOCKFREE_TEST_VALUES;
+            assert (val > prev[p] and !seen[val]);
+            prev[p] = val;
+            seen[val] = true;
+        }
+    }
+
+    k = 0;
+    for (i = 0; i < LOCKFREE_TEST_THREADS; i++)
+    {
+        k += got[i].size();
+    }
+    assert (k == LOCKFREE_TEST_THREADS * LOCKFREE_TEST_VALUES);
+
+    printf("[SUCCESS] LockFreeQueue with %d producers and %d consumers\n",
+           LOCKFREE_TEST_THREADS, LOCKFREE_TEST_THREADS);
+}
+
+void LockFreeTest::test_stack()
+{
+    LockFreeStack stack;
+    cshark_node_t *nt;
+    int val;
+    int i;
+
+    assert (stack.is_empty());
+    assert (stack.pop(&val) == ERROR_TARGET_EMPTY);
+    assert (stack.pop() == NULL);
+    assert (stack.get_top(&val) == ERROR_TARGET_EMPTY);
+    assert (stack.pop(NULL) == ERROR_PARAM and stack.get_top(NULL) == ERROR_PARAM);
+    assert (stack.push((cshark_node_t *)NULL) == ERROR_PARAM);
+
+    for (i = 0; i < 100; i++)
+    {
+        assert (stack.push(i) == SUCCESS);
+        assert (stack.get_top(&val) == SUCCESS and val == i);
+    }
+
+    nt = cshark_node_init();
+    nt->val = 100;
+    nt->name = "top";
+    assert (stack.push(nt) == SUCCESS);
+
+    // pop() returns a node the caller owns, with the value and name of the top
+    nt = stack.pop();
+    assert (nt != NULL and nt->val == 100 and nt->name == "top");
+    cshark_node_free(nt);
+
+    for (i = 99; i >= 50; i--)
+    {
+        assert (stack.pop(&val) == SUCCESS and val == i);
+    }
+    assert (!stack.is_empty());
+
+    // nodes left in the stack are freed by the destructor
+    printf("[SUCCESS] LockFreeStack push(), pop(), get_top()\n");
+}
+
+/**
+ * Threads push and pop concurrently, which also exercises elimination;
+ * every value pushed is popped exactly once
+ */
+void LockFreeTest::test_stack_threads()
+{
+    EpochDomain domain;
+    LockFreeStack stack(&domain);
+    vector<thread> threads;
+    vector<vector<int>> got(LOCKFREE_TEST_THREADS * 2);
+    vector<bool> seen(LOCKFREE_TEST_THREADS * LOCKFREE_TEST_VALUES, false);
+    atomic<size_t> remaining(LOCKFREE_TEST_THREADS * LOCKFREE_TEST_VALUES);
+    cshark_node_t *nt;
+    size_t i, k;
+    int val;
+
+    for (i = 0; i < LOCKFREE_TEST_THREADS; i++)
+    {
+        threads.push_back(thread([&stack, &got, &remaining, i]() {
+            int k, v;
+
+            // mixing pops into the pushes keeps the stack near empty, where threads collide
+            for (k = 0; k < LOCKFREE_TEST_VALUES; k++)
+            {
+                stack.push((int)(i * LOCKFREE_TEST_VALUES + k));
+                if (k % 2 == 0 and stack.pop(&v) == SUCCESS)
+                {
+                    got[i].push_back(v);
+                    remaining.fetch_sub(1);
+                }
+            }
+        }));
+
+        threads.push_back(thread([&stack, &got, &remaining, i]() {
+            cshark_node_t *nt;
+
+            while (remaining.load() > 0)
+            {
+                nt = stack.pop();
+                if (nt != NULL)
+                {
+                    got[LOCKFREE_TEST_THREADS + i].push_back(nt->val);
+                    remaining.fetch_sub(1);
+                    cshark_node_free(nt);
+                }
+            }
+        }));
+    }
+
+    for (i = 0; i < threads.size(); i++)
+    {
+        threads[i].join();
+    }
+
+    assert (stack.is_empty());
+
+    for (i = 0; i < got.size(); i++)
+    {
+        for (k = 0; k < got[i].size(); k++)
+        {
+            val = got[i][k];
+            assert (val >= 0 and val < LOCKFREE_TEST_THREADS * LOCKFREE_TEST_VALUES and !seen[val]);
+            seen[val] = true;
+        }
+    }
+
+    // the stack keeps working after the threads have gone
+    stack.push(1);
+    nt = stack.pop();
+    assert (nt != NULL and nt->val == 1);
+    cshark_node_free(nt);
+
+    printf("[SUCCESS] LockFreeStack with %d threads pushing and popping\n", LOCKFREE_TEST_THREADS * 2);
+}
+
+void LockFreeTest::test_hashtable()
+{
+    EpochDomain domain;
+    lockfree_hashtable_t *ht;
+    set<int> model;
+    uint64_t x = 88172645463325252ULL;
+    int i, key;
+
+    ht = lockfree_hashtable_init(&domain);
+    assert (lockfree_hashtable_getsize(ht) == 0 and lockfree_hashtable_get_buckets(ht) == 2);
+    assert (lockfree_hashtable_find(ht, 1) == HASH_NOT_FOUND and !lockfree_hashtable_contains(ht, 1));
+    assert (lockfree_hashtable_delete(ht, 1) == ERROR_NOT_FOUND);
+
+    assert (lockfree_hashtable_add(ht, 5, "name5") == SUCCESS);
+    assert (lockfree_hashtable_add(ht, 5, "other") == ERROR_EXISTS);
+    assert (lockfree_hashtable_find(ht, 5) == "name5");
+    assert (lockfree_hashtable_add(ht, -5, "minus") == SUCCESS and lockfree_hashtable_find(ht, -5) == "minus");
+    assert (lockfree_hashtable_delete(ht, 5) == SUCCESS and lockfree_hashtable_delete(ht, 5) == ERROR_NOT_FOUND);
+    assert (lockfree_hashtable_add(ht, 5, "again") == SUCCESS and lockfree_hashtable_find(ht, 5) == "again");
+    lockfree_hashtable_delete(ht, 5);
+    lockfree_hashtable_delete(ht, -5);
+
+    // random adds and deletes against a set, while the buckets double
+    for (i = 0; i < 50000; i++)
+    {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        key = (int)(x % 20000) - 10000;
+        if (x % 3 == 0)
+        {
+            assert ((lockfree_hashtable_delete(ht, key) == SUCCESS) == (model.erase(key) == 1));
+        }
+        else
+        {
+            assert ((lockfree_hashtable_add(ht, key, to_string(key)) == SUCCESS) == model.insert(key).second);
+        }
+    }
+
+    assert (lockfree_hashtable_getsize(ht) == model.size());
+    assert (lockfree_hashtable_get_buckets(ht) >= model.size() / LFHT_LOAD_FACTOR);
+    for (key = -10000; key < 10000; key++)
+    {
+        assert (lockfree_hashtable_contains(ht, key) == (model.count(key) == 1));
+        if (model.count(key) == 1)
+        {
+            assert (lockfree_hashtable_find(ht, key) == to_string(key));
+        }
+    }
+
+    assert (lockfree_hashtable_destroy(ht) == SUCCESS and lockfree_hashtable_destroy(NULL) == ERROR_PARAM);
+    domain.reclaim();
+
+    printf("[SUCCESS] lockfree_hashtable add(), find(), delete(), growing from 2 buckets\n");
+}
+
+/**
+ * Threads add disjoint keys while the table grows, then delete half of them while others look
+ * keys up; each key is added and deleted exactly once
+ */
+void LockFreeTest::test_hashtable_threads()
+{
+    EpochDomain domain;
+    lockfree_hashtable_t *ht;
+    vector<thread> threads;
+    size_t i;
+    int key;
+
+    ht = lockfree_hashtable_init(&domain);
+
+    for (i = 0; i < LOCKFREE_TEST_THREADS; i++)
+    {
+        threads.push_back(thread([ht, i]() {
+            int k;
+
+            for (k = 0; k < LOCKFREE_TEST_VALUES; k++)
+            {
+                assert (lockfree_hashtable_add(ht, (int)(k * LOCKFREE_TEST_THREADS + i), to_string(k)) == SUCCESS);
+            }
+        }));
+    }
+
+    for (i = 0; i < threads.size(); i++)
+    {
+        threads[i].join();
+    }
+    threads.clear();
+
+    assert (lockfree_hashtable_getsize(ht) == LOCKFREE_TEST_THREADS * LOCKFREE_TEST_VALUES);
+
+    for (i = 0; i < LOCKFREE_TEST_THREADS; i++)
+    {
+        threads.push_back(thread([ht, i]() {
+            int k;
+
+            for (k = 0; k < LOCKFREE_TEST_VALUES; k++)
+            {
+                if (i % 2 == 0)
+                {
+                    // every thread deletes odd keys, which race between threads
+                    lockfree_hashtable_delete(ht, 2 * k + 1);
+                }
+                else
+                {
+                    assert (lockfree_hashtable_contains(ht, 2 * k));
+                }
+            }
+        }));
+    }
+
+    for (i = 0; i < threads.size(); i++)
+    {
+        threads[i].join();
+    }
+
+    for (key = 0; key < LOCKFREE_TEST_THREADS * LOCKFREE_TEST_VALUES; key++)
+    {
+        assert (lockfree_hashtable_contains(ht, key) == (key % 2 == 0 or key >= 2 * LOCKFREE_TEST_VALUES));
+    }
+    assert (lockfree_hashtable_getsize(ht) == (LOCKFREE_TEST_THREADS - 1) * LOCKFREE_TEST_VALUES);
+
+    lockfree_hashtable_destroy(ht);
+
+    printf("[SUCCESS] lockfree_hashtable with %d threads adding, deleting and finding\n", LOCKFREE_TEST_THREADS);
+}
+
+void cpp_test_lockfree_main()
+{
+    printf("\n=== Lock-free containers test ===\n");
+
+    LockFreeTest *lockfree_test = new LockFreeTest();
+    lockfree_test->test_main();
+    delete(lockfree_test);
+}
@@ -0,0 +1,182 @@
+/*
+ ============================================================================
+ Name        : perfect_hashtable_test.cpp
+ Description : minimal perfect hash and static hash table test implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#include <assert.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "common/include/err.h"
+#include "datasturectures_test/include/perfect_hashtable_test.h"
+
+PerfectHashTableTest::PerfectHashTableTest()
+{
+}
+
+PerfectHashTableTest::~PerfectHashTableTest()
+{
+
+}
+
+void PerfectHashTableTest::test_main()
+{
+    this->test_mphf();
+    this->test_find();
+    this->test_save_load();
+}
+
+/**
+ * Keys of many set sizes map to distinct indexes in [0, n)
+ */
+void PerfectHashTableTest::test_mphf()
+{
+    size_t sizes[] = {1, 2, 3, 10, 100, 1000, 100000};
+    vector<int> keys;
+    vector<bool> seen;
+    mphf_t *f;
+    size_t i, s, idx;
+    uint32_t x = 2463534242u;
+
+    for (s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+    {
+        // consecutive keys, then random ones including negative keys
+        keys.clear();
+        for (i = 0; i < sizes[s]; i++)
+        {
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            keys.push_back(s % 2 == 0 ? (int)i : (int)(x & 0xfffffff0) - (int)i);
+        }
+
+        f = mphf_build(keys.data(), keys.size());
+        assert (f != NULL);
+
+        seen.assign(sizes[s], false);
+        for (i = 0; i < sizes[s]; i++)
+        {
+            idx = mphf_lookup(f, keys[i]);
+            assert (idx < sizes[s] and !seen[idx]);
+            seen[idx] = true;
+        }
+        mphf_destroy(f);
+    }
+
+    // the function of 100000 keys takes a few bits per key
+    f = mphf_build(keys.data(), keys.size());
+    assert (mphf_get_bits(f) < 8 * keys.size());
+    mphf_destroy(f);
+
+    keys[5] = keys[7];
+    assert (mphf_build(keys.data(), keys.size()) == NULL);
+    assert (mphf_build(keys.data(), 0) == NULL and mphf_build(NULL, 1) == NULL);
+
+    printf("[SUCCESS] mphf_build(), mphf_lookup()\n");
+}
+
+void PerfectHashTableTest::test_find()
+{
+    perfect_hashtable_t *t;
+    vector<int> keys;
+    vector<string> values;
+    const char *v;
+    size_t i, len;
+
+    for (i = 0; i < 5000; i++)
+    {
+        keys.push_back((int)(i * 7));
+        values.push_back(i % 10 == 0 ? string() : "value" + to_string(i));
+    }
+
+    t = perfect_hashtable_build(keys.data(), values.data(), keys.size());
+    assert (t != NULL and perfect_hashtable_getsize(t) == 5000);
+
+    for (i = 0; i < 5000; i++)
+    {
+        v = perfect_hashtable_find(t, (int)(i * 7), &len);
+        assert (v != NULL and string(v, len) == values[i]);
+        assert (perfect_hashtable_contains(t, (int)(i * 7)));
+
+        // keys outside the set map to some index, and its key does not match
+        assert (perfect_hashtable_find(t, (int)(i * 7 + 1), &len) == NULL);
+        assert (!perfect_hashtable_contains(t, -(int)i - 1));
+    }
+    perfect_hashtable_destroy(t);
+
+    keys[1] = keys[0];
+    assert (perfect_hashtable_build(keys.data(), values.data(), keys.size()) == NULL);
+
+    printf("[SUCCESS] perfect_hashtable_build(), find(), contains()\n");
+}
+
+/**
+ * A saved table loads back with the same entries; damaged buffers are rejected
+ */
+void PerfectHashTableTest::test_save_load()
+{
+    perfect_hashtable_t *t, *loaded;
+    vector<int> keys;
+    vector<string> values;
+    string buf, damaged;
+    const char *v;
+    size_t i, len;
+
+    for (i = 0; i < 1000; i++)
+    {
+        keys.push_back((int)(i * 2654435761u));
+        values.push_back(string(i % 17, 'a' + i % 26));
+    }
+
+    t = perfect_hashtable_build(keys.data(), values.data(), keys.size());
+    assert (perfect_hashtable_save(t, &buf) == SUCCESS);
+
+    loaded = perfect_hashtable_load(buf.data(), buf.size());
+    assert (loaded != NULL and perfect_hashtable_getsize(loaded) == 1000);
+    assert (perfect_hashtable_get_memory(loaded) == perfect_hashtable_get_memory(t));
+    for (i = 0; i < 1000; i++)
+    {
+        v = perfect_hashtable_find(loaded, keys[i], &len);
+        assert (v != NULL and string(v, len) == values[i]);
+    }
+    assert (!perfect_hashtable_contains(loaded, 1));
+    perfect_hashtable_destroy(loaded);
+
+    // every truncation, and a byte too many
+    for (i = 0; i < buf.size(); i++)
+    {
+        assert (perfect_hashtable_load(buf.data(), i) == NULL);
+    }
+    damaged = buf + "x";
+    assert (perfect_hashtable_load(damaged.data(), damaged.size()) == NULL);
+
+    // a wrong magic, an empty table and a huge key count
+    damaged = buf;
+    damaged[0] ^= 1;
+    assert (perfect_hashtable_load(damaged.data(), damaged.size()) == NULL);
+    damaged = buf;
+    memset(&damaged[16], 0, 8);
+    assert (perfect_hashtable_load(damaged.data(), damaged.size()) == NULL);
+    memset(&damaged[16], 0x7f, 8);
+    assert (perfect_hashtable_load(damaged.data(), damaged.size()) == NULL);
+    assert (perfect_hashtable_load(NULL, 0) == NULL and perfect_hashtable_save(t, NULL) == ERROR_PARAM);
+
+    perfect_hashtable_destroy(t);
+
+    printf("[SUCCESS] perfect_hashtable_save(), load()\n");
+}
+
+void cpp_test_perfect_hashtable_main()
+{
+    printf("\n=== Perfect hash table test ===\n");
+
+    PerfectHashTableTest *perfect_hashtable_test = new PerfectHashTableTest();
+    perfect_hashtable_test->test_main();
+    delete(perfect_hashtable_test);
+}
@@ -0,0 +1,278 @@
+/*
+ ============================================================================
+ Name        : persistent_test.cpp
+ Description : persistent list and tree test implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <map>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "common/include/err.h"
+#include "datastructures/include/persistent.h"
+#include "datasturectures_test/include/persistent_test.h"
+
+PersistentTest::PersistentTest()
+{
+}
+
+PersistentTest::~PersistentTest()
+{
+}
+
+void PersistentTest::test_main()
+{
+    this->test_list();
+    this->test_tree();
+    this->test_snapshot_threads();
+}
+
+/**
+ * Check a list version against expected values
+ */
+static void check_plist(const PersistentList &list, const vector<int> &vals)
+{
+    size_t i;
+
+    assert (list.get_size() == vals.size());
+
+    i = 0;
+    for (const cshark_plist_node_t &nt : list)
+    {
+        assert (i < vals.size() and nt.val == vals[i]);
+        i++;
+    }
+    assert (i == vals.size());
+}
+
+/**
+ * Check a tree version against expected keys and names, in key order
+ */
+static void check_ptree(const PersistentTree &tree, const map<int, string> &kv)
+{
+    map<int, string>::const_iterator it;
+
+    assert (tree.get_size() == kv.size());
+
+    it = kv.begin();
+    for (const cshark_ptree_node_t &nt : tree)
+    {
+        assert (it != kv.end() and nt.key == it->first and nt.name == it->second);
+        ++it;
+    }
+    assert (it == kv.end());
+}
+
+void PersistentTest::test_list()
+{
+    PersistentList list;
+    PersistentList snap;
+    vector<PersistentList> versions;
+    vector<vector<int>> expected;
+    vector<int> vals;
+    mt19937 rng(7);
+    size_t i, pos;
+    int op;
+
+    assert (list.is_empty() and list.pop_front() == ERROR_TARGET_EMPTY);
+    assert (list.set(0, 1) == ERROR_PARAM and list.insert(1, 1) == ERROR_PARAM and list.erase(0) == ERROR_PARAM);
+
+    for (i = 0; i < 1000; i++)
+    {
+        list.push_front((int)(999 - i));
+        vals.push_back((int)i);
+    }
+    check_plist(list, vals);
+
+    // a change at position 5 copies 6 nodes, and the rest is shared
+    snap = list.snapshot();
+    assert (list.set(5, -5) == SUCCESS);
+    assert (snap.find_by_pos(5)->val == 5 and list.find_by_pos(5)->val == -5);
+    assert (snap.find_by_pos(4) != list.find_by_pos(4) and snap.find_by_pos(6) == list.find_by_pos(6));
+
+    // without snapshots, changes are made in place
+    snap.clear();
+    assert (list.set(5, 5) == SUCCESS);
+    const cshark_plist_node_t *first = list.get_first();
+    assert (list.set(0, 100) == SUCCESS and list.get_first() == first);
+    list.set(0, 0);
+    check_plist(list, vals);
+
+    // random changes, keeping a snapshot of every 50th version
+    for (i = 0; i < 2000; i++)
+    {
+        op = (int)(rng() % 4);
+        pos = vals.empty() ? 0 : rng() % vals.size();
+
+        if (op == 0 or vals.empty())
+        {
+            pos = rng() % (vals.size() + 1);
+            assert (list.insert(pos, (int)i) == SUCCESS);
+            vals.insert(vals.begin() + pos, (int)i);
+        }
+        else if (op == 1)
+        {
+            assert (list.erase(pos) == SUCCESS);
+            vals.erase(vals.begin() + pos);
+        }
+        else if (op == 2)
+        {
+            assert (list.set(pos, -(int)i) == SUCCESS);
+            vals[pos] = -(int)i;
+        }
+        else
+        {
+            assert (list.pop_front() == SUCCESS);
+            vals.erase(vals.begin());
+        }
+
+        if (i % 50 == 0)
+        {
+            versions.push_back(list.snapshot());
+            expected.push_back(vals);
+        }
+    }
+
+    check_plist(list, vals);
+    for (i = 0; i < versions.size(); i++)
+    {
+        check_plist(versions[i], expected[i]);
+    }
+
+    printf("[SUCCESS] PersistentList snapshot(), push_front(), pop_front(), set(), insert(), erase()\n");
+}
+
+void PersistentTest::test_tree()
+{
+    PersistentTree tree;
+    PersistentTree snap;
+    vector<PersistentTree> versions;
+    vector<map<int, string>> expected;
+    map<int, string> kv;
+    mt19937 rng(11);
+    size_t i, shared;
+    int key;
+
+    assert (tree.is_empty() and tree.find(1) == NULL and tree.erase(1) == ERROR_NOT_FOUND);
+
+    for (i = 0; i < 1000; i++)
+    {
+        key = (int)(rng() % 5000);
+        tree.insert(key, to_string(key));
+        kv[key] = to_string(key);
+    }
+    check_ptree(tree, kv);
+
+    // an insert copies only the path to the new key
+    snap = tree.snapshot();
+    tree.insert(-1, "-1");
+    shared = 0;
+    for (const cshark_ptree_node_t &nt : snap)
+    {
+        shared += (tree.find(nt.key) == &nt) ? 1 : 0;
+    }
+    assert (shared + 64 > snap.get_size());
+    assert (snap.find(-1) == NULL and tree.find(-1)->name == "-1");
+
+    // without snapshots, changes are made in place
+    snap.clear();
+    const cshark_ptree_node_t *nt = tree.find(kv.begin()->first);
+    tree.insert(kv.begin()->first, "updated");
+    assert (tree.find(kv.begin()->first) == nt and nt->name == "updated");
+    tree.insert(kv.begin()->first, kv.begin()->second);
+    tree.erase(-1);
+    check_ptree(tree, kv);
+
+    for (i = 0; i < 5000; i++)
+    {
+        key = (int)(rng() % 2000);
+        if (rng() % 3 == 0)
+        {
+            assert (tree.erase(key) == (kv.erase(key) ? SUCCESS : ERROR_NOT_FOUND));
+        }
+        else
+        {
+            tree.insert(key, to_string(i));
+            kv[key] = to_string(i);
+        }
+
+        if (i % 250 == 0)
+        {
+            versions.push_back(tree.snapshot());
+            expected.push_back(kv);
+        }
+    }
+
+    check_ptree(tree, kv);
+    for (i = 0; i < versions.size(); i++)
+    {
+        check_ptree(versions[i], expected[i]);
+    }
+
+    printf("[SUCCESS] PersistentTree snapshot(), insert(), erase(), find()\n");
+}
+
+/**
+ * Readers walk snapshots in other threads while the writer keeps changing its version
+ */
+void PersistentTest::test_snapshot_threads()
+{
+    PersistentTree tree;
+    vector<thread> readers;
+    size_t i;
+    int k;
+
+    for (k = 0; k < 1000; k++)
+    {
+        tree.insert(k, to_string(k));
+    }
+
+    for (i = 0; i < 4; i++)
+    {
+        PersistentTree snap = tree.snapshot();
+
+        readers.push_back(thread([snap]() {
+            size_t n = 0;
+            int prev = -1;
+
+            for (const cshark_ptree_node_t &nt : snap)
+            {
+                assert (nt.key > prev and nt.name == to_string(nt.key));
+                prev = nt.key;
+                n++;
+            }
+            assert (n == snap.get_size());
+        }));
+
+        for (k = 0; k < 1000; k += 3)
+        {
+            tree.erase(k);
+            tree.insert(k, to_string(k));
+        }
+    }
+
+    for (i = 0; i < readers.size(); i++)
+    {
+        readers[i].join();
+    }
+
+    assert (tree.get_size() == 1000);
+
+    printf("[SUCCESS] Persistent snapshots read by other threads\n");
+}
+
+void cpp_test_persistent_main()
+{
+    printf("\n=== Persistent list and tree test ===\n");
+
+    PersistentTest *persistent_test = new PersistentTest();
+    persistent_test->test_main();
+    delete(persistent_test);
+}
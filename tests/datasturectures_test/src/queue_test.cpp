@@ -9,6 +9,8 @@
  */
 
 #include <assert.h>
+#include <algorithm>
+#include <vector>
 
 #include "datastructures/include/queue.h"
 #include "datasturectures_test/include/queue_test.h"
@@ -53,6 +55,87 @@ void QueueTest::test_main()
     delete(q1);
 
     printf("[SUCCESS] Queue enqueue(), dequeu(), is_empty(), is_full()\n");
+
+    this->test_batch();
+    this->test_iterator();
+}
+
+void QueueTest::test_batch()
+{
+    cshark_queue *cq;
+    cshark_node_t *nt;
+    Queue *q;
+    vector<int> in;
+    int out[8];
+    size_t i;
+
+    for (i = 0; i < 10; i++)
+    {
+        in.push_back((int)i);
+    }
+
+    q = new Queue();
+    assert (q->enqueue_batch(in.data(), 5) == SUCCESS);
+    assert (q->enqueue_range(in.begin() + 5, in.end()) == SUCCESS);
+    assert (q->enqueue_batch(NULL, 0) == SUCCESS and q->enqueue_batch(NULL, 1) == ERROR_PARAM);
+
+    nt = q->dequeue();
+    assert (nt->val == 0);
+    delete(nt);
+
+    assert (q->dequeue_batch(out, 8) == 8);
+    for (i = 0; i < 8; i++)
+    {
+        assert (out[i] == (int)(i + 1));
+    }
+    assert (q->dequeue_batch(out, 8) == 1 and out[0] == 9);
+    assert (q->dequeue_batch(out, 8) == 0 and q->is_empty());
+
+    q->enqueue(42);     // the queue is usable after being drained
+    nt = q->dequeue();
+    assert (nt->val == 42);
+    delete(nt);
+    delete(q);
+
+    cq = cshark_queue_init();
+    assert (cshark_queue_add_batch(cq, in.data(), in.size()) == SUCCESS);
+    assert (cshark_queue_getsize(cq) == 10);
+    assert (cshark_queue_pop_batch(cq, out, 4) == 4 and out[0] == 0 and out[3] == 3);
+    assert (cshark_queue_getsize(cq) == 6 and cq->first->val == 4 and cq->last->val == 9);
+    assert (cshark_queue_pop_batch(cq, out, 8) == 6 and out[5] == 9);
+    assert (cshark_queue_getsize(cq) == 0 and cq->last == cq->head);
+    assert (cshark_queue_add(cq, 7) == SUCCESS and cq->first->val == 7);
+    cshark_queue_destroy(cq);
+
+    printf("[SUCCESS] Queue enqueue_batch(), enqueue_range(), dequeue_batch()\n");
+}
+
+void QueueTest::test_iterator()
+{
+    Queue *q;
+    vector<int> in;
+    vector<int> out;
+    size_t i;
+
+    q = new Queue();
+    assert (q->begin() == q->end());
+
+    for (i = 0; i < 100; i++)
+    {
+        in.push_back((int)(i * 3));
+    }
+    q->enqueue_range(in.begin(), in.end());
+
+    // from the front to the rear
+    for (const cshark_node_t &nt : *q)
+    {
+        out.push_back(nt.val);
+    }
+    assert (out == in);
+    assert (count_if(q->begin(), q->end(), [](const cshark_node_t &nt) { return nt.val % 2 == 0; }) == 50);
+    delete(q);
+
+    printf("[SUCCESS] Queue iterator[begin(), end()]\n");
 }
 
 void cpp_test_queue_main()
@@ -0,0 +1,280 @@
+/*
+ ============================================================================
+ Name        : skiplist_test.cpp
+ Description : skip list test implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#include <assert.h>
+#include <algorithm>
+#include <map>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "common/include/err.h"
+#include "datasturectures_test/include/skiplist_test.h"
+
+SkipListTest::SkipListTest()
+{
+}
+
+SkipListTest::~SkipListTest()
+{
+
+}
+
+void SkipListTest::test_main()
+{
+    this->test_set();
+    this->test_map();
+    this->test_iterators();
+    this->test_random();
+    this->test_lockfree();
+    this->test_lockfree_threads();
+}
+
+void SkipListTest::test_set()
+{
+    SkipList list;
+    int keys[] = {40, 5, 23, 17, 60, 31, 52};
+    size_t i;
+
+    assert (list.get_size() == 0 and list.get_first() == NULL and list.get_last() == NULL);
+    assert (list.find(1) == NULL and list.erase(1) == ERROR_NOT_FOUND);
+
+    for (i = 0; i < sizeof(keys) / sizeof(keys[0]); i++)
+    {
+        assert (list.insert(keys[i]) == SUCCESS);
+    }
+    assert (list.insert(23) == ERROR_EXISTS);
+    assert (list.get_size() == 7);
+    assert (list.get_first()->val == 5 and list.get_last()->val == 60);
+
+    assert (list.contains(31) and !list.contains(30));
+    assert (list.lower_bound(30)->val == 31 and list.lower_bound(5)->val == 5);
+    assert (list.lower_bound(61) == NULL);
+
+    assert (list.erase(60) == SUCCESS and list.get_last()->val == 52);
+    assert (list.erase(5) == SUCCESS and list.get_first()->val == 17);
+    assert (list.erase(5) == ERROR_NOT_FOUND and list.get_size() == 5);
+
+    list.clear();
+    assert (list.get_size() == 0 and list.get_first() == NULL);
+    assert (list.insert(1) == SUCCESS and list.get_last()->val == 1);
+
+    printf("[SUCCESS] SkipList insert(), find() and erase() as a set\n");
+}
+
+void SkipListTest::test_map()
+{
+    SkipList list;
+
+    assert (list.put(2, "two") == SUCCESS and list.put(1, "one") == SUCCESS);
+    assert (list.find(2)->name == "two" and list.find(1)->name == "one");
+
+    assert (list.put(2, "TWO") == SUCCESS and list.get_size() == 2);
+    assert (list.find(2)->name == "TWO");
+
+    printf("[SUCCESS] SkipList put() as a map\n");
+}
+
+void SkipListTest::test_iterators()
+{
+    SkipList list;
+    vector<int> keys;
+    SkipList::iterator it;
+    int key;
+
+    for (key = 20; key > 0; key--)
+    {
+        list.insert(key * 10);
+    }
+
+    // level 0 is a sorted linklist
+    for (cshark_node_t &nt : list)
+    {
+        keys.push_back(nt.val);
+    }
+    assert (keys.size() == 20 and is_sorted(keys.begin(), keys.end()));
+
+    keys.clear();
+    for (cshark_node_t &nt : list.range(35, 80))
+    {
+        keys.push_back(nt.val);
+    }
+    assert (keys.size() == 4 and keys.front() == 40 and keys.back() == 70);
+
+    assert (list.range(80, 80).begin() == list.range(80, 80).end());
+    assert (list.range(300, 400).begin() == list.end());
+
+    it = list.end();
+    --it;
+    assert (it->val == 200);
+    assert (list.rbegin()->val == 200 and (++list.rbegin())->val == 190);
+    assert (distance(list.begin(), list.end()) == 20);
+
+    printf("[SUCCESS] SkipList iterators and range()\n");
+}
+
+/**
+ * Random operations against std::map, checking order and links at every level
+ */
+void SkipListTest::test_random()
+{
+    SkipList list;
+    map<int, string> model;
+    map<int, string>::iterator mit;
+    cshark_node_t *nt;
+    cshark_node_t *prev;
+    mt19937 rng(7);
+    int key, i, op;
+
+    for (i = 0; i < 20000; i++)
+    {
+        key = (int)(rng() % 2000) - 1000;
+        op = (int)(rng() % 4);
+
+        if (op == 0)
+        {
+            assert ((list.insert(key) == SUCCESS) == (model.count(key) == 0));
+            model.insert(make_pair(key, "unused"));
+        }
+        else if (op == 1)
+        {
+            list.put(key, to_string(i));
+            model[key] = to_string(i);
+        }
+        else if (op == 2)
+        {
+            assert ((list.erase(key) == SUCCESS) == (model.erase(key) == 1));
+        }
+        else
+        {
+            nt = list.lower_bound(key);
+            mit = model.lower_bound(key);
+            assert ((nt == NULL) == (mit == model.end()));
+            assert (nt == NULL or (nt->val == mit->first and nt->name == mit->second));
+        }
+    }
+
+    assert (list.get_size() == model.size());
+
+    prev = NULL;
+    mit = model.begin();
+    for (cshark_node_t &entry : list)
+    {
+        assert (entry.val == mit->first and entry.name == mit->second);
+        assert (prev == NULL or entry.prev == prev);
+        prev = &entry;
+        ++mit;
+    }
+
+    printf("[SUCCESS] SkipList random operations against std::map\n");
+}
+
+void SkipListTest::test_lockfree()
+{
+    LockFreeSkipList list;
+    set<int> model;
+    int keys[64];
+    mt19937 rng(3);
+    size_t n;
+    int key, i;
+
+    assert (!list.contains(1) and list.erase(1) == ERROR_NOT_FOUND);
+    assert (list.insert(1) == SUCCESS and list.insert(1) == ERROR_EXISTS);
+    assert (list.contains(1) and list.erase(1) == SUCCESS and !list.contains(1));
+
+    for (i = 0; i < 20000; i++)
+    {
+        key = (int)(rng() % 1000);
+        if (rng() % 2 == 0)
+        {
+            assert ((list.insert(key) == SUCCESS) == model.insert(key).second);
+        }
+        else
+        {
+            assert ((list.erase(key) == SUCCESS) == (model.erase(key) == 1));
+        }
+    }
+    assert (list.get_size() == model.size());
+
+    n = list.range(100, 300, keys, 64);
+    assert (n == (size_t)min<ptrdiff_t>(64, distance(model.lower_bound(100), model.lower_bound(300))));
+    assert (equal(keys, keys + n, model.lower_bound(100)));
+
+    printf("[SUCCESS] LockFreeSkipList insert(), contains(), erase() and range()\n");
+}
+
+/**
+ * Threads insert and erase overlapping keys; every key is added and removed by pairs of
+ * operations, so the list ends with the keys each thread added last
+ */
+void SkipListTest::test_lockfree_threads()
+{
+    LockFreeSkipList list;
+    vector<thread> workers;
+    int keys[4000];
+    size_t n;
+    int t, key;
+
+    for (t = 0; t < 4; t++)
+    {
+        workers.push_back(thread([&list, t]() {
+            mt19937 rng(t);
+            int key, i;
+
+            for (i = 0; i < 20000; i++)
+            {
+                key = (int)(rng() % 2000);
+                if (rng() % 2 == 0)
+                {
+                    list.insert(key);
+                }
+                else
+                {
+                    list.erase(key);
+                }
+                list.contains((int)(rng() % 2000));
+            }
+
+            // each thread owns keys 2000 + t * 500 and up, which all end up in the list
+            for (i = 0; i < 500; i++)
+            {
+                assert (list.insert(2000 + t * 500 + i) == SUCCESS);
+            }
+        }));
+    }
+
+    for (t = 0; t < 4; t++)
+    {
+        workers[t].join();
+    }
+
+    n = list.range(2000, 4000, keys, 4000);
+    assert (n == 2000);
+    for (key = 0; key < 2000; key++)
+    {
+        assert (keys[key] == 2000 + key);
+    }
+
+    n = list.range(0, 4000, keys, 4000);
+    assert (n == list.get_size() and is_sorted(keys, keys + n));
+    assert (adjacent_find(keys, keys + n) == keys + n);
+
+    printf("[SUCCESS] LockFreeSkipList shared by 4 threads\n");
+}
+
+void cpp_test_skiplist_main()
+{
+    printf("\n=== SkipList test ===\n");
+
+    SkipListTest *skiplist_test = new SkipListTest();
+    skiplist_test->test_main();
+    delete(skiplist_test);
+}
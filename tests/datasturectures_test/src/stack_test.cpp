@@ -9,6 +9,10 @@
  */
 
 #include <assert.h>
+#include <algorithm>
+#include <list>
+
+#include "common/include/err.h"
 #include "datasturectures_test/include/stack_test.h"
 
 StackTest::StackTest()
@@ -50,6 +54,66 @@ void StackTest::test_main()
     delete(s1);
 
     printf("[SUCCESS] Stack push(), pop(), is_empty(), is_full()\n");
+
+    this->test_batch();
+    this->test_iterator();
+}
+
+void StackTest::test_batch()
+{
+    cshark_node_t *nt;
+    Stack *s;
+    int in[6] = {0, 1, 2, 3, 4, 5};
+    list<int> more(3, 7);
+    int out[4];
+
+    s = new Stack();
+    assert (s->push_batch(in, 6) == SUCCESS);
+    assert (s->push_range(more.begin(), more.end()) == SUCCESS);   // any forward iterator
+    assert (s->push_batch(NULL, 2) == ERROR_PARAM);
+
+    assert (s->pop_batch(out, 4) == 4);
+    assert (out[0] == 7 and out[1] == 7 and out[2] == 7 and out[3] == 5);
+
+    nt = s->pop();
+    assert (nt->val == 4);
+    delete(nt);
+
+    assert (s->pop_batch(out, 4) == 4 and out[0] == 3 and out[3] == 0);
+    assert (s->pop_batch(out, 4) == 0 and s->is_empty() and s->get_top() == NULL);
+
+    s->push(9);
+    assert (s->get_top()->val == 9);
+    delete(s);
+
+    printf("[SUCCESS] Stack push_batch(), push_range(), pop_batch()\n");
+}
+
+void StackTest::test_iterator()
+{
+    Stack *s;
+    Stack::iterator it;
+    int vals[5] = {1, 2, 3, 4, 5};
+    int expected;
+
+    s = new Stack();
+    assert (s->begin() == s->end());
+
+    s->push_batch(vals, 5);
+
+    // from the top to the bottom
+    expected = 5;
+    for (cshark_node_t &nt : *s)
+    {
+        assert (nt.val == expected--);
+    }
+    assert (expected == 0);
+
+    it = find_if(s->begin(), s->end(), [](const cshark_node_t &nt) { return nt.val < 3; });
+    assert (it != s->end() and it->val == 2);
+    delete(s);
+
+    printf("[SUCCESS] Stack iterator[begin(), end()]\n");
 }
 
 void cpp_test_stack_main()
@@ -0,0 +1,248 @@
+/*
+ ============================================================================
+ Name        : static_test.cpp
+ Description : fixed-capacity containers test implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#include <assert.h>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/include/err.h"
+#include "datasturectures_test/include/static_test.h"
+
+// empty containers are constant expressions, and never allocate
+static constexpr StaticStack<int, 4> const_stack;
+static constexpr StaticQueue<int, 4> const_queue;
+static constexpr StaticHashTable<int, int, 8> const_table;
+static constexpr StaticBTree<int, 7> const_tree;
+
+static_assert(const_stack.is_empty() and const_stack.capacity() == 4, "constexpr StaticStack");
+static_assert(const_queue.get_size() == 0 and !const_queue.is_full(), "constexpr StaticQueue");
+static_assert(const_table.is_empty() and const_table.capacity() == 8, "constexpr StaticHashTable");
+static_assert(const_tree.get_size() == 0 and StaticBTree<int, 7>::left(1) == 3 and
+              StaticBTree<int, 7>::parent(6) == 2, "constexpr StaticBTree");
+
+StaticTest::StaticTest()
+{
+}
+
+StaticTest::~StaticTest()
+{
+
+}
+
+void StaticTest::test_main()
+{
+    this->test_stack();
+    this->test_queue();
+    this->test_hashtable();
+    this->test_tree();
+}
+
+void StaticTest::test_stack()
+{
+    StaticStack<int, 8> stack;
+    StaticStack<string, 2> names;
+    vector<int> vals;
+    int v;
+    int i;
+
+    assert (stack.is_empty() and stack.get_top() == NULL);
+    assert (stack.pop(&v) == ERROR_TARGET_EMPTY);
+
+    for (i = 0; i < 8; i++)
+    {
+        assert (stack.push(i) == SUCCESS);
+        assert (*stack.get_top() == i);
+    }
+    assert (stack.is_full() and stack.push(8) == ERROR_MAX_NODES);
+
+    // iterators walk from the top
+    for (int x : stack)
+    {
+        vals.push_back(x);
+    }
+    assert (vals.size() == 8 and vals[0] == 7 and vals[7] == 0);
+
+    for (i = 7; i >= 0; i--)
+    {
+        assert (stack.pop(&v) == SUCCESS and v == i);
+    }
+    assert (stack.is_empty());
+
+    assert (names.push("a") == SUCCESS and names.push("b") == SUCCESS);
+    assert (names.pop(NULL) == SUCCESS and *names.get_top() == "a");
+    names.clear();
+    assert (names.is_empty());
+
+    printf("[SUCCESS] StaticStack push(), pop(), get_top(), iterator\n");
+}
+
+void StaticTest::test_queue()
+{
+    StaticQueue<int, 5> queue;
+    int v;
+    int i, k;
+
+    assert (queue.is_empty() and queue.get_front() == NULL);
+    assert (queue.dequeue(&v) == ERROR_TARGET_EMPTY);
+
+    // wrap around the ring several times
+    k = 0;
+    for (i = 0; i < 100; i++)
+    {
+        assert (queue.enqueue(i) == SUCCESS);
+        if (queue.is_full())
+        {
+            assert (queue.enqueue(-1) == ERROR_MAX_NODES);
+            while (queue.get_size() > 1)
+            {
+                assert (*queue.get_front() == k and queue.at(0) == k);
+                assert (queue.dequeue(&v) == SUCCESS and v == k);
+                k++;
+            }
+        }
+    }
+
+    while (!queue.is_empty())
+    {
+        assert (queue.dequeue(&v) == SUCCESS and v == k);
+        k++;
+    }
+    assert (k == 100);
+
+    printf("[SUCCESS] StaticQueue enqueue(), dequeue(), ring wrap-around\n");
+}
+
+void StaticTest::test_hashtable()
+{
+    StaticHashTable<int, int, 256> *table;
+    StaticHashTable<string, int, 4> names;
+    map<int, int> expected;
+    mt19937 rng(7);
+    size_t n;
+    int key, i;
+
+    table = new StaticHashTable<int, int, 256>();
+    assert (table->find(1) == NULL and table->erase(1) == ERROR_NOT_FOUND);
+
+    // random inserts and erases against std::map, with the table up to 3/4 full
+    for (i = 0; i < 20000; i++)
+    {
+        key = (int)(rng() % 400);
+        if (rng() % 2 == 0)
+        {
+            if (expected.size() < 192 or expected.count(key) > 0)
+            {
+                assert (table->insert(key, i) == SUCCESS);
+                expected[key] = i;
+            }
+        }
+        else
+        {
+            assert (table->erase(key) == (expected.erase(key) > 0 ? SUCCESS : ERROR_NOT_FOUND));
+        }
+
+        if (i % 1000 == 0)
+        {
+            assert (table->get_size() == expected.size());
+            for (key = 0; key < 400; key++)
+            {
+                const int *v = table->find(key);
+                assert (expected.count(key) > 0 ? (v != NULL and *v == expected[key]) : v == NULL);
+            }
+        }
+    }
+
+    n = 0;
+    table->for_each([&](int k, int v) {
+        assert (expected[k] == v);
+        n++;
+    });
+    assert (n == expected.size());
+
+    // a full table still finds every key, and rejects new ones
+    table->clear();
+    for (i = 0; i < 256; i++)
+    {
+        assert (table->insert(i * 7, i) == SUCCESS);
+    }
+    assert (table->is_full() and table->insert(-1, 0) == ERROR_MAX_NODES);
+    assert (table->insert(7, 100) == SUCCESS and *table->find(7) == 100);
+    for (i = 0; i < 256; i++)
+    {
+        assert (table->contains(i * 7));
+    }
+    delete(table);
+
+    assert (names.insert("one", 1) == SUCCESS and names.insert("two", 2) == SUCCESS);
+    assert (*names.find("two") == 2 and !names.contains("three"));
+
+    printf("[SUCCESS] StaticHashTable insert(), find(), erase(), full table\n");
+}
+
+/**
+ * Get the values of a BTree in an order by its iterator
+ */
+static vector<int> static_btree_vals(BTree *btree, ORDER_TYPE order)
+{
+    vector<int> vals;
+
+    for (const cshark_node_t &nt : btree->traversal(order))
+    {
+        vals.push_back(nt.val);
+    }
+
+    return vals;
+}
+
+void StaticTest::test_tree()
+{
+    StaticBTree<int, 40> tree;
+    ORDER_TYPE orders[4] = {PREORDER, INORDER, POSTORDER, LEVELORDER};
+    BTree *btree;
+    int out[40];
+    size_t n, k;
+    int i;
+
+    assert (tree.get_root() == NULL and tree.traverse(INORDER, out, 40) == 0);
+
+    // complete trees of all sizes give the same orders as BTree::create_by_level()
+    for (n = 1; n <= 40; n++)
+    {
+        assert (tree.insert((int)n) == SUCCESS);
+        btree = new BTree();
+        btree->create_by_level(n);
+
+        for (i = 0; i < 4; i++)
+        {
+            k = tree.traverse(orders[i], out, 40);
+            assert (vector<int>(out, out + k) == static_btree_vals(btree, orders[i]));
+        }
+        delete(btree);
+    }
+
+    assert (tree.is_full() and tree.insert(41) == ERROR_MAX_NODES);
+    assert (*tree.get_root() == 1 and tree.at(StaticBTree<int, 40>::right(0)) == 3);
+
+    // output is cut at max
+    assert (tree.traverse(POSTORDER, out, 3) == 3 and out[0] == 32 and out[1] == 33 and out[2] == 16);
+
+    printf("[SUCCESS] StaticBTree insert(), traverse() in all orders\n");
+}
+
+void cpp_test_static_main()
+{
+    printf("\n=== Fixed-capacity containers test ===\n");
+
+    StaticTest *static_test = new StaticTest();
+    static_test->test_main();
+    delete(static_test);
+}
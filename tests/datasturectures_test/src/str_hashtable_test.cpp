@@ -0,0 +1,173 @@
+/*
+ ============================================================================
+ Name        : str_hashtable_test.cpp
+ Description : string-keyed hash table test implementation
+ Author      : Zhi Liu<zliucd66@gmail.com>
+ Copyright   : Codeshark is a free C/C++ code repository under Apache 2.0 license,
+               see LICENSE.txt.
+ ============================================================================
+ */
+
+#include <assert.h>
+#include <string.h>
+#include <map>
+#include <string>
+
+#include "common/include/err.h"
+#include "datasturectures_test/include/str_hashtable_test.h"
+
+StrHashTableTest::StrHashTableTest()
+{
+}
+
+StrHashTableTest::~StrHashTableTest()
+{
+
+}
+
+void StrHashTableTest::test_main()
+{
+    this->test_add_find();
+    this->test_random();
+    this->test_compact();
+}
+
+void StrHashTableTest::test_add_find()
+{
+    str_hashtable_t *ht;
+    const char *buf = "alpha beta gamma";
+    const char *v;
+    size_t len;
+
+    ht = str_hashtable_init(0);
+    assert (str_hashtable_getsize(ht) == 0 and str_hashtable_find(ht, "alpha", 5, &len) == NULL);
+
+    // keys are looked up by pointer and length, e.g., words of a buffer
+    assert (str_hashtable_add(ht, buf, 5, "1", 1) == SUCCESS);
+    assert (str_hashtable_add(ht, buf + 6, 4, "22", 2) == SUCCESS);
+    v = str_hashtable_find(ht, "beta", 4, &len);
+    assert (v != NULL and len == 2 and memcmp(v, "22", 2) == 0);
+    assert (str_hashtable_contains(ht, "alpha", 5) and !str_hashtable_contains(ht, "alph", 4));
+    assert (!str_hashtable_contains(ht, buf, 16));
+
+    // an update keeps one entry; the old value stays readable until compaction
+    assert (str_hashtable_add(ht, string("alpha"), string("one")) == SUCCESS);
+    v = str_hashtable_find(ht, string("alpha"), &len);
+    assert (str_hashtable_getsize(ht) == 2 and len == 3 and memcmp(v, "one", 3) == 0);
+
+    // empty keys and values, and bytes which are not text
+    assert (str_hashtable_add(ht, "", 0, "", 0) == SUCCESS);
+    assert (str_hashtable_find(ht, "", 0, &len) != NULL and len == 0);
+    assert (str_hashtable_add(ht, "a\0b", 3, "x", 1) == SUCCESS and !str_hashtable_contains(ht, "a\0c", 3));
+    assert (str_hashtable_contains(ht, "a\0b", 3) and !str_hashtable_contains(ht, "a", 1));
+
+    assert (str_hashtable_delete(ht, "beta", 4) == SUCCESS and str_hashtable_delete(ht, "beta", 4) == ERROR_NOT_FOUND);
+    assert (!str_hashtable_contains(ht, "beta", 4) and str_hashtable_getsize(ht) == 3);
+    assert (str_hashtable_add(NULL, "a", 1, "b", 1) == ERROR_PARAM and str_hashtable_add(ht, NULL, 1, "b", 1) == ERROR_PARAM);
+
+    str_hashtable_destroy(ht);
+
+    printf("[SUCCESS] str_hashtable add(), find(), contains(), delete()\n");
+}
+
+/**
+ * Random adds, updates and deletes against std::map, through rehashes and deleted slots
+ */
+void StrHashTableTest::test_random()
+{
+    str_hashtable_t *ht;
+    map<string, string> model;
+    map<string, string>::iterator it;
+    uint64_t x = 88172645463325252ULL;
+    string key, val;
+    const char *v;
+    size_t len;
+    int i;
+
+    ht = str_hashtable_init(0);
+    for (i = 0; i < 100000; i++)
+    {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        key = "key/" + to_string(x % 5000) + string(x % 23, 'k');
+        if (x % 4 == 0)
+        {
+            assert ((str_hashtable_delete(ht, key.data(), key.size()) == SUCCESS) == (model.erase(key) == 1));
+        }
+        else
+        {
+            val = "val" + to_string(i);
+            str_hashtable_add(ht, key, val);
+            model[key] = val;
+        }
+    }
+
+    assert (str_hashtable_getsize(ht) == model.size());
+    for (it = model.begin(); it != model.end(); it++)
+    {
+        v = str_hashtable_find(ht, it->first, &len);
+        assert (v != NULL and string(v, len) == it->second);
+    }
+
+    str_hashtable_destroy(ht);
+
+    printf("[SUCCESS] str_hashtable against std::map, %zu keys\n", model.size());
+}
+
+void StrHashTableTest::test_compact()
+{
+    str_hashtable_t *ht;
+    string key;
+    const char *v;
+    size_t before, len;
+    int i;
+
+    ht = str_hashtable_init(1000);
+    for (i = 0; i < 1000; i++)
+    {
+        key = "key" + to_string(i);
+        str_hashtable_add(ht, key, string(100, 'a'));
+    }
+
+    // a table sized for its keys never rehashes while they are added
+    assert (ht->capacity == 2048);
+
+    for (i = 0; i < 1000; i++)
+    {
+        key = "key" + to_string(i);
+        if (i % 2 == 0)
+        {
+            str_hashtable_delete(ht, key.data(), key.size());
+        }
+        else
+        {
+            str_hashtable_add(ht, key, "b");
+        }
+    }
+
+    before = ht->arena->get_used();
+    assert (str_hashtable_compact(ht) == SUCCESS and ht->garbage == 0 and ht->deleted == 0);
+    assert (ht->arena->get_used() < before);
+
+    for (i = 0; i < 1000; i++)
+    {
+        key = "key" + to_string(i);
+        v = str_hashtable_find(ht, key, &len);
+        assert ((v != NULL) == (i % 2 == 1));
+        assert (v == NULL or (len == 1 and v[0] == 'b'));
+    }
+
+    str_hashtable_destroy(ht);
+
+    printf("[SUCCESS] str_hashtable compact()\n");
+}
+
+void cpp_test_str_hashtable_main()
+{
+    printf("\n=== String hash table test ===\n");
+
+    StrHashTableTest *str_hashtable_test = new StrHashTableTest();
+    str_hashtable_test->test_main();
+    delete(str_hashtable_test);
+}
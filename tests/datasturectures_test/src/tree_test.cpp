@@ -10,6 +10,8 @@
 
 #include <stdio.h>
 #include <assert.h>
+#include <algorithm>
+#include <vector>
 
 #include "datastructures/include/tree.h"
 #include "datasturectures_test/include/tree_test.h"
@@ -77,6 +79,116 @@ void TreeTest::test_main()
     delete(btree);
 
     printf("[SUCCESS] Btree postorder recursive traversal\n");
+
+    this->test_iterator();
+}
+
+/**
+ * Values of nodes in a traversal order, by iterator
+ */
+static vector<int> iterate_vals(BTree *btree, ORDER_TYPE order)
+{
+    vector<int> vals;
+
+    for (cshark_node_t &nt : btree->traversal(order))
+    {
+        vals.push_back(nt.val);
+    }
+
+    return vals;
+}
+
+/**
+ * Values of nodes in a traversal order, by recursive traversal
+ */
+static vector<int> recursive_vals(BTree *btree, ORDER_TYPE order)
+{
+    LinkList *list;
+    vector<int> vals;
+
+    if (order == PREORDER)
+    {
+        btree->traverse_preorder(&list);
+    }
+    else if (order == INORDER)
+    {
+        btree->traverse_inorder(&list);
+    }
+    else
+    {
+        btree->traverse_postorder(&list);
+    }
+
+    for (cshark_node_t &nt : *list)
+    {
+        vals.push_back(nt.val);
+    }
+
+    list->detach_head();    // the nodes belong to the tree
+    delete(list);
+
+    return vals;
+}
+
+void TreeTest::test_iterator()
+{
+    BTree *btree;
+    cshark_node_t nodes[6];
+    cshark_btree_iterator it;
+    vector<int> vals;
+    size_t n;
+    int i;
+
+    // complete trees of all shapes up to 40 nodes
+    for (n = 1; n <= 40; n++)
+    {
+        btree = new BTree();
+        btree->create_by_level(n);
+
+        assert (iterate_vals(btree, PREORDER) == recursive_vals(btree, PREORDER));
+        assert (iterate_vals(btree, INORDER) == recursive_vals(btree, INORDER));
+        assert (iterate_vals(btree, POSTORDER) == recursive_vals(btree, POSTORDER));
+
+        vals = iterate_vals(btree, LEVELORDER);
+        assert (vals.size() == n);
+        for (i = 0; i < (int)n; i++)
+        {
+            assert (vals[i] == i + 1);
+        }
+
+        it = find_if(btree->begin(INORDER), btree->end(), [](const cshark_node_t &nt) { return nt.val == 1; });
+        assert (it != btree->end() and it.operator->() == btree->get_root());
+        delete(btree);
+    }
+
+    // a tree with single-child nodes:  1 -> left 2 -> right 3 -> left 4, 1 -> right 5 -> right 6
+    for (i = 0; i < 6; i++)
+    {
+        nodes[i].val = i + 1;
+        nodes[i].left = NULL;
+        nodes[i].right = NULL;
+    }
+    nodes[0].left = &nodes[1];
+    nodes[1].right = &nodes[2];
+    nodes[2].left = &nodes[3];
+    nodes[0].right = &nodes[4];
+    nodes[4].right = &nodes[5];
+
+    const char *expected[4] = {"1,2,3,4,5,6", "2,4,3,1,5,6", "4,3,2,6,5,1", "1,2,5,3,6,4"};
+    ORDER_TYPE orders[4] = {PREORDER, INORDER, POSTORDER, LEVELORDER};
+    for (i = 0; i < 4; i++)
+    {
+        string s;
+        for (cshark_node_t &nt : cshark_btree_traversal(&nodes[0], orders[i]))
+        {
+            s += (s.empty() ? "" : ",") + to_string(nt.val);
+        }
+        assert (s == expected[i]);
+    }
+
+    assert (cshark_btree_traversal(NULL, INORDER).begin() == cshark_btree_iterator());
+
+    printf("[SUCCESS] Btree iterator[begin(), end(), traversal()]\n");
 }
 
 void cpp_tree_test_main()